@@ -1,8 +1,28 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <unordered_set>
+#include <vector>
 
 class Occt_view;
+class TopoDS_Shape;
+
+/// Document records changed since the last autosave capture (see `Occt_view::capture_doc_snapshot`).
+struct Doc_dirty
+{
+  std::unordered_set<size_t>   sketches;   // Sketch ids
+  std::unordered_set<uint64_t> shapes;     // Shape ids
+  bool                         all{false}; // Every record (new document, file open, checkpoint restore)
+
+  void clear()
+  {
+    sketches.clear();
+    shapes.clear();
+    all = false;
+  }
+};
 
 /// One undo/redo step. Subclasses record a forward change; `apply_reverse` undoes it and
 /// `apply_forward` redoes it.
@@ -14,4 +34,12 @@ public:
   virtual void                   apply_forward(Occt_view& view) = 0;
   virtual void                   apply_reverse(Occt_view& view) = 0;
   virtual std::unique_ptr<Delta> clone() const                  = 0;
+
+  /// Approximate heap bytes held by this step, excluding shape geometry (see `collect_geometry`).
+  virtual size_t approx_bytes() const = 0;
+  /// Appends the shapes this step keeps alive. History memory counts each distinct `TShape` once, so geometry
+  /// shared with the document or with other steps is not double counted.
+  virtual void collect_geometry(std::vector<TopoDS_Shape>& /*out*/) const {}
+  /// Adds the sketches and shapes this step changes in either direction. The default marks the whole document.
+  virtual void collect_dirty(Doc_dirty& out) const { out.all = true; }
 };
@@ -0,0 +1,162 @@
+#include "doc_autosave.h"
+
+#include <fstream>
+#include <system_error>
+
+#include "gui_occt_view.h"
+#include "utl_parallel.h"
+#include "utl_settings.h"
+
+namespace
+{
+constexpr const char* k_recovered_file_name = "recovered.ezy";
+} // namespace
+
+Doc_autosave::Doc_autosave()
+    : m_last_save(Clock::now())
+{
+}
+
+Doc_autosave::~Doc_autosave()
+{
+  if (m_job.valid())
+    m_job.wait();
+}
+
+void Doc_autosave::poll(Occt_view& view, const std::function<void(const std::string&)>& log, Clock::time_point now)
+{
+  if (m_job.valid() && m_job.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    finish_job_(log);
+
+  if (m_job.valid() || m_interval_s <= 0 || view.doc_edit_revision() == m_saved_rev)
+    return;
+
+  if (now - m_last_save < std::chrono::seconds(m_interval_s))
+    return;
+
+  const std::filesystem::path path = settings::user_recovery_project_path();
+  if (path.empty())
+    return;
+
+  // Capturing is the only UI-thread cost; encoding, compression and the write run on the worker. The job borrows
+  // the snapshot, which `m_job_snapshot` keeps alive until the result is collected here.
+  m_job_snapshot = view.capture_doc_snapshot();
+  m_saved_rev    = view.doc_edit_revision();
+  m_last_save    = now;
+  m_wrote_file   = true;
+  m_job          = run_task_async(Task_priority::Background,
+                                  [snapshot = m_job_snapshot.get(), path] { return write_recovery(*snapshot, path); });
+}
+
+void Doc_autosave::mark_clean(const Occt_view& view)
+{
+  if (m_job.valid())
+  {
+    (void)m_job.get();
+    m_job_snapshot.reset();
+  }
+
+  remove_recovery_();
+  m_saved_rev = view.doc_edit_revision();
+  m_last_save = Clock::now();
+  m_failing   = false;
+}
+
+void Doc_autosave::settle(const std::function<void(const std::string&)>& log)
+{
+  if (m_job.valid())
+    finish_job_(log);
+}
+
+void Doc_autosave::shutdown()
+{
+  if (m_job.valid())
+  {
+    (void)m_job.get();
+    m_job_snapshot.reset();
+  }
+
+  remove_recovery_();
+}
+
+Status Doc_autosave::write_recovery(const Doc_snapshot& snapshot, const std::filesystem::path& path)
+{
+  // Geometry is encoded entry by entry while packing; a failing encode makes `pack_ezy_to` return false.
+  Ezy_geom_source   geoms;
+  const std::string manifest = Occt_view::doc_snapshot_to_json(snapshot, geoms);
+
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+  std::filesystem::path tmp = path;
+  tmp += ".tmp";
+
+  std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+  if (!out)
+    return Status(Result_status::Error, "cannot open " + tmp.string() + " for writing");
+
+  const bool written = pack_ezy_to(
+      [&out](const uint8_t* data, std::size_t size)
+      {
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        return out.good();
+      },
+      manifest, snapshot.assets, geoms);
+  out.close();
+  if (!written || !out)
+  {
+    std::filesystem::remove(tmp, ec);
+    return Status(Result_status::Error, "writing " + tmp.string() + " failed");
+  }
+
+  std::filesystem::rename(tmp, path, ec);
+  if (ec)
+  {
+    const std::string reason = ec.message();
+    std::filesystem::remove(tmp, ec);
+    return Status(Result_status::Error, "replacing " + path.string() + ": " + reason);
+  }
+
+  return Status::ok();
+}
+
+std::filesystem::path Doc_autosave::claim_previous_recovery()
+{
+  const std::filesystem::path path = settings::user_recovery_project_path();
+  std::error_code             ec;
+  if (path.empty() || !std::filesystem::exists(path, ec))
+    return {};
+
+  const std::filesystem::path claimed = path.parent_path() / k_recovered_file_name;
+  std::filesystem::rename(path, claimed, ec);
+  return ec ? std::filesystem::path() : claimed;
+}
+
+void Doc_autosave::finish_job_(const std::function<void(const std::string&)>& log)
+{
+  const Status st = m_job.get();
+  m_job_snapshot.reset();
+  if (st.is_ok())
+  {
+    m_failing = false;
+    return;
+  }
+
+  // Retry at the next interval even without further edits; report once per run of failures.
+  m_saved_rev = ~uint64_t(0);
+  if (!m_failing && log)
+    log("Autosave failed: " + st.message());
+
+  m_failing = true;
+}
+
+void Doc_autosave::remove_recovery_()
+{
+  if (!m_wrote_file)
+    return;
+
+  m_wrote_file                     = false;
+  const std::filesystem::path path = settings::user_recovery_project_path();
+  std::error_code             ec;
+  if (!path.empty())
+    std::filesystem::remove(path, ec);
+}
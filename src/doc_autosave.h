@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "shp.h"
+#include "shp_delta.h"
+#include "utl.h"
+#include "utl_asset_store.h"
+#include "utl_io.h"
+#include "utl_types.h"
+
+class Occt_view;
+
+/// Document state captured on the UI thread for a background `.ezy` writer (`Occt_view::capture_doc_snapshot`).
+/// Slots are immutable once captured and shared with the next snapshot while their records stay clean. Shape geometry
+/// is a copy taken at capture (`BRepBuilderAPI_Copy`, no display mesh): the document's own TShapes gain
+/// triangulations in place when displayed or exported, so a worker must not read them.
+struct Doc_snapshot
+{
+  struct Shape_slot
+  {
+    Shape_rec                 rec;          // `deferred_geom` is never set; see `read_pending`
+    Shp_deferred_geom::Reader read_pending; // Encoded geometry of a shape a lazy load has not read yet
+  };
+
+  struct Sketch_slot
+  {
+    size_t           id{0};
+    nlohmann::json   json;  // `Sketch_json` dump without "isCurrent" (written from `current_sketch_id`)
+    Ezy_geom_entries geoms; // Originating face entry, if any
+  };
+
+  std::vector<std::shared_ptr<const Shape_slot>>  shapes;   // Document order
+  std::vector<std::shared_ptr<const Sketch_slot>> sketches; // Document order
+  size_t                                          current_sketch_id{0};
+  Project_unit                                    unit{Project_unit::Inch};
+  nlohmann::json                                  view;   // Camera, as `Occt_view::to_json` writes it
+  Ezy_asset_store                                 assets; // Copy of the document store; pixel buffers are shared
+};
+
+/// Periodic crash-recovery saves. `poll` runs on the UI thread every frame; once the interval has passed with edits
+/// pending it captures a `Doc_snapshot` and writes it on a worker thread to `settings::user_recovery_project_path()`.
+/// The file only exists while this session has unsaved work, so one left at startup means a session ended early.
+class Doc_autosave
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  Doc_autosave();
+  ~Doc_autosave();
+
+  Doc_autosave(const Doc_autosave&)            = delete;
+  Doc_autosave& operator=(const Doc_autosave&) = delete;
+
+  /// Seconds between saves; 0 disables autosave.
+  void              set_interval_s(int seconds) { m_interval_s = seconds; }
+  [[nodiscard]] int interval_s() const { return m_interval_s; }
+
+  /// Collects a finished save (failures go to `log`) and starts the next one when due.
+  void poll(Occt_view& view, const std::function<void(const std::string&)>& log, Clock::time_point now = Clock::now());
+  /// The document now matches a file (opened, saved, or new): waits for a running save, removes the recovery file
+  /// and counts only later edits.
+  void               mark_clean(const Occt_view& view);
+  /// Blocks until a running save is done, collects it (failures go to `log`) and releases its snapshot, whose pending
+  /// geometry readers may map the project file; call before that file is overwritten.
+  void               settle(const std::function<void(const std::string&)>& log);
+  [[nodiscard]] bool busy() const { return m_job.valid(); }
+  /// Clean exit: waits for a running save and removes the recovery file.
+  void               shutdown();
+
+  /// Writes `snapshot` to a temporary file beside `path` and renames it over `path`, so a crash mid-write keeps the
+  /// previous recovery. Worker-thread safe.
+  [[nodiscard]] static Status write_recovery(const Doc_snapshot& snapshot, const std::filesystem::path& path);
+  /// Moves a recovery file left by an earlier session aside (to `recovered.ezy`), so this session's saves do not
+  /// replace it. Returns the moved file, or empty when there was none.
+  [[nodiscard]] static std::filesystem::path claim_previous_recovery();
+
+private:
+  void finish_job_(const std::function<void(const std::string&)>& log);
+  void remove_recovery_();
+
+  int                                 m_interval_s{60};
+  uint64_t                            m_saved_rev{0};      // `Occt_view::doc_edit_revision` the file reflects
+  Clock::time_point                   m_last_save;         // Start of the last save, or of the clean state
+  bool                                m_wrote_file{false}; // A recovery file from this session is on disk
+  bool                                m_failing{false};    // Last save failed (logged once per streak)
+  std::shared_ptr<const Doc_snapshot> m_job_snapshot;      // Released on the UI thread once the job is collected
+  std::future<Status>                 m_job;
+};
@@ -5,6 +5,11 @@
 #include "skt_json.h"
 #include "utl.h"
 
+namespace
+{
+size_t json_bytes_(const nlohmann::json& j);
+} // namespace
+
 Sketch_struct_delta::Sketch_struct_delta(Kind kind, nlohmann::json sketch_json, bool was_current,
                                          std::optional<nlohmann::json> auto_created_default_json)
     : m_kind(kind)
@@ -58,6 +63,22 @@ std::unique_ptr<Delta> Sketch_struct_delta::clone() const
   return std::make_unique<Sketch_struct_delta>(m_kind, m_sketch_json, m_was_current, m_auto_created_default_json);
 }
 
+size_t Sketch_struct_delta::approx_bytes() const
+{
+  size_t bytes = sizeof(*this) + json_bytes_(m_sketch_json);
+  if (m_auto_created_default_json)
+    bytes += json_bytes_(*m_auto_created_default_json);
+
+  return bytes;
+}
+
+void Sketch_struct_delta::collect_dirty(Doc_dirty& out) const
+{
+  out.sketches.insert(m_sketch_json["id"].get<size_t>());
+  if (m_auto_created_default_json)
+    out.sketches.insert((*m_auto_created_default_json)["id"].get<size_t>());
+}
+
 Underlay_delta::Underlay_delta(size_t sketch_id, nlohmann::json before, nlohmann::json after)
     : m_sketch_id(sketch_id)
     , m_before(std::move(before))
@@ -97,6 +118,10 @@ std::unique_ptr<Delta> Underlay_delta::clone() const
   return std::make_unique<Underlay_delta>(m_sketch_id, m_before, m_after);
 }
 
+size_t Underlay_delta::approx_bytes() const { return sizeof(*this) + json_bytes_(m_before) + json_bytes_(m_after); }
+
+void Underlay_delta::collect_dirty(Doc_dirty& out) const { out.sketches.insert(m_sketch_id); }
+
 Composite_delta::Composite_delta(std::vector<std::unique_ptr<Delta>> parts)
     : m_parts(std::move(parts))
 {
@@ -123,3 +148,55 @@ std::unique_ptr<Delta> Composite_delta::clone() const
 
   return std::make_unique<Composite_delta>(std::move(copies));
 }
+
+size_t Composite_delta::approx_bytes() const
+{
+  size_t bytes = sizeof(*this) + m_parts.capacity() * sizeof(std::unique_ptr<Delta>);
+  for (const std::unique_ptr<Delta>& part : m_parts)
+    bytes += part->approx_bytes();
+
+  return bytes;
+}
+
+void Composite_delta::collect_geometry(std::vector<TopoDS_Shape>& out) const
+{
+  for (const std::unique_ptr<Delta>& part : m_parts)
+    part->collect_geometry(out);
+}
+
+void Composite_delta::collect_dirty(Doc_dirty& out) const
+{
+  for (const std::unique_ptr<Delta>& part : m_parts)
+    part->collect_dirty(out);
+}
+
+size_t Doc_checkpoint::approx_bytes() const
+{
+  size_t bytes = sizeof(*this) + shapes.capacity() * sizeof(Shape_slot) + sketches.capacity() * sizeof(Sketch_slot);
+  for (const Shape_slot& slot : shapes)
+    bytes += approx_shape_rec_bytes(*slot.rec);
+
+  for (const Sketch_slot& slot : sketches)
+    bytes += sizeof(std::string) + slot.json->capacity();
+
+  return bytes;
+}
+
+namespace
+{
+// Node-by-node estimate of a parsed JSON tree (values, keys and string payloads).
+size_t json_bytes_(const nlohmann::json& j)
+{
+  size_t bytes = sizeof(nlohmann::json);
+  if (j.is_string())
+    bytes += sizeof(std::string) + j.get_ref<const std::string&>().capacity();
+  else if (j.is_object())
+    for (auto it = j.begin(); it != j.end(); ++it)
+      bytes += sizeof(std::string) + it.key().size() + json_bytes_(it.value());
+  else if (j.is_array())
+    for (const nlohmann::json& v : j)
+      bytes += json_bytes_(v);
+
+  return bytes;
+}
+} // namespace
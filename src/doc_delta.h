@@ -1,6 +1,8 @@
 #pragma once
 
 #include "delta.h"
+#include "shp_delta.h"
+#include "utl_types.h"
 
 #include <cstdint>
 #include <memory>
@@ -25,6 +27,8 @@ public:
   void                   apply_forward(Occt_view& view) override;
   void                   apply_reverse(Occt_view& view) override;
   std::unique_ptr<Delta> clone() const override;
+  size_t                 approx_bytes() const override;
+  void                   collect_dirty(Doc_dirty& out) const override;
 
 private:
   void add_sketch_(Occt_view& view, const nlohmann::json& sketch_json, bool make_current) const;
@@ -45,6 +49,8 @@ public:
   void                   apply_forward(Occt_view& view) override;
   void                   apply_reverse(Occt_view& view) override;
   std::unique_ptr<Delta> clone() const override;
+  size_t                 approx_bytes() const override;
+  void                   collect_dirty(Doc_dirty& out) const override;
 
 private:
   void apply_json_(Occt_view& view, const nlohmann::json& j) const;
@@ -63,7 +69,36 @@ public:
   void                   apply_forward(Occt_view& view) override;
   void                   apply_reverse(Occt_view& view) override;
   std::unique_ptr<Delta> clone() const override;
+  size_t                 approx_bytes() const override;
+  void                   collect_geometry(std::vector<TopoDS_Shape>& out) const override;
+  void                   collect_dirty(Doc_dirty& out) const override;
 
 private:
   std::vector<std::unique_ptr<Delta>> m_parts;
 };
+
+/// Whole-document state for the undo steps that are not expressed as deltas (mixed delete, file open).
+/// Shape records are immutable and shared with the previous checkpoint while unchanged; their geometry is the
+/// document's own `TopoDS_Shape`, so a checkpoint costs attributes and sketch JSON rather than BREP text.
+struct Doc_checkpoint
+{
+  struct Shape_slot
+  {
+    std::shared_ptr<const Shape_rec> rec;
+    size_t                           geom_bytes{0}; // approx_shape_bytes(rec->geom); travels with a shared record
+  };
+
+  struct Sketch_slot
+  {
+    size_t                             id{0};
+    std::shared_ptr<const std::string> json; // Sketch_json dump without "isCurrent"; shared while the sketch is clean
+  };
+
+  std::vector<Shape_slot>  shapes;   // Document order
+  std::vector<Sketch_slot> sketches; // Document order
+  size_t                   current_sketch_id{0};
+  Project_unit             unit{Project_unit::Inch};
+
+  /// Heap bytes excluding shape geometry (which is reported per slot).
+  [[nodiscard]] size_t approx_bytes() const;
+};
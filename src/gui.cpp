@@ -34,11 +34,13 @@
 #include "gui_occt_view.h"
 #include "doc_delta.h"
 #include "utl_io.h"
+#include "utl_mapped_file.h"
 #include "scr_python_console.h"
 #include "shp_info.h"
 #include "skt.h"
 #include "utl.h"
 #include "utl_cad_file_info.h"
+#include "utl_parallel.h"
 #include "version.h"
 
 #include <Standard_Version.hxx>
@@ -105,6 +107,7 @@ ImFont* GUI::console_font() const
 
 GUI::~GUI()
 {
+  m_autosave.shutdown();      // Clean exit: no recovery file is left behind
   cleanup_log_redirection_(); // Clean up stream redirection
 }
 
@@ -126,6 +129,10 @@ GUI& GUI::instance()
 
 void GUI::render_gui()
 {
+  // A finished extrude body first, so the coalesced cursor motion can start the next build right away.
+  m_view->shp_extrude().poll_preview();
+  flush_mouse_move_();
+
   // Underlay transform sliders use sketch_plane_view_aabb_2d -> pt_on_plane -> view projection.
   // FlushViewEvents must run before ImGui so the camera matches the latest pan/zoom/rotate (do_frame() runs later).
   m_view->flush_view_events();
@@ -153,6 +160,7 @@ void GUI::render_gui()
   // Paint the busy modal before poll so WASM can show "Importing..." for a frame first.
   cad_busy_dialog_();
   poll_cad_busy_();
+  m_autosave.poll(*m_view, [this](const std::string& msg) { log_message(msg); });
   options_();
   message_status_window_();
   error_modal_dialog_();
@@ -174,6 +182,12 @@ void GUI::render_gui()
 
 void GUI::render_occt() { m_view->do_frame(); }
 
+bool GUI::wants_frames() const
+{
+  return cad_busy_() || m_view->shp_cross_section().section_busy() || m_view->shp_extrude().preview_busy() ||
+         m_view->view_animating();
+}
+
 // Initialize toolbar buttons
 void GUI::initialize_toolbar_()
 {
@@ -390,6 +404,9 @@ void GUI::menu_bar_()
       save_file_dialog_();
     }
 
+    if (!m_recovered_path.empty() && ImGui::MenuItem("Open recovered work"))
+      open_recovered_project_();
+
     if (ImGui::BeginMenu("Project units"))
     {
       const Project_unit cur = m_view->get_project_unit();
@@ -428,10 +445,9 @@ void GUI::menu_bar_()
       for (const Example_file& ex : m_example_files)
         if (ImGui::MenuItem(ex.label.c_str()))
         {
-          std::ifstream     file(ex.path, std::ios::binary);
-          const std::string file_bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
-          if (file.good() && !file_bytes.empty())
-            on_file(ex.path, file_bytes);
+          const auto file = Mapped_file::open(ex.path);
+          if (file && file->size() > 0)
+            on_file(ex.path, file);
           else
             show_message("Error opening example: " + ex.label);
         }
@@ -447,7 +463,10 @@ void GUI::menu_bar_()
 #endif
 
     if (ImGui::MenuItem("Exit"))
+    {
+      m_autosave.shutdown();
       exit(0);
+    }
 
     ImGui::EndMenu();
   }
@@ -810,21 +829,15 @@ void GUI::toolbar_()
         switch (std::get<Command>(m_toolbar_buttons[i].data))
         {
         case Command::Shape_cut:
-          if (Status s = m_view->shp_cut().selected_cut(); !s.is_ok())
-            show_message(s.message());
-
+          begin_shape_job_(m_view->shp_cut().selected_cut_job());
           break;
 
         case Command::Shape_fuse:
-          if (Status s = m_view->shp_fuse().selected_fuse(); !s.is_ok())
-            show_message(s.message());
-
+          begin_shape_job_(m_view->shp_fuse().selected_fuse_job());
           break;
 
         case Command::Shape_common:
-          if (Status s = m_view->shp_common().selected_common(); !s.is_ok())
-            show_message(s.message());
-
+          begin_shape_job_(m_view->shp_common().selected_common_job());
           break;
 
         default:
@@ -1132,7 +1145,7 @@ bool GUI::parse_dist_text_to_float_(const char* buf, float& out)
   return true;
 }
 
-bool GUI::is_valid_project_manifest_(const std::string& s)
+bool GUI::is_valid_project_manifest_(std::string_view s)
 {
   try
   {
@@ -1145,40 +1158,54 @@ bool GUI::is_valid_project_manifest_(const std::string& s)
   }
 }
 
-bool GUI::is_valid_project_file_(const std::string& bytes)
+bool GUI::is_valid_project_file_(std::string_view bytes)
 {
   if (is_ezy_zip(bytes))
   {
-    const auto unpacked = unpack_ezy(bytes);
-    return unpacked && is_valid_project_manifest_(unpacked->manifest_json);
+    const auto manifest = read_ezy_manifest(bytes);
+    return manifest && is_valid_project_manifest_(*manifest);
   }
 
   return is_ezy_json(bytes) && is_valid_project_manifest_(bytes);
 }
 
-std::optional<std::string> GUI::manifest_from_project_file_(const std::string& file_bytes, Occt_view& view, bool replace_assets)
+std::optional<std::string> GUI::manifest_from_project_file_(const std::shared_ptr<const Mapped_file>& file,
+                                                            std::shared_ptr<const Ezy_archive>& out_archive)
 {
-  if (is_ezy_zip(file_bytes))
+  out_archive.reset();
+  const std::string_view bytes = file->view();
+  if (is_ezy_zip(bytes))
   {
-    auto unpacked = unpack_ezy(file_bytes);
-    if (!unpacked)
+    auto archive = Ezy_archive::open(file);
+    if (!archive)
       return std::nullopt;
 
-    if (replace_assets)
-      view.asset_store().clear();
+    auto manifest = archive->read_manifest();
+    if (manifest)
+      out_archive = std::move(archive);
 
-    for (auto& [id, data] : unpacked->assets)
-      view.asset_store().import_asset(id, std::move(data));
-
-    return unpacked->manifest_json;
+    return manifest;
   }
 
-  if (is_ezy_json(file_bytes))
-    return file_bytes;
+  if (is_ezy_json(bytes))
+    return std::string(bytes);
 
   return std::nullopt;
 }
 
+void GUI::import_project_assets_(const std::shared_ptr<const Ezy_archive>& archive, Ezy_asset_store& store, bool lazy)
+{
+  store.clear();
+  for (const auto& [id, size] : archive->asset_sizes())
+    if (lazy)
+      store.import_lazy_asset(id, size,
+                              [archive, id]() { return archive->read_asset(id).value_or(std::vector<uint8_t>{}); });
+    else if (auto data = archive->read_asset(id))
+      store.import_asset(id, std::move(*data));
+    else
+      log_message("on_file: skipping unreadable asset " + id);
+}
+
 const std::vector<std::string>& GUI::occt_material_combo_labels_()
 {
   static std::vector<std::string> names;
@@ -1385,14 +1412,10 @@ void GUI::sketch_list_()
     return;
   }
 
-  const ImGuiStyle& st              = ImGui::GetStyle();
-  float             max_name_text_w = 0.f;
-  for (const Sketch::sptr& s : m_view->get_sketches())
-  {
-    EZY_ASSERT(s);
-    const std::string& nm = s->get_name();
-    max_name_text_w       = std::max(max_name_text_w, ImGui::CalcTextSize(nm.c_str(), nm.c_str() + nm.size()).x);
-  }
+  const ImGuiStyle& st = ImGui::GetStyle();
+  if (m_sketch_list_rows_dirty || m_sketch_list_rows_rev != m_view->doc_tree_revision() ||
+      m_sketch_list_font_size != ImGui::GetFontSize())
+    rebuild_sketch_list_rows_();
 
   if (!ImGui::Begin("Sketch List", &m_show_sketch_list, ImGuiWindowFlags_None))
   {
@@ -1406,9 +1429,8 @@ void GUI::sketch_list_()
   }
 
   ImGui::BeginChild("##sketch_list_scroll", ImVec2(0.f, 0.f), false, ImGuiWindowFlags_HorizontalScrollbar);
-  const float name_field_w = list_name_field_width_(st, max_name_text_w);
+  const float name_field_w = list_name_field_width_(st, m_sketch_list_name_w);
 
-  int          index = 0;
   Sketch::sptr sketch_to_delete;
   Sketch::sptr sketch_list_hover;
   Sketch::sptr sketch_list_measurement_hover_sketch;
@@ -1419,7 +1441,7 @@ void GUI::sketch_list_()
   size_t       sketch_list_hover_edge_index = SIZE_MAX;
   Sketch::sptr sketch_list_hover_node_sketch;
   size_t       sketch_list_hover_node_index = SIZE_MAX;
-  for (Sketch::sptr& sketch : m_view->get_sketches())
+  auto draw_sketch_row = [&](const Sketch::sptr& sketch, int index)
   {
     EZY_ASSERT(sketch);
 
@@ -1468,7 +1490,11 @@ void GUI::sketch_list_()
     ImGui::PushID(("name" + id_suffix).c_str());
     ImGui::SetNextItemWidth(name_field_w);
     if (ImGui::InputText("", name_buffer, sizeof(name_buffer)))
+    {
       sketch->set_name(std::string(name_buffer));
+      m_view->mark_sketch_dirty(sketch->get_id());
+      m_sketch_list_rows_dirty = true; // Name width may change.
+    }
 
     // This will open a popup when you right-click on the InputText
     if (ImGui::BeginPopupContextItem("Sketch_InputTextContextMenu"))
@@ -1490,6 +1516,7 @@ void GUI::sketch_list_()
         m_view->set_sketch_list_hover(nullptr);
 
       sketch->set_visible(visible);
+      m_view->mark_sketch_dirty(sketch->get_id());
     }
 
     if (ui_show_contextual_help() && ImGui::IsItemHovered())
@@ -1566,8 +1593,43 @@ void GUI::sketch_list_()
       sketch_list_inspector_(sketch, index, row_ui, sketch_list_measurement_hover_sketch, sketch_list_measurement_hover_index,
                              sketch_list_hover_face_sketch, sketch_list_hover_face_index, sketch_list_hover_edge_sketch,
                              sketch_list_hover_edge_index, sketch_list_hover_node_sketch, sketch_list_hover_node_index);
+  };
+
+  // Collapsed rows share one height, so each run of them goes through a clipper; an expanded row (inspector
+  // underneath) is drawn in full between runs.
+  const bool show_expand     = ui_show_sketch_list_expand();
+  const int  row_count       = static_cast<int>(m_sketch_list_rows.size());
+  auto       row_is_expanded = [&](int i)
+  {
+    if (!show_expand)
+      return false;
 
-    ++index;
+    const auto it = m_sketch_list_ui.find(m_sketch_list_rows[static_cast<size_t>(i)]->get_id());
+    return it != m_sketch_list_ui.end() && it->second.expanded;
+  };
+
+  for (int first = 0; first < row_count;)
+  {
+    int last = first;
+    while (last < row_count && !row_is_expanded(last))
+      ++last;
+
+    if (last > first)
+    {
+      ImGuiListClipper clipper;
+      clipper.Begin(last - first);
+      while (clipper.Step())
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+          draw_sketch_row(m_sketch_list_rows[static_cast<size_t>(first + i)], first + i);
+    }
+
+    if (last < row_count)
+    {
+      draw_sketch_row(m_sketch_list_rows[static_cast<size_t>(last)], last);
+      ++last;
+    }
+
+    first = last;
   }
 
   m_view->set_sketch_list_hover(sketch_list_hover);
@@ -1598,6 +1660,23 @@ void GUI::sketch_list_()
   ImGui::End();
 }
 
+void GUI::rebuild_sketch_list_rows_()
+{
+  const Occt_view::Sketch_list& sketches = m_view->get_sketches();
+  m_sketch_list_rows.assign(sketches.begin(), sketches.end());
+  m_sketch_list_name_w = 0.f;
+  for (const Sketch::sptr& s : m_sketch_list_rows)
+  {
+    EZY_ASSERT(s);
+    const std::string& nm = s->get_name();
+    m_sketch_list_name_w  = std::max(m_sketch_list_name_w, ImGui::CalcTextSize(nm.c_str(), nm.c_str() + nm.size()).x);
+  }
+
+  m_sketch_list_font_size  = ImGui::GetFontSize();
+  m_sketch_list_rows_rev   = m_view->doc_tree_revision();
+  m_sketch_list_rows_dirty = false;
+}
+
 void GUI::sketch_underlay_import_dialog_()
 {
 #ifndef __EMSCRIPTEN__
@@ -2533,10 +2612,11 @@ void GUI::shape_list_()
       m_view->set_current_group_id(grp->get_id());
   }
 
+  // One selection snapshot per frame feeds both the Group button and the row highlights.
+  const std::vector<Shp_ptr> sel = m_view->get_selected_shps();
   ImGui::SameLine();
   {
-    const std::vector<Shp_ptr> sel       = m_view->get_selected_shps();
-    const bool                 can_group = !sel.empty();
+    const bool can_group = !sel.empty();
     if (!can_group)
       ImGui::BeginDisabled();
 
@@ -2565,10 +2645,23 @@ void GUI::shape_list_()
   Shp_ptr  shape_list_hover;
   Shape_id shape_to_ungroup_id = 0;
 
-  std::unordered_set<const AIS_Shape*> selected_in_viewer;
-  for (const AIS_Shape_ptr& ais : m_view->get_selected())
-    if (!ais.IsNull())
-      selected_in_viewer.insert(ais.get());
+  // A group row is selected when any descendant solid is; mark ancestors of the selection once instead of walking
+  // every group's subtree per row.
+  std::unordered_set<const Shp*> selected_in_viewer;
+  std::unordered_set<Shape_id>   groups_with_selection;
+  for (const Shp_ptr& shp : sel)
+  {
+    selected_in_viewer.insert(shp.get());
+    Shape_id walk = shp->get_parent_id();
+    while (walk != 0 && groups_with_selection.insert(walk).second)
+    {
+      const Shp_ptr p = m_view->find_shape_by_id(walk);
+      if (p.IsNull())
+        break;
+
+      walk = p->get_parent_id();
+    }
+  }
 
   auto row_is_selected = [&](const Shp_ptr& shape) -> bool
   {
@@ -2576,13 +2669,8 @@ void GUI::shape_list_()
       return false;
 
     if (shape->is_group())
-    {
-      for (const Shp_ptr& leaf : m_view->shape_descendant_solids(shape->get_id()))
-        if (selected_in_viewer.count(leaf.get()) != 0)
-          return true;
+      return groups_with_selection.count(shape->get_id()) != 0;
 
-      return false;
-    }
     return selected_in_viewer.count(shape.get()) != 0;
   };
 
@@ -2608,20 +2696,20 @@ void GUI::shape_list_()
     ctx.UpdateCurrentViewer();
   };
 
-  // Tree node always uses NoTreePushOnOpen; indent children with an explicit TreePush/TreePop
-  // pair so table rows cannot leave the ImGui tree stack unbalanced (which nested siblings
-  // under the wrong parent and made Ungroup look like it only moved one child).
-  std::unordered_set<Shape_id> shape_list_ancestors;
-  auto                         draw_shape_row = [&](auto&& self, const Shp_ptr& shape) -> void
+  // Rows come from the flattened model, so the tree node always uses NoTreePushOnOpen and depth is a plain
+  // Indent around the row (the indent-enabled name column picks it up in TableNextRow). The ImGui tree stack
+  // never spans rows, so a clipped-out parent cannot leave it unbalanced.
+  auto draw_shape_row = [&](const Shape_list_row& row) -> void
   {
+    const Shp_ptr& shape = row.shape;
     EZY_ASSERT(shape);
-    if (!shape_list_ancestors.insert(shape->get_id()).second)
-      return; // Parent cycle: skip rather than hang the Shape List.
+    const float indent = static_cast<float>(row.depth) * ImGui::GetStyle().IndentSpacing;
+    if (indent > 0.0f)
+      ImGui::Indent(indent);
 
-    const bool                 is_group         = shape->is_group();
-    const std::vector<Shp_ptr> children         = m_view->shape_children(shape->get_id());
-    const bool                 has_children     = !children.empty();
-    const bool                 is_current_group = is_group && shape->get_id() == m_view->current_group_id();
+    const bool is_group         = shape->is_group();
+    const bool has_children     = row.has_children;
+    const bool is_current_group = is_group && shape->get_id() == m_view->current_group_id();
     // Selection highlight follows the 3D viewer only. Current group uses a distinct tint so
     // Alt-drag / clear-selection cannot look like the group (or its children) stayed selected.
     const bool row_selected = row_is_selected(shape);
@@ -2654,6 +2742,7 @@ void GUI::shape_list_()
       if (shape->HasColor())
         shape->UnsetColor();
       shape->SetMaterial(Graphic3d_MaterialAspect(static_cast<Graphic3d_NameOfMaterial>(i)));
+      m_view->mark_shape_dirty(shape->get_id());
       m_view->refresh_shape_shading_(shape);
       m_view->ctx().Redisplay(shape, true);
       m_view->ctx().UpdateCurrentViewer();
@@ -2668,6 +2757,7 @@ void GUI::shape_list_()
         m_view->set_shape_list_hover(nullptr);
 
       shape->set_visible(visible);
+      m_view->mark_shape_dirty(shape->get_id());
       m_view->sync_sketch_shape_faint_style();
     }
     row_hovered |= ImGui::IsItemHovered();
@@ -2754,18 +2844,17 @@ void GUI::shape_list_()
     if (row_selected)
       node_flags |= ImGuiTreeNodeFlags_Selected;
 
-    bool open = true;
+    const bool open = row.open;
     if (has_children)
-    {
-      const auto exp_it = m_shape_list_expanded.find(shape->get_id());
-      open              = (exp_it == m_shape_list_expanded.end()) ? true : exp_it->second;
       ImGui::SetNextItemOpen(open);
-    }
 
     ImGui::SetNextItemAllowOverlap();
     const bool node_open = ImGui::TreeNodeEx("##node", node_flags);
     if (has_children && node_open != open)
+    {
       m_shape_list_expanded[shape->get_id()] = node_open;
+      m_shape_list_rows_dirty                = true;
+    }
 
     if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen())
       select_shape_row(shape);
@@ -2808,7 +2897,10 @@ void GUI::shape_list_()
     ImGui::SameLine();
     ImGui::SetNextItemWidth(std::max(1.0f, ImGui::GetContentRegionAvail().x));
     if (ImGui::InputText("##name", name_buffer, sizeof(name_buffer)))
+    {
       shape->set_name(std::string(name_buffer));
+      m_view->mark_shape_dirty(shape->get_id());
+    }
 
     if (ImGui::IsItemClicked())
       select_shape_row(shape);
@@ -2847,18 +2939,14 @@ void GUI::shape_list_()
     if (row_hovered && shape->get_visible() && !is_group)
       shape_list_hover = shape;
 
-    if (has_children && node_open)
-    {
-      ImGui::TreePush(reinterpret_cast<const void*>(static_cast<uintptr_t>(shape->get_id())));
-      for (const Shp_ptr& child : children)
-        self(self, child);
-      ImGui::TreePop();
-    }
-
     ImGui::PopID();
-    shape_list_ancestors.erase(shape->get_id());
+    if (indent > 0.0f)
+      ImGui::Unindent(indent);
   };
 
+  if (m_shape_list_rows_dirty || m_shape_list_rows_rev != m_view->doc_tree_revision())
+    rebuild_shape_list_rows_();
+
   const ImGuiTableFlags table_flags =
       ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_NoBordersInBody | ImGuiTableFlags_SizingFixedFit;
   if (ImGui::BeginTable("##shape_outliner", 4, table_flags, ImVec2(0.f, 0.f)))
@@ -2879,8 +2967,26 @@ void GUI::shape_list_()
                         ImVec2(st_mat.FramePadding.x, std::max(1.0f, st_mat.FramePadding.y * 0.65f)));
     ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(st_mat.CellPadding.x, std::max(1.0f, st_mat.CellPadding.y * 0.5f)));
 
-    for (const Shp_ptr& root : m_view->shape_children(0))
-      draw_shape_row(draw_shape_row, root);
+    // Rows share one height, so only the visible slice is submitted. Keep the row being dragged alive while it
+    // scrolls out of view so the drag source is still submitted.
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(m_shape_list_rows.size()));
+    if (const ImGuiPayload* drag = ImGui::GetDragDropPayload();
+        drag != nullptr && drag->IsDataType("EZY_SHAPE_ID") && drag->DataSize == sizeof(Shape_id))
+    {
+      Shape_id drag_id = 0;
+      std::memcpy(&drag_id, drag->Data, sizeof(drag_id));
+      for (size_t i = 0; i < m_shape_list_rows.size(); ++i)
+        if (m_shape_list_rows[i].shape->get_id() == drag_id)
+        {
+          clipper.IncludeItemByIndex(static_cast<int>(i));
+          break;
+        }
+    }
+
+    while (clipper.Step())
+      for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+        draw_shape_row(m_shape_list_rows[static_cast<size_t>(i)]);
 
     // Empty pad below the last row: drop here to move to document root (no permanent root node).
     // Size from the visible clip remainder, not GetContentRegionAvail().y -- inside a ScrollY
@@ -2945,6 +3051,7 @@ void GUI::shape_list_()
   if (shape_to_ungroup_id != 0)
   {
     m_shape_list_expanded.erase(shape_to_ungroup_id);
+    m_shape_list_rows_dirty = true;
     (void)m_view->ungroup_shape(shape_to_ungroup_id);
   }
 
@@ -2954,6 +3061,40 @@ void GUI::shape_list_()
   ImGui::End();
 }
 
+void GUI::rebuild_shape_list_rows_()
+{
+  m_shape_list_rows.clear();
+  m_shape_list_rows_rev   = m_view->doc_tree_revision();
+  m_shape_list_rows_dirty = false;
+
+  std::unordered_set<Shape_id> ancestors;
+  auto                         add_rows = [&](auto&& self, const Shp_ptr& shape, int depth) -> void
+  {
+    EZY_ASSERT(shape);
+    if (!ancestors.insert(shape->get_id()).second)
+      return; // Parent cycle: skip rather than hang the Shape List.
+
+    const std::vector<Shp_ptr> children = m_view->shape_children(shape->get_id());
+    Shape_list_row             row;
+    row.shape        = shape;
+    row.depth        = depth;
+    row.has_children = !children.empty();
+    row.open         = true; // Missing expand entry defaults to open.
+    if (const auto exp_it = m_shape_list_expanded.find(shape->get_id()); exp_it != m_shape_list_expanded.end())
+      row.open = exp_it->second;
+
+    m_shape_list_rows.push_back(row);
+    if (row.has_children && row.open)
+      for (const Shp_ptr& child : children)
+        self(self, child, depth + 1);
+
+    ancestors.erase(shape->get_id());
+  };
+
+  for (const Shp_ptr& root : m_view->shape_children(0))
+    add_rows(add_rows, root, 0);
+}
+
 void GUI::open_shape_info_(const Shp_ptr& shape)
 {
   if (shape.IsNull() || shape->is_group())
@@ -3056,12 +3197,13 @@ void GUI::shape_info_dialog_()
   ImGui::End();
 }
 
-void GUI::open_file_inspector_(const std::string& file_path, const std::string& file_bytes)
+void GUI::open_file_inspector_(const std::string& file_path, std::shared_ptr<const Mapped_file> file)
 {
   m_file_inspector_path      = file_path;
-  m_file_inspector_bytes     = file_bytes;
-  m_file_inspector_fmt       = utl_cad_file_info::detect(file_path, file_bytes);
+  m_file_inspector_fmt       = utl_cad_file_info::detect(file_path, file->view());
+  m_file_inspector_file      = std::move(file);
   m_file_inspector_step_mode = Step_import_mode::Preserve_hierarchy;
+  m_file_inspector_ply_mode  = Ply_import_mode::Triangulation;
   m_file_inspector_open      = true;
 }
 
@@ -3071,16 +3213,51 @@ void GUI::cancel_cad_busy_()
 {
   if (!m_cad_busy_progress.IsNull())
     m_cad_busy_progress->request_cancel();
+
+  if (m_cad_busy_kind != Cad_busy_kind::Shape_op)
+    return;
+
+  // Booleans stop at the next progress poll, a fillet may not; either way the task is let go and its result dropped.
+  clear_all(m_cad_busy_kind, m_cad_busy_progress, m_cad_busy_modal_open, m_cad_busy_shape_task);
+  m_cad_busy_shape_commit = nullptr;
+  show_message("Operation cancelled.");
+}
+
+void GUI::begin_shape_job_(Result<Shape_job> job)
+{
+  if (!job.is_ok())
+  {
+    show_message(job.message());
+    return;
+  }
+
+  if (cad_busy_())
+  {
+    show_message("Wait for the current operation to finish.");
+    return;
+  }
+
+  m_cad_busy_kind         = Cad_busy_kind::Shape_op;
+  m_cad_busy_title        = job->title;
+  m_cad_busy_open_popup   = true;
+  m_cad_busy_modal_open   = true;
+  m_cad_busy_shape_commit = std::move(job->commit);
+  m_cad_busy_path.clear();
+
+  m_cad_busy_progress = new Atomic_progress_indicator();
+  m_cad_busy_progress->set_stage("Computing...");
+  // Emscripten runs the compute inline here; the result is still committed by the next poll.
+  m_cad_busy_shape_task = Shape_job_task::start(std::move(job->compute), m_cad_busy_progress);
 }
 
 void GUI::begin_step_import_(const Step_import_mode mode)
 {
-  if (cad_busy_() || m_file_inspector_bytes.empty() || !m_view)
+  if (cad_busy_() || !m_file_inspector_file || m_file_inspector_file->size() == 0 || !m_view)
     return;
 
   m_cad_busy_kind        = Cad_busy_kind::Import;
   m_cad_busy_path        = m_file_inspector_path;
-  m_cad_busy_bytes       = m_file_inspector_bytes;
+  m_cad_busy_bytes       = std::string(m_file_inspector_file->view());
   m_cad_busy_import_mode = mode;
   m_cad_busy_title       = "Importing";
   m_cad_busy_open_popup  = true;
@@ -3093,13 +3270,14 @@ void GUI::begin_step_import_(const Step_import_mode mode)
   const Step_import_mode              m     = mode;
   const double                        scale = m_view->step_import_model_scale();
   const Atomic_progress_indicator_ptr prog  = m_cad_busy_progress;
-  m_cad_busy_import_fut                     = std::async(std::launch::async,
-                                                         [bytes, m, scale, prog]() -> std::pair<Status, Occt_view::Step_import_geom>
-                                                         {
-                                       Occt_view::Step_import_geom geom;
-                                       Status st = Occt_view::prepare_step_import(bytes, m, scale, geom, prog);
-                                       return {st, std::move(geom)};
-                                     });
+  m_cad_busy_import_fut =
+      run_task_async(Task_priority::Background,
+                     [bytes, m, scale, prog]() -> std::pair<Status, Occt_view::Step_import_geom>
+                     {
+                       Occt_view::Step_import_geom geom;
+                       Status st = Occt_view::prepare_step_import(bytes, m, scale, geom, prog);
+                       return {st, std::move(geom)};
+                     });
 #else
   // OpenPopup + one painted frame before the main-thread Transfer freezes the UI.
   m_cad_busy_defer_frames = 2;
@@ -3148,6 +3326,41 @@ void GUI::finish_step_import_(Status st, Occt_view::Step_import_geom& geom)
 
 void GUI::poll_cad_busy_()
 {
+#ifndef __EMSCRIPTEN__
+  if (m_cad_busy_kind == Cad_busy_kind::Open)
+  {
+    if (!m_cad_busy_open_fut.valid() || m_cad_busy_open_fut.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      return;
+
+    auto [st, geom]                                  = m_cad_busy_open_fut.get();
+    const std::shared_ptr<const Ezy_archive> archive = std::move(m_cad_busy_archive);
+    clear_all(m_cad_busy_kind, m_cad_busy_progress, m_cad_busy_modal_open);
+    finish_project_open_(st, geom, m_cad_busy_path, archive, true);
+    return;
+  }
+#endif
+
+  if (m_cad_busy_kind == Cad_busy_kind::Shape_op)
+  {
+    if (!m_cad_busy_shape_task || !m_cad_busy_shape_task->ready())
+      return;
+
+    TopoDS_Shape            result;
+    const Status            st     = m_cad_busy_shape_task->take(result);
+    const Shape_job::Commit commit = std::move(m_cad_busy_shape_commit);
+    clear_all(m_cad_busy_kind, m_cad_busy_progress, m_cad_busy_modal_open, m_cad_busy_shape_task);
+    if (!st.is_ok())
+    {
+      show_message(st.message());
+      return;
+    }
+
+    if (Shp_rslt r = commit(result); !r.is_ok())
+      show_message(r.message());
+
+    return;
+  }
+
   if (m_cad_busy_kind != Cad_busy_kind::Import)
     return;
 
@@ -3201,7 +3414,7 @@ void GUI::cad_busy_dialog_()
   if (!ImGui::BeginPopupModal("##EzyCadCadBusy", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoMove))
     return;
 
-  ImGui::TextUnformatted("Importing...");
+  ImGui::TextUnformatted(m_cad_busy_title.empty() ? "Importing..." : (m_cad_busy_title + "...").c_str());
   const std::string name = std::filesystem::path(m_cad_busy_path).filename().string();
   if (!name.empty())
     ImGui::TextWrapped("%s", name.c_str());
@@ -3248,9 +3461,10 @@ void GUI::close_file_inspector_()
 {
   m_file_inspector_open = false;
   m_file_inspector_path.clear();
-  m_file_inspector_bytes.clear();
+  m_file_inspector_file.reset();
   m_file_inspector_fmt       = utl_cad_file_info::Format::Unknown;
   m_file_inspector_step_mode = Step_import_mode::Preserve_hierarchy;
+  m_file_inspector_ply_mode  = Ply_import_mode::Triangulation;
 }
 
 void GUI::file_inspector_dialog_()
@@ -3272,7 +3486,7 @@ void GUI::file_inspector_dialog_()
   if (!name.empty())
     ImGui::TextUnformatted(name.c_str());
 
-  if (utl_cad_file_info::can_import(m_file_inspector_fmt) && !m_file_inspector_bytes.empty())
+  if (utl_cad_file_info::can_import(m_file_inspector_fmt) && m_file_inspector_file && m_file_inspector_file->size() > 0)
   {
     const bool is_step = m_file_inspector_fmt == utl_cad_file_info::Format::Step;
     if (is_step)
@@ -3294,12 +3508,24 @@ void GUI::file_inspector_dialog_()
     else
       m_file_inspector_step_mode = Step_import_mode::Preserve_hierarchy;
 
+    if (m_file_inspector_fmt == utl_cad_file_info::Format::Ply)
+    {
+      bool facets = m_file_inspector_ply_mode == Ply_import_mode::Brep_facets;
+      if (ImGui::Checkbox("One BRep face per triangle", &facets))
+        m_file_inspector_ply_mode = facets ? Ply_import_mode::Brep_facets : Ply_import_mode::Triangulation;
+      if (ui_show_contextual_help() && ImGui::IsItemHovered())
+        ImGui::SetTooltip("Off (default): the mesh loads as one triangulated face; fast even for scans with millions\n"
+                          "of triangles, and exports to STL/PLY as is.\n"
+                          "On: each triangle becomes a planar face (the old behavior); much slower and larger.");
+    }
+
     ImGui::BeginDisabled(cad_busy_());
     if (ImGui::Button("Import into project"))
     {
       if (m_file_inspector_fmt == utl_cad_file_info::Format::Step)
         begin_step_import_(m_file_inspector_step_mode);
-      else if (on_import_file(m_file_inspector_path, m_file_inspector_bytes, m_file_inspector_step_mode))
+      else if (on_import_file(m_file_inspector_path, m_file_inspector_file->view(), m_file_inspector_step_mode,
+                              m_file_inspector_ply_mode))
       {
         close_file_inspector_();
         ImGui::End();
@@ -3339,7 +3565,8 @@ void GUI::dbg_()
     return;
   }
   // Undo / redo stack
-  ImGui::Text("Undo: %zu (Ctrl+Z)  |  Redo: %zu (Ctrl+Y)  [max 50]", m_view->undo_stack_size(), m_view->redo_stack_size());
+  ImGui::Text("Undo: %zu (Ctrl+Z)  |  Redo: %zu (Ctrl+Y)  [%.1f / %d MB]", m_view->undo_stack_size(), m_view->redo_stack_size(),
+              static_cast<double>(m_view->undo_memory_bytes()) / (1024.0 * 1024.0), m_undo_budget_mb);
   ImGui::Separator();
   // Get the available content region width
   float available_width = ImGui::GetContentRegionAvail().x;
@@ -3555,7 +3782,14 @@ void GUI::init(GLFWwindow* window, ImFont* console_font)
   else
     log_message("EzyCad: " + std::to_string(m_example_files.size()) + " example project(s) available in File > Examples.");
 
+  // Claimed before this session can autosave over it.
+  m_recovered_path = Doc_autosave::claim_previous_recovery().string();
   load_default_project_();
+  if (!m_recovered_path.empty())
+  {
+    log_message("EzyCad: unsaved work from the previous session was recovered to " + m_recovered_path);
+    show_message("Unsaved work from the previous session was recovered: File > Open recovered work.");
+  }
 }
 
 void GUI::persist_last_opened_project_path_(const std::string& path)
@@ -3592,14 +3826,12 @@ void GUI::load_default_project_()
       const std::filesystem::path p(m_last_opened_project_path);
       if (std::filesystem::exists(p))
       {
-        std::ifstream file(p, std::ios::binary);
-        if (file.is_open())
+        if (const auto file = Mapped_file::open(p.string()))
         {
-          const std::string file_bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
-          if (is_valid_project_file_(file_bytes))
+          if (is_valid_project_file_(file->view()))
           {
             log_message("EzyCad: loading last opened project: " + p.string());
-            on_file(p.string(), file_bytes, false);
+            on_file(p.string(), file, false);
             log_message("EzyCad: startup document loaded (last opened).");
             return;
           }
@@ -3641,18 +3873,17 @@ void GUI::load_default_project_()
   else
     log_message("EzyCad: no saved startup project; trying bundled default.");
 
-  std::ifstream file(k_bundled_default, std::ios::binary);
-  if (!file.is_open())
+  const auto file = Mapped_file::open(k_bundled_default);
+  if (!file)
   {
     log_message("EzyCad: bundled " + std::string(k_bundled_default) + " not found; keeping initial empty document.");
     return;
   }
 
-  const std::string file_bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
-  if (is_valid_project_file_(file_bytes))
+  if (is_valid_project_file_(file->view()))
   {
     log_message("EzyCad: loading bundled default project (" + std::string(k_bundled_default) + ").");
-    on_file(k_bundled_default, file_bytes, false);
+    on_file(k_bundled_default, file, false);
     m_last_saved_path.clear();
     log_message("EzyCad: startup document loaded (bundled default).");
   }
@@ -3666,6 +3897,8 @@ void GUI::clear_sketch_list_ui_()
   m_sketch_list_scroll_y       = 0.f;
   m_sketch_list_scroll_restore = false;
   m_shape_list_expanded.clear();
+  m_shape_list_rows_dirty  = true;
+  m_sketch_list_rows_dirty = true;
 }
 
 nlohmann::json GUI::shape_list_ui_to_json_() const
@@ -3691,6 +3924,7 @@ void GUI::apply_shape_list_ui_from_json_(const nlohmann::json& j)
 {
   using namespace nlohmann;
   m_shape_list_expanded.clear();
+  m_shape_list_rows_dirty = true;
   if (m_view)
     m_view->set_current_group_id(0);
 
@@ -3808,27 +4042,46 @@ void GUI::apply_sketch_list_ui_from_json_(const nlohmann::json& j)
   }
 }
 
-std::string GUI::serialized_project_json_() const
+std::string GUI::serialized_project_json_(Ezy_geom_entries* geoms) const
+{
+  return serialized_project_json_(m_view->to_json(geoms));
+}
+
+std::string GUI::serialized_project_json_(const std::string& view_json) const
 {
   using namespace nlohmann;
-  std::string project_json = m_view->to_json();
-  json        j            = json::parse(project_json);
-  j["mode"]                = static_cast<int>(get_mode());
-  j["ui"]["sketchList"]    = sketch_list_ui_to_json_();
-  j["ui"]["shapeList"]     = shape_list_ui_to_json_();
+  json j                = json::parse(view_json);
+  j["mode"]             = static_cast<int>(get_mode());
+  j["ui"]["sketchList"] = sketch_list_ui_to_json_();
+  j["ui"]["shapeList"]  = shape_list_ui_to_json_();
   return j.dump(2);
 }
 
 std::vector<uint8_t> GUI::serialized_project_ezy_() const
 {
-  const std::string manifest = serialized_project_json_();
-  return pack_ezy(manifest, m_view->asset_store());
+  Ezy_geom_entries  geoms;
+  const std::string manifest = serialized_project_json_(&geoms);
+  return pack_ezy(manifest, m_view->asset_store(), geoms);
+}
+
+std::function<bool(const Ezy_write_sink&)> GUI::project_ezy_writer_()
+{
+  // The file about to be written may be the one a lazy load (or a running autosave) still reads from. The autosave
+  // snapshot's pending readers hold the project mapping too, so it must be released, not just waited for.
+  m_autosave.settle([this](const std::string& msg) { log_message(msg); });
+  m_view->load_deferred();
+  // Shapes are encoded one at a time as the writer packs them, not all up front.
+  Ezy_geom_source   geoms;
+  const std::string manifest = serialized_project_json_(m_view->to_json(geoms));
+  return [this, geoms = std::move(geoms), manifest](const Ezy_write_sink& sink)
+  {
+    return pack_ezy_to(sink, manifest, m_view->asset_store(), geoms);
+  };
 }
 
 void GUI::save_startup_project_()
 {
-  const std::vector<uint8_t> ezy_bytes = serialized_project_ezy_();
-  if (!settings::save_user_startup_project(ezy_bytes))
+  if (!settings::save_user_startup_project(project_ezy_writer_()))
   {
     show_message("Could not save startup project.");
     return;
@@ -3850,6 +4103,16 @@ void GUI::clear_saved_startup_project_()
 
 void GUI::on_mouse_pos(const ScreenCoords& screen_coords)
 {
+  // GLFW can report many positions per frame; only the last one drives the tool (one preview rebuild per frame).
+  m_pending_mouse_pos = screen_coords;
+}
+
+void GUI::flush_mouse_move_()
+{
+  if (!m_pending_mouse_pos)
+    return;
+
+  const ScreenCoords screen_coords = *std::exchange(m_pending_mouse_pos, std::nullopt);
   m_view->on_mouse_move(screen_coords);
 
   switch (get_mode())
@@ -3954,15 +4217,11 @@ void GUI::on_left_click_(const ScreenCoords& screen_coords)
     break;
 
   case Mode::Shape_chamfer:
-    if (Status s = m_view->shp_chamfer().add_chamfer(screen_coords, m_chamfer_mode); !s.is_ok())
-      show_message(s.message());
-
+    begin_shape_job_(m_view->shp_chamfer().chamfer_job(screen_coords, m_chamfer_mode));
     break;
 
   case Mode::Shape_fillet:
-    if (Status s = m_view->shp_fillet().add_fillet(screen_coords, m_fillet_mode); !s.is_ok())
-      show_message(s.message());
-
+    begin_shape_job_(m_view->shp_fillet().fillet_job(screen_coords, m_fillet_mode));
     break;
 
   case Mode::Shape_polar_duplicate:
@@ -3984,6 +4243,7 @@ void GUI::sketch_left_click(const ScreenCoords& screen_coords)
 
 void GUI::on_mouse_button(int button, int action, int mods)
 {
+  flush_mouse_move_();
   const ScreenCoords screen_coords = cursor_screen_coords();
 
   if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS && mods == 0)
@@ -4029,6 +4289,7 @@ void GUI::on_mouse_button(int button, int action, int mods)
 void GUI::on_mouse_scroll(double xoffset, double yoffset)
 {
   EZY_ASSERT(m_glfw_window != nullptr);
+  flush_mouse_move_();
 
   const bool shift_finer = glfwGetKey(m_glfw_window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
                            glfwGetKey(m_glfw_window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS;
@@ -4088,7 +4349,8 @@ void GUI::open_export_units_dialog_(Export_format fmt)
     m_export_unit = Export_unit::Inch;
     break;
   }
-  m_open_export_units_modal = true;
+  m_export_mesh.lin_deflection = m_view->export_lin_deflection_default(m_export_unit);
+  m_open_export_units_modal    = true;
 }
 
 void GUI::export_units_dialog_()
@@ -4122,14 +4384,36 @@ void GUI::export_units_dialog_()
   ImGui::Text("Export %s in which units?", fmt_label);
   ImGui::Spacing();
 
+  const Export_unit prev_unit = m_export_unit;
   if (ImGui::RadioButton("Inches", m_export_unit == Export_unit::Inch))
     m_export_unit = Export_unit::Inch;
   if (ImGui::RadioButton("Millimeters", m_export_unit == Export_unit::Millimeter))
     m_export_unit = Export_unit::Millimeter;
 
+  if (m_export_unit != prev_unit)
+    m_export_mesh.lin_deflection = m_view->export_lin_deflection_default(m_export_unit);
+
   ImGui::Spacing();
   if (m_export_pending_fmt == Export_format::Stl || m_export_pending_fmt == Export_format::Ply)
+  {
     ImGui::TextWrapped("STL and PLY have no unit metadata; vertex coordinates will be in the chosen unit.");
+    ImGui::Spacing();
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputDouble(m_export_unit == Export_unit::Millimeter ? "Linear deflection (mm)" : "Linear deflection (in)",
+                       &m_export_mesh.lin_deflection, 0.0, 0.0, "%.4f");
+    if (ImGui::IsItemHovered())
+      ImGui::SetTooltip("Largest gap between a facet and the true surface. Smaller is finer and slower.");
+
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::InputDouble("Angular deflection (deg)", &m_export_mesh.ang_deflection_deg, 0.0, 0.0, "%.1f");
+    if (ImGui::IsItemHovered())
+      ImGui::SetTooltip("Largest angle between neighboring facets on curved faces (1 to 90).");
+
+    if (m_export_mesh.lin_deflection <= 0.0)
+      m_export_mesh.lin_deflection = m_view->export_lin_deflection_default(m_export_unit);
+
+    m_export_mesh.ang_deflection_deg = std::clamp(m_export_mesh.ang_deflection_deg, 1.0, 90.0);
+  }
 
   ImGui::Spacing();
   if (ImGui::Button("Export", ImVec2(120.0f, 0.0f)))
@@ -4189,7 +4473,7 @@ void GUI::export_file_dialog_(Export_format fmt, Export_unit unit)
     return;
   }
 
-  const Status s = m_view->export_document(fmt, unit, selected);
+  const Status s = m_view->export_document(fmt, unit, selected, m_export_mesh);
   if (!s.is_ok())
     show_message(s.message());
   else
@@ -4214,7 +4498,7 @@ void GUI::export_file_dialog_(Export_format fmt, Export_unit unit)
     download_name = "export.ply";
     break;
   }
-  const Status s = m_view->export_document(fmt, unit, mem_path);
+  const Status s = m_view->export_document(fmt, unit, mem_path, m_export_mesh);
   if (!s.is_ok())
   {
     show_message(s.message());
@@ -4241,17 +4525,10 @@ void GUI::import_file_dialog_()
 
   if (selected)
   {
-    // Binary mode required for PLY (mesh payload may contain 0x1A; Windows text mode treats that as EOF).
-    std::ifstream file(selected, std::ios::binary);
-    if (!file.is_open())
-    {
-      show_message("Error opening: " + std::filesystem::path(selected).filename().string());
-      return;
-    }
-
-    const std::string file_bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
-    if (!file_bytes.empty())
-      on_inspector_file(selected, file_bytes);
+    // Mapped read-only, so a large scan is parsed in place instead of being copied into memory first.
+    const std::shared_ptr<const Mapped_file> file = Mapped_file::open(selected);
+    if (file && file->size() > 0)
+      on_inspector_file(selected, file);
     else
       show_message("Error opening: " + std::filesystem::path(selected).filename().string());
   }
@@ -4266,6 +4543,20 @@ void GUI::new_project_()
   m_last_saved_path.clear();
   clear_sketch_list_ui_();
   m_view->new_file();
+  m_autosave.mark_clean(*m_view);
+}
+
+void GUI::open_recovered_project_()
+{
+  const auto file = Mapped_file::open(m_recovered_path);
+  if (!file || !is_valid_project_file_(file->view()))
+  {
+    show_message("Recovered work could not be read.");
+    m_recovered_path.clear();
+    return;
+  }
+
+  on_file(m_recovered_path, file, false);
 }
 
 void GUI::open_file_dialog_()
@@ -4282,10 +4573,9 @@ void GUI::open_file_dialog_()
             );
   if (selected)
   {
-    std::ifstream     file(selected, std::ios::binary);
-    const std::string file_bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
-    if (file.good() && !file_bytes.empty())
-      on_file(selected, file_bytes);
+    const auto file = Mapped_file::open(selected);
+    if (file && file->size() > 0)
+      on_file(selected, file);
 
     else
       show_message("Error opening: " + std::filesystem::path(selected).filename().string());
@@ -4298,9 +4588,8 @@ void GUI::open_file_dialog_()
 
 void GUI::save_file_dialog_()
 {
-  const std::vector<uint8_t> ezy_bytes = serialized_project_ezy_();
-
 #ifndef __EMSCRIPTEN__
+  const auto write_ezy = project_ezy_writer_();
   std::string file;
   if (!m_last_saved_path.empty())
     file = m_last_saved_path; // Reuse last saved path
@@ -4364,10 +4653,15 @@ void GUI::save_file_dialog_()
     }
     else
     {
-      errno = 0;
-      out.write(reinterpret_cast<const char*>(ezy_bytes.data()), static_cast<std::streamsize>(ezy_bytes.size()));
+      errno              = 0;
+      const bool written = write_ezy(
+          [&out](const uint8_t* data, size_t size)
+          {
+            out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+            return out.good();
+          });
       out.flush();
-      if (!out.good())
+      if (!written || !out.good())
       {
         show_error_dialog("Save failed", describe_save_failure("writing file data"));
       }
@@ -4377,13 +4671,17 @@ void GUI::save_file_dialog_()
         if (!out)
           show_error_dialog("Save failed", describe_save_failure("closing the file"));
         else
+        {
+          m_autosave.mark_clean(*m_view);
           show_message("Saved: " + std::filesystem::path(file).filename().string());
+        }
       }
     }
   }
   else
     show_message("Save canceled");
 #else
+  const std::vector<uint8_t> ezy_bytes = serialized_project_ezy_();
   if (ezy_bytes.empty())
   {
     show_error_dialog("Save failed",
@@ -4400,13 +4698,24 @@ void GUI::save_file_dialog_()
 
 void GUI::on_file(const std::string& file_path, const std::string& file_bytes, bool announce_load)
 {
-  using namespace nlohmann;
+  on_file(file_path, Mapped_file::from_bytes(file_bytes), announce_load);
+}
 
+void GUI::on_file(const std::string& file_path, const std::shared_ptr<const Mapped_file>& file, bool announce_load)
+{
+  const std::string_view file_bytes = file->view();
   log_message("on_file: path=" + file_path + " bytes=" + std::to_string(file_bytes.size()) +
-              " zip=" + (is_ezy_zip(file_bytes) ? "yes" : "no") + " json=" + (is_ezy_json(file_bytes) ? "yes" : "no"));
+              " mapped=" + (file->mapped() ? "yes" : "no") + " zip=" + (is_ezy_zip(file_bytes) ? "yes" : "no") +
+              " json=" + (is_ezy_json(file_bytes) ? "yes" : "no"));
 
-  m_view->push_undo_snapshot();
-  const std::optional<std::string> manifest = manifest_from_project_file_(file_bytes, *m_view, true);
+  if (cad_busy_())
+  {
+    show_message("Wait for the current operation to finish before opening a project.");
+    return;
+  }
+
+  std::shared_ptr<const Ezy_archive> archive;
+  const std::optional<std::string>   manifest = manifest_from_project_file_(file, archive);
   if (!manifest)
     log_message("on_file: manifest_from_project_file_ FAILED");
   else
@@ -4415,18 +4724,85 @@ void GUI::on_file(const std::string& file_path, const std::string& file_bytes, b
 
   if (!manifest || !is_valid_project_manifest_(*manifest))
   {
-    m_view->pop_undo_snapshot();
     show_message("Invalid EzyCad project: " + std::filesystem::path(file_path).filename().string());
     return;
   }
 
-  const json j = json::parse(*manifest);
-  m_view->load(*manifest);
+  const bool lazy = archive && m_lazy_project_load;
+#ifndef __EMSCRIPTEN__
+  // Startup loads finish before the first frame; interactive opens decode behind the busy dialog.
+  if (announce_load)
+  {
+    begin_project_open_(file_path, *manifest, archive, lazy);
+    return;
+  }
+#endif
+
+  Occt_view::Project_load_geom geom;
+  const Status st = Occt_view::prepare_load(*manifest, Occt_view::geom_reader(archive), lazy ? archive : nullptr, geom);
+  finish_project_open_(st, geom, file_path, archive, announce_load);
+}
+
+void GUI::begin_project_open_(const std::string& file_path, const std::string& manifest,
+                              const std::shared_ptr<const Ezy_archive>& archive, bool lazy)
+{
+  m_cad_busy_kind       = Cad_busy_kind::Open;
+  m_cad_busy_path       = file_path;
+  m_cad_busy_archive    = archive;
+  m_cad_busy_title      = "Opening";
+  m_cad_busy_open_popup = true;
+  m_cad_busy_modal_open = true;
+
+#ifndef __EMSCRIPTEN__
+  m_cad_busy_progress = new Atomic_progress_indicator();
+  m_cad_busy_progress->set_stage("Starting...");
+  const Atomic_progress_indicator_ptr prog = m_cad_busy_progress;
+  m_cad_busy_open_fut =
+      run_task_async(Task_priority::Background,
+                     [manifest, archive, lazy, prog]() -> std::pair<Status, Occt_view::Project_load_geom>
+                     {
+                       Occt_view::Project_load_geom geom;
+                       Status st = Occt_view::prepare_load(manifest, Occt_view::geom_reader(archive), lazy ? archive : nullptr,
+                                                           geom, prog);
+                       return {st, std::move(geom)};
+                     });
+#endif
+}
+
+void GUI::finish_project_open_(const Status& st, Occt_view::Project_load_geom& geom, const std::string& file_path,
+                               const std::shared_ptr<const Ezy_archive>& archive, bool announce_load)
+{
+  const std::string name = std::filesystem::path(file_path).filename().string();
+  if (!st.is_ok())
+  {
+    log_message("on_file: " + st.message());
+    if (st.message().find("cancelled") != std::string::npos)
+      show_message("Open cancelled: " + name);
+    else
+      show_message("Invalid EzyCad project: " + name);
+
+    return;
+  }
+
+  m_view->push_undo_snapshot();
+  if (archive)
+    import_project_assets_(archive, m_view->asset_store(), geom.lazy_archive != nullptr);
+
+  m_view->commit_load(geom, true);
+  if (geom.lazy_archive)
+    log_message("on_file: " + std::to_string(m_view->deferred_shape_count()) + " shape(s) deferred");
+
   log_message("on_file: load complete");
+  const nlohmann::json& j = geom.doc;
   apply_sketch_list_ui_from_json_(j);
   apply_shape_list_ui_from_json_(j);
-  m_last_saved_path = file_path;
-  Mode opened_mode  = Mode::Normal;
+  // Recovered work stays unsaved: it is saved under a name the user picks, never back into the recovery file.
+  const bool recovered = !m_recovered_path.empty() && file_path == m_recovered_path;
+  m_last_saved_path    = recovered ? std::string() : file_path;
+  if (!recovered)
+    m_autosave.mark_clean(*m_view);
+
+  Mode opened_mode = Mode::Normal;
   if (j.contains("mode") && j["mode"].is_number_integer())
   {
     const int idx = j["mode"].get<int>();
@@ -4435,14 +4811,17 @@ void GUI::on_file(const std::string& file_path, const std::string& file_bytes, b
   }
   set_mode(opened_mode);
 #ifndef __EMSCRIPTEN__
-  if (file_path != "(startup)" && !file_path.empty() && file_path != "res/default.ezy")
+  if (!recovered && file_path != "(startup)" && !file_path.empty() && file_path != "res/default.ezy")
     persist_last_opened_project_path_(file_path);
 #endif
-  if (announce_load)
-    show_message("Opened: " + std::filesystem::path(file_path).filename().string());
+  if (recovered)
+    show_message("Opened recovered work. Use Save as to keep it.");
+  else if (announce_load)
+    show_message("Opened: " + name);
 }
 
-bool GUI::on_import_file(const std::string& file_path, const std::string& file_data, const Step_import_mode step_mode)
+bool GUI::on_import_file(const std::string& file_path, std::string_view file_data, const Step_import_mode step_mode,
+                         const Ply_import_mode ply_mode)
 {
   std::string ext = std::filesystem::path(file_path).extension().string();
   for (char& c : ext)
@@ -4450,7 +4829,7 @@ bool GUI::on_import_file(const std::string& file_path, const std::string& file_d
 
   if (ext == ".ply")
   {
-    if (!m_view->import_ply(file_data))
+    if (!m_view->import_ply(file_data, ply_mode))
     {
       show_message("PLY import failed.");
       return false;
@@ -4460,7 +4839,7 @@ bool GUI::on_import_file(const std::string& file_path, const std::string& file_d
     return true;
   }
 
-  if (Status st = m_view->import_step(file_data, step_mode); !st.is_ok())
+  if (Status st = m_view->import_step(std::string(file_data), step_mode); !st.is_ok())
   {
     show_message(st.message());
     return false;
@@ -4485,7 +4864,12 @@ bool GUI::on_import_file(const std::string& file_path, const std::string& file_d
 
 void GUI::on_inspector_file(const std::string& file_path, const std::string& file_data)
 {
-  open_file_inspector_(file_path, file_data);
+  open_file_inspector_(file_path, Mapped_file::from_bytes(file_data));
+}
+
+void GUI::on_inspector_file(const std::string& file_path, const std::shared_ptr<const Mapped_file>& file)
+{
+  open_file_inspector_(file_path, file);
 }
 
 namespace
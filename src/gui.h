@@ -19,6 +19,7 @@
 #include <variant>
 #include <vector>
 
+#include "doc_autosave.h"
 #include "utl_geom.h"
 #include "imgui.h"
 #include "imgui_markdown.h"
@@ -27,6 +28,7 @@
 #include "gui_hotkeys.h"
 #include "gui_occt_view.h"
 #include "shp_info.h"
+#include "shp_job.h"
 #include "utl_cad_file_info.h"
 #include "utl_types.h"
 
@@ -141,6 +143,15 @@ inline constexpr double k_gui_view_zoom_scroll_scale_default = 4.0;
 inline constexpr double k_gui_default_2d_view_size_min     = 0.1;
 inline constexpr double k_gui_default_2d_view_size_max     = 1000.0;
 inline constexpr double k_gui_default_2d_view_size_default = 3.0;
+/// Allowed range and default for `gui.undo_budget_mb` (undo/redo history memory cap; must match Settings slider).
+inline constexpr int k_gui_undo_budget_mb_min     = 16;
+inline constexpr int k_gui_undo_budget_mb_max     = 4096;
+inline constexpr int k_gui_undo_budget_mb_default = 256;
+/// Allowed range and default for `gui.autosave_interval_s` (seconds between recovery saves, 0 = off; must match
+/// Settings slider).
+inline constexpr int k_gui_autosave_interval_s_min     = 0;
+inline constexpr int k_gui_autosave_interval_s_max     = 3600;
+inline constexpr int k_gui_autosave_interval_s_default = 60;
 /// `gui.ui_verbosity`: 0 = minimal UI; odd steps unlock feature tiers; even steps unlock help tiers.
 inline constexpr int k_gui_ui_verbosity_min     = 0;
 inline constexpr int k_gui_ui_verbosity_default = 6;
@@ -190,6 +201,8 @@ struct Gui_settings_headers
   bool sketch_underlay{false};
   bool startup{false};
   bool hotkeys{false};
+  bool undo{false};
+  bool project_files{false};
 };
 
 /// Per-sketch Sketch List expand / subsection open state (project `ui.sketchList`).
@@ -202,6 +215,15 @@ struct Sketch_list_row_ui
   bool faces{false};
 };
 
+/// One Shape List row in the flattened outliner (collapsed subtrees left out).
+struct Shape_list_row
+{
+  Shp_ptr shape;
+  int     depth{0};
+  bool    has_children{false};
+  bool    open{false};
+};
+
 namespace doc_urls
 {
 // clang-format off
@@ -221,6 +243,8 @@ inline constexpr const char* k_occt_view                    = "https://ezycad.re
 inline constexpr const char* k_startup_project              = "https://ezycad.readthedocs.io/en/latest/usage-settings.html#startup-project";
 inline constexpr const char* k_extrude_sketch_face          = "https://ezycad.readthedocs.io/en/latest/usage.html#extrude-sketch-face-tool-e";
 inline constexpr const char* k_hotkeys                      = "https://ezycad.readthedocs.io/en/latest/usage-settings.html#keyboard-shortcuts";
+inline constexpr const char* k_edit_operations              = "https://ezycad.readthedocs.io/en/latest/usage.html#edit-operations";
+inline constexpr const char* k_project_files                = "https://ezycad.readthedocs.io/en/latest/usage-settings.html#project-files";
 // clang-format on
 } // namespace doc_urls
 
@@ -243,6 +267,7 @@ public:
   void render_occt();
 
   void on_key(int key, int scancode, int action, int mods); // gui_mode.cpp
+  /// Keeps the latest cursor position; the tools see it once per frame (`render_gui`) or before the next click or key.
   void on_mouse_pos(const ScreenCoords& screen_coords);
   void on_mouse_button(int button, int action, int mods);
   /// Headless/tests: same sketch LMB placement as on_mouse_button (does not require ImGui mouse pos).
@@ -297,6 +322,10 @@ public:
   float sketch_shape_faint_opacity() const { return m_sketch_shape_faint_opacity; }
   /// Master on/off for faint shapes in all sketch modes (`gui.sketch_shape_faint_enabled`).
   bool sketch_shape_faint_enabled() const { return m_sketch_shape_faint_enabled; }
+  /// `gui.render_mode` is "on_demand": the native main loop waits for events while `wants_frames()` is false.
+  bool render_on_demand() const { return m_render_on_demand; }
+  /// Work that advances without input: a busy-dialog job, a cross-section job, or an OCCT view animation.
+  [[nodiscard]] bool wants_frames() const;
   /// Extrude dense-face fast preview (`gui.extrude_fast_preview`); Settings.
   bool extrude_fast_preview_enabled() const { return m_extrude_fast_preview; }
   /// Edge count above which extrude uses face-copy preview (`gui.extrude_fast_preview_edge_threshold`).
@@ -384,9 +413,16 @@ public:
 #endif
 
   void               on_file(const std::string& file_path, const std::string& file_bytes, bool announce_load = true);
-  [[nodiscard]] bool on_import_file(const std::string& file_path, const std::string& file_data,
-                                    Step_import_mode step_mode = Step_import_mode::Preserve_hierarchy);
+  /// Opens a project from a mapped file or wrapped bytes. With `gui.lazy_project_load`, zip projects keep `file` open
+  /// and read shape geometry and underlay pixels only when first needed.
+  void               on_file(const std::string& file_path, const std::shared_ptr<const Mapped_file>& file,
+                             bool announce_load = true);
+  [[nodiscard]] bool on_import_file(const std::string& file_path, std::string_view file_data,
+                                    Step_import_mode step_mode = Step_import_mode::Preserve_hierarchy,
+                                    Ply_import_mode  ply_mode  = Ply_import_mode::Triangulation);
   void               on_inspector_file(const std::string& file_path, const std::string& file_data);
+  /// Shows File -> Import for a mapped file; PLY meshes are parsed from the mapping without a copy.
+  void               on_inspector_file(const std::string& file_path, const std::shared_ptr<const Mapped_file>& file);
   /// Emscripten `on_sketch_underlay_selected` routes here (must be public for C callback).
   void on_sketch_underlay_file(const std::string& file_path, const std::string& file_bytes);
 
@@ -418,6 +454,8 @@ private:
   void sketch_origin_set_edit_();
   void open_sketch_origin_set_edit_(const std::shared_ptr<Sketch>& sk, int plane_idx, double v_min, double v_max);
   void on_left_click_(const ScreenCoords& screen_coords);
+  /// Drive the current tool with the pending `on_mouse_pos` position, if any.
+  void flush_mouse_move_();
   void sketch_list_();
   void sketch_list_inspector_(const std::shared_ptr<Sketch>& sketch, int index, Sketch_list_row_ui& row_ui,
                               std::shared_ptr<Sketch>& hover_dim_sketch, size_t& hover_dim_index,
@@ -433,15 +471,26 @@ private:
   void                         sketch_properties_dialog_();
   void                         sketch_origin_panel_settings_(const std::shared_ptr<Sketch>& sk);
   void                         shape_list_();
+  void                         rebuild_shape_list_rows_();
+  void                         rebuild_sketch_list_rows_();
   void                         shape_info_dialog_();
   void                         open_shape_info_(const Shp_ptr& shape);
   void                         file_inspector_dialog_();
-  void                         open_file_inspector_(const std::string& file_path, const std::string& file_bytes);
+  void                         open_file_inspector_(const std::string& file_path, std::shared_ptr<const Mapped_file> file);
   void                         close_file_inspector_();
   void                         cad_busy_dialog_();
   void                         poll_cad_busy_();
   void                         begin_step_import_(Step_import_mode mode);
   void                         finish_step_import_(Status st, Occt_view::Step_import_geom& geom);
+  /// Runs `Occt_view::prepare_load` on a worker thread behind the busy dialog (native interactive opens).
+  void                         begin_project_open_(const std::string& file_path, const std::string& manifest,
+                                                   const std::shared_ptr<const Ezy_archive>& archive, bool lazy);
+  /// Commits a prepared project and restores its UI state, mode and recent path (UI thread).
+  void                         finish_project_open_(const Status& st, Occt_view::Project_load_geom& geom,
+                                                    const std::string& file_path,
+                                                    const std::shared_ptr<const Ezy_archive>& archive, bool announce_load);
+  /// Runs a Boolean / fillet / chamfer `Shape_job` behind the busy dialog; the result is committed by `poll_cad_busy_`.
+  void                         begin_shape_job_(Result<Shape_job> job);
   void                         cancel_cad_busy_();
   [[nodiscard]] bool           cad_busy_() const;
 
@@ -555,20 +604,33 @@ private:
 
   void save_startup_project_();
   void clear_saved_startup_project_();
+  /// Opens the work an earlier session's autosave left behind (`m_recovered_path`).
+  void open_recovered_project_();
   /// Native only: store path in settings after a successful Open (for optional startup load).
   void                               persist_last_opened_project_path_(const std::string& path);
-  [[nodiscard]] std::string          serialized_project_json_() const;
+  /// Manifest JSON; geometry goes to `geoms` (v4) when given, else stays inline.
+  [[nodiscard]] std::string          serialized_project_json_(Ezy_geom_entries* geoms = nullptr) const;
+  /// Adds the GUI state (mode, list UI) to an `Occt_view::to_json` manifest.
+  [[nodiscard]] std::string          serialized_project_json_(const std::string& view_json) const;
   [[nodiscard]] std::vector<uint8_t> serialized_project_ezy_() const;
+  /// Serializes the document now; the returned writer streams the `.ezy` archive into any sink (file saves).
+  /// Settles autosave and finishes a lazy load first, so nothing still maps the file being written.
+  [[nodiscard]] std::function<bool(const Ezy_write_sink&)> project_ezy_writer_();
   void                               open_url_(const std::string& url);
   void                               update_window_title_();
   [[nodiscard]] std::string          project_title_segment_() const;
   /// Parses a float from manual dist/angle ImGui text fields (trimmed, full-string match).
   [[nodiscard]] static bool parse_dist_text_to_float_(const char* buf, float& out);
-  /// True if bytes are a valid v3 zip or legacy JSON EzyCad project.
-  [[nodiscard]] static bool                       is_valid_project_file_(const std::string& bytes);
-  [[nodiscard]] static bool                       is_valid_project_manifest_(const std::string& manifest_json);
-  [[nodiscard]] static std::optional<std::string> manifest_from_project_file_(const std::string& file_bytes, Occt_view& view,
-                                                                              bool replace_assets);
+  /// True if bytes are a valid v3/v4 zip or legacy JSON EzyCad project. Zip projects only have their manifest read.
+  [[nodiscard]] static bool                       is_valid_project_file_(std::string_view bytes);
+  [[nodiscard]] static bool                       is_valid_project_manifest_(std::string_view manifest_json);
+  /// For zip projects also hands back the indexed archive; its assets and geometry entries are read by the caller
+  /// (`out_archive` stays null for legacy JSON).
+  [[nodiscard]] static std::optional<std::string> manifest_from_project_file_(const std::shared_ptr<const Mapped_file>& file,
+                                                                              std::shared_ptr<const Ezy_archive>& out_archive);
+  /// Replaces the asset store's contents with the underlay assets of `archive`, read now or registered to be read
+  /// on first use.
+  static void import_project_assets_(const std::shared_ptr<const Ezy_archive>& archive, Ezy_asset_store& store, bool lazy);
 
   /// OCCT standard material display names for ImGui combos (index matches \c Graphic3d_NameOfMaterial).
   [[nodiscard]] static const std::vector<std::string>& occt_material_combo_labels_();
@@ -654,6 +716,10 @@ private:
   double m_view_roll_step_deg = k_gui_view_roll_step_deg_default;
   /// Multiplier for `UpdateZoom(Aspect_ScrollDelta(..., int(y * scale)))`; persisted in `gui.view_zoom_scroll_scale`.
   double m_view_zoom_scroll_scale = k_gui_view_zoom_scroll_scale_default;
+  /// Undo history memory cap in MiB, applied via `Occt_view::set_undo_budget_bytes`; persisted in `gui.undo_budget_mb`.
+  int m_undo_budget_mb = k_gui_undo_budget_mb_default;
+  /// Seconds between crash-recovery saves (0 = off), applied to `m_autosave`; persisted in `gui.autosave_interval_s`.
+  int m_autosave_interval_s = k_gui_autosave_interval_s_default;
   /// Sketch-plane framing for New Project / default camera (`gui.default_2d_view_width` / `_height`, inches).
   double                      m_default_2d_view_width   = k_gui_default_2d_view_size_default;
   double                      m_default_2d_view_height  = k_gui_default_2d_view_size_default;
@@ -672,11 +738,12 @@ private:
   std::string m_error_modal_title;
   std::string m_error_modal_message;
 
-  // File -> Export: unit picker modal (inches / mm) before save/download
-  bool          m_open_export_units_modal{false};
-  bool          m_export_units_modal_open{false};
-  Export_format m_export_pending_fmt{Export_format::Step};
-  Export_unit   m_export_unit{Export_unit::Inch};
+  // File -> Export: unit picker modal (inches / mm, plus mesh tolerances for STL/PLY) before save/download
+  bool               m_open_export_units_modal{false};
+  bool               m_export_units_modal_open{false};
+  Export_format      m_export_pending_fmt{Export_format::Step};
+  Export_unit        m_export_unit{Export_unit::Inch};
+  Mesh_export_params m_export_mesh; // Linear deflection resets with the unit; angular is kept for the session
 
   // Log window (single buffer for ImGui read-only multiline = selectable / copyable text)
   std::vector<char> m_log_buffer{'\0'};
@@ -694,8 +761,14 @@ private:
 
   std::string m_last_saved_path; // Session path for Ctrl+S / Save as
   bool        m_load_last_opened_on_startup{false};
+  bool        m_lazy_project_load{true}; // `gui.lazy_project_load`: read geometry of opened zip projects on demand
+  bool        m_render_on_demand{true};  // `gui.render_mode`: "on_demand" (idle loop sleeps) or "continuous"
   std::string m_last_opened_project_path; // Persisted in settings (native)
 
+  // Crash recovery
+  Doc_autosave m_autosave;
+  std::string  m_recovered_path; // Recovery file a previous session left; empty when there was none
+
   using Example_file_list = std::vector<Example_file>;
   Example_file_list m_example_files;
 
@@ -705,39 +778,59 @@ private:
   float                              m_sketch_list_scroll_y{0.f};
   bool                               m_sketch_list_scroll_restore{false};
 
-  bool                        m_show_sketch_list{true};
-  bool                        m_show_shape_list{true};
-  bool                        m_show_options{true};
-  bool                        m_show_settings_dialog{false};
-  bool                        m_open_about_popup{false};
-  bool                        m_about_popup_open{false};
-  bool                        m_shape_info_open{false};
-  Shp_ptr                     m_shape_info_shp;
-  std::vector<shp_info::Line> m_shape_info_lines;
-  bool                        m_file_inspector_open{false};
-  Step_import_mode            m_file_inspector_step_mode{Step_import_mode::Preserve_hierarchy};
-  std::string                 m_file_inspector_path;
-  std::string                 m_file_inspector_bytes;
-  utl_cad_file_info::Format   m_file_inspector_fmt{utl_cad_file_info::Format::Unknown};
+  // Row models drawn through ImGuiListClipper. Rebuilt only when `Occt_view::doc_tree_revision` moves or the
+  // list's own state (expand flags, names, font size) changes, not every frame.
+  std::vector<Shape_list_row>          m_shape_list_rows;
+  uint64_t                             m_shape_list_rows_rev{0};
+  bool                                 m_shape_list_rows_dirty{true};
+  std::vector<std::shared_ptr<Sketch>> m_sketch_list_rows;
+  float                                m_sketch_list_name_w{0.f};    // Widest sketch name at `m_sketch_list_font_size`.
+  float                                m_sketch_list_font_size{0.f};
+  uint64_t                             m_sketch_list_rows_rev{0};
+  bool                                 m_sketch_list_rows_dirty{true};
+
+  bool                               m_show_sketch_list{true};
+  bool                               m_show_shape_list{true};
+  bool                               m_show_options{true};
+  bool                               m_show_settings_dialog{false};
+  bool                               m_open_about_popup{false};
+  bool                               m_about_popup_open{false};
+  bool                               m_shape_info_open{false};
+  Shp_ptr                            m_shape_info_shp;
+  std::vector<shp_info::Line>        m_shape_info_lines;
+  bool                               m_file_inspector_open{false};
+  Step_import_mode                   m_file_inspector_step_mode{Step_import_mode::Preserve_hierarchy};
+  Ply_import_mode                    m_file_inspector_ply_mode{Ply_import_mode::Triangulation};
+  std::string                        m_file_inspector_path;
+  std::shared_ptr<const Mapped_file> m_file_inspector_file; // Mapped on desktop; bytes from the browser picker
+  utl_cad_file_info::Format          m_file_inspector_fmt{utl_cad_file_info::Format::Unknown};
+
+  std::optional<ScreenCoords> m_pending_mouse_pos; // Latest `on_mouse_pos` not yet applied
 
   enum class Cad_busy_kind : uint8_t
   {
     Idle,
-    Import
+    Import,
+    Open,
+    Shape_op
   };
-  Cad_busy_kind                 m_cad_busy_kind{Cad_busy_kind::Idle};
-  bool                          m_cad_busy_open_popup{false};
-  bool                          m_cad_busy_modal_open{false};
-  Atomic_progress_indicator_ptr m_cad_busy_progress;
-  std::string                   m_cad_busy_path;
-  std::string                   m_cad_busy_bytes;
-  std::string                   m_cad_busy_title;
-  Step_import_mode              m_cad_busy_import_mode{Step_import_mode::Preserve_hierarchy};
+  Cad_busy_kind                      m_cad_busy_kind{Cad_busy_kind::Idle};
+  bool                               m_cad_busy_open_popup{false};
+  bool                               m_cad_busy_modal_open{false};
+  Atomic_progress_indicator_ptr      m_cad_busy_progress;
+  std::string                        m_cad_busy_path;
+  std::string                        m_cad_busy_bytes;
+  std::string                        m_cad_busy_title;
+  Step_import_mode                   m_cad_busy_import_mode{Step_import_mode::Preserve_hierarchy};
+  std::shared_ptr<const Ezy_archive> m_cad_busy_archive; // Project being opened (zip only)
+  std::shared_ptr<Shape_job_task>    m_cad_busy_shape_task;   // Dropped on Cancel; a late result is discarded
+  Shape_job::Commit                  m_cad_busy_shape_commit;
 #ifdef __EMSCRIPTEN__
   /// Frames to paint the Importing modal before starting the blocking STEP transfer.
   int m_cad_busy_defer_frames{0};
 #else
-  std::future<std::pair<Status, Occt_view::Step_import_geom>> m_cad_busy_import_fut;
+  std::future<std::pair<Status, Occt_view::Step_import_geom>>  m_cad_busy_import_fut;
+  std::future<std::pair<Status, Occt_view::Project_load_geom>> m_cad_busy_open_fut;
 #endif
   std::string m_about_markdown;
   uint32_t    m_about_splash_gl{0};
@@ -166,6 +166,7 @@ void GUI::set_parent_mode() { set_mode(parent_mode_of(get_mode())); }
 void GUI::on_key(int key, int scancode, int action, int mods)
 {
   (void)scancode;
+  flush_mouse_move_(); // Tab / Enter / Esc act on the tool state at the latest cursor position
   const bool press_or_repeat = (action == GLFW_PRESS || action == GLFW_REPEAT);
 
   // Capture before fixed view/nav handlers so reserved chords can be rejected with a message.
@@ -399,18 +400,15 @@ void GUI::dispatch_hotkey_action_(Gui_action action)
   case Gui_action::Mode_polar_duplicate:      set_mode(Mode::Shape_polar_duplicate);          break;
   case Gui_action::Mode_cross_section:        set_mode(Mode::Shape_cross_section);            break;
   case Gui_action::Cmd_shape_cut:
-    if (Status s = m_view->shp_cut().selected_cut(); !s.is_ok())
-      show_message(s.message());
+    begin_shape_job_(m_view->shp_cut().selected_cut_job());
     break;
 
   case Gui_action::Cmd_shape_fuse:
-    if (Status s = m_view->shp_fuse().selected_fuse(); !s.is_ok())
-      show_message(s.message());
+    begin_shape_job_(m_view->shp_fuse().selected_fuse_job());
     break;
 
   case Gui_action::Cmd_shape_common:
-    if (Status s = m_view->shp_common().selected_common(); !s.is_ok())
-      show_message(s.message());
+    begin_shape_job_(m_view->shp_common().selected_common_job());
     break;
 
   case Gui_action::Edit_delete:               m_view->delete_selected();  break;
@@ -941,6 +939,20 @@ void GUI::options_shape_cross_section_mode_()
   if (ImGui::Checkbox("Show section outline", &show_section_outline))
     section.set_show_section_outline(show_section_outline);
 
+  // Precompute sections a whole slider range on the pool; the single-threaded web build would stall instead.
+  bool start_precompute = false;
+#ifndef __EMSCRIPTEN__
+  bool precompute = section.get_precompute();
+  if (ImGui::Checkbox("Precompute offsets", &precompute))
+  {
+    section.set_precompute(precompute);
+    start_precompute = precompute && have_selection;
+  }
+
+  if (precompute)
+    ImGui::TextDisabled("Section cache: %.1f MB", double(section.cache_bytes()) / (1024.0 * 1024.0));
+#endif
+
   double     offset_min = -1.0;
   double     offset_max = 1.0;
   const bool have_range = section.try_get_offset_range_display(offset_min, offset_max);
@@ -965,8 +977,13 @@ void GUI::options_shape_cross_section_mode_()
 
   ImGui::SetNextItemWidth(180.0f);
   ImGui::BeginDisabled(!have_range);
-  ImGui::SliderScalar("Offset", ImGuiDataType_Double, &offset, &offset_min, &offset_max, "%.6g");
+  const bool offset_changed = ImGui::SliderScalar("Offset", ImGuiDataType_Double, &offset, &offset_min, &offset_max, "%.6g");
   ImGui::EndDisabled();
+  // Only a mouse drag snaps to the precomputed samples; a typed or Ctrl+click value is kept exact and sectioned on
+  // demand.
+  if (have_range && offset_changed && ImGui::IsMouseDown(ImGuiMouseButton_Left))
+    offset = section.snap_offset_display(offset, offset_min, offset_max);
+
   section.set_offset_display(offset);
   ImGui::SameLine(0.0f, ImGui::GetStyle().ItemInnerSpacing.x);
   ImGui::TextUnformatted(m_view->project_unit_suffix());
@@ -974,7 +991,7 @@ void GUI::options_shape_cross_section_mode_()
     ImGui::TextDisabled("Select solid shapes to enable the offset slider.");
 
   // Plane annotation updates immediately; section wires run async (poll below).
-  if (section.preview_inputs_stale())
+  if (section.preview_inputs_stale() || start_precompute)
   {
     if (m_view->get_selected_shps().empty())
     {
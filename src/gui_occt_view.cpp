@@ -11,8 +11,6 @@
 #include <Bnd_Box.hxx>
 #include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
-#include <BRepAlgoAPI_Fuse.hxx>
-#include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepPrimAPI_MakePrism.hxx>
 #include <BRepTools.hxx>
 #include <BRep_Builder.hxx>
@@ -41,7 +39,6 @@
 #include <PrsDim_LengthDimension.hxx>
 #include <STEPControl_Writer.hxx>
 #include <StdSelect_BRepOwner.hxx>
-#include <StlAPI_Writer.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Compound.hxx>
@@ -55,12 +52,16 @@
 #include <gp_Trsf.hxx>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
+#include "utl_boolean.h"
 #include "utl_dbg.h"
 #include "delta.h"
+#include "doc_autosave.h"
 #include "doc_delta.h"
 #include "utl_geom.h"
 #include "gui.h"
+#include "utl_mesh.h"
 #include "utl_ply_io.h"
 #include "shp.h"
 #include "shp_create.h"
@@ -73,6 +74,7 @@
 #include "utl_json.h"
 #include "utl_occt.h"
 #include "utl_cad_file_info.h"
+#include "utl_parallel.h"
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -636,6 +638,7 @@ void Occt_view::create_sketch_from_planar_face_(const ScreenCoords& screen_coord
       EZY_ASSERT(!outer_wire.IsNull());
       m_cur_sketch = std::make_shared<Sketch>("Sketch from face", *this, *pln, outer_wire);
       m_sketches.push_back(m_cur_sketch);
+      ++m_doc_tree_rev;
       m_cur_sketch->set_current();
       refresh_viewer_grid_();
       push_undo_delta(std::make_unique<Sketch_struct_delta>(Sketch_struct_delta::Kind::Add,
@@ -654,6 +657,7 @@ void Occt_view::create_default_sketch_()
 
   m_cur_sketch = std::make_shared<Sketch>("Sketch", *this, xy_plane());
   m_sketches.push_back(m_cur_sketch);
+  ++m_doc_tree_rev;
   m_cur_sketch->set_current();
 }
 
@@ -688,6 +692,7 @@ void Occt_view::add_sketch(const gp_Pln& pln, const std::string& base_name)
   const std::string name = unique_sequential_name(base_name, existing);
   m_cur_sketch           = std::make_shared<Sketch>(name, *this, pln);
   m_sketches.push_back(m_cur_sketch);
+  ++m_doc_tree_rev;
   m_cur_sketch->set_current();
   refresh_viewer_grid_();
   push_undo_delta(std::make_unique<Sketch_struct_delta>(Sketch_struct_delta::Kind::Add,
@@ -744,6 +749,7 @@ Status Occt_view::create_sketch_from_cross_section(const std::string& base_name)
   sketch->rebuild_faces();
   m_cur_sketch = sketch;
   m_sketches.push_back(m_cur_sketch);
+  ++m_doc_tree_rev;
   m_cur_sketch->set_current();
   refresh_viewer_grid_();
   push_undo_delta(std::make_unique<Sketch_struct_delta>(Sketch_struct_delta::Kind::Add,
@@ -1042,10 +1048,116 @@ void Occt_view::add_shp_(Shp_ptr& shp, bool use_current_group)
     m_ctx->UpdateCurrentViewer();
   }
 
-  m_shps.push_back(shp);
+  push_shp_(shp);
   sync_sketch_shape_faint_style();
 }
 
+void Occt_view::push_shp_(const Shp_ptr& shp)
+{
+  m_shps.push_back(shp);
+  if (shp.IsNull())
+    return;
+
+  if (!m_shp_by_id.try_emplace(shp->get_id(), std::prev(m_shps.end())).second)
+    ++m_shp_id_dups[shp->get_id()];
+
+  link_child_(shp);
+  ++m_doc_tree_rev;
+}
+
+std::list<Shp_ptr>::iterator Occt_view::erase_shp_(std::list<Shp_ptr>::iterator it)
+{
+  const Shp_ptr& shp = *it;
+  if (!shp.IsNull())
+  {
+    unlink_child_(shp);
+    const Shape_id id    = shp->get_id();
+    auto           dups  = m_shp_id_dups.find(id);
+    auto           found = m_shp_by_id.find(id);
+    if (found != m_shp_by_id.end() && found->second == it)
+    {
+      m_shp_by_id.erase(found);
+      // Hand the id to the next shape that shares it (rare, so a scan is fine).
+      if (dups != m_shp_id_dups.end())
+        for (auto other = m_shps.begin(); other != m_shps.end(); ++other)
+          if (other != it && !other->IsNull() && (*other)->get_id() == id)
+          {
+            m_shp_by_id.emplace(id, other);
+            break;
+          }
+    }
+
+    if (dups != m_shp_id_dups.end() && --dups->second == 0)
+      m_shp_id_dups.erase(dups);
+  }
+
+  ++m_doc_tree_rev;
+  return m_shps.erase(it);
+}
+
+void Occt_view::erase_shp_(const Shp_ptr& shp)
+{
+  if (shp.IsNull())
+    return;
+
+  auto found = m_shp_by_id.find(shp->get_id());
+  if (found != m_shp_by_id.end() && *found->second == shp)
+  {
+    erase_shp_(found->second);
+    return;
+  }
+
+  // Duplicate id not currently indexed; fall back to a scan.
+  auto it = std::find(m_shps.begin(), m_shps.end(), shp);
+  if (it != m_shps.end())
+    erase_shp_(it);
+}
+
+void Occt_view::clear_shp_index_()
+{
+  m_shp_by_id.clear();
+  m_shp_id_dups.clear();
+  m_shp_children.clear();
+  ++m_doc_tree_rev;
+}
+
+namespace
+{
+bool sibling_less_(const Shp_ptr& a, const Shp_ptr& b)
+{
+  if (a->get_sibling_order() != b->get_sibling_order())
+    return a->get_sibling_order() < b->get_sibling_order();
+
+  return a->get_id() < b->get_id();
+}
+} // namespace
+
+void Occt_view::link_child_(const Shp_ptr& shp)
+{
+  std::vector<Shp_ptr>& kids = m_shp_children[shp->get_parent_id()];
+  kids.insert(std::upper_bound(kids.begin(), kids.end(), shp, sibling_less_), shp);
+}
+
+void Occt_view::unlink_child_(const Shp_ptr& shp)
+{
+  auto found = m_shp_children.find(shp->get_parent_id());
+  if (found == m_shp_children.end())
+    return;
+
+  std::vector<Shp_ptr>& kids = found->second;
+  // Same (order, id) key can repeat only on corrupt input, so search the equal range for the exact pointer.
+  auto [lo, hi] = std::equal_range(kids.begin(), kids.end(), shp, sibling_less_);
+  auto pos      = std::find(lo, hi, shp);
+  if (pos == hi)
+    pos = std::find(kids.begin(), kids.end(), shp);
+
+  if (pos != kids.end())
+    kids.erase(pos);
+
+  if (kids.empty())
+    m_shp_children.erase(found);
+}
+
 void Occt_view::ensure_current_group_valid_()
 {
   if (m_current_group_id == 0)
@@ -1084,24 +1196,21 @@ void Occt_view::adopt_shape_id(Shape_id id)
 
 Shp_ptr Occt_view::find_shape_by_id(Shape_id id) const
 {
-  for (const Shp_ptr& s : m_shps)
-    if (!s.IsNull() && s->get_id() == id)
-      return s;
+  auto found = m_shp_by_id.find(id);
+  if (found == m_shp_by_id.end())
+    return Shp_ptr();
 
-  return Shp_ptr();
+  return *found->second;
 }
 
 int Occt_view::next_sibling_order(Shape_id parent_id) const
 {
-  int max_order = -1;
-  for (const Shp_ptr& s : m_shps)
-  {
-    if (s.IsNull() || s->get_parent_id() != parent_id)
-      continue;
+  // Children are kept sorted by order, so the last one holds the maximum.
+  auto found = m_shp_children.find(parent_id);
+  if (found == m_shp_children.end())
+    return 0;
 
-    max_order = std::max(max_order, s->get_sibling_order());
-  }
-  return max_order + 1;
+  return std::max(found->second.back()->get_sibling_order() + 1, 0);
 }
 
 bool Occt_view::would_reparent_create_cycle(Shape_id id, Shape_id new_parent) const
@@ -1134,19 +1243,11 @@ bool Occt_view::would_reparent_create_cycle(Shape_id id, Shape_id new_parent) co
 
 std::vector<Shp_ptr> Occt_view::shape_children(Shape_id parent_id) const
 {
-  std::vector<Shp_ptr> kids;
-  for (const Shp_ptr& s : m_shps)
-    if (!s.IsNull() && s->get_parent_id() == parent_id)
-      kids.push_back(s);
+  auto found = m_shp_children.find(parent_id);
+  if (found == m_shp_children.end())
+    return {};
 
-  std::sort(kids.begin(), kids.end(),
-            [](const Shp_ptr& a, const Shp_ptr& b)
-            {
-              if (a->get_sibling_order() != b->get_sibling_order())
-                return a->get_sibling_order() < b->get_sibling_order();
-              return a->get_id() < b->get_id();
-            });
-  return kids;
+  return found->second;
 }
 
 std::vector<Shp_ptr> Occt_view::shape_descendant_solids(Shape_id id) const
@@ -1171,8 +1272,9 @@ std::vector<Shp_ptr> Occt_view::shape_descendant_solids(Shape_id id) const
       continue;
     }
 
-    for (const Shp_ptr& c : shape_children(n->get_id()))
-      stack.push_back(c);
+    auto kids = m_shp_children.find(n->get_id());
+    if (kids != m_shp_children.end())
+      stack.insert(stack.end(), kids->second.begin(), kids->second.end());
   }
   return out;
 }
@@ -1221,8 +1323,11 @@ void Occt_view::apply_shape_link(Shape_id id, Shape_id parent_id, int sibling_or
   if (shp.IsNull())
     return;
 
+  unlink_child_(shp);
   shp->set_parent_id(parent_id);
   shp->set_sibling_order(sibling_order);
+  link_child_(shp);
+  ++m_doc_tree_rev;
 }
 
 Shp_ptr Occt_view::create_group(const std::string& name, Shape_id parent_id)
@@ -1276,7 +1381,7 @@ Status Occt_view::group_shapes(const std::vector<Shp_ptr>& nodes)
     links.push_back(ch);
   }
 
-  m_shps.push_back(grp);
+  push_shp_(grp);
   for (const Shape_tree_delta::Link_change& ch : links)
     apply_shape_link(ch.id, ch.new_parent, ch.new_order);
 
@@ -1297,9 +1402,8 @@ Status Occt_view::ungroup_shape(Shape_id group_id)
 
   // Snapshot every direct child id up front (all must move one level up).
   std::vector<Shape_id> kid_ids;
-  kid_ids.reserve(m_shps.size());
-  for (const Shp_ptr& s : m_shps)
-    if (!s.IsNull() && s->get_id() != group_id && s->get_parent_id() == group_id)
+  for (const Shp_ptr& s : shape_children(group_id))
+    if (s->get_id() != group_id)
       kid_ids.push_back(s->get_id());
 
   std::vector<Shape_tree_delta::Link_change> links;
@@ -1385,6 +1489,12 @@ Status Occt_view::reparent_shape(Shape_id id, Shape_id new_parent, int sibling_o
 }
 
 void Occt_view::insert_shape_rec(const Shape_rec& rec)
+{
+  insert_shape_rec_(rec);
+  sync_sketch_shape_faint_style();
+}
+
+void Occt_view::insert_shape_rec_(const Shape_rec& rec)
 {
   Shp_ptr shp;
   if (rec.is_group)
@@ -1393,7 +1503,7 @@ void Occt_view::insert_shape_rec(const Shape_rec& rec)
   }
   else
   {
-    shp               = new Shp(*m_ctx, rec.geom);
+    shp               = rec.deferred_geom ? new Shp(*m_ctx, rec.deferred_geom, rec.frame) : new Shp(*m_ctx, rec.geom);
     const int nmat    = Graphic3d_MaterialAspect::NumberOfMaterials();
     int       mat_idx = rec.material;
     if (mat_idx < 0 || mat_idx >= nmat)
@@ -1414,29 +1524,25 @@ void Occt_view::insert_shape_rec(const Shape_rec& rec)
   if (shp->get_visible() != rec.visible)
     shp->set_visible(rec.visible);
 
-  m_shps.push_back(shp);
-  sync_sketch_shape_faint_style();
+  push_shp_(shp);
 }
 
 void Occt_view::remove_shape_by_id(Shape_id id)
 {
-  for (auto it = m_shps.begin(); it != m_shps.end(); ++it)
-  {
-    if ((*it).IsNull() || (*it)->get_id() != id)
-      continue;
+  auto found = m_shp_by_id.find(id);
+  if (found == m_shp_by_id.end())
+    return;
 
-    Shp_ptr shp = *it;
-    if (m_shape_list_hover == shp)
-      set_shape_list_hover(nullptr);
+  Shp_ptr shp = *found->second;
+  if (m_shape_list_hover == shp)
+    set_shape_list_hover(nullptr);
 
-    if (!shp->is_group())
-      m_ctx->Remove(shp, false);
+  if (!shp->is_group())
+    m_ctx->Remove(shp, false);
 
-    m_shps.erase(it);
-    ensure_current_group_valid_();
-    m_ctx->UpdateCurrentViewer();
-    return;
-  }
+  erase_shp_(found->second);
+  ensure_current_group_valid_();
+  m_ctx->UpdateCurrentViewer();
 }
 
 void Occt_view::set_shape_geom_by_id(Shape_id id, const TopoDS_Shape& geom, const gp_Ax3& frame)
@@ -1457,6 +1563,7 @@ void Occt_view::undo_insert_sketch(const nlohmann::json& sketch_json, bool make_
 {
   Sketch_ptr sketch = Sketch_json::from_json(*this, sketch_json);
   m_sketches.push_back(sketch);
+  ++m_doc_tree_rev;
   if (make_current)
   {
     m_cur_sketch = sketch;
@@ -1487,6 +1594,7 @@ void Occt_view::undo_remove_sketch(size_t sketch_id)
       set_sketch_list_hover_node(nullptr, SIZE_MAX);
 
     m_sketches.erase(it);
+    ++m_doc_tree_rev;
     if (m_cur_sketch == sketch)
     {
       if (m_sketches.empty())
@@ -1829,6 +1937,7 @@ void Occt_view::set_project_unit(Project_unit unit)
     return;
 
   m_project_unit = unit;
+  ++m_doc_edit_rev; // Snapshots always capture the unit; no record is dirty
   refresh_sketch_annotations({.length_dimensions = true});
 }
 
@@ -1928,10 +2037,11 @@ Shape_rec Occt_view::capture_clipboard_shape_rec_(const Shp& shp) const
   if (!rec.is_group)
   {
     // Bake AIS local transform, then deep-copy so clipboard never shares TShape with the document.
-    const TopoDS_Shape&      s  = shp.Shape();
-    const gp_Trsf&           tr = shp.LocalTransformation();
-    BRepBuilderAPI_Transform transformer(s, tr, true);
-    BRepBuilderAPI_Copy      copier(transformer.Shape());
+    const TopoDS_Shape&      s         = shp.Shape();
+    const gp_Trsf&           tr        = shp.LocalTransformation();
+    const bool               mesh_only = has_mesh_only_faces(s);
+    BRepBuilderAPI_Transform transformer(s, tr, true, mesh_only);
+    BRepBuilderAPI_Copy      copier(transformer.Shape(), true, mesh_only);
     rec.geom = copier.Shape();
     if (tr.Form() != gp_Identity)
       rec.frame.Transform(tr);
@@ -2139,7 +2249,7 @@ Status Occt_view::paste_clipboard_shapes()
       if (rec.geom.IsNull())
         return Status::user_error("Clipboard solid has no geometry.");
 
-      BRepBuilderAPI_Copy copier(rec.geom);
+      BRepBuilderAPI_Copy copier(rec.geom, true, has_mesh_only_faces(rec.geom));
       rec.geom = copier.Shape();
       if (rec.geom.IsNull())
         return Status::user_error("Failed to copy solid geometry.");
@@ -2197,11 +2307,19 @@ void Occt_view::remove_selected_length_dimensions_from_sketches_()
   for (const PrsDim_LengthDimension_ptr& dim : selected_dims)
     for (Sketch_ptr& s : m_sketches)
       if (s->try_remove_length_dimension(dim.get()))
+      {
+        mark_sketch_dirty(s->get_id());
         break;
+      }
 }
 
 void Occt_view::delete_(std::vector<AIS_Shape_ptr>& to_delete)
 {
+  // Sketch items go without a delta of their own (the caller pushed a checkpoint), so flag their sketches.
+  for (const AIS_Shape_ptr& shp : to_delete)
+    if (const Sketch* owner = sketch_owner_of_list_ais_(shp))
+      mark_sketch_dirty(owner->get_id());
+
   for (AIS_Shape_ptr& shp : to_delete)
     try_remove_sketch_permanent_node_mark(shp.get());
 
@@ -2211,7 +2329,7 @@ void Occt_view::delete_(std::vector<AIS_Shape_ptr>& to_delete)
 
   for (auto itr = m_shps.begin(); itr != m_shps.end();)
     if (std::find(to_delete.begin(), to_delete.end(), *itr) != to_delete.end())
-      itr = m_shps.erase(itr);
+      itr = erase_shp_(itr);
     else
       ++itr;
 
@@ -2748,7 +2866,12 @@ void Occt_view::select_shps_intersecting_screen_rect_(int xmin, int ymin, int xm
 void Occt_view::do_frame()
 {
   flush_view_events();
-  if (!m_view.IsNull())
+  if (m_view.IsNull())
+    return;
+
+  if (std::exchange(m_viewer_update_pending, false))
+    m_ctx->UpdateCurrentViewer();
+  else
     m_view->Redraw();
 }
 
@@ -3748,6 +3871,7 @@ void Occt_view::remove_sketch(const Sketch_ptr& sketch)
   const nlohmann::json removed_json = Sketch_json::to_json(*sketch, m_assets);
 
   m_sketches.remove(sketch);
+  ++m_doc_tree_rev;
   std::optional<nlohmann::json> auto_default;
   if (m_cur_sketch == sketch)
   {
@@ -3826,12 +3950,14 @@ void Occt_view::set_dynamic_highlight_enabled(bool enabled)
 }
 
 // ---------------------------------------------------------------------------
-// Undo / redo: interactive edits use typed deltas; JSON snapshots for mixed delete / file open.
+// Undo / redo: interactive edits use typed deltas; shared-record checkpoints for mixed delete / file open.
 namespace
 {
 /// Move/Rotate/Scale follow the mouse while active. Restoring those modes on undo/redo would
 /// immediately drag whatever is selected; use the tool's parent mode instead.
 Mode mode_for_history_restore_(Mode mode);
+/// True when a checkpoint record for \a a can stand in for \a b (same attrs and the same TShape / location).
+bool same_shape_rec_(const Shape_rec& a, const Shape_rec& b);
 } // namespace
 
 void Occt_view::push_undo_snapshot()
@@ -3839,13 +3965,10 @@ void Occt_view::push_undo_snapshot()
   if (m_restoring)
     return;
 
-  m_redo_stack.clear();
   Undo_entry entry;
-  entry.json = to_json();
-  entry.mode = m_gui.get_mode();
-  m_undo_stack.push_back(std::move(entry));
-  if (m_undo_stack.size() > k_max_undo)
-    m_undo_stack.erase(m_undo_stack.begin());
+  entry.checkpoint = capture_checkpoint_();
+  entry.mode       = m_gui.get_mode();
+  push_undo_entry_(std::move(entry));
 }
 
 void Occt_view::push_undo_delta(std::unique_ptr<Delta> delta)
@@ -3853,13 +3976,10 @@ void Occt_view::push_undo_delta(std::unique_ptr<Delta> delta)
   if (m_restoring || !delta)
     return;
 
-  m_redo_stack.clear();
   Undo_entry entry;
   entry.delta = std::move(delta);
   entry.mode  = m_gui.get_mode();
-  m_undo_stack.push_back(std::move(entry));
-  if (m_undo_stack.size() > k_max_undo)
-    m_undo_stack.erase(m_undo_stack.begin());
+  push_undo_entry_(std::move(entry));
 }
 
 void Occt_view::pop_undo_snapshot()
@@ -3878,19 +3998,24 @@ bool Occt_view::undo()
   m_restoring      = true;
   Undo_entry state = std::move(m_undo_stack.back());
   m_undo_stack.pop_back();
+  note_doc_edit_(state);
 
   Undo_entry redo_entry;
   redo_entry.mode = m_gui.get_mode();
 
   if (state.delta)
   {
-    redo_entry.delta = state.delta->clone();
+    // A delta describes both directions, so the same object moves to the redo stack.
     state.delta->apply_reverse(*this);
+    redo_entry.delta = std::move(state.delta);
+    redo_entry.bytes = state.bytes;
+    redo_entry.geom  = std::move(state.geom);
   }
   else
   {
-    redo_entry.json = to_json();
-    load(state.json, false); // Keep current view so undo/redo keeps a single perspective
+    redo_entry.checkpoint = capture_checkpoint_();
+    measure_undo_entry_(redo_entry);
+    restore_checkpoint_(*state.checkpoint); // Camera untouched so undo/redo keeps a single perspective
   }
 
   m_redo_stack.push_back(std::move(redo_entry));
@@ -3911,19 +4036,23 @@ bool Occt_view::redo()
   m_restoring      = true;
   Undo_entry state = std::move(m_redo_stack.back());
   m_redo_stack.pop_back();
+  note_doc_edit_(state);
 
   Undo_entry undo_entry;
   undo_entry.mode = m_gui.get_mode();
 
   if (state.delta)
   {
-    undo_entry.delta = state.delta->clone();
     state.delta->apply_forward(*this);
+    undo_entry.delta = std::move(state.delta);
+    undo_entry.bytes = state.bytes;
+    undo_entry.geom  = std::move(state.geom);
   }
   else
   {
-    undo_entry.json = to_json();
-    load(state.json, false); // Keep current view so undo/redo keeps a single perspective
+    undo_entry.checkpoint = capture_checkpoint_();
+    measure_undo_entry_(undo_entry);
+    restore_checkpoint_(*state.checkpoint); // Camera untouched so undo/redo keeps a single perspective
   }
 
   m_undo_stack.push_back(std::move(undo_entry));
@@ -3942,53 +4071,319 @@ bool Occt_view::can_redo() const { return !m_redo_stack.empty(); }
 size_t Occt_view::undo_stack_size() const { return m_undo_stack.size(); }
 size_t Occt_view::redo_stack_size() const { return m_redo_stack.size(); }
 
+size_t Occt_view::undo_memory_bytes() const
+{
+  // Geometry the document still shows is not history overhead; anything else is counted once per TShape. Shapes not
+  // read yet from a lazy load hold no geometry and are skipped rather than read.
+  std::unordered_set<const TopoDS_TShape*> counted;
+  for (const Shp_ptr& shp : m_shps)
+    if (!shp->is_group() && !shp->deferred_geom() && !shp->Shape().IsNull())
+      counted.insert(shp->Shape().TShape().get());
+
+  size_t bytes = 0;
+  for (const std::vector<Undo_entry>* stack : {&m_undo_stack, &m_redo_stack})
+    for (const Undo_entry& entry : *stack)
+    {
+      bytes += entry.bytes;
+      for (const auto& [tshape, geom_bytes] : entry.geom)
+        if (counted.insert(tshape).second)
+          bytes += geom_bytes;
+    }
+
+  return bytes;
+}
+
+void Occt_view::set_undo_budget_bytes(size_t bytes)
+{
+  m_undo_budget_bytes = bytes;
+  if (!m_restoring)
+    trim_undo_history_();
+}
+
+size_t Occt_view::undo_budget_bytes() const { return m_undo_budget_bytes; }
+
+std::shared_ptr<const Doc_checkpoint> Occt_view::capture_checkpoint_()
+{
+  auto checkpoint  = std::make_shared<Doc_checkpoint>();
+  checkpoint->unit = m_project_unit;
+
+  // Unchanged shapes and sketches reuse the previous checkpoint's records instead of new copies.
+  const std::shared_ptr<const Doc_checkpoint>                     prev = m_last_checkpoint.lock();
+  std::unordered_map<Shape_id, const Doc_checkpoint::Shape_slot*> prev_slots;
+  if (prev)
+    for (const Doc_checkpoint::Shape_slot& slot : prev->shapes)
+      prev_slots.emplace(slot.rec->id, &slot);
+
+  checkpoint->shapes.reserve(m_shps.size());
+  for (const Shp_ptr& shp : m_shps)
+  {
+    Shape_rec  rec   = capture_shape_rec(*shp);
+    const auto found = prev_slots.find(rec.id);
+    if (found != prev_slots.end() && same_shape_rec_(*found->second->rec, rec))
+    {
+      checkpoint->shapes.push_back(*found->second);
+      continue;
+    }
+
+    Doc_checkpoint::Shape_slot slot;
+    slot.geom_bytes = rec.is_group ? 0 : approx_shape_bytes(rec.geom);
+    slot.rec        = std::make_shared<const Shape_rec>(std::move(rec));
+    checkpoint->shapes.push_back(std::move(slot));
+  }
+
+  // Sketches reuse the previous dump unless an edit since that capture touched them (same tracking as autosave); the
+  // current one may hold edits no delta reported yet, so it is always dumped.
+  std::unordered_map<size_t, const Doc_checkpoint::Sketch_slot*> prev_sketches;
+  if (prev && !m_checkpoint_dirty.all)
+    for (const Doc_checkpoint::Sketch_slot& slot : prev->sketches)
+      prev_sketches.emplace(slot.id, &slot);
+
+  checkpoint->current_sketch_id = m_cur_sketch ? m_cur_sketch->get_id() : 0;
+  checkpoint->sketches.reserve(m_sketches.size());
+  for (const Sketch_ptr& s : m_sketches)
+  {
+    const auto found = prev_sketches.find(s->get_id());
+    if (found != prev_sketches.end() && s != m_cur_sketch && !m_checkpoint_dirty.sketches.contains(s->get_id()))
+    {
+      checkpoint->sketches.push_back(*found->second);
+      continue;
+    }
+
+    nlohmann::json j = Sketch_json::to_json(*s, m_assets);
+    j.erase("isCurrent");
+    checkpoint->sketches.push_back({s->get_id(), std::make_shared<const std::string>(j.dump())});
+  }
+
+  m_checkpoint_dirty.clear();
+  m_last_checkpoint = checkpoint;
+  return checkpoint;
+}
+
+void Occt_view::restore_checkpoint_(const Doc_checkpoint& checkpoint)
+{
+  for (AIS_Shape_ptr& s : m_shps)
+    m_ctx->Remove(s, false);
+
+  clear_all(m_sketches, m_cur_sketch, m_shps);
+  clear_shp_index_();
+  m_project_unit = checkpoint.unit;
+
+  for (const Doc_checkpoint::Sketch_slot& slot : checkpoint.sketches)
+  {
+    nlohmann::json j = nlohmann::json::parse(*slot.json);
+    j["isCurrent"]   = slot.id == checkpoint.current_sketch_id;
+    m_sketches.push_back(Sketch_json::from_json(*this, j));
+    ++m_doc_tree_rev;
+    if (slot.id == checkpoint.current_sketch_id)
+      m_cur_sketch = m_sketches.back();
+  }
+
+  ensure_current_sketch_();
+
+  // Records hold the geometry itself, so no BREP parsing; shape ids are kept as recorded.
+  for (const Doc_checkpoint::Shape_slot& slot : checkpoint.shapes)
+    insert_shape_rec_(*slot.rec);
+
+  ensure_current_group_valid_();
+  sync_sketch_shape_faint_style();
+  if (m_cur_sketch)
+  {
+    m_cur_sketch->set_current();
+    refresh_viewer_grid_();
+  }
+
+  m_checkpoint_dirty.all = true; // Every sketch was rebuilt from another state
+  m_ctx->UpdateCurrentViewer();
+}
+
+void Occt_view::measure_undo_entry_(Undo_entry& entry)
+{
+  std::unordered_set<const TopoDS_TShape*> seen;
+  entry.geom.clear();
+  if (entry.delta)
+  {
+    entry.bytes = entry.delta->approx_bytes();
+    std::vector<TopoDS_Shape> shapes;
+    entry.delta->collect_geometry(shapes);
+    for (const TopoDS_Shape& shape : shapes)
+      if (!shape.IsNull() && seen.insert(shape.TShape().get()).second)
+        entry.geom.emplace_back(shape.TShape().get(), approx_shape_bytes(shape));
+
+    return;
+  }
+
+  EZY_ASSERT(entry.checkpoint);
+  entry.bytes = entry.checkpoint->approx_bytes();
+  for (const Doc_checkpoint::Shape_slot& slot : entry.checkpoint->shapes)
+  {
+    const TopoDS_Shape& shape = slot.rec->geom;
+    if (!shape.IsNull() && seen.insert(shape.TShape().get()).second)
+      entry.geom.emplace_back(shape.TShape().get(), slot.geom_bytes);
+  }
+}
+
+void Occt_view::push_undo_entry_(Undo_entry entry)
+{
+  measure_undo_entry_(entry);
+  note_doc_edit_(entry);
+  m_redo_stack.clear();
+  m_undo_stack.push_back(std::move(entry));
+  trim_undo_history_();
+}
+
+void Occt_view::trim_undo_history_()
+{
+  if (m_undo_stack.size() > k_max_undo)
+    m_undo_stack.erase(m_undo_stack.begin(), m_undo_stack.end() - static_cast<std::ptrdiff_t>(k_max_undo));
+
+  if (m_undo_stack.size() <= 1)
+    return;
+
+  // Same accounting as `undo_memory_bytes`, kept as a running total: each geometry counts once while any step still
+  // holds it, so dropping a step subtracts its payload and the geometry only it held.
+  std::unordered_set<const TopoDS_TShape*> shown;
+  for (const Shp_ptr& shp : m_shps)
+    if (!shp->is_group() && !shp->deferred_geom() && !shp->Shape().IsNull())
+      shown.insert(shp->Shape().TShape().get());
+
+  std::unordered_map<const TopoDS_TShape*, std::pair<size_t, size_t>> held; // (steps holding it, bytes)
+  size_t                                                              bytes = 0;
+  for (const std::vector<Undo_entry>* stack : {&m_undo_stack, &m_redo_stack})
+    for (const Undo_entry& entry : *stack)
+    {
+      bytes += entry.bytes;
+      for (const auto& [tshape, geom_bytes] : entry.geom)
+        if (!shown.contains(tshape))
+        {
+          const auto [itr, added] = held.try_emplace(tshape, 0, geom_bytes);
+          if (added)
+            bytes += geom_bytes;
+
+          ++itr->second.first;
+        }
+    }
+
+  // The newest step always survives so the last edit stays undoable even when it alone exceeds the budget.
+  size_t dropped = 0;
+  while (m_undo_stack.size() - dropped > 1 && bytes > m_undo_budget_bytes)
+  {
+    const Undo_entry& entry = m_undo_stack[dropped++];
+    bytes -= entry.bytes;
+    for (const auto& item : entry.geom)
+      if (const auto itr = held.find(item.first); itr != held.end() && --itr->second.first == 0)
+      {
+        bytes -= itr->second.second;
+        held.erase(itr);
+      }
+  }
+
+  m_undo_stack.erase(m_undo_stack.begin(), m_undo_stack.begin() + static_cast<std::ptrdiff_t>(dropped));
+}
+
+void Occt_view::note_doc_edit_(const Undo_entry& entry)
+{
+  if (entry.delta)
+  {
+    entry.delta->collect_dirty(m_doc_dirty);
+    entry.delta->collect_dirty(m_checkpoint_dirty);
+  }
+  else
+    m_doc_dirty.all = true; // Checkpoints restore (or precede) whole-document changes; see `m_checkpoint_dirty`
+
+  ++m_doc_edit_rev;
+}
+
+void Occt_view::reset_doc_snapshot_()
+{
+  m_doc_dirty.clear();
+  m_doc_dirty.all = true;
+  m_last_doc_snapshot.reset();
+}
+
 // ---------------------------------------------------------------------------
-// Document format: 1 = legacy sketch edges could carry a 4th "dim" flag; 2 = length_dimensions array + 3-tuple edges.
+// Document format: 1 = legacy sketch edges could carry a 4th "dim" flag; 2 = length_dimensions array + 3-tuple edges;
+// 3 = zip archive with underlay assets; 4 = geometry in binary `geom/<id>.brep` entries referenced by "geomRef".
 namespace
 {
-constexpr int k_ezy_file_format_version = 3;
-}
+constexpr int k_ezy_file_format_version        = 3;
+constexpr int k_ezy_binary_geom_format_version = 4;
+
+bool is_group_json_(const nlohmann::json& shape_json);
+/// True when a lazy load from `archive` leaves the shape's geometry unread: the entry must exist and the frame be
+/// saved, since computing a default frame needs the geometry.
+bool defers_shape_geom_(const nlohmann::json& shape_json, const Ezy_archive* archive);
+/// Inline BRep text (v1-v3) or the referenced binary entry (v4); null when missing or unreadable. Worker-thread safe.
+TopoDS_Shape decode_shape_geom_(const nlohmann::json& shape_json, const Ezy_geom_reader& read_geom);
+/// Manifest entry of `rec` without its geometry ("geom" / "geomRef" are added by the writer).
+nlohmann::json shape_rec_json_(const Shape_rec& rec);
+/// Copy of document geometry that no UI-thread edit reaches: display and export meshing add triangulations to the
+/// document's TFace / TEdge in place, so a worker must not encode the original.
+TopoDS_Shape snapshot_geom_(const TopoDS_Shape& geom);
+} // namespace
 
 // ---------------------------------------------------------------------------
-std::string Occt_view::to_json() const
+std::string Occt_view::to_json(Ezy_geom_entries* geoms) const { return to_json_(geoms, nullptr); }
+
+std::string Occt_view::to_json(Ezy_geom_source& geoms) const
+{
+  auto              faces    = std::make_shared<Ezy_geom_entries>();
+  auto              shapes   = std::make_shared<std::unordered_map<std::string, TopoDS_Shape>>();
+  const std::string manifest = to_json_(faces.get(), shapes.get());
+  geoms.ids.clear();
+  for (const auto& g : *faces)
+    geoms.ids.push_back(g.first);
+
+  for (const auto& g : *shapes)
+    geoms.ids.push_back(g.first);
+
+  std::sort(geoms.ids.begin(), geoms.ids.end());
+  geoms.read = [faces, shapes](const std::string& geom_id) -> std::optional<std::string>
+  {
+    if (const auto face = faces->find(geom_id); face != faces->end())
+      return face->second;
+
+    return write_brep_binary(shapes->at(geom_id));
+  };
+
+  return manifest;
+}
+
+std::string Occt_view::to_json_(Ezy_geom_entries* geoms, std::unordered_map<std::string, TopoDS_Shape>* shape_geoms) const
 {
   using namespace nlohmann;
   json j;
-  j["ezyFormat"]   = k_ezy_file_format_version;
+  j["ezyFormat"]   = geoms ? k_ezy_binary_geom_format_version : k_ezy_file_format_version;
   j["projectUnit"] = (m_project_unit == Project_unit::Millimeter) ? "millimeter" : "inch";
   json& sketches = j["sketches"] = json::array();
   json& shps = j["shapes"] = json::array();
 
-  const auto pnt_to_json = [](double x, double y, double z)
-  {
-    return ::to_json(gp_Pnt(x, y, z));
-  };
-
   // ---------------------------------------------------------------------------
   // Sketches / shapes
   for (const Sketch_ptr& s : m_sketches)
-    sketches.push_back(Sketch_json::to_json(*s, m_assets));
+    sketches.push_back(Sketch_json::to_json(*s, m_assets, geoms));
 
   for (const Shp_ptr& s : m_shps)
   {
-    json shp_json;
-    shp_json["id"]       = s->get_id();
-    shp_json["name"]     = s->get_name();
-    shp_json["parentId"] = s->get_parent_id();
-    shp_json["order"]    = s->get_sibling_order();
-    shp_json["visible"]  = s->get_visible();
-    if (s->is_group())
-    {
-      shp_json["isGroup"] = true;
-    }
-    else
+    json shp_json = shape_rec_json_(capture_shape_rec(*s));
+    if (!s->is_group())
     {
       const TopoDS_Shape& shape = s->Shape();
-      std::ostringstream  oss;
-      BRepTools::Write(shape, oss, false, false, TopTools_FormatVersion_CURRENT);
-      shp_json["material"] = s->Material();
-      shp_json["geom"]     = oss.str();
-      shp_json["frame"]    = ::to_json(gp_Pln(s->get_frame()));
+      if (geoms)
+      {
+        const std::string ref = std::to_string(s->get_id());
+        if (shape_geoms)
+          (*shape_geoms)[ref] = shape;
+        else
+          (*geoms)[ref] = write_brep_binary(shape);
+
+        shp_json["geomRef"] = ref;
+      }
+      else
+      {
+        std::ostringstream oss;
+        BRepTools::Write(shape, oss, has_mesh_only_faces(shape), false, TopTools_FormatVersion_CURRENT);
+        shp_json["geom"] = oss.str();
+      }
     }
     shps.push_back(shp_json);
   }
@@ -3996,41 +4391,349 @@ std::string Occt_view::to_json() const
   // ---------------------------------------------------------------------------
   // View / camera state
   if (!m_view.IsNull())
+    j["view"] = view_to_json_();
+
+  return j.dump(2);
+}
+
+nlohmann::json Occt_view::view_to_json_() const
+{
+  using namespace nlohmann;
+  const auto pnt_to_json = [](double x, double y, double z)
+  {
+    return ::to_json(gp_Pnt(x, y, z));
+  };
+
+  json view_json;
+
+  // Eye and target (At) positions
+  double eye_x, eye_y, eye_z;
+  double at_x, at_y, at_z;
+  m_view->Eye(eye_x, eye_y, eye_z);
+  m_view->At(at_x, at_y, at_z);
+
+  view_json["eye"] = pnt_to_json(eye_x, eye_y, eye_z);
+  view_json["at"]  = pnt_to_json(at_x, at_y, at_z);
+
+  // Up and projection directions
+  double up_x, up_y, up_z;
+  double proj_x, proj_y, proj_z;
+  m_view->Up(up_x, up_y, up_z);
+  m_view->Proj(proj_x, proj_y, proj_z);
+
+  view_json["up"]   = ::to_json(gp_Dir(up_x, up_y, up_z));
+  view_json["proj"] = ::to_json(gp_Dir(proj_x, proj_y, proj_z));
+
+  // View scale (zoom level)
+  view_json["scale"] = m_view->Scale();
+  return view_json;
+}
+
+void Occt_view::mark_shape_dirty(Shape_id id)
+{
+  m_doc_dirty.shapes.insert(id);
+  ++m_doc_edit_rev;
+}
+
+void Occt_view::mark_sketch_dirty(size_t sketch_id)
+{
+  m_doc_dirty.sketches.insert(sketch_id);
+  m_checkpoint_dirty.sketches.insert(sketch_id);
+  ++m_doc_edit_rev;
+}
+
+std::shared_ptr<const Doc_snapshot> Occt_view::capture_doc_snapshot()
+{
+  auto snapshot               = std::make_shared<Doc_snapshot>();
+  snapshot->unit              = m_project_unit;
+  snapshot->current_sketch_id = m_cur_sketch ? m_cur_sketch->get_id() : 0;
+  snapshot->assets            = m_assets;
+  if (!m_view.IsNull())
+    snapshot->view = view_to_json_();
+
+  // Clean records reuse the previous capture's slots; only dirty ones are captured again.
+  const std::shared_ptr<const Doc_snapshot> prev = m_doc_dirty.all ? nullptr : m_last_doc_snapshot;
+  std::unordered_map<Shape_id, const std::shared_ptr<const Doc_snapshot::Shape_slot>*> prev_shapes;
+  std::unordered_map<size_t, const std::shared_ptr<const Doc_snapshot::Sketch_slot>*>  prev_sketches;
+  if (prev)
   {
-    json& view_json = j["view"];
+    for (const std::shared_ptr<const Doc_snapshot::Shape_slot>& slot : prev->shapes)
+      prev_shapes.emplace(slot->rec.id, &slot);
 
-    // Eye and target (At) positions
-    double eye_x, eye_y, eye_z;
-    double at_x, at_y, at_z;
-    m_view->Eye(eye_x, eye_y, eye_z);
-    m_view->At(at_x, at_y, at_z);
+    for (const std::shared_ptr<const Doc_snapshot::Sketch_slot>& slot : prev->sketches)
+      prev_sketches.emplace(slot->id, &slot);
+  }
+
+  snapshot->shapes.reserve(m_shps.size());
+  for (const Shp_ptr& shp : m_shps)
+  {
+    const auto found = prev_shapes.find(shp->get_id());
+    if (found != prev_shapes.end() && !m_doc_dirty.shapes.contains(shp->get_id()))
+    {
+      snapshot->shapes.push_back(*found->second);
+      continue;
+    }
+
+    auto slot = std::make_shared<Doc_snapshot::Shape_slot>();
+    slot->rec = capture_shape_rec(*shp);
+    // The pending geometry object is UI-thread only: keep its decoded shape or a copy of its reader instead.
+    if (const Shp_deferred_geom_ptr geom = std::move(slot->rec.deferred_geom))
+    {
+      if (geom->loaded())
+        slot->rec.geom = geom->get();
+      else
+        slot->read_pending = geom->reader();
+    }
+
+    // The worker encodes a private copy; the slot is reused while the shape stays clean, so it is copied once per edit.
+    slot->rec.geom = snapshot_geom_(slot->rec.geom);
+
+    snapshot->shapes.push_back(std::move(slot));
+  }
 
-    view_json["eye"] = pnt_to_json(eye_x, eye_y, eye_z);
-    view_json["at"]  = pnt_to_json(at_x, at_y, at_z);
+  snapshot->sketches.reserve(m_sketches.size());
+  for (const Sketch_ptr& s : m_sketches)
+  {
+    const auto found = prev_sketches.find(s->get_id());
+    if (found != prev_sketches.end() && s != m_cur_sketch && !m_doc_dirty.sketches.contains(s->get_id()))
+    {
+      snapshot->sketches.push_back(*found->second);
+      continue;
+    }
+
+    auto slot  = std::make_shared<Doc_snapshot::Sketch_slot>();
+    slot->id   = s->get_id();
+    slot->json = Sketch_json::to_json(*s, m_assets, &slot->geoms);
+    slot->json.erase("isCurrent");
+    snapshot->sketches.push_back(std::move(slot));
+  }
 
-    // Up and projection directions
-    double up_x, up_y, up_z;
-    double proj_x, proj_y, proj_z;
-    m_view->Up(up_x, up_y, up_z);
-    m_view->Proj(proj_x, proj_y, proj_z);
+  m_doc_dirty.clear();
+  m_last_doc_snapshot = snapshot;
+  return snapshot;
+}
 
-    view_json["up"]   = ::to_json(gp_Dir(up_x, up_y, up_z));
-    view_json["proj"] = ::to_json(gp_Dir(proj_x, proj_y, proj_z));
+std::string Occt_view::doc_snapshot_to_json(const Doc_snapshot& snapshot, Ezy_geom_source& geoms)
+{
+  using namespace nlohmann;
+  json j;
+  j["ezyFormat"]   = k_ezy_binary_geom_format_version;
+  j["projectUnit"] = (snapshot.unit == Project_unit::Millimeter) ? "millimeter" : "inch";
+  json& sketches = j["sketches"] = json::array();
+  json& shps = j["shapes"] = json::array();
 
-    // View scale (zoom level)
-    view_json["scale"] = m_view->Scale();
+  // Entries point into `snapshot`, which outlives the write (`Doc_autosave` keeps it until the job is collected).
+  std::unordered_map<std::string, const std::string*>               faces;
+  std::unordered_map<std::string, const Doc_snapshot::Shape_slot*> slots;
+  for (const std::shared_ptr<const Doc_snapshot::Sketch_slot>& slot : snapshot.sketches)
+  {
+    json& sketch_json        = sketches.emplace_back(slot->json);
+    sketch_json["isCurrent"] = slot->id == snapshot.current_sketch_id;
+    for (const auto& g : slot->geoms)
+      faces.emplace(g.first, &g.second);
   }
 
+  for (const std::shared_ptr<const Doc_snapshot::Shape_slot>& slot : snapshot.shapes)
+  {
+    const Shape_rec& rec      = slot->rec;
+    json             shp_json = shape_rec_json_(rec);
+    if (!rec.is_group)
+    {
+      const std::string ref = std::to_string(rec.id);
+      slots.emplace(ref, slot.get());
+      shp_json["geomRef"] = ref;
+    }
+    shps.push_back(std::move(shp_json));
+  }
+
+  geoms.ids.clear();
+  for (const auto& g : faces)
+    geoms.ids.push_back(g.first);
+
+  for (const auto& g : slots)
+    geoms.ids.push_back(g.first);
+
+  std::sort(geoms.ids.begin(), geoms.ids.end());
+  geoms.read = [faces = std::move(faces), slots = std::move(slots)](const std::string& geom_id) -> std::optional<std::string>
+  {
+    if (const auto face = faces.find(geom_id); face != faces.end())
+      return *face->second;
+
+    // Pending entries are copied as read from the source archive; nothing to decode. A failed read leaves the entry
+    // out, and the shape is dropped when the recovery file is opened.
+    const Doc_snapshot::Shape_slot& slot = *slots.at(geom_id);
+    if (slot.read_pending)
+      return slot.read_pending();
+
+    return write_brep_binary(slot.rec.geom);
+  };
+
+  if (!snapshot.view.is_null())
+    j["view"] = snapshot.view;
+
   return j.dump(2);
 }
 
-void Occt_view::load(const std::string& json_str, bool restore_view)
+void Occt_view::load(const std::string& json_str, bool restore_view, const Ezy_geom_entries* geoms)
+{
+  Project_load_geom geom;
+  if (Status st = prepare_load(json_str, geom_reader(geoms), nullptr, geom); !st.is_ok())
+  {
+    m_gui.log_message(st.message());
+    return;
+  }
+
+  commit_load(geom, restore_view);
+}
+
+void Occt_view::load_lazy(const std::string& json_str, const std::shared_ptr<const Ezy_archive>& archive, bool restore_view)
+{
+  EZY_ASSERT(archive);
+  Project_load_geom geom;
+  if (Status st = prepare_load(json_str, geom_reader(archive), archive, geom); !st.is_ok())
+  {
+    m_gui.log_message(st.message());
+    return;
+  }
+
+  commit_load(geom, restore_view);
+}
+
+void Occt_view::load_deferred()
+{
+  for (const std::weak_ptr<Shp_deferred_geom>& weak : m_deferred_geoms)
+    if (const Shp_deferred_geom_ptr geom = weak.lock())
+      (void)geom->get();
+
+  m_deferred_geoms.clear();
+  for (const Shp_ptr& shp : m_shps)
+    if (shp->deferred_geom())
+      (void)shp->Shape();
+
+  m_assets.load_pending();
+  // Snapshot slots of still-unread shapes hold readers over the archive too.
+  reset_doc_snapshot_();
+}
+
+size_t Occt_view::deferred_shape_count() const
+{
+  return static_cast<size_t>(
+      std::count_if(m_shps.begin(), m_shps.end(), [](const Shp_ptr& shp) { return shp->deferred_geom() != nullptr; }));
+}
+
+Ezy_geom_reader Occt_view::geom_reader(const Ezy_geom_entries* geoms)
+{
+  if (!geoms)
+    return {};
+
+  return [geoms](const std::string& id) -> std::optional<std::string>
+  {
+    const auto it = geoms->find(id);
+    return it != geoms->end() ? std::optional<std::string>(it->second) : std::nullopt;
+  };
+}
+
+Ezy_geom_reader Occt_view::geom_reader(const std::shared_ptr<const Ezy_archive>& archive)
+{
+  if (!archive)
+    return {};
+
+  return [archive](const std::string& id) { return archive->read_geom(id); };
+}
+
+Status Occt_view::prepare_load(const std::string& json_str, const Ezy_geom_reader& read_geom,
+                               const std::shared_ptr<const Ezy_archive>& lazy_archive, Project_load_geom& out,
+                               const Atomic_progress_indicator_ptr& progress)
+{
+  using namespace nlohmann;
+  out              = {};
+  out.lazy_archive = lazy_archive;
+  if (!progress.IsNull())
+    progress->set_stage("Reading project...");
+
+  try
+  {
+    out.doc = json::parse(json_str);
+  }
+  catch (const json::exception& e)
+  {
+    return Status::user_error(std::string("Project: invalid JSON (") + e.what() + ").");
+  }
+
+  if (!out.doc.contains("sketches") || !out.doc["sketches"].is_array())
+    return Status::user_error("Project: no sketches array.");
+
+  if (!out.doc.contains("shapes") || !out.doc["shapes"].is_array())
+    out.doc["shapes"] = json::array();
+
+  const json& shapes   = out.doc["shapes"];
+  const json& sketches = out.doc["sketches"];
+  out.shapes.resize(shapes.size());
+  out.sketch_faces.resize(sketches.size());
+
+  // One work item per shape to decode, then one per sketch; groups and deferred shapes have nothing to decode.
+  std::vector<size_t> shape_items;
+  for (size_t i = 0; i < shapes.size(); ++i)
+    if (!is_group_json_(shapes[i]) && !defers_shape_geom_(shapes[i], lazy_archive.get()))
+      shape_items.push_back(i);
+
+  const size_t item_count = shape_items.size() + sketches.size();
+  if (!progress.IsNull())
+    progress->set_stage("Decoding geometry...");
+
+  // Ranges are taken up front in item order; closing one from a worker reports it (OCCT progress is thread-safe).
+  Message_ProgressScope              scope(progress.IsNull() ? Message_ProgressRange() : progress->Start(),
+                                           "Decoding geometry", static_cast<double>(std::max<size_t>(item_count, 1)));
+  std::vector<Message_ProgressRange> ranges;
+  ranges.reserve(item_count);
+  for (size_t i = 0; i < item_count; ++i)
+    ranges.push_back(scope.Next());
+
+  std::atomic<bool> cancel{false};
+  parallel_for_each_index(
+      item_count,
+      [&](size_t item)
+      {
+        if (!progress.IsNull() && progress->cancelled())
+        {
+          cancel.store(true);
+          return;
+        }
+
+        try
+        {
+          if (item < shape_items.size())
+            out.shapes[shape_items[item]] = decode_shape_geom_(shapes[shape_items[item]], read_geom);
+          else
+            out.sketch_faces[item - shape_items.size()] =
+                Sketch_json::read_originating_face(sketches[item - shape_items.size()], read_geom);
+        }
+        catch (...)
+        {
+          // Left null: commit skips the shape, or loads the sketch on its plane without the face.
+        }
+
+        ranges[item].Close();
+      },
+      &cancel);
+
+  if (cancel.load() || (!progress.IsNull() && progress->cancelled()))
+    return Status::user_error("Project: load cancelled.");
+
+  return Status::ok();
+}
+
+void Occt_view::commit_load(Project_load_geom& geom, bool restore_view)
 {
   using namespace nlohmann;
   for (AIS_Shape_ptr& s : m_shps)
     m_ctx->Remove(s, false);
 
   clear_all(m_sketches, m_cur_sketch, m_shps);
+  clear_shp_index_();
+  reset_doc_snapshot_();
+  m_checkpoint_dirty.all = true;
+  ++m_doc_edit_rev;
 
   if (!m_restoring)
   {
@@ -4039,8 +4742,10 @@ void Occt_view::load(const std::string& json_str, bool restore_view)
   }
 
   m_next_shape_id = 1;
+  std::erase_if(m_deferred_geoms, [](const std::weak_ptr<Shp_deferred_geom>& weak) { return weak.expired(); });
 
-  const json j = json::parse(json_str);
+  const json&                               j       = geom.doc;
+  const std::shared_ptr<const Ezy_archive>& archive = geom.lazy_archive;
   (void)j.value("ezyFormat", 1); // Reserved for future migrations; sketch JSON migrates per-edge dim flags in Sketch_json.
   m_project_unit = Project_unit::Inch;
   if (j.contains("projectUnit") && j["projectUnit"].is_string())
@@ -4050,9 +4755,11 @@ void Occt_view::load(const std::string& json_str, bool restore_view)
       m_project_unit = Project_unit::Millimeter;
   }
   EZY_ASSERT(j.contains("sketches") && j["sketches"].is_array());
-  for (const auto& s : j["sketches"])
+  for (size_t i = 0; i < j["sketches"].size(); ++i)
   {
-    m_sketches.push_back(Sketch_json::from_json(*this, s));
+    const json& s = j["sketches"][i];
+    m_sketches.push_back(Sketch_json::from_json(*this, s, geom.sketch_faces[i]));
+    ++m_doc_tree_rev;
     if (s["isCurrent"])
     {
       // if(m_cur_sketch)
@@ -4064,23 +4771,38 @@ void Occt_view::load(const std::string& json_str, bool restore_view)
 
   ensure_current_sketch_();
 
-  for (const json& s : j["shapes"])
+  for (size_t i = 0; i < j["shapes"].size(); ++i)
   {
-    const bool is_group = s.contains("isGroup") && s["isGroup"].is_boolean() && s["isGroup"].get<bool>();
-    Shp_ptr    shp;
+    const json& s        = j["shapes"][i];
+    const bool  is_group = is_group_json_(s);
+    Shp_ptr     shp;
     if (is_group)
     {
       shp = Shp::create_group(*m_ctx, s.value("name", "Group"));
     }
     else
     {
-      TopoDS_Shape       shape;
-      std::istringstream iss;
-      iss.str(s["geom"]);
-      BRepTools::Read(shape, iss, BRep_Builder());
-      shp = new Shp(*m_ctx, shape);
-      if (s.contains("frame") && s["frame"].is_object())
-        shp->set_frame(from_json_pln(s["frame"]).Position());
+      const bool has_frame = s.contains("frame") && s["frame"].is_object();
+      if (defers_shape_geom_(s, archive.get()))
+      {
+        const std::string ref      = s["geomRef"].get<std::string>();
+        auto              deferred = std::make_shared<Shp_deferred_geom>([archive, ref] { return archive->read_geom(ref); });
+        m_deferred_geoms.push_back(deferred);
+        shp = new Shp(*m_ctx, deferred, from_json_pln(s["frame"]).Position());
+      }
+      else if (geom.shapes[i].IsNull())
+      {
+        m_gui.log_message("Project load: missing or unreadable geometry for shape '" + s.value("name", std::string()) +
+                          "'; shape skipped.");
+        continue;
+      }
+      else
+      {
+        shp = new Shp(*m_ctx, geom.shapes[i]);
+        if (has_frame)
+          shp->set_frame(from_json_pln(s["frame"]).Position());
+      }
+
       int mat_idx = static_cast<int>(m_default_material.Name());
       if (s.contains("material") && s["material"].is_number_integer())
         mat_idx = s["material"].get<int>();
@@ -4115,7 +4837,7 @@ void Occt_view::load(const std::string& json_str, bool restore_view)
         shp->set_visible(vis);
     }
 
-    m_shps.push_back(shp);
+    push_shp_(shp);
   }
   sync_sketch_shape_faint_style();
 
@@ -4194,17 +4916,18 @@ double model_to_cad_mm_export_scale_(double dimension_scale);
 double model_to_inch_export_scale_(double dimension_scale);
 } // namespace
 
-TopoDS_Shape Occt_view::shape_with_local_transform_(const AIS_Shape_ptr& ais) const
+TopoDS_Shape Occt_view::shape_with_local_transform_(const Shp_ptr& shp) const
 {
-  if (ais.IsNull())
+  if (shp.IsNull())
     return {};
 
-  const TopoDS_Shape& s = ais->Shape();
+  // `Shp::Shape()` reads geometry a lazy load deferred, so hidden shapes still export.
+  const TopoDS_Shape& s = shp->Shape();
   if (s.IsNull())
     return {};
 
-  const gp_Trsf&           tr = ais->LocalTransformation();
-  BRepBuilderAPI_Transform transformer(s, tr, true);
+  const gp_Trsf&           tr = shp->LocalTransformation();
+  BRepBuilderAPI_Transform transformer(s, tr, true, has_mesh_only_faces(s));
   return transformer.Shape();
 }
 
@@ -4247,15 +4970,14 @@ Status Occt_view::build_export_shape_(TopoDS_Shape& out_shape) const
   return Status::ok();
 }
 
-Status Occt_view::export_document(Export_format fmt, Export_unit unit, const std::string& file_path)
+Status Occt_view::export_document(Export_format fmt, Export_unit unit, const std::string& file_path,
+                                  const Mesh_export_params& mesh)
 {
   TopoDS_Shape shape;
   CHK_RET(build_export_shape_(shape));
 
-  const double dim_scale = get_dimension_scale();
-  const double unit_scale =
-      (unit == Export_unit::Millimeter) ? model_to_cad_mm_export_scale_(dim_scale) : model_to_inch_export_scale_(dim_scale);
-  shape = scale_shape_about_origin_(shape, unit_scale);
+  const double unit_scale = export_unit_scale_(unit);
+  shape                   = scale_shape_about_origin_(shape, unit_scale);
 
   const char* unit_name = (unit == Export_unit::Millimeter) ? "MM" : "INCH";
 
@@ -4292,31 +5014,33 @@ Status Occt_view::export_document(Export_format fmt, Export_unit unit, const std
     return Status::ok();
   }
   case Export_format::Stl:
-  {
-    // Tessellate in export units (0.1 model units, scaled like the geometry).
-    constexpr double               k_lin_deflection_model = 0.1;
-    const double                   lin_deflection         = k_lin_deflection_model * unit_scale;
-    const BRepMesh_IncrementalMesh mesher(shape, lin_deflection);
-    (void)mesher;
-    StlAPI_Writer stl_writer;
-    stl_writer.ASCIIMode() = false;
-    if (!stl_writer.Write(shape, file_path.c_str()))
-      return Status::user_error("STL write failed.");
-
-    return Status::ok();
-  }
   case Export_format::Ply:
   {
-    constexpr double               k_lin_deflection_model = 0.1;
-    const double                   lin_deflection         = k_lin_deflection_model * unit_scale;
-    const BRepMesh_IncrementalMesh mesher(shape, lin_deflection);
-    (void)mesher;
+    // Tessellate in export units; the default chord tolerance is 0.1 model units, scaled like the geometry.
+    const double lin_deflection = mesh.lin_deflection > 0.0 ? mesh.lin_deflection : export_lin_deflection_default(unit);
+    const double ang_deflection = to_radians(std::clamp(mesh.ang_deflection_deg, 1.0, 90.0));
+    mesh_shape_parallel(shape, lin_deflection, ang_deflection);
+    if (fmt == Export_format::Stl)
+      return export_stl_binary_file(shape, file_path);
+
     return export_ply_binary_file(shape, file_path);
   }
   }
   return Status::user_error("Unknown export format.");
 }
 
+double Occt_view::export_lin_deflection_default(Export_unit unit) const
+{
+  constexpr double k_lin_deflection_model = 0.1;
+  return k_lin_deflection_model * export_unit_scale_(unit);
+}
+
+double Occt_view::export_unit_scale_(Export_unit unit) const
+{
+  const double dim_scale = get_dimension_scale();
+  return (unit == Export_unit::Millimeter) ? model_to_cad_mm_export_scale_(dim_scale) : model_to_inch_export_scale_(dim_scale);
+}
+
 double Occt_view::step_import_model_scale() const { return step_import_to_model_scale_(get_dimension_scale()); }
 
 Status Occt_view::prepare_step_import(const std::string& step_data, const Step_import_mode mode, const double to_model_scale,
@@ -4341,24 +5065,37 @@ Status Occt_view::prepare_step_import(const std::string& step_data, const Step_i
   if (!progress.IsNull())
     progress->set_stage("Scaling shapes...");
 
-  for (utl_cad_file_info::Named_node& node : out.named)
-  {
-    if (node.is_group || node.shape.IsNull())
-      continue;
+  std::vector<size_t> leaves;
+  for (size_t i = 0; i < out.named.size(); ++i)
+    if (!out.named[i].is_group && !out.named[i].shape.IsNull())
+      leaves.push_back(i);
 
-    node.shape = scale_shape_about_origin_(node.shape, to_model_scale);
-  }
+  if (leaves.empty())
+    return Status::user_error("STEP: no valid shapes in file.");
 
-  bool any_leaf = false;
-  for (const utl_cad_file_info::Named_node& n : out.named)
-    if (!n.is_group && !n.shape.IsNull())
-    {
-      any_leaf = true;
-      break;
-    }
+  // Each leaf is copied into a new shape, so leaves that instance the same part only share read-only input.
+  std::atomic<bool> scale_failed{false};
+  parallel_for_each_index(
+      leaves.size(),
+      [&](size_t i)
+      {
+        TopoDS_Shape& shape = out.named[leaves[i]].shape;
+        try
+        {
+          shape = scale_shape_about_origin_(shape, to_model_scale);
+        }
+        catch (const Standard_Failure&)
+        {
+          scale_failed.store(true, std::memory_order_relaxed);
+        }
+      },
+      progress.IsNull() ? nullptr : progress->cancel_flag());
 
-  if (!any_leaf)
-    return Status::user_error("STEP: no valid shapes in file.");
+  if (!progress.IsNull() && progress->cancelled())
+    return Status::user_error("STEP: import cancelled.");
+
+  if (scale_failed.load(std::memory_order_relaxed))
+    return Status::user_error("STEP: scaling imported shapes failed.");
 
   if (mode != Step_import_mode::Union_shapes)
     return Status::ok();
@@ -4366,30 +5103,30 @@ Status Occt_view::prepare_step_import(const std::string& step_data, const Step_i
   if (!progress.IsNull())
     progress->set_stage("Fusing shapes...");
 
-  TopoDS_Shape result;
-  bool         have = false;
-  for (utl_cad_file_info::Named_node& node : out.named)
+  if (leaves.size() == 1)
   {
-    if (node.is_group || node.shape.IsNull())
-      continue;
+    out.fused = out.named[leaves.front()].shape;
+    out.named.clear();
+    return Status::ok();
+  }
 
-    if (!have)
-    {
-      result = node.shape;
-      have   = true;
-      continue;
-    }
+  // One Boolean over all leaves: intersections are computed once for the whole set instead of re-intersecting a
+  // growing result with each leaf.
+  std::vector<TopoDS_Shape> operands;
+  operands.reserve(leaves.size());
+  for (const size_t i : leaves)
+    operands.push_back(out.named[i].shape);
 
-    BRepAlgoAPI_Fuse fuse_op(result, node.shape);
-    if (!fuse_op.IsDone())
-      return Status::user_error("STEP: union of imported shapes failed.");
+  Boolean_params params;
+  params.progress = progress;
+  if (Status st = boolean_op_multi(Boolean_op::Fuse, operands, out.fused, params); !st.is_ok())
+  {
+    if (!progress.IsNull() && progress->cancelled())
+      return Status::user_error("STEP: import cancelled.");
 
-    result = fuse_op.Shape();
-    if (result.IsNull())
-      return Status::user_error("STEP: union produced an empty shape.");
+    return Status::user_error("STEP: union of imported shapes failed (" + st.message() + ")");
   }
 
-  out.fused = result;
   out.named.clear();
   return Status::ok();
 }
@@ -4490,10 +5227,12 @@ Status Occt_view::import_step(const std::string& step_data, const Step_import_mo
   return commit_step_import(geom);
 }
 
-bool Occt_view::import_ply(const std::string& ply_bytes)
+bool Occt_view::import_ply(std::string_view ply_bytes, Ply_import_mode mode)
 {
+  // Scaling while parsing avoids a BRep copy of a facet compound and keeps a triangulation face surface-free.
   TopoDS_Shape shape;
-  if (Status st = import_ply_shape(ply_bytes, shape); !st.is_ok())
+  const double scale = ply_import_to_model_scale_(get_dimension_scale());
+  if (Status st = import_ply_shape(ply_bytes, shape, mode, scale); !st.is_ok())
   {
     m_gui.log_message("PLY import failed: " + st.message());
     return false;
@@ -4501,8 +5240,6 @@ bool Occt_view::import_ply(const std::string& ply_bytes)
   if (shape.IsNull())
     return false;
 
-  shape = scale_shape_about_origin_(shape, ply_import_to_model_scale_(get_dimension_scale()));
-
   Shp_ptr shp = new Shp(*m_ctx, shape);
   add_shp_(shp, true);
   push_undo_delta(std::make_unique<Shape_add_delta>(std::vector<Shape_rec>{capture_shape_rec(*shp)}));
@@ -4519,6 +5256,7 @@ void Occt_view::new_file()
   m_redo_stack.clear();
   remove(m_shps);
   clear_all(m_shps, m_sketches, m_cur_sketch);
+  clear_shp_index_();
   m_assets.clear();
   // Keep m_shape_clipboard so Copy then New then Paste can seed a fresh document.
   // Live source-root ids are invalid after the document is cleared.
@@ -4527,6 +5265,9 @@ void Occt_view::new_file()
   m_next_shape_id    = 1;
   m_current_group_id = 0;
   m_project_unit     = m_gui.default_project_unit();
+  reset_doc_snapshot_();
+  m_checkpoint_dirty.all = true;
+  ++m_doc_edit_rev;
 
   create_default_sketch_();
   refresh_viewer_grid_();
@@ -4624,6 +5365,14 @@ Mode mode_for_history_restore_(Mode mode)
   }
 }
 
+bool same_shape_rec_(const Shape_rec& a, const Shape_rec& b)
+{
+  return a.id == b.id && a.name == b.name && a.material == b.material && a.geom.IsEqual(b.geom) &&
+         a.deferred_geom == b.deferred_geom && a.frame.Location().IsEqual(b.frame.Location(), 0.0) && a.frame.Direction().IsEqual(b.frame.Direction(), 0.0) &&
+         a.frame.XDirection().IsEqual(b.frame.XDirection(), 0.0) && a.parent_id == b.parent_id &&
+         a.sibling_order == b.sibling_order && a.is_group == b.is_group && a.visible == b.visible;
+}
+
 TopoDS_Shape scale_shape_about_origin_(const TopoDS_Shape& shape, double factor)
 {
   if (shape.IsNull())
@@ -4633,7 +5382,7 @@ TopoDS_Shape scale_shape_about_origin_(const TopoDS_Shape& shape, double factor)
 
   gp_Trsf tr;
   tr.SetScale(gp_Pnt(0.0, 0.0, 0.0), factor);
-  return BRepBuilderAPI_Transform(shape, tr, true).Shape();
+  return BRepBuilderAPI_Transform(shape, tr, true, has_mesh_only_faces(shape)).Shape();
 }
 
 double step_import_to_model_scale_(double dimension_scale) { return dimension_scale / k_mm_per_inch; }
@@ -4643,4 +5392,73 @@ double ply_import_to_model_scale_(double dimension_scale) { return dimension_sca
 double model_to_cad_mm_export_scale_(double dimension_scale) { return k_mm_per_inch / dimension_scale; }
 
 double model_to_inch_export_scale_(double dimension_scale) { return 1.0 / dimension_scale; }
+
+bool is_group_json_(const nlohmann::json& shape_json)
+{
+  return shape_json.contains("isGroup") && shape_json["isGroup"].is_boolean() && shape_json["isGroup"].get<bool>();
+}
+
+bool defers_shape_geom_(const nlohmann::json& shape_json, const Ezy_archive* archive)
+{
+  return archive && !is_group_json_(shape_json) && shape_json.contains("frame") && shape_json["frame"].is_object() &&
+         shape_json.contains("geomRef") && shape_json["geomRef"].is_string() &&
+         archive->has_geom(shape_json["geomRef"].get<std::string>());
+}
+
+TopoDS_Shape decode_shape_geom_(const nlohmann::json& shape_json, const Ezy_geom_reader& read_geom)
+{
+  TopoDS_Shape shape;
+  if (shape_json.contains("geomRef") && shape_json["geomRef"].is_string())
+  {
+    if (read_geom)
+      if (const std::optional<std::string> bytes = read_geom(shape_json["geomRef"].get<std::string>()))
+        shape = read_brep_binary(*bytes);
+  }
+  else if (shape_json.contains("geom") && shape_json["geom"].is_string())
+  {
+    std::istringstream iss(shape_json["geom"].get<std::string>());
+    try
+    {
+      BRepTools::Read(shape, iss, BRep_Builder());
+    }
+    catch (const Standard_Failure&)
+    {
+      return TopoDS_Shape();
+    }
+  }
+
+  return shape;
+}
+
+nlohmann::json shape_rec_json_(const Shape_rec& rec)
+{
+  nlohmann::json shp_json;
+  shp_json["id"]       = rec.id;
+  shp_json["name"]     = rec.name;
+  shp_json["parentId"] = rec.parent_id;
+  shp_json["order"]    = rec.sibling_order;
+  shp_json["visible"]  = rec.visible;
+  if (rec.is_group)
+  {
+    shp_json["isGroup"] = true;
+  }
+  else
+  {
+    shp_json["material"] = rec.material;
+    shp_json["frame"]    = ::to_json(gp_Pln(rec.frame));
+  }
+
+  return shp_json;
+}
+
+TopoDS_Shape snapshot_geom_(const TopoDS_Shape& geom)
+{
+  if (geom.IsNull())
+    return geom;
+
+  // Mesh-only faces (PLY) keep their triangulation, the only geometry they have; other display meshes are dropped,
+  // as `write_brep_binary` does not write them.
+  BRepBuilderAPI_Copy copier(geom, true, has_mesh_only_faces(geom));
+  return copier.Shape();
+}
 } // namespace
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include <set>
 #include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "gui_occt_glfw_win.h"
@@ -28,16 +30,19 @@
 #include "shp_rotate.h"
 #include "shp_scale.h"
 #include "shp_cross_section.h"
+#include "doc_delta.h"
 #include "shp_delta.h"
 #include "utl_types.h"
 #include "utl_asset_store.h"
 #include "utl_cad_file_info.h"
 #include "utl_geom.h"
+#include "utl_io.h"
 #include "utl_occt_progress.h"
 
 #include <nlohmann/json.hpp>
 
 class Delta;
+struct Doc_snapshot;
 class GUI;
 class Sketch;
 struct Sketch_annotation_refresh;
@@ -47,6 +52,7 @@ class TopoDS_Face;
 class TopoDS_Wire;
 class TopoDS_Edge;
 class TopoDS_Shape;
+class TopoDS_TShape;
 enum class Mode;
 enum class Command;
 
@@ -94,8 +100,45 @@ public:
   /// Top view (+Z) centered on the origin, framed to Settings default 2D view width x height (display units).
   void reset_default_view();
 
-  std::string            to_json() const;
-  void                   load(const std::string& json_str, bool restore_view = true);
+  /// Document manifest JSON. With `geoms` (`.ezy` v4 archives) shape and originating-face geometry is written there
+  /// as binary BRep and the manifest only references it by id; without it geometry stays inline as BRep text (v3).
+  std::string            to_json(Ezy_geom_entries* geoms = nullptr) const;
+  /// v4 manifest whose shape geometry is encoded only when `pack_ezy_to` reads it from `geoms` (the source holds the
+  /// current shapes); originating faces are small and encoded now.
+  std::string            to_json(Ezy_geom_source& geoms) const;
+  /// `geoms` supplies the entries a v4 manifest references; v1-v3 manifests carry their geometry inline.
+  void                   load(const std::string& json_str, bool restore_view = true, const Ezy_geom_entries* geoms = nullptr);
+  /// Lazy load of a v4 manifest: shapes read their geometry from `archive` when first displayed or queried, so hidden
+  /// shapes and shapes in hidden groups cost nothing until used. Underlay pixels are read when first drawn if the
+  /// caller imported them with `Ezy_asset_store::import_lazy_asset`. Sketch geometry is small and read right away.
+  void                   load_lazy(const std::string& json_str, const std::shared_ptr<const Ezy_archive>& archive,
+                                   bool restore_view = true);
+  /// Reads everything a lazy load left pending, including shapes only undo history still holds, and drops the
+  /// archive. Call before overwriting the project file a lazy load mapped.
+  void                   load_deferred();
+  /// Shapes whose geometry is still pending from a lazy load.
+  [[nodiscard]] size_t   deferred_shape_count() const;
+  /// Project manifest with its geometry decoded off the UI thread (no AIS / document mutation).
+  struct Project_load_geom
+  {
+    nlohmann::json                     doc;          // Parsed manifest
+    std::vector<TopoDS_Shape>          shapes;       // Per `doc["shapes"]` entry; null for groups and deferred shapes
+    std::vector<TopoDS_Shape>          sketch_faces; // Per `doc["sketches"]` entry; null without an originating face
+    std::shared_ptr<const Ezy_archive> lazy_archive; // Deferred shapes read from it on first use
+  };
+
+  /// Parse a manifest and decode shape BReps and sketch originating faces on worker threads; `load` / `load_lazy`
+  /// without the document update, so it may run off the UI thread. `read_geom` resolves v4 entries; shapes
+  /// `lazy_archive` can defer are left undecoded. Fails on invalid JSON or when `progress` is cancelled.
+  [[nodiscard]] static Status prepare_load(const std::string& json_str, const Ezy_geom_reader& read_geom,
+                                           const std::shared_ptr<const Ezy_archive>& lazy_archive, Project_load_geom& out,
+                                           const Atomic_progress_indicator_ptr& progress = {});
+  /// Replace the document with prepared geometry (UI thread). Sketch topology is rebuilt here: sketches own AIS
+  /// objects.
+  void                   commit_load(Project_load_geom& geom, bool restore_view = true);
+  /// Readers over v4 geometry entries for `prepare_load` (empty for null).
+  [[nodiscard]] static Ezy_geom_reader geom_reader(const Ezy_geom_entries* geoms);
+  [[nodiscard]] static Ezy_geom_reader geom_reader(const std::shared_ptr<const Ezy_archive>& archive);
   Ezy_asset_store&       asset_store() { return m_assets; }
   const Ezy_asset_store& asset_store() const { return m_assets; }
   /// Geometry prepared off the UI thread for STEP import (no AIS / document mutation).
@@ -121,14 +164,20 @@ public:
   /// Model-space scale factor for STEP import (mm cascade -> inches * dimension_scale).
   [[nodiscard]] double step_import_model_scale() const;
 
-  /// Import PLY (coords treated as inches) scaled into model space (* dimension_scale).
-  bool import_ply(const std::string& ply_bytes);
+  /// Import PLY (coords treated as inches) scaled into model space (* dimension_scale). \a ply_bytes is read in place,
+  /// so a `Mapped_file` view avoids copying the file.
+  bool import_ply(std::string_view ply_bytes, Ply_import_mode mode = Ply_import_mode::Triangulation);
 
-  /// Writes STEP/IGES/STL/PLY from model space in \a unit. Selected document shapes if any, else all.
-  [[nodiscard]] Status export_document(Export_format fmt, Export_unit unit, const std::string& file_path);
+  /// Writes STEP/IGES/STL/PLY from model space in \a unit. Selected document shapes if any, else all. STL and PLY
+  /// tessellate each body in parallel with \a mesh and stream the triangles to \a file_path.
+  [[nodiscard]] Status export_document(Export_format fmt, Export_unit unit, const std::string& file_path,
+                                       const Mesh_export_params& mesh = {});
+  /// Default `Mesh_export_params::lin_deflection` in \a unit (0.1 model units).
+  [[nodiscard]] double export_lin_deflection_default(Export_unit unit) const;
 
-  // Undo / redo (element deltas for edits; full JSON only for file-open checkpoint).
-  /// Saves current document (full JSON) and mode. Prefer typed deltas for interactive edits.
+  // Undo / redo (element deltas for edits; document checkpoints only for mixed delete and file open).
+  /// Saves a document checkpoint and mode. Unchanged shape records are shared with the previous checkpoint and
+  /// reference the document's geometry. Prefer typed deltas for interactive edits.
   void push_undo_snapshot();
   /// Records an element/document delta (sketch, shape, underlay, etc.).
   void push_undo_delta(std::unique_ptr<Delta> delta);
@@ -140,6 +189,11 @@ public:
   bool   can_redo() const;
   size_t undo_stack_size() const;
   size_t redo_stack_size() const;
+  /// Approximate bytes held by undo and redo history; geometry the document still uses is not counted.
+  size_t undo_memory_bytes() const;
+  /// Oldest undo steps are dropped while history exceeds \a bytes (the newest step is always kept).
+  void   set_undo_budget_bytes(size_t bytes);
+  size_t undo_budget_bytes() const;
 
   Shape_id allocate_shape_id();
   void     adopt_shape_id(Shape_id id);
@@ -187,6 +241,10 @@ public:
   void ensure_current_sketch_for_undo();
 
   void do_frame();
+  /// Redraw after a display change, once at the end of the frame (`do_frame`) however often it is called.
+  void update_viewer() { m_viewer_update_pending = true; }
+  /// True while OCCT asks for another frame without input (view cube / camera animation, inertia).
+  bool view_animating() const { return ToAskNextFrame(); }
   /// Apply pending navigation (pan/zoom/rotate) to the camera before UI uses view projection (e.g. underlay slider bounds).
   void flush_view_events();
 
@@ -226,6 +284,22 @@ public:
 
   void cancel(Set_parent_mode set_parent_mode);
 
+  /// Bumped whenever a shape or sketch is added or removed, or a shape is relinked; lets UI row models detect a
+  /// stale document tree without rescanning it. Names, visibility, and selection do not change it.
+  [[nodiscard]] uint64_t doc_tree_revision() const { return m_doc_tree_rev; }
+
+  // Autosave (see `Doc_autosave`)
+  /// Bumped by every recorded edit, undo, redo and load; equal values mean the document did not change in between.
+  [[nodiscard]] uint64_t doc_edit_revision() const { return m_doc_edit_rev; }
+  /// For edits that record no undo step (renames, visibility, material).
+  void                   mark_shape_dirty(Shape_id id);
+  void                   mark_sketch_dirty(size_t sketch_id);
+  /// Document state for a background writer. Records not marked dirty since the previous capture are shared with it;
+  /// the current sketch is always recaptured, since sketch tools edit it before they record a step.
+  [[nodiscard]] std::shared_ptr<const Doc_snapshot> capture_doc_snapshot();
+  /// `.ezy` v4 manifest of `snapshot`; `geoms` encodes its geometry as it is packed. Worker-thread safe.
+  [[nodiscard]] static std::string doc_snapshot_to_json(const Doc_snapshot& snapshot, Ezy_geom_source& geoms);
+
   // Sketch related
   Sketch_list&       get_sketches();
   const Sketch_list& get_sketches() const;
@@ -249,6 +323,7 @@ public:
   /// Enter face-extrude drag for a Sketch List face (after mode is already Sketch_face_extrude).
   bool begin_sketch_face_extrude(const AIS_Shape_ptr& face);
 
+  /// Document shapes for iteration; insert/erase and parent changes go through the view so its shape index stays valid.
   std::list<Shp_ptr>& get_shapes();
   std::string         get_unique_shape_name(const char* base_name) const;
   void                add_box(double ox, double oy, double oz, double width, double length, double height);
@@ -438,13 +513,24 @@ private:
 
   /// Register shape. When \a use_current_group, solids still at parent 0 are placed under current_group_id().
   void        add_shp_(Shp_ptr& shp, bool use_current_group = false);
+  // Shape registry: every insert/erase of `m_shps` goes through these so the id and children indexes stay in sync.
+  void                         push_shp_(const Shp_ptr& shp);
+  std::list<Shp_ptr>::iterator erase_shp_(std::list<Shp_ptr>::iterator it);
+  void                         erase_shp_(const Shp_ptr& shp);
+  void                         clear_shp_index_();
+  void                         link_child_(const Shp_ptr& shp);
+  void                         unlink_child_(const Shp_ptr& shp);
+  /// `insert_shape_rec` without the per-shape faint-style sync (callers inserting many shapes sync once).
+  void        insert_shape_rec_(const Shape_rec& rec);
   void        ensure_current_group_valid_();
   std::string unique_shape_name_(const char* base_name) const;
   /// Snapshot one shape for the in-app clipboard (independent BREP; local transform baked).
   [[nodiscard]] Shape_rec capture_clipboard_shape_rec_(const Shp& shp) const;
 
-  TopoDS_Shape         shape_with_local_transform_(const AIS_Shape_ptr& ais) const;
+  TopoDS_Shape         shape_with_local_transform_(const Shp_ptr& shp) const;
   [[nodiscard]] Status build_export_shape_(TopoDS_Shape& out_shape) const;
+  /// Model space -> \a unit for CAD/mesh export.
+  [[nodiscard]] double export_unit_scale_(Export_unit unit) const;
 
   void                         update_view_background_();
   static Occt_grid_rect_params clamp_occt_grid_rect_params_(Occt_grid_rect_params g);
@@ -486,18 +572,45 @@ private:
   GLFWwindow*                m_glfw_window{nullptr};
   Occt_glfw_win_ptr          m_occt_window;
   // Undo / redo
-  static constexpr size_t k_max_undo{50};
+  static constexpr size_t k_max_undo{200};
+  static constexpr size_t k_default_undo_budget_bytes{size_t(256) << 20};
 
   struct Undo_entry
   {
-    std::unique_ptr<Delta> delta;
-    std::string            json; // Full-document snapshot when `delta` is null
-    Mode                   mode; // Mode at time of operation; restored when navigating stacks
+    std::unique_ptr<Delta>                               delta;
+    std::shared_ptr<const Doc_checkpoint>                checkpoint; // Document state when `delta` is null
+    Mode                                                 mode;       // Mode at time of operation; restored on undo/redo
+    size_t                                               bytes{0};   // Payload size without geometry
+    std::vector<std::pair<const TopoDS_TShape*, size_t>> geom;       // Distinct geometry held, with its approx size
   };
 
-  std::vector<Undo_entry> m_undo_stack;
-  std::vector<Undo_entry> m_redo_stack;
-  bool                    m_restoring{false};
+  std::vector<Undo_entry>             m_undo_stack;
+  std::vector<Undo_entry>             m_redo_stack;
+  std::weak_ptr<const Doc_checkpoint> m_last_checkpoint; // Source of shared records for the next capture
+  /// Sketches edited since `m_last_checkpoint` was captured (from deltas and `mark_sketch_dirty`); `all` after a
+  /// restore, load, or new document.
+  Doc_dirty                           m_checkpoint_dirty;
+  size_t                              m_undo_budget_bytes{k_default_undo_budget_bytes};
+  bool                                m_restoring{false};
+
+  [[nodiscard]] std::shared_ptr<const Doc_checkpoint> capture_checkpoint_();
+  void                                                restore_checkpoint_(const Doc_checkpoint& checkpoint);
+  static void                                         measure_undo_entry_(Undo_entry& entry);
+  void                                                push_undo_entry_(Undo_entry entry);
+  void                                                trim_undo_history_();
+
+  // Autosave
+  Doc_dirty                           m_doc_dirty;
+  uint64_t                            m_doc_edit_rev{0};
+  std::shared_ptr<const Doc_snapshot> m_last_doc_snapshot; // Source of shared records for the next capture
+
+  void           note_doc_edit_(const Undo_entry& entry);
+  /// Next capture starts over (new document, load, or a source the old records read from going away).
+  void           reset_doc_snapshot_();
+  nlohmann::json view_to_json_() const;
+  /// `to_json`; with `shape_geoms` (and `geoms`) shape geometry is collected there unencoded instead.
+  std::string    to_json_(Ezy_geom_entries* geoms, std::unordered_map<std::string, TopoDS_Shape>* shape_geoms) const;
+
   size_t                  m_next_sketch_id{1};
   Shape_id                m_next_shape_id{1};
   Shape_id                m_current_group_id{0};
@@ -506,6 +619,8 @@ private:
   /// Live document ids of clipboard roots at copy time (for paste-as-sibling when still current).
   std::vector<Shape_id> m_shape_clipboard_source_roots;
   Ezy_asset_store       m_assets;
+  /// Geometry lazy loads left pending, held weakly: shapes and undo records own it (see `load_deferred`).
+  std::vector<std::weak_ptr<Shp_deferred_geom>> m_deferred_geoms;
 
   // --------------------------------------------------------------------
   // Dimension related
@@ -514,6 +629,14 @@ private:
   Project_unit                           m_project_unit{Project_unit::Inch};
   std::optional<double>                  m_entered_dim;
   std::list<Shp_ptr>                     m_shps;
+  /// Id -> position in `m_shps` (first shape wins on duplicate ids).
+  std::unordered_map<Shape_id, std::list<Shp_ptr>::iterator> m_shp_by_id;
+  /// Id -> number of further shapes sharing it (absent when unique); erasing the indexed one re-indexes the next.
+  std::unordered_map<Shape_id, size_t>                       m_shp_id_dups;
+  /// Parent id (0 = roots) -> children sorted by (sibling_order, id). Once a shape is registered, change its parent
+  /// or order only through `apply_shape_link`.
+  std::unordered_map<Shape_id, std::vector<Shp_ptr>>         m_shp_children;
+  uint64_t                                                   m_doc_tree_rev{0};
   Sketch_list                            m_sketches;
   std::shared_ptr<Sketch>                m_cur_sketch;
   TopAbs_ShapeEnum                       m_shp_selection_mode{TopAbs_SHAPE};
@@ -552,6 +675,7 @@ private:
   [[nodiscard]] static Sketch* sketch_owner_of_list_ais_(const AIS_Shape_ptr& ais);
   Graphic3d_MaterialAspect     m_default_material;
   bool                         m_headless_view{false};
+  bool                         m_viewer_update_pending{false}; // Set by `update_viewer`, cleared by `do_frame`
   /// True when LMB press was handled by planar-face sketch creation without AIS_ViewController::PressMouseButton (pair with
   /// release skip).
   bool m_planar_face_lmb_skipped_view_controller{false};
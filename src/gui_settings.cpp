@@ -163,6 +163,10 @@ void GUI::save_occt_view_settings()
       {"settings_headers",                   settings_headers_to_json_(m_settings_headers)},
       {"view_roll_step_deg",                 m_view_roll_step_deg},
       {"view_zoom_scroll_scale",             m_view_zoom_scroll_scale},
+      {"undo_budget_mb",                     m_undo_budget_mb},
+      {"lazy_project_load",                  m_lazy_project_load},
+      {"render_mode",                        m_render_on_demand ? "on_demand" : "continuous"},
+      {"autosave_interval_s",                m_autosave_interval_s},
       {"default_2d_view_width",              m_default_2d_view_width},
       {"default_2d_view_height",             m_default_2d_view_height},
       {"default_project_unit",               (m_default_project_unit == Project_unit::Millimeter) ? "millimeter" : "inch"},
@@ -461,6 +465,11 @@ void GUI::parse_gui_panes_settings_(const std::string& content)
     m_add_mid_pt_rect_edges       = b("add_mid_pt_rect_edges", true);
     m_add_mid_pt_slot_edges       = b("add_mid_pt_slot_edges", false);
     m_load_last_opened_on_startup = b("load_last_opened_on_startup", b("load_last_saved_on_startup", false));
+    m_lazy_project_load           = b("lazy_project_load", true);
+
+    m_render_on_demand = true;
+    if (g.contains("render_mode") && g["render_mode"].is_string())
+      m_render_on_demand = g["render_mode"].get<std::string>() != "continuous";
 
     if (g.contains("last_opened_project_path") && g["last_opened_project_path"].is_string())
       m_last_opened_project_path = g["last_opened_project_path"].get<std::string>();
@@ -550,6 +559,33 @@ void GUI::parse_gui_panes_settings_(const std::string& content)
     if (m_view)
       m_view->set_zoom_scroll_scale(m_view_zoom_scroll_scale);
 
+    m_undo_budget_mb = k_gui_undo_budget_mb_default;
+    if (g.contains("undo_budget_mb") && g["undo_budget_mb"].is_number_integer())
+    {
+      const int v = g["undo_budget_mb"].get<int>();
+      if (v >= k_gui_undo_budget_mb_min && v <= k_gui_undo_budget_mb_max)
+        m_undo_budget_mb = v;
+      else
+        log_message("EzyCad: settings gui.undo_budget_mb out of range [" + std::to_string(k_gui_undo_budget_mb_min) + ", " +
+                    std::to_string(k_gui_undo_budget_mb_max) + "], got " + std::to_string(v) + "; using default.");
+    }
+
+    if (m_view)
+      m_view->set_undo_budget_bytes(static_cast<size_t>(m_undo_budget_mb) << 20);
+
+    m_autosave_interval_s = k_gui_autosave_interval_s_default;
+    if (g.contains("autosave_interval_s") && g["autosave_interval_s"].is_number_integer())
+    {
+      const int v = g["autosave_interval_s"].get<int>();
+      if (v >= k_gui_autosave_interval_s_min && v <= k_gui_autosave_interval_s_max)
+        m_autosave_interval_s = v;
+      else
+        log_message("EzyCad: settings gui.autosave_interval_s out of range [" + std::to_string(k_gui_autosave_interval_s_min) +
+                    ", " + std::to_string(k_gui_autosave_interval_s_max) + "], got " + std::to_string(v) + "; using default.");
+    }
+
+    m_autosave.set_interval_s(m_autosave_interval_s);
+
     m_default_2d_view_width = k_gui_default_2d_view_size_default;
     if (g.contains("default_2d_view_width") && g["default_2d_view_width"].is_number())
     {
@@ -1050,6 +1086,25 @@ void GUI::settings_()
         save_occt_view_settings();
       }
 
+#ifndef __EMSCRIPTEN__
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::AlignTextToFramePadding();
+      ImGui::TextUnformatted("Rendering");
+      ImGui::TableSetColumnIndex(1);
+      int render_idx = m_render_on_demand ? 0 : 1;
+      if (ImGui::Combo("##render_mode", &render_idx, "On demand\0Continuous\0"))
+      {
+        m_render_on_demand = render_idx == 0;
+        save_occt_view_settings();
+      }
+
+      ImGui::SameLine(0.0f, ImGui::GetStyle().ItemInnerSpacing.x);
+      GUI_DOC_HELP_("On demand redraws only after input, while an operation or view animation runs, and twice a "
+                    "second otherwise, so an idle window uses almost no CPU or GPU. Continuous redraws every frame.",
+                    doc_urls::k_occt_view);
+#endif
+
       ImGui::EndTable();
     }
 
@@ -2043,6 +2098,92 @@ void GUI::settings_()
                   doc_urls::k_startup_project);
   }
 
+  if (settings_collapsing_header_("Undo history", m_settings_headers.undo))
+  {
+    if (ImGui::BeginTable("settings_undo", 2, ImGuiTableFlags_SizingStretchProp))
+    {
+      ImGui::TableSetupColumn("label", ImGuiTableColumnFlags_WidthFixed, k_label_col_w);
+      ImGui::TableSetupColumn("control", ImGuiTableColumnFlags_WidthStretch);
+
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::AlignTextToFramePadding();
+      ImGui::TextUnformatted("Memory budget");
+      ImGui::TableSetColumnIndex(1);
+      if (ImGui::SliderInt("##undo_budget_mb", &m_undo_budget_mb, k_gui_undo_budget_mb_min, k_gui_undo_budget_mb_max, "%d MB",
+                           ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_ClampOnInput | ImGuiSliderFlags_Logarithmic))
+      {
+        m_undo_budget_mb = std::clamp(m_undo_budget_mb, k_gui_undo_budget_mb_min, k_gui_undo_budget_mb_max);
+        if (m_view)
+          m_view->set_undo_budget_bytes(static_cast<size_t>(m_undo_budget_mb) << 20);
+
+        save_occt_view_settings();
+      }
+
+      ImGui::SameLine(0.0f, ImGui::GetStyle().ItemInnerSpacing.x);
+      GUI_DOC_HELP_("Oldest undo steps are dropped once the history needs more memory than this. The most recent step "
+                    "is always kept. Ctrl+click to type a value. Click ? to open the user guide.",
+                    doc_urls::k_edit_operations);
+
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::AlignTextToFramePadding();
+      ImGui::TextUnformatted("In use");
+      ImGui::TableSetColumnIndex(1);
+      ImGui::AlignTextToFramePadding();
+      ImGui::Text("%.1f MB (%zu undo / %zu redo steps)", static_cast<double>(m_view->undo_memory_bytes()) / (1024.0 * 1024.0),
+                  m_view->undo_stack_size(), m_view->redo_stack_size());
+
+      ImGui::EndTable();
+    }
+
+    if (ui_show_contextual_help())
+      ImGui::TextWrapped("Geometry still shown in the document is shared with the history and not counted.");
+  }
+
+  if (settings_collapsing_header_("Project files", m_settings_headers.project_files))
+  {
+    if (ImGui::BeginTable("settings_project_files", 2, ImGuiTableFlags_SizingStretchProp))
+    {
+      ImGui::TableSetupColumn("label", ImGuiTableColumnFlags_WidthFixed, k_label_col_w);
+      ImGui::TableSetupColumn("control", ImGuiTableColumnFlags_WidthStretch);
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::AlignTextToFramePadding();
+      ImGui::TextUnformatted("Load geometry on demand");
+      ImGui::TableSetColumnIndex(1);
+      if (ImGui::Checkbox("##lazy_project_load", &m_lazy_project_load))
+        save_occt_view_settings();
+
+      ImGui::SameLine(0.0f, ImGui::GetStyle().ItemInnerSpacing.x);
+      GUI_DOC_HELP_("When enabled, opening a .ezy reads shape geometry and underlay images from the file only when they "
+                    "are first shown or used, so hidden shapes cost nothing. Applies to the next project opened. Click ? "
+                    "to open the user guide.",
+                    doc_urls::k_project_files);
+
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::AlignTextToFramePadding();
+      ImGui::TextUnformatted("Autosave interval");
+      ImGui::TableSetColumnIndex(1);
+      if (ImGui::SliderInt("##autosave_interval_s", &m_autosave_interval_s, k_gui_autosave_interval_s_min,
+                           k_gui_autosave_interval_s_max, m_autosave_interval_s == 0 ? "Off" : "%d s",
+                           ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_ClampOnInput))
+      {
+        m_autosave_interval_s = std::clamp(m_autosave_interval_s, k_gui_autosave_interval_s_min, k_gui_autosave_interval_s_max);
+        m_autosave.set_interval_s(m_autosave_interval_s);
+        save_occt_view_settings();
+      }
+
+      ImGui::SameLine(0.0f, ImGui::GetStyle().ItemInnerSpacing.x);
+      GUI_DOC_HELP_("How often unsaved changes are written to a recovery file in the user config folder, in the "
+                    "background. After a crash, File > Open recovered work restores them. 0 turns autosave off. Click "
+                    "? to open the user guide.",
+                    doc_urls::k_project_files);
+      ImGui::EndTable();
+    }
+  }
+
   ImGui::Separator();
   if (ImGui::Button("Defaults"))
   {
@@ -2214,6 +2355,8 @@ nlohmann::json settings_headers_to_json_(const Gui_settings_headers& h)
       {"sketch_underlay",   h.sketch_underlay},
       {"startup",           h.startup},
       {"hotkeys",           h.hotkeys},
+      {"undo",              h.undo},
+      {"project_files",     h.project_files},
   };
   // clang-format on
 }
@@ -2242,6 +2385,8 @@ void parse_settings_headers_json_(const nlohmann::json& obj, Gui_settings_header
   out.sketch_underlay   = b("sketch_underlay",    defaults.sketch_underlay);
   out.startup           = b("startup",            defaults.startup);
   out.hotkeys           = b("hotkeys",            defaults.hotkeys);
+  out.undo              = b("undo",               defaults.undo);
+  out.project_files     = b("project_files",      defaults.project_files);
   // clang-format on
 }
 
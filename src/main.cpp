@@ -9,6 +9,7 @@
 #endif
 #include <stdio.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <functional>
 #include <memory>
@@ -62,36 +63,55 @@ static std::function<void(GLFWwindow* window, int button, int action, int mods)>
 static std::function<void(GLFWwindow* window, int width, int height)>                       windowSizeCallback;
 static std::function<void(GLFWwindow* window, double xoffset, double yoffset)>              scroll_callback;
 
+// On-demand rendering (`gui.render_mode`): after input the loop keeps drawing this many frames so ImGui hover and
+// layout settle, then sleeps in glfwWaitEventsTimeout until the next event or the timeout (autosave, toast expiry).
+constexpr int    k_frames_after_input = 3;
+constexpr double k_idle_wait_s        = 0.5;
+static int       s_frames_until_idle  = k_frames_after_input;
+
+static void note_input() { s_frames_until_idle = k_frames_after_input; }
+
 void key_callback_wrapper(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
+  note_input();
   if (keyCallback)
     keyCallback(window, key, scancode, action, mods);
 }
 
 void cursor_pos_callback_wrapper(GLFWwindow* window, double xpos, double ypos)
 {
+  note_input();
   if (cursorPosCallback)
     cursorPosCallback(window, xpos, ypos);
 }
 
 void mouse_button_callback_wrapper(GLFWwindow* window, int button, int action, int mods)
 {
+  note_input();
   if (mouseButtonCallback)
     mouseButtonCallback(window, button, action, mods);
 }
 
 void window_size_callback_wrapper(GLFWwindow* window, int width, int height)
 {
+  note_input();
   if (windowSizeCallback)
     windowSizeCallback(window, width, height);
 }
 
 void scroll_callback_wrapper(GLFWwindow* window, double xoffset, double yoffset)
 {
+  note_input();
   if (scroll_callback)
     scroll_callback(window, xoffset, yoffset);
 }
 
+void window_refresh_callback_wrapper(GLFWwindow* window)
+{
+  (void)window;
+  note_input(); // Uncovered or damaged window contents
+}
+
 using namespace glm;
 
 namespace
@@ -284,6 +304,7 @@ int main(int argc, char** argv)
       return 1;
     }
     py_queue  = std::make_unique<Python_execution_queue>();
+    py_queue->set_wake([] { glfwPostEmptyEvent(); });
     py_remote = std::make_unique<Python_remote_server>(*py_queue);
     std::string start_err;
     if (!py_remote->start(ep, start_err))
@@ -378,6 +399,7 @@ int main(int argc, char** argv)
   glfwSetMouseButtonCallback(window, mouse_button_callback_wrapper);
   glfwSetWindowSizeCallback(window, window_size_callback_wrapper);
   glfwSetScrollCallback(window, scroll_callback_wrapper);
+  glfwSetWindowRefreshCallback(window, window_refresh_callback_wrapper);
 
   // Main loop
 #ifdef __EMSCRIPTEN__
@@ -393,7 +415,18 @@ int main(int argc, char** argv)
     // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application, or clear/overwrite
     // your copy of the keyboard data. Generally you may always pass all inputs to dear imgui, and hide them from your
     // application based on those two flags.
+#ifndef __EMSCRIPTEN__
+    // Background jobs (busy dialog, cross-section) and view animations need frames without input; remote Python
+    // work posts an empty event to end the wait.
+    if (gui.render_on_demand() && s_frames_until_idle == 0 && !gui.wants_frames())
+      glfwWaitEventsTimeout(k_idle_wait_s);
+    else
+      glfwPollEvents();
+
+    s_frames_until_idle = std::max(s_frames_until_idle - 1, 0);
+#else
     glfwPollEvents();
+#endif
 
 #if !defined(__EMSCRIPTEN__) && defined(EZYCAD_HAVE_PYTHON)
     if (py_queue)
@@ -177,16 +177,27 @@ bool parse_listen_arg(const std::string& arg, Python_listen_endpoint& out, std::
   return true;
 }
 
+void Python_execution_queue::set_wake(std::function<void()> wake)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_wake = std::move(wake);
+}
+
 void Python_execution_queue::enqueue(std::string code, Completer done)
 {
   {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
     if (!m_shutdown)
     {
       Job job;
       job.code = std::move(code);
       job.done = std::move(done);
       m_jobs.push_back(std::move(job));
+      const std::function<void()> wake = m_wake;
+      lock.unlock();
+      if (wake)
+        wake();
+
       return;
     }
   }
@@ -514,6 +525,8 @@ void Python_execution_queue::enqueue(std::string code, Completer done)
   }
 }
 
+void Python_execution_queue::set_wake(std::function<void()> wake) { (void)wake; }
+
 void Python_execution_queue::process_pending(Python_console& console) { (void)console; }
 
 void Python_execution_queue::shutdown() {}
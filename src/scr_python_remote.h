@@ -30,6 +30,8 @@ public:
   using Completer = std::function<void(Python_exec_result)>;
 
   void enqueue(std::string code, Completer done);
+  /// Called after each successful `enqueue` (listener thread) so an idle main loop wakes to run the job.
+  void set_wake(std::function<void()> wake);
   void process_pending(Python_console& console);
   /// Fail all pending jobs and reject new ones (unblocks remote waiters on shutdown).
   void shutdown();
@@ -42,8 +44,9 @@ private:
   };
 
   std::mutex       m_mutex;
-  std::vector<Job> m_jobs;
-  bool             m_shutdown = false;
+  std::vector<Job>      m_jobs;
+  bool                  m_shutdown = false;
+  std::function<void()> m_wake;
 };
 
 /// Background TCP server: length-prefixed UTF-8 JSON frames for remote Python console exec.
@@ -6,6 +6,8 @@
 #include <Bnd_Box.hxx>
 #include <TopoDS_Compound.hxx>
 
+#include "utl_occt.h"
+
 namespace
 {
 gp_Ax3 default_shape_frame_(const TopoDS_Shape& shape);
@@ -23,6 +25,19 @@ Shp::Shp(AIS_InteractiveContext& ctx, const TopoDS_Shape& shp)
 {
 }
 
+Shp::Shp(AIS_InteractiveContext& ctx, const Shp_deferred_geom_ptr& geom, const gp_Ax3& frame)
+    : AIS_Shape(TopoDS_Shape())
+    , m_ctx(ctx)
+    , m_id(0)
+    , m_name("Shape")
+    , m_disp_mode(AIS_Shaded)
+    , m_visible(true)
+    , m_selection_mode(TopAbs_SHAPE)
+    , m_frame(frame)
+    , m_deferred_geom(geom)
+{
+}
+
 Shp::~Shp() {}
 
 Shp_ptr Shp::create_group(AIS_InteractiveContext& ctx, const std::string& name)
@@ -40,6 +55,15 @@ Shape_id Shp::get_id() const { return m_id; }
 
 void Shp::set_id(Shape_id id) { m_id = id; }
 
+const TopoDS_Shape& Shp::Shape() const
+{
+  // Reading deferred geometry only fills in what the shape already stands for, so it is allowed from const callers.
+  if (m_deferred_geom)
+    const_cast<Shp*>(this)->load_deferred_geom_();
+
+  return AIS_Shape::Shape();
+}
+
 const std::string& Shp::get_name() const { return m_name; }
 
 void Shp::set_name(const std::string& name) { m_name = name; }
@@ -98,7 +122,9 @@ void Shp::set_selection_mode(const TopAbs_ShapeEnum mode)
 
 void Shp::set_sketch_faint(bool enabled, AIS_DisplayMode faint_mode, float transparency)
 {
-  if (m_is_group)
+  // Leaving the override off changes nothing; redisplaying here would also read the geometry of lazily loaded shapes
+  // that callers are about to keep hidden.
+  if (m_is_group || (!enabled && !m_sketch_faint_active))
     return;
 
   m_sketch_faint_active = enabled;
@@ -107,6 +133,29 @@ void Shp::set_sketch_faint(bool enabled, AIS_DisplayMode faint_mode, float trans
   update_display_();
 }
 
+void Shp::Compute(const Handle(PrsMgr_PresentationManager)& prs_mgr, const Handle(Prs3d_Presentation)& prs,
+                  const Standard_Integer mode)
+{
+  if (m_deferred_geom)
+    load_deferred_geom_();
+
+  AIS_Shape::Compute(prs_mgr, prs, mode);
+}
+
+void Shp::ComputeSelection(const Handle(SelectMgr_Selection)& sel, const Standard_Integer mode)
+{
+  if (m_deferred_geom)
+    load_deferred_geom_();
+
+  AIS_Shape::ComputeSelection(sel, mode);
+}
+
+void Shp::load_deferred_geom_()
+{
+  const Shp_deferred_geom_ptr geom = std::move(m_deferred_geom);
+  SetShape(geom->get());
+}
+
 AIS_DisplayMode Shp::effective_disp_mode_() const { return m_sketch_faint_active ? m_faint_disp_mode : m_disp_mode; }
 
 void Shp::redisplay_()
@@ -140,6 +189,23 @@ void Shp::update_display_()
   m_ctx.UpdateCurrentViewer();
 }
 
+Shp_deferred_geom::Shp_deferred_geom(Reader read)
+    : m_read(std::move(read))
+{
+}
+
+const TopoDS_Shape& Shp_deferred_geom::get()
+{
+  if (m_read)
+  {
+    const std::optional<std::string> bytes = m_read();
+    m_shape                                = bytes ? read_brep_binary(*bytes) : TopoDS_Shape();
+    m_read                                 = nullptr;
+  }
+
+  return m_shape;
+}
+
 namespace
 {
 gp_Ax3 default_shape_frame_(const TopoDS_Shape& shape)
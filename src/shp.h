@@ -4,6 +4,10 @@
 #include <AIS_DisplayMode.hxx>
 #include <gp_Ax3.hxx>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
 
 #include "utl.h"
 
@@ -14,11 +18,38 @@ using Shape_id = uint64_t;
 class Shp;
 using Shp_ptr = opencascade::handle<Shp>;
 
+/// Shape geometry read on first use (lazy project load). Shared by the shape and any undo records taken before it was
+/// read, so all of them end up with the same TShape. UI-thread only.
+class Shp_deferred_geom
+{
+public:
+  /// `read` returns binary BRep bytes (`write_brep_binary`), or nullopt when the source cannot supply them.
+  using Reader = std::function<std::optional<std::string>()>;
+
+  explicit Shp_deferred_geom(Reader read);
+
+  /// Runs the reader once and decodes its bytes; a failed read yields a null shape.
+  const TopoDS_Shape& get();
+  bool                loaded() const { return !m_read; }
+  /// The pending reader, for writers that copy the encoded geometry as is (autosave); empty once loaded. A copy may
+  /// run on any thread its source allows (`Ezy_archive` reads are thread-safe).
+  const Reader&       reader() const { return m_read; }
+
+private:
+  Reader       m_read; // Released after the read so the source (e.g. a mapped file) can close.
+  TopoDS_Shape m_shape;
+};
+
+using Shp_deferred_geom_ptr = std::shared_ptr<Shp_deferred_geom>;
+
 /// Document shape or organizational group (group nodes have no viewer display).
 class Shp : public AIS_Shape
 {
 public:
   Shp(AIS_InteractiveContext& ctx, const TopoDS_Shape& shp);
+  /// Shape whose geometry is read when first displayed or queried. `frame` is given because the default frame would
+  /// need the geometry's bounds.
+  Shp(AIS_InteractiveContext& ctx, const Shp_deferred_geom_ptr& geom, const gp_Ax3& frame);
   /// Organizational group (empty compound geometry; never displayed).
   static Shp_ptr create_group(AIS_InteractiveContext& ctx, const std::string& name);
   virtual ~Shp();
@@ -34,6 +65,12 @@ public:
   void set_visible(const bool visible);
   void set_selection_mode(const TopAbs_ShapeEnum mode);
 
+  /// Geometry, read first if still deferred. Hides `AIS_Shape::Shape()`, which returns a null shape until then; code
+  /// holding only an `AIS_Shape` handle sees geometry once the shape has been displayed.
+  const TopoDS_Shape& Shape() const;
+  /// Pending geometry of a lazily loaded shape; null once read (or for ordinary shapes).
+  const Shp_deferred_geom_ptr& deferred_geom() const { return m_deferred_geom; }
+
   bool     is_group() const { return m_is_group; }
   Shape_id get_parent_id() const { return m_parent_id; }
   void     set_parent_id(Shape_id parent_id) { m_parent_id = parent_id; }
@@ -56,6 +93,12 @@ public:
   bool sketch_faint_active() const { return m_sketch_faint_active; }
 
 protected:
+  // Read deferred geometry before OCCT builds the presentation or selection from it.
+  void Compute(const Handle(PrsMgr_PresentationManager)& prs_mgr, const Handle(Prs3d_Presentation)& prs,
+               const Standard_Integer mode) override;
+  void ComputeSelection(const Handle(SelectMgr_Selection)& sel, const Standard_Integer mode) override;
+
+  void            load_deferred_geom_();
   void            update_display_();
   void            redisplay_();
   AIS_DisplayMode effective_disp_mode_() const;
@@ -72,6 +115,7 @@ protected:
   Shape_id                m_parent_id{0};
   int                     m_sibling_order{0};
   gp_Ax3                  m_frame;
+  Shp_deferred_geom_ptr   m_deferred_geom;
 };
 
 using Shp_rslt = Result<Shp_ptr>;
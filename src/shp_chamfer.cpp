@@ -1,6 +1,7 @@
 #include "shp_chamfer.h"
 
 #include <BRepFilletAPI_MakeChamfer.hxx>
+#include <Message_ProgressRange.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Edge.hxx>
@@ -19,17 +20,25 @@ Shp_chamfer::Shp_chamfer(Occt_view& view)
 
 Status Shp_chamfer::add_chamfer(const ScreenCoords& screen_coords, const Chamfer_mode chamfer_mode)
 {
-  Shp_ptr chamfer_src_shp = Shp_ptr::DownCast(get_shape_(screen_coords));
-  if (chamfer_src_shp.IsNull())
-    return Status::user_error("Click on a shape.");
+  Result<Shape_job> job = chamfer_job(screen_coords, chamfer_mode);
+  if (!job.is_ok())
+    return Status(job.status(), job.message());
 
-  const Shape_rec removed = capture_shape_rec(*chamfer_src_shp);
+  Shp_rslt r = job->run();
+  if (!r.is_ok())
+    return Status(r.status(), r.message());
 
-  BRepFilletAPI_MakeChamfer chamfer_maker(chamfer_src_shp->Shape());
+  return Status::ok();
+}
 
-  // Convert diagonal distance to setback distance (divide by sqrt(2))
-  const double setback_dist = m_chamfer_dist / std::sqrt(2.0);
+Result<Shape_job> Shp_chamfer::chamfer_job(const ScreenCoords& screen_coords, const Chamfer_mode chamfer_mode)
+{
+  Shp_ptr chamfer_src_shp = Shp_ptr::DownCast(get_shape_(screen_coords));
+  if (chamfer_src_shp.IsNull())
+    return Result<Shape_job>(Result_status::User_error, "Click on a shape.");
 
+  // Picked edges are copied out now; the chamfer itself is built by the job.
+  std::vector<TopoDS_Edge> edges;
   switch (chamfer_mode)
   {
   case Chamfer_mode::Shape:
@@ -37,8 +46,7 @@ Status Shp_chamfer::add_chamfer(const ScreenCoords& screen_coords, const Chamfer
     TopExp_Explorer edge_explorer(chamfer_src_shp->Shape(), TopAbs_EDGE);
     while (edge_explorer.More())
     {
-      const TopoDS_Edge& edge = TopoDS::Edge(edge_explorer.Current());
-      chamfer_maker.Add(setback_dist, edge);
+      edges.push_back(TopoDS::Edge(edge_explorer.Current()));
       edge_explorer.Next();
     }
 
@@ -49,13 +57,12 @@ Status Shp_chamfer::add_chamfer(const ScreenCoords& screen_coords, const Chamfer
   {
     const TopoDS_Face* face = get_face_(screen_coords);
     if (!face)
-      return Status::user_error("No chamfer face detected.");
+      return Result<Shape_job>(Result_status::User_error, "No chamfer face detected.");
 
     TopExp_Explorer edge_explorer(*face, TopAbs_EDGE);
     while (edge_explorer.More())
     {
-      const TopoDS_Edge& edge = TopoDS::Edge(edge_explorer.Current());
-      chamfer_maker.Add(setback_dist, edge);
+      edges.push_back(TopoDS::Edge(edge_explorer.Current()));
       edge_explorer.Next();
     }
 
@@ -66,14 +73,13 @@ Status Shp_chamfer::add_chamfer(const ScreenCoords& screen_coords, const Chamfer
   {
     const TopoDS_Wire* wire = get_wire_(screen_coords);
     if (!wire)
-      return Status::user_error("No chamfer wire detected.");
+      return Result<Shape_job>(Result_status::User_error, "No chamfer wire detected.");
 
     // Chamfer all edges in the wire
     TopExp_Explorer edge_explorer(*wire, TopAbs_EDGE);
     while (edge_explorer.More())
     {
-      const TopoDS_Edge& wire_edge = TopoDS::Edge(edge_explorer.Current());
-      chamfer_maker.Add(setback_dist, wire_edge);
+      edges.push_back(TopoDS::Edge(edge_explorer.Current()));
       edge_explorer.Next();
     }
 
@@ -84,9 +90,9 @@ Status Shp_chamfer::add_chamfer(const ScreenCoords& screen_coords, const Chamfer
   {
     const TopoDS_Edge* edge = get_edge_(screen_coords);
     if (!edge)
-      return Status::user_error("No chamfer edge detected.");
+      return Result<Shape_job>(Result_status::User_error, "No chamfer edge detected.");
 
-    chamfer_maker.Add(setback_dist, *edge);
+    edges.push_back(*edge);
     break;
   }
 
@@ -94,27 +100,42 @@ Status Shp_chamfer::add_chamfer(const ScreenCoords& screen_coords, const Chamfer
     EZY_ASSERT(false);
   }
 
-  try
-  {
-    chamfer_maker.Build();
-    Shp_ptr chamfer_shp = new Shp(ctx(), chamfer_maker.Shape());
-    replace_picked_shape_(chamfer_src_shp, chamfer_shp, "Chamfered shape");
-    view().push_undo_delta(std::make_unique<Shape_replace_delta>(std::vector<Shape_rec>{removed},
-                                                                 std::vector<Shape_rec>{capture_shape_rec(*chamfer_shp)}));
-  }
-  catch (const Standard_Failure& e)
+  // Convert diagonal distance to setback distance (divide by sqrt(2))
+  const double setback_dist = m_chamfer_dist / std::sqrt(2.0);
+
+  Shape_job job;
+  job.title   = "Chamfering";
+  job.compute = [source = chamfer_src_shp->Shape(), edges = std::move(edges),
+                 setback_dist](TopoDS_Shape& result, const Atomic_progress_indicator_ptr& progress)
   {
-    const std::string err_str = standard_failure_message(e);
-    DBG_MSG(err_str);
-    return Status::user_error(err_str);
-  }
-  catch (...)
+    BRepFilletAPI_MakeChamfer chamfer_maker(source);
+    for (const TopoDS_Edge& edge : edges)
+      chamfer_maker.Add(setback_dist, edge);
+
+    chamfer_maker.Build(progress.IsNull() ? Message_ProgressRange() : progress->Start());
+    if (!progress.IsNull() && progress->cancelled())
+      return Status::user_error("Chamfer cancelled.");
+
+    if (!chamfer_maker.IsDone())
+      return Status::user_error("Chamfer failed; try a smaller distance.");
+
+    result = chamfer_maker.Shape();
+    return Status::ok();
+  };
+  job.commit = [this, src = chamfer_src_shp](const TopoDS_Shape& result) -> Shp_rslt
   {
-    // Investigate if this happens
-    EZY_ASSERT(false);
-  }
+    if (Status st = check_operands_current_({src}); !st.is_ok())
+      return Shp_rslt(st.status(), st.message());
 
-  return Status::ok();
+    Shp_ptr         old_shp    = src;
+    const Shape_rec removed    = capture_shape_rec(*old_shp);
+    Shp_ptr         chamfer_shp = new Shp(ctx(), result);
+    replace_picked_shape_(old_shp, chamfer_shp, "Chamfered shape");
+    view().push_undo_delta(std::make_unique<Shape_replace_delta>(std::vector<Shape_rec>{removed},
+                                                                 std::vector<Shape_rec>{capture_shape_rec(*chamfer_shp)}));
+    return Shp_rslt(chamfer_shp);
+  };
+  return Result<Shape_job>(std::move(job));
 }
 
 void Shp_chamfer::set_chamfer_dist(const double dist) { m_chamfer_dist = dist; }
@@ -9,7 +9,10 @@ class Shp_chamfer : private Shp_operation_base
 public:
   Shp_chamfer(Occt_view& view);
 
+  /// Chamfer the edges picked at \a screen_coords, to completion on the calling thread.
   [[nodiscard]] Status add_chamfer(const ScreenCoords& screen_coords, const Chamfer_mode chamfer_mode);
+  /// `add_chamfer` as a `Shape_job` (GUI background run): edges are picked now, the shape is replaced on commit.
+  [[nodiscard]] Result<Shape_job> chamfer_job(const ScreenCoords& screen_coords, const Chamfer_mode chamfer_mode);
 
   void   set_chamfer_dist(const double dist);
   double get_chamfer_dist() const;
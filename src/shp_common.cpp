@@ -1,10 +1,8 @@
 #include "shp_common.h"
 
-#include <BRepAlgoAPI_Common.hxx>
-
 #include "gui_occt_view.h"
-#include "shp_delta.h"
 #include "utl.h"
+#include "utl_boolean.h"
 
 Shp_common::Shp_common(Occt_view& view)
     : Shp_operation_base(view)
@@ -13,57 +11,35 @@ Shp_common::Shp_common(Occt_view& view)
 
 Shp_rslt Shp_common::common(std::vector<Shp_ptr> shps)
 {
-  if (shps.size() < 2)
-    return Shp_rslt(Result_status::User_error, "common requires two or more shapes");
-
-  for (const Shp_ptr& shp : shps)
-    if (shp.IsNull())
-      return Shp_rslt(Result_status::User_error, "common: null shape");
-
-  m_shps = std::move(shps);
-
-  std::vector<Shape_rec> removed;
-  removed.reserve(m_shps.size());
-  for (const Shp_ptr& shp : m_shps)
-    removed.push_back(capture_shape_rec(*shp));
-
-  std::vector<Shp_ptr>::iterator itr = m_shps.begin();
-
-  // Start with the first shape
-  TopoDS_Shape result = (*itr)->Shape();
-
-  // Intersect with each subsequent shape
-  for (++itr; itr != m_shps.end(); ++itr)
-  {
-    BRepAlgoAPI_Common common_op(result, (*itr)->Shape());
+  Result<Shape_job> job = common_job(std::move(shps));
+  if (!job.is_ok())
+    return Shp_rslt(job.status(), job.message());
 
-    // Check if the operation was successful
-    if (!common_op.IsDone())
-      return Shp_rslt(Result_status::User_error, "Error: Common operation failed");
+  return job->run();
+}
 
-    // Get the result of this intersection operation
-    result = common_op.Shape();
+Result<Shape_job> Shp_common::common_job(std::vector<Shp_ptr> shps)
+{
+  return boolean_job_(Boolean_op::Common, std::move(shps), "common", "Intersecting", "Common");
+}
 
-    if (result.IsNull())
-      return Shp_rslt(Result_status::User_error, "Error: Resulting shape is null");
-  }
+Result<Shape_job> Shp_common::selected_common_job()
+{
+  if (Status st = ensure_operation_multi_shps_(); !st.is_ok())
+    return Result<Shape_job>(st.status(), st.message());
 
-  // Create a new shape from the common result
-  Shp_ptr shp = new Shp(ctx(), result);
-  shp->set_name("Common");
-  assign_result_parent_(shp, m_shps);
-  delete_operation_shps_();
-  add_shp_(shp);
-  view().push_undo_delta(
-      std::make_unique<Shape_replace_delta>(std::move(removed), std::vector<Shape_rec>{capture_shape_rec(*shp)}));
-  return Shp_rslt(shp);
+  return common_job(std::move(m_shps));
 }
 
 Status Shp_common::selected_common()
 {
-  CHK_RET(ensure_operation_multi_shps_());
-  Shp_rslt r = common(std::move(m_shps));
+  Result<Shape_job> job = selected_common_job();
+  if (!job.is_ok())
+    return Status(job.status(), job.message());
+
+  Shp_rslt r = job->run();
   if (!r.is_ok())
     return Status(r.status(), r.message());
+
   return Status::ok();
 }
@@ -10,6 +10,11 @@ public:
   /// Intersect two or more shapes; deletes inputs and adds the result. Returns the common shape.
   [[nodiscard]] Shp_rslt common(std::vector<Shp_ptr> shps);
 
-  /// Common using the current multi-shape selection (GUI).
+  /// Common using the current multi-shape selection, to completion on the calling thread.
   [[nodiscard]] Status selected_common();
+
+  /// `common` as a `Shape_job` (GUI background run); the operands are replaced when the job commits.
+  [[nodiscard]] Result<Shape_job> common_job(std::vector<Shp_ptr> shps);
+  /// `common_job` on the current multi-shape selection.
+  [[nodiscard]] Result<Shape_job> selected_common_job();
 };
@@ -5,6 +5,7 @@
 #include "utl.h"
 #include "utl_dbg.h"
 #include "utl_occt.h"
+#include "utl_parallel.h"
 
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepAlgoAPI_Common.hxx>
@@ -20,6 +21,7 @@
 #include <GeomAbs_CurveType.hxx>
 #include <Graphic3d_ClipPlane.hxx>
 #include <Graphic3d_ZLayerId.hxx>
+#include <Precision.hxx>
 #include <Quantity_Color.hxx>
 #include <Standard_Failure.hxx>
 #include <TopAbs_ShapeEnum.hxx>
@@ -35,10 +37,14 @@
 #include <array>
 #include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <limits>
+#include <list>
+#include <mutex>
 #include <optional>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -74,14 +80,69 @@ Result<Cross_section_geometry> section_one_shape_on_plane_(const TopoDS_Shape& s
 Result<Cross_section_geometry> cross_section_shape_on_plane_(const TopoDS_Shape& shape, const gp_Pln& plane);
 Result<TopoDS_Solid>           keep_half_space_(const gp_Pln& plane, const Bnd_Box& bounds);
 Result<TopoDS_Shape>           clip_solid_to_half_space_(const TopoDS_Shape& world_shape, const TopoDS_Solid& half_space);
-void                           for_each_index_(size_t count, const std::function<void(size_t)>& fn, std::atomic<bool>* cancel);
 
-std::vector<Result<Cross_section_geometry>> section_shapes_on_plane_(const std::vector<TopoDS_Shape>& world_shapes,
-                                                                     const gp_Pln& plane, std::atomic<bool>* cancel);
+Result<Cross_section_geometry> section_one_shape_cached_(Cross_section_cache& cache, const Section_cache_source& source,
+                                                        const TopoDS_Shape& world_shape, const gp_Pln& plane);
+std::vector<Result<Cross_section_geometry>> section_shapes_on_plane_(const std::vector<TopoDS_Shape>&         world_shapes,
+                                                                     const std::vector<Section_cache_source>& sources,
+                                                                     const gp_Pln& plane, Cross_section_cache& cache,
+                                                                     std::atomic<bool>* cancel);
+size_t section_bytes_(const Cross_section_geometry& geometry);
+bool   same_trsf_(const gp_Trsf& a, const gp_Trsf& b);
+bool   same_sources_(const std::vector<Section_cache_source>& a, const std::vector<Section_cache_source>& b);
+double precompute_sample_(double min_display, double max_display, int index);
+
+constexpr size_t k_section_cache_budget_bytes = size_t(64) << 20;
 Assembled_section assemble_section_geometries_(const std::vector<Result<Cross_section_geometry>>& section_results,
                                                const std::vector<std::string>&                    shape_names);
 } // namespace
 
+class Cross_section_cache
+{
+public:
+  explicit Cross_section_cache(size_t budget_bytes)
+      : m_budget_bytes(budget_bytes)
+  {
+  }
+
+  /// The cached result for \a source cut by \a plane, moved to the front of the LRU.
+  [[nodiscard]] std::optional<Result<Cross_section_geometry>> find(const Section_cache_source& source, const gp_Pln& plane);
+  /// Stores \a result, evicting the least recently used entries once over budget.
+  void insert(const Section_cache_source& source, const gp_Pln& plane, const Result<Cross_section_geometry>& result);
+  [[nodiscard]] size_t bytes() const;
+
+private:
+  struct Key
+  {
+    Shape_id                    id{0};
+    const void*                 tshape{nullptr};
+    std::array<std::int64_t, 4> plane{}; // Quantized normal and signed distance from the origin, normal sign folded
+
+    bool operator==(const Key&) const = default;
+  };
+
+  struct Key_hash
+  {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry
+  {
+    Key                            key;
+    Section_cache_source           source; // Holds the TShape so its address is not reused while cached
+    Result<Cross_section_geometry> result;
+    size_t                         bytes{0};
+  };
+
+  static Key key_(const Section_cache_source& source, const gp_Pln& plane);
+
+  mutable std::mutex                                            m_mu;
+  std::list<Entry>                                              m_lru; // Most recently used first
+  std::unordered_map<Key, std::list<Entry>::iterator, Key_hash> m_index;
+  size_t                                                        m_bytes{0};
+  size_t                                                        m_budget_bytes;
+};
+
 Result<Cross_section_geometry> cross_section_shape(const TopoDS_Shape& shape, const gp_Ax3& frame, Cross_section_plane plane,
                                                    double offset)
 {
@@ -89,12 +150,14 @@ Result<Cross_section_geometry> cross_section_shape(const TopoDS_Shape& shape, co
 }
 
 Shp_cross_section::Shp_cross_section(Occt_view& view)
-    : Shp_operation_base(view)
+    : Shp_operation_base(view),
+      m_cache(std::make_shared<Cross_section_cache>(k_section_cache_budget_bytes))
 {
 }
 
 Shp_cross_section::~Shp_cross_section()
 {
+  cancel_precompute_();
   cancel_section_jobs_();
   clear_preview_ais_();
   clear_ais_clips_();
@@ -115,6 +178,7 @@ Result<Shp_cross_section::Shared_plane> Shp_cross_section::build_shared_plane_(c
   Shared_plane shared;
   shared.shapes.reserve(shapes.size());
   shared.world_shapes.reserve(shapes.size());
+  shared.sources.reserve(shapes.size());
   shared.shape_names.reserve(shapes.size());
   gp_Ax3 shared_axes;
   bool   have_axes = false;
@@ -139,6 +203,7 @@ Result<Shp_cross_section::Shared_plane> Shp_cross_section::build_shared_plane_(c
 
     shared.shapes.push_back(shp);
     shared.world_shapes.push_back(std::move(world_shape));
+    shared.sources.push_back({shp->get_id(), shp->Shape(), shp->LocalTransformation()});
     shared.shape_names.push_back(shp->get_name());
   }
 
@@ -150,6 +215,7 @@ Result<Shp_cross_section::Shared_plane> Shp_cross_section::build_shared_plane_(c
   shared_axes.SetLocation(gp_Pnt((x_min + x_max) * 0.5, (y_min + y_max) * 0.5, (z_min + z_max) * 0.5));
 
   const double offset_model = view().to_model(m_offset_display);
+  shared.axes               = shared_axes;
   shared.plane              = cross_section_plane_(shared_axes, m_plane, offset_model, m_invert_normal);
 
   return shared;
@@ -179,6 +245,9 @@ Status Shp_cross_section::request_preview(const std::vector<Shp_ptr>& shapes)
   display_plane_annotation_(plane_ctx.bounds, plane_ctx.plane);
   // Keep last cyan wires until the new section job finishes (feels less flickery while dragging).
   enqueue_section_(plane_ctx);
+  if (m_precompute)
+    start_precompute_(plane_ctx);
+
   ctx().UpdateCurrentViewer();
 
   return Status::ok();
@@ -201,6 +270,7 @@ void Shp_cross_section::enqueue_section_(const Shared_plane& plane_ctx)
   Section_request req;
   req.generation   = gen;
   req.world_shapes = plane_ctx.world_shapes;
+  req.sources      = plane_ctx.sources;
   req.shape_names  = plane_ctx.shape_names;
   req.plane        = plane_ctx.plane;
 
@@ -224,8 +294,10 @@ void Shp_cross_section::start_section_job_(Section_request req)
   m_cancel.store(false);
 
 #ifndef __EMSCRIPTEN__
-  m_running        = std::async(std::launch::async, [req = std::move(req), cancel = &m_cancel]() mutable
-                                { return compute_section_result_(std::move(req), cancel); });
+  // Destroying the future does not wait; `cancel_section_jobs_` waits before `m_cancel` goes away.
+  m_running        = run_task_async(Task_priority::Interactive,
+                                    [req = std::move(req), cache = m_cache, cancel = &m_cancel]() mutable
+                                    { return compute_section_result_(std::move(req), *cache, cancel); });
   m_running_active = true;
 #else
   Chunked_job job;
@@ -236,10 +308,11 @@ void Shp_cross_section::start_section_job_(Section_request req)
 #endif
 }
 
-Shp_cross_section::Section_result Shp_cross_section::compute_section_result_(Section_request req, std::atomic<bool>* cancel)
+Shp_cross_section::Section_result Shp_cross_section::compute_section_result_(Section_request req, Cross_section_cache& cache,
+                                                                              std::atomic<bool>* cancel)
 {
   const std::vector<Result<Cross_section_geometry>> section_results =
-      section_shapes_on_plane_(req.world_shapes, req.plane, cancel);
+      section_shapes_on_plane_(req.world_shapes, req.sources, req.plane, cache, cancel);
 
   Section_result out;
   out.generation = req.generation;
@@ -301,7 +374,8 @@ std::optional<Status> Shp_cross_section::poll()
     }
     else if (job.next < job.request.world_shapes.size())
     {
-      job.results[job.next] = section_one_shape_on_plane_(job.request.world_shapes[job.next], job.request.plane);
+      job.results[job.next] = section_one_shape_cached_(*m_cache, job.request.sources[job.next],
+                                                        job.request.world_shapes[job.next], job.request.plane);
       ++job.next;
     }
     else
@@ -545,6 +619,7 @@ Status Shp_cross_section::clip(const std::vector<Shp_ptr>& shapes)
 
 void Shp_cross_section::clear()
 {
+  cancel_precompute_();
   cancel_section_jobs_();
   clear_preview_ais_();
   clear_ais_clips_();
@@ -625,15 +700,19 @@ void Shp_cross_section::acknowledge_current_selection() { acknowledge_inputs_(ge
 
 bool Shp_cross_section::try_get_offset_range_display(double& out_min, double& out_max)
 {
-  const std::vector<Shp_ptr> selected = get_selected_shps_();
-  if (selected.empty())
+  return offset_range_display_(get_selected_shps_(), out_min, out_max);
+}
+
+bool Shp_cross_section::offset_range_display_(const std::vector<Shp_ptr>& shapes, double& out_min, double& out_max)
+{
+  if (shapes.empty())
     return false;
 
   Bnd_Box combined_bounds;
   gp_Ax3  shared_axes;
   bool    have_axes = false;
 
-  for (const Shp_ptr& shp : selected)
+  for (const Shp_ptr& shp : shapes)
   {
     TopoDS_Shape world_shape = shape_world_(*shp);
     if (!contains_solid_(world_shape) || !append_bounds_(world_shape, combined_bounds))
@@ -668,6 +747,170 @@ bool Shp_cross_section::try_get_offset_range_display(double& out_min, double& ou
   return true;
 }
 
+void Shp_cross_section::set_precompute(bool precompute)
+{
+  m_precompute = precompute;
+  if (!precompute)
+    cancel_precompute_();
+}
+
+double Shp_cross_section::snap_offset_display(double offset_display, double min_display, double max_display) const
+{
+  if (!m_precompute || !(max_display > min_display))
+    return offset_display;
+
+  const double step  = (max_display - min_display) / (k_precompute_samples - 1);
+  const double index = std::clamp(std::round((offset_display - min_display) / step), 0.0, double(k_precompute_samples - 1));
+
+  return precompute_sample_(min_display, max_display, int(index));
+}
+
+size_t Shp_cross_section::cache_bytes() const { return m_cache->bytes(); }
+
+void Shp_cross_section::start_precompute_(const Shared_plane& plane_ctx)
+{
+  if (m_precompute_cancel && m_precompute_plane == m_plane && m_precompute_invert == m_invert_normal &&
+      same_sources_(m_precompute_sources, plane_ctx.sources))
+    return; // Same selection and plane orientation: only the offset moved
+
+  cancel_precompute_();
+
+  double min_display;
+  double max_display;
+  if (!offset_range_display_(plane_ctx.shapes, min_display, max_display))
+    return;
+
+  // Samples nearest the current offset first, so the stretch the user is dragging through fills in before the ends.
+  std::vector<int> order(k_precompute_samples);
+  for (int i = 0; i < k_precompute_samples; ++i)
+    order[i] = i;
+
+  std::stable_sort(order.begin(), order.end(),
+                   [&](int a, int b)
+                   {
+                     return std::abs(precompute_sample_(min_display, max_display, a) - m_offset_display) <
+                            std::abs(precompute_sample_(min_display, max_display, b) - m_offset_display);
+                   });
+
+  std::vector<gp_Pln> planes;
+  planes.reserve(order.size());
+  for (int i : order)
+  {
+    const double offset_model = view().to_model(precompute_sample_(min_display, max_display, i));
+    planes.push_back(cross_section_plane_(plane_ctx.axes, m_plane, offset_model, m_invert_normal));
+  }
+
+  m_precompute_cancel  = std::make_shared<std::atomic<bool>>(false);
+  m_precompute_sources = plane_ctx.sources;
+  m_precompute_plane   = m_plane;
+  m_precompute_invert  = m_invert_normal;
+
+  run_task(Task_priority::Background,
+           [cache = m_cache, cancel = m_precompute_cancel, world_shapes = plane_ctx.world_shapes,
+            sources = plane_ctx.sources, planes = std::move(planes)]
+           {
+             parallel_for_each_index(
+                 planes.size(),
+                 [&](size_t p)
+                 {
+                   for (size_t i = 0; i < world_shapes.size() && !cancel->load(); ++i)
+                     (void)section_one_shape_cached_(*cache, sources[i], world_shapes[i], planes[p]);
+                 },
+                 cancel.get());
+           });
+}
+
+void Shp_cross_section::cancel_precompute_()
+{
+  // The running task keeps its own references; it stops after the solids it is sectioning.
+  if (m_precompute_cancel)
+    m_precompute_cancel->store(true);
+
+  m_precompute_cancel.reset();
+  m_precompute_sources.clear();
+}
+
+std::optional<Result<Cross_section_geometry>> Cross_section_cache::find(const Section_cache_source& source, const gp_Pln& plane)
+{
+  const Key                   key = key_(source, plane);
+  std::lock_guard<std::mutex> lock(m_mu);
+  const auto                  it = m_index.find(key);
+  if (it == m_index.end())
+    return std::nullopt;
+
+  const Entry& entry = *it->second;
+  if (!entry.source.shape.IsEqual(source.shape) || !same_trsf_(entry.source.local_trsf, source.local_trsf))
+    return std::nullopt;
+
+  m_lru.splice(m_lru.begin(), m_lru, it->second);
+  return entry.result;
+}
+
+void Cross_section_cache::insert(const Section_cache_source& source, const gp_Pln& plane,
+                                 const Result<Cross_section_geometry>& result)
+{
+  Entry entry;
+  entry.key    = key_(source, plane);
+  entry.source = source;
+  entry.result = result;
+  entry.bytes  = sizeof(Entry) + (result.has_value() ? section_bytes_(*result) : 0);
+
+  std::lock_guard<std::mutex> lock(m_mu);
+  if (const auto it = m_index.find(entry.key); it != m_index.end())
+  {
+    m_bytes -= it->second->bytes;
+    m_lru.erase(it->second);
+    m_index.erase(it);
+  }
+
+  m_bytes += entry.bytes;
+  m_lru.push_front(std::move(entry));
+  m_index.emplace(m_lru.front().key, m_lru.begin());
+
+  while (m_bytes > m_budget_bytes && m_lru.size() > 1)
+  {
+    m_bytes -= m_lru.back().bytes;
+    m_index.erase(m_lru.back().key);
+    m_lru.pop_back();
+  }
+}
+
+size_t Cross_section_cache::bytes() const
+{
+  std::lock_guard<std::mutex> lock(m_mu);
+  return m_bytes;
+}
+
+Cross_section_cache::Key Cross_section_cache::key_(const Section_cache_source& source, const gp_Pln& plane)
+{
+  const gp_Dir& normal = plane.Axis().Direction();
+  const double  dist   = gp_Vec(plane.Location().XYZ()).Dot(gp_Vec(normal));
+
+  Key key;
+  key.id     = source.id;
+  key.tshape = source.shape.TShape().get();
+  key.plane  = {std::llround(normal.X() * 1.0e9), std::llround(normal.Y() * 1.0e9), std::llround(normal.Z() * 1.0e9),
+                std::llround(dist / Precision::Confusion())};
+
+  // A plane and its flip cut the same curves.
+  const auto first_nonzero = std::find_if(key.plane.begin(), key.plane.begin() + 3, [](std::int64_t v) { return v != 0; });
+  if (first_nonzero != key.plane.begin() + 3 && *first_nonzero < 0)
+    for (std::int64_t& v : key.plane)
+      v = -v;
+
+  return key;
+}
+
+size_t Cross_section_cache::Key_hash::operator()(const Key& key) const
+{
+  size_t h = std::hash<Shape_id>()(key.id);
+  h ^= std::hash<const void*>()(key.tshape) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+  for (std::int64_t v : key.plane)
+    h ^= std::hash<std::int64_t>()(v) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+
+  return h;
+}
+
 namespace
 {
 gp_Pln cross_section_plane_(const gp_Ax3& frame, Cross_section_plane plane, double offset, bool invert_normal)
@@ -823,74 +1066,77 @@ bool bbox_misses_plane_(const Bnd_Box& bounds, const gp_Pln& plane)
   return d_max < -tol || d_min > tol;
 }
 
-void for_each_index_(size_t count, const std::function<void(size_t)>& fn, std::atomic<bool>* cancel)
+Result<Cross_section_geometry> section_one_shape_cached_(Cross_section_cache& cache, const Section_cache_source& source,
+                                                        const TopoDS_Shape& world_shape, const gp_Pln& plane)
 {
-  if (count == 0)
-    return;
-
-#ifdef __EMSCRIPTEN__
-  for (size_t i = 0; i < count; ++i)
-  {
-    if (cancel && cancel->load())
-      break;
-
-    fn(i);
-  }
-#else
-  if (count == 1)
-  {
-    if (!(cancel && cancel->load()))
-      fn(0);
+  if (std::optional<Result<Cross_section_geometry>> cached = cache.find(source, plane))
+    return std::move(*cached);
 
-    return;
-  }
+  Result<Cross_section_geometry> result = section_one_shape_on_plane_(world_shape, plane);
+  // Misses are answers too; OCCT failures are retried next time.
+  if (result.has_value() || result.status() == Result_status::User_error)
+    cache.insert(source, plane, result);
 
-  const unsigned           hw      = std::thread::hardware_concurrency();
-  const size_t             workers = std::min(count, static_cast<size_t>(hw == 0 ? 2u : hw));
-  std::atomic<size_t>      next{0};
-  std::vector<std::thread> threads;
-  threads.reserve(workers);
-  for (size_t w = 0; w < workers; ++w)
-  {
-    threads.emplace_back(
-        [&]()
-        {
-          for (;;)
-          {
-            if (cancel && cancel->load())
-              break;
-
-            const size_t i = next.fetch_add(1, std::memory_order_relaxed);
-            if (i >= count)
-              break;
-
-            fn(i);
-          }
-        });
-  }
-  for (std::thread& t : threads)
-    t.join();
-#endif
+  return result;
 }
 
-std::vector<Result<Cross_section_geometry>> section_shapes_on_plane_(const std::vector<TopoDS_Shape>& world_shapes,
-                                                                     const gp_Pln& plane, std::atomic<bool>* cancel)
+std::vector<Result<Cross_section_geometry>> section_shapes_on_plane_(const std::vector<TopoDS_Shape>&         world_shapes,
+                                                                     const std::vector<Section_cache_source>& sources,
+                                                                     const gp_Pln& plane, Cross_section_cache& cache,
+                                                                     std::atomic<bool>* cancel)
 {
   std::vector<Result<Cross_section_geometry>> results(world_shapes.size());
-  for_each_index_(
+  parallel_for_each_index(
       world_shapes.size(),
       [&](size_t i)
       {
         if (cancel && cancel->load())
           return;
 
-        results[i] = section_one_shape_on_plane_(world_shapes[i], plane);
+        results[i] = section_one_shape_cached_(cache, sources[i], world_shapes[i], plane);
       },
       cancel);
 
   return results;
 }
 
+size_t section_bytes_(const Cross_section_geometry& geometry)
+{
+  // Rough TopoDS/Geom footprint: edge, vertices and curve handles; B-spline poles and knots on top.
+  constexpr size_t k_edge_bytes    = 1024;
+  constexpr size_t k_bspline_bytes = 4096;
+
+  return geometry.edge_count * k_edge_bytes + geometry.bspline_count * k_bspline_bytes;
+}
+
+bool same_trsf_(const gp_Trsf& a, const gp_Trsf& b)
+{
+  for (int row = 1; row <= 3; ++row)
+    for (int col = 1; col <= 4; ++col)
+      if (a.Value(row, col) != b.Value(row, col))
+        return false;
+
+  return true;
+}
+
+bool same_sources_(const std::vector<Section_cache_source>& a, const std::vector<Section_cache_source>& b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (size_t i = 0; i < a.size(); ++i)
+    if (a[i].id != b[i].id || !a[i].shape.IsEqual(b[i].shape) || !same_trsf_(a[i].local_trsf, b[i].local_trsf))
+      return false;
+
+  return true;
+}
+
+double precompute_sample_(double min_display, double max_display, int index)
+{
+  const int last = Shp_cross_section::k_precompute_samples - 1;
+  return index == last ? max_display : min_display + (max_display - min_display) * index / last;
+}
+
 Assembled_section assemble_section_geometries_(const std::vector<Result<Cross_section_geometry>>& section_results,
                                                const std::vector<std::string>&                    shape_names)
 {
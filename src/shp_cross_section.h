@@ -5,10 +5,12 @@
 #include <Bnd_Box.hxx>
 #include <gp_Ax3.hxx>
 #include <gp_Pln.hxx>
+#include <gp_Trsf.hxx>
 #include <TopoDS_Shape.hxx>
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -35,6 +37,19 @@ struct Cross_section_geometry
   std::size_t  other_curve_count{0};
 };
 
+/// What identifies one operand's section in `Cross_section_cache`: document id, geometry (`Shp::Shape()`, whose
+/// TShape changes on every edit and is held so it cannot be reused) and presentation transform.
+struct Section_cache_source
+{
+  Shape_id     id{0};
+  TopoDS_Shape shape;
+  gp_Trsf      local_trsf;
+};
+
+/// LRU of per-shape section results, keyed by `Section_cache_source` and cutting plane, evicted by estimated memory.
+/// Shared by the preview job and precompute (thread-safe; defined in shp_cross_section.cpp).
+class Cross_section_cache;
+
 /// Compute a cross-section with a plane from \a frame local coordinates. Offset is in
 /// model units along the selected local plane normal. Interactive preview uses one
 /// shared plane for the whole selection (first-shape axes, selection bbox center).
@@ -90,25 +105,39 @@ public:
   [[nodiscard]] bool preview_inputs_stale() const;
   void               acknowledge_current_selection();
   [[nodiscard]] bool try_get_offset_range_display(double& out_min, double& out_max);
+  /// Precompute: after each preview request, section the selection at `k_precompute_samples` evenly spaced offsets
+  /// across the slider range in the background (cached). Dragging the Offset slider then snaps to those samples.
+  bool get_precompute() const { return m_precompute; }
+  void set_precompute(bool precompute);
+  /// With precompute on, \a offset_display rounded to the nearest sample of [\a min_display, \a max_display]. For
+  /// slider drags only: a typed offset stays exact.
+  [[nodiscard]] double snap_offset_display(double offset_display, double min_display, double max_display) const;
+  /// Estimated memory held by cached section results.
+  [[nodiscard]] size_t cache_bytes() const;
+
+  static constexpr int k_precompute_samples = 65;
   /// Block until the current section job finishes (used by sketch import / tests).
   [[nodiscard]] Status wait_section();
 
 private:
   struct Shared_plane
   {
-    std::vector<Shp_ptr>      shapes;
-    std::vector<TopoDS_Shape> world_shapes;
-    std::vector<std::string>  shape_names;
-    Bnd_Box                   bounds;
-    gp_Pln                    plane;
+    std::vector<Shp_ptr>              shapes;
+    std::vector<TopoDS_Shape>         world_shapes;
+    std::vector<Section_cache_source> sources;
+    std::vector<std::string>          shape_names;
+    Bnd_Box                           bounds;
+    gp_Ax3                            axes; // Plane frame at offset 0
+    gp_Pln                            plane;
   };
 
   struct Section_request
   {
-    std::uint64_t             generation{0};
-    std::vector<TopoDS_Shape> world_shapes;
-    std::vector<std::string>  shape_names;
-    gp_Pln                    plane;
+    std::uint64_t                     generation{0};
+    std::vector<TopoDS_Shape>         world_shapes;
+    std::vector<Section_cache_source> sources;
+    std::vector<std::string>          shape_names;
+    gp_Pln                            plane;
   };
 
   struct Section_result
@@ -131,7 +160,12 @@ private:
   void                                cancel_section_jobs_();
   void                                enqueue_section_(const Shared_plane& plane_ctx);
   void                                start_section_job_(Section_request req);
-  [[nodiscard]] static Section_result compute_section_result_(Section_request req, std::atomic<bool>* cancel);
+  void                                start_precompute_(const Shared_plane& plane_ctx);
+  void                                cancel_precompute_();
+  [[nodiscard]] bool                  offset_range_display_(const std::vector<Shp_ptr>& shapes, double& out_min,
+                                                            double& out_max);
+  [[nodiscard]] static Section_result compute_section_result_(Section_request req, Cross_section_cache& cache,
+                                                              std::atomic<bool>* cancel);
   [[nodiscard]] std::optional<Status> finish_section_result_(Section_result result);
   [[nodiscard]] Result<Shared_plane>  build_shared_plane_(const std::vector<Shp_ptr>& shapes);
 
@@ -154,6 +188,13 @@ private:
   Graphic3d_ClipPlane_ptr m_ais_clip_plane;
   std::vector<Shp_ptr>    m_ais_clipped_shapes;
 
+  bool                                 m_precompute{false};
+  std::shared_ptr<Cross_section_cache> m_cache;                 // Shared with jobs that outlive a cancel
+  std::shared_ptr<std::atomic<bool>>   m_precompute_cancel;     // Set to stop the running precompute
+  std::vector<Section_cache_source>    m_precompute_sources;    // Inputs of the running precompute
+  Cross_section_plane                  m_precompute_plane{Cross_section_plane::XY};
+  bool                                 m_precompute_invert{false};
+
   std::atomic<std::uint64_t>     m_generation{0};
   std::atomic<bool>              m_cancel{false};
   std::optional<Section_request> m_pending;
@@ -1,11 +1,8 @@
 #include "shp_cut.h"
 
-#include <BRepAlgoAPI_Cut.hxx>
-#include <NCollection_List.hxx>
-
 #include "gui_occt_view.h"
-#include "shp_delta.h"
 #include "utl.h"
+#include "utl_boolean.h"
 
 Shp_cut::Shp_cut(Occt_view& view)
     : Shp_operation_base(view)
@@ -14,56 +11,33 @@ Shp_cut::Shp_cut(Occt_view& view)
 
 Shp_rslt Shp_cut::cut(std::vector<Shp_ptr> shps)
 {
-  if (shps.size() < 2)
-    return Shp_rslt(Result_status::User_error, "cut requires two or more shapes");
-
-  for (const Shp_ptr& shp : shps)
-    if (shp.IsNull())
-      return Shp_rslt(Result_status::User_error, "cut: null shape");
-
-  m_shps = std::move(shps);
-
-  std::vector<Shape_rec> removed;
-  removed.reserve(m_shps.size());
-  for (const Shp_ptr& shp : m_shps)
-    removed.push_back(capture_shape_rec(*shp));
-
-  std::vector<Shp_ptr>::iterator itr = m_shps.begin();
-
-  NCollection_List<TopoDS_Shape> tool_list;
-  NCollection_List<TopoDS_Shape> arguments;
-  arguments.Append((*itr)->Shape());
-  for (++itr; itr != m_shps.end(); ++itr)
-    tool_list.Append((*itr)->Shape());
+  Result<Shape_job> job = cut_job(std::move(shps));
+  if (!job.is_ok())
+    return Shp_rslt(job.status(), job.message());
 
-  BRepAlgoAPI_Cut cut_op;
-  cut_op.SetArguments(arguments);
-  cut_op.SetTools(tool_list); // Set tool shapes
-
-  // Perform difference operation
-  cut_op.Build();
-  if (!cut_op.IsDone())
-    return Shp_rslt(Result_status::User_error, "Error: Difference operation failed");
+  return job->run();
+}
 
-  const TopoDS_Shape& result_shape = cut_op.Shape();
-  if (result_shape.IsNull())
-    return Shp_rslt(Result_status::User_error, "Error: Resulting shape is null");
+Result<Shape_job> Shp_cut::cut_job(std::vector<Shp_ptr> shps)
+{
+  return boolean_job_(Boolean_op::Cut, std::move(shps), "cut", "Cutting", "Cut");
+}
 
-  Shp_ptr shp = new Shp(ctx(), result_shape);
-  shp->set_name("Cut");
-  assign_result_parent_(shp, m_shps);
-  delete_operation_shps_();
-  add_shp_(shp);
-  view().push_undo_delta(
-      std::make_unique<Shape_replace_delta>(std::move(removed), std::vector<Shape_rec>{capture_shape_rec(*shp)}));
+Result<Shape_job> Shp_cut::selected_cut_job()
+{
+  if (Status st = ensure_operation_multi_shps_(); !st.is_ok())
+    return Result<Shape_job>(st.status(), st.message());
 
-  return Shp_rslt(shp);
+  return cut_job(std::move(m_shps));
 }
 
 Status Shp_cut::selected_cut()
 {
-  CHK_RET(ensure_operation_multi_shps_());
-  Shp_rslt r = cut(std::move(m_shps));
+  Result<Shape_job> job = selected_cut_job();
+  if (!job.is_ok())
+    return Status(job.status(), job.message());
+
+  Shp_rslt r = job->run();
   if (!r.is_ok())
     return Status(r.status(), r.message());
 
@@ -11,6 +11,11 @@ public:
   /// Argument order matches selection: first shape is the body, the rest are tools.
   [[nodiscard]] Shp_rslt cut(std::vector<Shp_ptr> shps);
 
-  /// Cut using the current multi-shape selection (GUI).
+  /// Cut using the current multi-shape selection, to completion on the calling thread.
   [[nodiscard]] Status selected_cut();
+
+  /// `cut` as a `Shape_job` (GUI background run); the operands are replaced when the job commits.
+  [[nodiscard]] Result<Shape_job> cut_job(std::vector<Shp_ptr> shps);
+  /// `cut_job` on the current multi-shape selection.
+  [[nodiscard]] Result<Shape_job> selected_cut_job();
 };
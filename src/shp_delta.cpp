@@ -1,11 +1,25 @@
 #include "shp_delta.h"
 
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+
 #include "gui_occt_view.h"
 
 namespace
 {
-void remove_recs_(Occt_view& view, const std::vector<Shape_rec>& recs);
-void insert_recs_(Occt_view& view, const std::vector<Shape_rec>& recs);
+// Rough per-entity costs (topology node, geometry handle and tolerance data) for `approx_shape_bytes`.
+constexpr size_t c_face_bytes   = 640;
+constexpr size_t c_edge_bytes   = 384;
+constexpr size_t c_vertex_bytes = 128;
+
+void   remove_recs_(Occt_view& view, const std::vector<Shape_rec>& recs);
+void   insert_recs_(Occt_view& view, const std::vector<Shape_rec>& recs);
+size_t recs_bytes_(const std::vector<Shape_rec>& recs);
+void   collect_recs_geometry_(const std::vector<Shape_rec>& recs, std::vector<TopoDS_Shape>& out);
+void   collect_recs_dirty_(const std::vector<Shape_rec>& recs, Doc_dirty& out);
 void apply_links_(Occt_view& view, const std::vector<Shape_tree_delta::Link_change>& links, bool forward);
 } // namespace
 
@@ -15,15 +29,48 @@ Shape_rec capture_shape_rec(const Shp& shp)
   rec.id            = shp.get_id();
   rec.name          = shp.get_name();
   rec.material      = shp.Material();
-  rec.geom          = shp.Shape();
   rec.frame         = shp.get_frame();
   rec.parent_id     = shp.get_parent_id();
   rec.sibling_order = shp.get_sibling_order();
   rec.is_group      = shp.is_group();
   rec.visible       = shp.get_visible();
+  // A shape not read yet shares its pending geometry with the record instead of being read for it.
+  rec.deferred_geom = shp.deferred_geom();
+  if (!rec.deferred_geom)
+    rec.geom = shp.Shape();
+
   return rec;
 }
 
+size_t approx_shape_rec_bytes(const Shape_rec& rec) { return sizeof(Shape_rec) + rec.name.capacity(); }
+
+size_t approx_shape_bytes(const TopoDS_Shape& shape)
+{
+  if (shape.IsNull())
+    return 0;
+
+  TopTools_IndexedMapOfShape faces, edges, vertices;
+  TopExp::MapShapes(shape, TopAbs_FACE, faces);
+  TopExp::MapShapes(shape, TopAbs_EDGE, edges);
+  TopExp::MapShapes(shape, TopAbs_VERTEX, vertices);
+  size_t bytes = static_cast<size_t>(faces.Extent()) * c_face_bytes + static_cast<size_t>(edges.Extent()) * c_edge_bytes +
+                 static_cast<size_t>(vertices.Extent()) * c_vertex_bytes;
+
+  // Display meshes usually dominate imported and tessellated solids.
+  for (int i = 1; i <= faces.Extent(); ++i)
+  {
+    TopLoc_Location                  loc;
+    const Handle(Poly_Triangulation) tri = BRep_Tool::Triangulation(TopoDS::Face(faces(i)), loc);
+    if (tri.IsNull())
+      continue;
+
+    bytes += static_cast<size_t>(tri->NbNodes()) * (sizeof(gp_Pnt) + sizeof(gp_Pnt2d)) +
+             static_cast<size_t>(tri->NbTriangles()) * sizeof(Poly_Triangle);
+  }
+
+  return bytes;
+}
+
 Shape_add_delta::Shape_add_delta(std::vector<Shape_rec> added)
     : m_added(std::move(added))
 {
@@ -35,6 +82,12 @@ void Shape_add_delta::apply_reverse(Occt_view& view) { remove_recs_(view, m_adde
 
 std::unique_ptr<Delta> Shape_add_delta::clone() const { return std::make_unique<Shape_add_delta>(m_added); }
 
+size_t Shape_add_delta::approx_bytes() const { return sizeof(*this) + recs_bytes_(m_added); }
+
+void Shape_add_delta::collect_geometry(std::vector<TopoDS_Shape>& out) const { collect_recs_geometry_(m_added, out); }
+
+void Shape_add_delta::collect_dirty(Doc_dirty& out) const { collect_recs_dirty_(m_added, out); }
+
 Shape_remove_delta::Shape_remove_delta(std::vector<Shape_rec> removed)
     : m_removed(std::move(removed))
 {
@@ -46,6 +99,12 @@ void Shape_remove_delta::apply_reverse(Occt_view& view) { insert_recs_(view, m_r
 
 std::unique_ptr<Delta> Shape_remove_delta::clone() const { return std::make_unique<Shape_remove_delta>(m_removed); }
 
+size_t Shape_remove_delta::approx_bytes() const { return sizeof(*this) + recs_bytes_(m_removed); }
+
+void Shape_remove_delta::collect_geometry(std::vector<TopoDS_Shape>& out) const { collect_recs_geometry_(m_removed, out); }
+
+void Shape_remove_delta::collect_dirty(Doc_dirty& out) const { collect_recs_dirty_(m_removed, out); }
+
 Shape_geom_delta::Shape_geom_delta(std::vector<Geom_change> changes)
     : m_changes(std::move(changes))
 {
@@ -65,6 +124,23 @@ void Shape_geom_delta::apply_reverse(Occt_view& view)
 
 std::unique_ptr<Delta> Shape_geom_delta::clone() const { return std::make_unique<Shape_geom_delta>(m_changes); }
 
+size_t Shape_geom_delta::approx_bytes() const { return sizeof(*this) + m_changes.capacity() * sizeof(Geom_change); }
+
+void Shape_geom_delta::collect_geometry(std::vector<TopoDS_Shape>& out) const
+{
+  for (const Geom_change& ch : m_changes)
+  {
+    out.push_back(ch.before_geom);
+    out.push_back(ch.after_geom);
+  }
+}
+
+void Shape_geom_delta::collect_dirty(Doc_dirty& out) const
+{
+  for (const Geom_change& ch : m_changes)
+    out.shapes.insert(ch.id);
+}
+
 Shape_replace_delta::Shape_replace_delta(std::vector<Shape_rec> removed, std::vector<Shape_rec> added)
     : m_removed(std::move(removed))
     , m_added(std::move(added))
@@ -85,6 +161,20 @@ void Shape_replace_delta::apply_reverse(Occt_view& view)
 
 std::unique_ptr<Delta> Shape_replace_delta::clone() const { return std::make_unique<Shape_replace_delta>(m_removed, m_added); }
 
+size_t Shape_replace_delta::approx_bytes() const { return sizeof(*this) + recs_bytes_(m_removed) + recs_bytes_(m_added); }
+
+void Shape_replace_delta::collect_geometry(std::vector<TopoDS_Shape>& out) const
+{
+  collect_recs_geometry_(m_removed, out);
+  collect_recs_geometry_(m_added, out);
+}
+
+void Shape_replace_delta::collect_dirty(Doc_dirty& out) const
+{
+  collect_recs_dirty_(m_removed, out);
+  collect_recs_dirty_(m_added, out);
+}
+
 Shape_tree_delta::Shape_tree_delta(std::vector<Shape_rec> added, std::vector<Shape_rec> removed, std::vector<Link_change> links)
     : m_added(std::move(added))
     , m_removed(std::move(removed))
@@ -111,6 +201,25 @@ std::unique_ptr<Delta> Shape_tree_delta::clone() const
   return std::make_unique<Shape_tree_delta>(m_added, m_removed, m_links);
 }
 
+size_t Shape_tree_delta::approx_bytes() const
+{
+  return sizeof(*this) + recs_bytes_(m_added) + recs_bytes_(m_removed) + m_links.capacity() * sizeof(Link_change);
+}
+
+void Shape_tree_delta::collect_geometry(std::vector<TopoDS_Shape>& out) const
+{
+  collect_recs_geometry_(m_added, out);
+  collect_recs_geometry_(m_removed, out);
+}
+
+void Shape_tree_delta::collect_dirty(Doc_dirty& out) const
+{
+  collect_recs_dirty_(m_added, out);
+  collect_recs_dirty_(m_removed, out);
+  for (const Link_change& link : m_links)
+    out.shapes.insert(link.id);
+}
+
 namespace
 {
 void remove_recs_(Occt_view& view, const std::vector<Shape_rec>& recs)
@@ -125,25 +234,36 @@ void insert_recs_(Occt_view& view, const std::vector<Shape_rec>& recs)
     view.insert_shape_rec(rec);
 }
 
+size_t recs_bytes_(const std::vector<Shape_rec>& recs)
+{
+  size_t bytes = (recs.capacity() - recs.size()) * sizeof(Shape_rec);
+  for (const Shape_rec& rec : recs)
+    bytes += approx_shape_rec_bytes(rec);
+
+  return bytes;
+}
+
+void collect_recs_geometry_(const std::vector<Shape_rec>& recs, std::vector<TopoDS_Shape>& out)
+{
+  for (const Shape_rec& rec : recs)
+    if (!rec.is_group)
+      out.push_back(rec.geom);
+}
+
+void collect_recs_dirty_(const std::vector<Shape_rec>& recs, Doc_dirty& out)
+{
+  for (const Shape_rec& rec : recs)
+    out.shapes.insert(rec.id);
+}
+
 void apply_links_(Occt_view& view, const std::vector<Shape_tree_delta::Link_change>& links, bool forward)
 {
   for (const Shape_tree_delta::Link_change& ch : links)
-  {
-    Shp_ptr shp = view.find_shape_by_id(ch.id);
-    if (shp.IsNull())
-      continue;
-
     if (forward)
-    {
-      shp->set_parent_id(ch.new_parent);
-      shp->set_sibling_order(ch.new_order);
-    }
+      view.apply_shape_link(ch.id, ch.new_parent, ch.new_order);
     else
-    {
-      shp->set_parent_id(ch.old_parent);
-      shp->set_sibling_order(ch.old_order);
-    }
-  }
+      view.apply_shape_link(ch.id, ch.old_parent, ch.old_order);
+
   view.sync_sketch_shape_faint_style();
 }
 
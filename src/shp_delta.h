@@ -12,18 +12,23 @@
 /// In-memory snapshot of one document shape for undo/redo (shared TopoDS_Shape + attrs).
 struct Shape_rec
 {
-  Shape_id     id{0};
-  std::string  name;
-  int          material{0};
-  TopoDS_Shape geom;
-  gp_Ax3       frame;
-  Shape_id     parent_id{0};
-  int          sibling_order{0};
-  bool         is_group{false};
-  bool         visible{true};
+  Shape_id              id{0};
+  std::string           name;
+  int                   material{0};
+  TopoDS_Shape          geom;
+  Shp_deferred_geom_ptr deferred_geom; // Set instead of `geom` for lazily loaded shapes not yet read.
+  gp_Ax3                frame;
+  Shape_id              parent_id{0};
+  int                   sibling_order{0};
+  bool                  is_group{false};
+  bool                  visible{true};
 };
 
 Shape_rec capture_shape_rec(const Shp& shp);
+/// Heap bytes held by \a rec apart from its geometry (see `approx_shape_bytes`).
+size_t approx_shape_rec_bytes(const Shape_rec& rec);
+/// Rough heap footprint of \a shape: topology, curve/surface geometry and cached triangulation. For undo budgeting.
+size_t approx_shape_bytes(const TopoDS_Shape& shape);
 
 /// Adds shapes on forward; removes them on reverse.
 class Shape_add_delta : public Delta
@@ -34,6 +39,9 @@ public:
   void                   apply_forward(Occt_view& view) override;
   void                   apply_reverse(Occt_view& view) override;
   std::unique_ptr<Delta> clone() const override;
+  size_t                 approx_bytes() const override;
+  void                   collect_geometry(std::vector<TopoDS_Shape>& out) const override;
+  void                   collect_dirty(Doc_dirty& out) const override;
 
 private:
   std::vector<Shape_rec> m_added;
@@ -48,6 +56,9 @@ public:
   void                   apply_forward(Occt_view& view) override;
   void                   apply_reverse(Occt_view& view) override;
   std::unique_ptr<Delta> clone() const override;
+  size_t                 approx_bytes() const override;
+  void                   collect_geometry(std::vector<TopoDS_Shape>& out) const override;
+  void                   collect_dirty(Doc_dirty& out) const override;
 
 private:
   std::vector<Shape_rec> m_removed;
@@ -71,6 +82,9 @@ public:
   void                   apply_forward(Occt_view& view) override;
   void                   apply_reverse(Occt_view& view) override;
   std::unique_ptr<Delta> clone() const override;
+  size_t                 approx_bytes() const override;
+  void                   collect_geometry(std::vector<TopoDS_Shape>& out) const override;
+  void                   collect_dirty(Doc_dirty& out) const override;
 
 private:
   std::vector<Geom_change> m_changes;
@@ -85,6 +99,9 @@ public:
   void                   apply_forward(Occt_view& view) override;
   void                   apply_reverse(Occt_view& view) override;
   std::unique_ptr<Delta> clone() const override;
+  size_t                 approx_bytes() const override;
+  void                   collect_geometry(std::vector<TopoDS_Shape>& out) const override;
+  void                   collect_dirty(Doc_dirty& out) const override;
 
 private:
   std::vector<Shape_rec> m_removed;
@@ -109,6 +126,9 @@ public:
   void                   apply_forward(Occt_view& view) override;
   void                   apply_reverse(Occt_view& view) override;
   std::unique_ptr<Delta> clone() const override;
+  size_t                 approx_bytes() const override;
+  void                   collect_geometry(std::vector<TopoDS_Shape>& out) const override;
+  void                   collect_dirty(Doc_dirty& out) const override;
 
 private:
   std::vector<Shape_rec>   m_added;
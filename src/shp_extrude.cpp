@@ -6,11 +6,14 @@
 #include <BRepOffsetAPI_ThruSections.hxx>
 #include <BRepPrimAPI_MakePrism.hxx>
 #include <BRepTools.hxx>
+#include <Message_ProgressRange.hxx>
+#include <Message_ProgressScope.hxx>
 #include <Precision.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <cmath>
 #include <gp_Trsf.hxx>
+#include <utility>
 #include <vector>
 
 #include "utl_dbg.h"
@@ -19,6 +22,7 @@
 #include "gui_occt_view.h"
 #include "skt.h"
 #include "shp_delta.h"
+#include "shp_job.h"
 #include "utl.h"
 #include "utl_occt.h"
 
@@ -29,7 +33,7 @@ gp_Pnt       centroid_of_verts_(const std::vector<gp_Pnt>& verts);
 TopoDS_Wire  transform_wire_(const TopoDS_Wire& wire, const gp_Trsf& trsf);
 gp_Trsf      section_trsf_(const gp_Ax1& axis, double height_along_axis, double twist_rad);
 TopoDS_Shape loft_twisted_wire_(const TopoDS_Wire& wire, const gp_Ax1& axis, double h0, double h1, double ang0, double ang1,
-                                int n_seg);
+                                int n_seg, const Message_ProgressRange& range = Message_ProgressRange());
 std::vector<TopoDS_Wire> face_hole_wires_(const TopoDS_Face& face, const TopoDS_Wire& outer_wire);
 } // namespace
 
@@ -99,6 +103,13 @@ void Shp_extrude::finalize()
   // Lite preview only moved face copies. Always bake a shaded solid.
   clear_lite_other_face_();
   const TopoDS_Shape body = make_body_(*m_last_preview_dist, m_extrude_side, m_twist_angle);
+  if (body.IsNull())
+  {
+    gui().log_message("Extrude failed: the twisted loft or a hole cut did not build.");
+    cancel();
+    return;
+  }
+
   m_extruded->ResetTransformation();
   m_extruded->Set(body);
   m_extruded->set_disp_mode(AIS_Shaded);
@@ -415,94 +426,175 @@ void Shp_extrude::update_extrude_preview_(const double extrude_dist, const Plane
 
   // Skip redundant work when height / side / twist / phase / preview mode are unchanged.
   if (!m_extruded.IsNull() && m_last_preview_dist && m_last_preview_side == side &&
-      m_last_preview_both_sides == m_extrude_both_sides && m_lite_preview_active == lite &&
+      m_last_preview_both_sides == m_extrude_both_sides && m_last_preview_lite == lite &&
       m_last_preview_was_twist_phase == twist_phase_now &&
       std::fabs(extrude_dist - *m_last_preview_dist) <= Precision::Confusion() &&
       std::fabs(m_twist_angle - m_last_preview_twist) <= Precision::Angular())
     return;
 
-  // Switching between lite and full needs a fresh AIS object.
-  if (!m_extruded.IsNull() && m_lite_preview_active != lite)
+  if (twist_phase_now)
+    update_angle_dim_();
+  else
+    update_dim_(extrude_dist, side);
+
+  if (lite)
   {
-    clear_lite_other_face_();
+    cancel_body_tasks_();
+    show_lite_preview_(extrude_dist, side);
+  }
+  else
+  {
+    // Shaded solid built off the UI thread. The last shaded body stays up until the new one arrives, so dragging
+    // does not flash the face copy; the copy only stands in before the first body (or after a failed build).
+    request_body_preview_(body_request_(extrude_dist, side, m_twist_angle));
+    if (m_lite_preview_active || m_extruded.IsNull())
+      show_lite_preview_(extrude_dist, side);
+  }
+
+  view().update_viewer();
+  m_last_preview_dist            = extrude_dist;
+  m_last_preview_side            = side;
+  m_last_preview_both_sides      = m_extrude_both_sides;
+  m_last_preview_twist           = m_twist_angle;
+  m_last_preview_was_twist_phase = twist_phase_now;
+  m_last_preview_lite            = lite;
+}
+
+void Shp_extrude::show_lite_preview_(const double extrude_dist, const Plane_side side)
+{
+  // Dense faces: move copies of the sketch face (translate + optional twist rotation).
+  // Side walls are not previewed; finalize builds the real prism / thru-sections solid.
+  if (!m_extruded.IsNull() && !m_lite_preview_active)
+  {
+    // Switching from the shaded body needs a fresh AIS object.
     ctx().Remove(m_extruded, false);
     m_extruded.Nullify();
   }
 
-  if (twist_phase_now)
-    update_angle_dim_();
-  else
-    update_dim_(extrude_dist, side);
+  if (m_extruded.IsNull())
+  {
+    m_extruded = new Shp(ctx(), m_to_extrude->Shape());
+    m_extruded->set_disp_mode(AIS_WireFrame);
+    ctx().Display(m_extruded, AIS_WireFrame, AIS_Shape::SelectionMode(TopAbs_SHAPE), false);
+  }
 
   const double side_sign = (side == Plane_side::Front) ? 1.0 : -1.0;
+  const gp_Ax1 axis      = twist_axis_();
+  const double h_far     = m_extrude_both_sides ? (0.5 * side_sign * extrude_dist) : (side_sign * extrude_dist);
+  const double ang_far   = m_extrude_both_sides ? (0.5 * m_twist_angle) : m_twist_angle;
+  m_extruded->SetLocalTransformation(section_trsf_(axis, h_far, ang_far));
 
-  if (lite)
+  if (m_extrude_both_sides)
   {
-    // Dense faces: move copies of the sketch face (translate + optional twist rotation).
-    // Side walls are not previewed; finalize builds the real prism / thru-sections solid.
-    if (m_extruded.IsNull())
+    if (m_lite_face_other.IsNull())
     {
-      m_extruded = new Shp(ctx(), m_to_extrude->Shape());
-      m_extruded->set_disp_mode(AIS_WireFrame);
-      ctx().Display(m_extruded, AIS_WireFrame, AIS_Shape::SelectionMode(TopAbs_SHAPE), false);
+      m_lite_face_other = new AIS_Shape(m_to_extrude->Shape());
+      ctx().Display(m_lite_face_other, AIS_WireFrame, -1, false);
+      ctx().Deactivate(m_lite_face_other);
     }
 
-    const gp_Ax1 axis    = twist_axis_();
-    const double h_far   = m_extrude_both_sides ? (0.5 * side_sign * extrude_dist) : (side_sign * extrude_dist);
-    const double ang_far = m_extrude_both_sides ? (0.5 * m_twist_angle) : m_twist_angle;
-    m_extruded->SetLocalTransformation(section_trsf_(axis, h_far, ang_far));
+    const double h_near   = -0.5 * side_sign * extrude_dist;
+    const double ang_near = -0.5 * m_twist_angle;
+    m_lite_face_other->SetLocalTransformation(section_trsf_(axis, h_near, ang_near));
+    ctx().Redisplay(m_lite_face_other, false);
+  }
+  else
+    clear_lite_other_face_();
 
-    if (m_extrude_both_sides)
-    {
-      if (m_lite_face_other.IsNull())
-      {
-        m_lite_face_other = new AIS_Shape(m_to_extrude->Shape());
-        ctx().Display(m_lite_face_other, AIS_WireFrame, -1, false);
-        ctx().Deactivate(m_lite_face_other);
-      }
+  ctx().Redisplay(m_extruded, false);
+  m_lite_preview_active = true;
+}
 
-      const double h_near   = -0.5 * side_sign * extrude_dist;
-      const double ang_near = -0.5 * m_twist_angle;
-      m_lite_face_other->SetLocalTransformation(section_trsf_(axis, h_near, ang_near));
-      ctx().Redisplay(m_lite_face_other, false);
-    }
-    else
-      clear_lite_other_face_();
+void Shp_extrude::show_body_preview_(const TopoDS_Shape& body)
+{
+  clear_lite_other_face_();
+  if (!m_extruded.IsNull() && m_lite_preview_active)
+  {
+    ctx().Remove(m_extruded, false);
+    m_extruded.Nullify();
+  }
 
-    m_lite_preview_active = true;
+  if (m_extruded.IsNull())
+  {
+    m_extruded = new Shp(ctx(), body);
+    m_extruded->set_disp_mode(AIS_Shaded);
+    ctx().Display(m_extruded, AIS_Shaded, AIS_Shape::SelectionMode(TopAbs_SHAPE), false);
   }
   else
   {
-    clear_lite_other_face_();
+    m_extruded->ResetTransformation();
+    m_extruded->Set(body);
+    m_extruded->set_disp_mode(AIS_Shaded);
+  }
 
-    // Shaded solid: prism when twist ~ 0, thru-sections when twisted.
-    const TopoDS_Shape body = make_body_(extrude_dist, side, m_twist_angle);
+  m_extruded->SetMaterial(view().get_default_material());
+  view().refresh_shape_shading_(m_extruded);
+  ctx().Redisplay(m_extruded, false);
+  m_lite_preview_active = false;
+}
 
-    if (m_extruded.IsNull())
-    {
-      m_extruded = new Shp(ctx(), body);
-      m_extruded->set_disp_mode(AIS_Shaded);
-      ctx().Display(m_extruded, AIS_Shaded, AIS_Shape::SelectionMode(TopAbs_SHAPE), false);
-    }
-    else
+void Shp_extrude::request_body_preview_(Body_request req)
+{
+  req.generation = ++m_body_generation;
+  if (m_body_task)
+  {
+    m_body_pending = std::move(req);
+    return;
+  }
+
+  // `poll_preview` picks the body up on a later frame; the lite face copy stands in until then.
+  start_body_task_(std::move(req));
+}
+
+void Shp_extrude::start_body_task_(Body_request req)
+{
+  m_body_task_generation = req.generation;
+  m_body_progress        = new Atomic_progress_indicator();
+  m_body_task            = Shape_job_task::start(
+      [req = std::move(req)](TopoDS_Shape& result, const Atomic_progress_indicator_ptr& progress) -> Status
+      {
+        result = make_body_(req, progress);
+        return result.IsNull() ? Status::user_error("Extrude preview failed.") : Status::ok();
+      },
+      m_body_progress, Task_priority::Interactive, Job_thread::Pool);
+}
+
+void Shp_extrude::poll_preview()
+{
+  if (m_body_task && m_body_task->ready())
+  {
+    TopoDS_Shape body;
+    const Status status = m_body_task->take(body);
+    m_body_task.reset();
+    m_body_progress.Nullify();
+    // Older bodies are superseded by the pending request; a failed build falls back to the lite face copy.
+    if (m_body_task_generation == m_body_generation)
     {
-      m_extruded->ResetTransformation();
-      m_extruded->Set(body);
-      m_extruded->set_disp_mode(AIS_Shaded);
-    }
+      if (status.is_ok())
+        show_body_preview_(body);
+      else if (m_last_preview_dist)
+        show_lite_preview_(*m_last_preview_dist, m_last_preview_side);
 
-    m_extruded->SetMaterial(view().get_default_material());
-    view().refresh_shape_shading_(m_extruded);
-    m_lite_preview_active = false;
+      view().update_viewer();
+    }
   }
 
-  ctx().Redisplay(m_extruded, false);
-  ctx().UpdateCurrentViewer();
-  m_last_preview_dist            = extrude_dist;
-  m_last_preview_side            = side;
-  m_last_preview_both_sides      = m_extrude_both_sides;
-  m_last_preview_twist           = m_twist_angle;
-  m_last_preview_was_twist_phase = twist_phase_now;
+  if (!m_body_task && m_body_pending)
+    start_body_task_(*std::exchange(m_body_pending, std::nullopt));
+}
+
+bool Shp_extrude::preview_busy() const { return m_body_task != nullptr || m_body_pending.has_value(); }
+
+void Shp_extrude::cancel_body_tasks_()
+{
+  ++m_body_generation;
+  // Stops a twisted loft or hole cut at its next progress check instead of running on for a dropped result.
+  if (!m_body_progress.IsNull())
+    m_body_progress->request_cancel();
+
+  m_body_task.reset();
+  m_body_progress.Nullify();
+  m_body_pending.reset();
 }
 
 gp_Ax1 Shp_extrude::twist_axis_() const { return gp_Ax1(m_twist_centroid, m_to_extrude_pln.Axis().Direction()); }
@@ -522,58 +614,88 @@ double Shp_extrude::twist_dim_radius_() const
   return radius;
 }
 
-TopoDS_Shape Shp_extrude::make_prism_body_(const double extrude_dist, const Plane_side side) const
+Shp_extrude::Body_request Shp_extrude::body_request_(const double extrude_dist, const Plane_side side,
+                                                     const double twist_rad) const
 {
-  EZY_ASSERT(side != Plane_side::On);
-  EZY_ASSERT(extrude_dist > Precision::Confusion());
+  Body_request req;
+  req.face         = TopoDS::Face(m_to_extrude->Shape());
+  req.pln          = m_to_extrude_pln;
+  req.twist_axis   = twist_axis_();
+  req.both_sides   = m_extrude_both_sides;
+  req.extrude_dist = extrude_dist;
+  req.side         = side;
+  req.twist_rad    = twist_rad;
 
-  const gp_Vec normal_dir(m_to_extrude_pln.Axis().Direction());
-  const double side_sign   = (side == Plane_side::Front) ? 1.0 : -1.0;
-  const gp_Vec extrude_vec = normal_dir * (side_sign * extrude_dist);
+  return req;
+}
 
-  TopoDS_Face face = TopoDS::Face(m_to_extrude->Shape());
-  if (m_extrude_both_sides)
+TopoDS_Shape Shp_extrude::make_body_(const double extrude_dist, const Plane_side side, const double twist_rad) const
+{
+  return make_body_(body_request_(extrude_dist, side, twist_rad));
+}
+
+TopoDS_Shape Shp_extrude::make_prism_body_(const Body_request& req)
+{
+  EZY_ASSERT(req.side != Plane_side::On);
+  EZY_ASSERT(req.extrude_dist > Precision::Confusion());
+
+  const gp_Vec normal_dir(req.pln.Axis().Direction());
+  const double side_sign   = (req.side == Plane_side::Front) ? 1.0 : -1.0;
+  const gp_Vec extrude_vec = normal_dir * (side_sign * req.extrude_dist);
+
+  TopoDS_Face face = req.face;
+  if (req.both_sides)
   {
     gp_Trsf trsf;
-    trsf.SetTranslation(normal_dir * (-side_sign * (extrude_dist * 0.5)));
+    trsf.SetTranslation(normal_dir * (-side_sign * (req.extrude_dist * 0.5)));
     face = TopoDS::Face(BRepBuilderAPI_Transform(face, trsf, true).Shape());
   }
 
   return BRepPrimAPI_MakePrism(face, extrude_vec);
 }
 
-TopoDS_Shape Shp_extrude::make_body_(const double extrude_dist, const Plane_side side, const double twist_rad) const
+TopoDS_Shape Shp_extrude::make_body_(const Body_request& req, const Atomic_progress_indicator_ptr& progress)
 {
-  EZY_ASSERT(side != Plane_side::On);
-  EZY_ASSERT(extrude_dist > Precision::Confusion());
+  EZY_ASSERT(req.side != Plane_side::On);
+  EZY_ASSERT(req.extrude_dist > Precision::Confusion());
 
-  if (std::fabs(twist_rad) <= Precision::Angular())
-    return make_prism_body_(extrude_dist, side);
+  if (std::fabs(req.twist_rad) <= Precision::Angular())
+    return make_prism_body_(req);
 
-  const TopoDS_Face face       = TopoDS::Face(m_to_extrude->Shape());
-  const TopoDS_Wire outer_wire = BRepTools::OuterWire(face);
+  const TopoDS_Wire outer_wire = BRepTools::OuterWire(req.face);
   EZY_ASSERT(!outer_wire.IsNull());
 
-  const double side_sign = (side == Plane_side::Front) ? 1.0 : -1.0;
-  const gp_Ax1 axis      = twist_axis_();
+  const double side_sign = (req.side == Plane_side::Front) ? 1.0 : -1.0;
+  const gp_Ax1 axis      = req.twist_axis;
 
   // Param t in [0, 1]: height along signed extrude axis, twist from near to far.
-  const double h0   = m_extrude_both_sides ? (-0.5 * side_sign * extrude_dist) : 0.0;
-  const double h1   = m_extrude_both_sides ? (0.5 * side_sign * extrude_dist) : (side_sign * extrude_dist);
-  const double ang0 = m_extrude_both_sides ? (-0.5 * twist_rad) : 0.0;
-  const double ang1 = m_extrude_both_sides ? (0.5 * twist_rad) : twist_rad;
+  const double h0   = req.both_sides ? (-0.5 * side_sign * req.extrude_dist) : 0.0;
+  const double h1   = req.both_sides ? (0.5 * side_sign * req.extrude_dist) : (side_sign * req.extrude_dist);
+  const double ang0 = req.both_sides ? (-0.5 * req.twist_rad) : 0.0;
+  const double ang1 = req.both_sides ? (0.5 * req.twist_rad) : req.twist_rad;
 
-  const double abs_ang = std::fabs(twist_rad);
+  const double abs_ang = std::fabs(req.twist_rad);
   const int    n_seg   = std::max(1, static_cast<int>(std::ceil(abs_ang / to_radians(45.0))));
 
-  TopoDS_Shape body = loft_twisted_wire_(outer_wire, axis, h0, h1, ang0, ang1, n_seg);
+  const std::vector<TopoDS_Wire> holes = face_hole_wires_(req.face, outer_wire);
+  Message_ProgressScope          scope(progress.IsNull() ? Message_ProgressRange() : progress->Start(), "Extrude",
+                                       static_cast<double>(1 + 2 * holes.size()));
+  // A cancelled or failed loft / cut yields a null body; the caller reports it (this may run on a worker thread).
+  TopoDS_Shape body = loft_twisted_wire_(outer_wire, axis, h0, h1, ang0, ang1, n_seg, scope.Next());
+  if (body.IsNull())
+    return {};
 
   // MakePrism keeps face holes; loft only the outer wire then cut matching twisted hole solids.
-  for (const TopoDS_Wire& hole : face_hole_wires_(face, outer_wire))
+  for (const TopoDS_Wire& hole : holes)
   {
-    const TopoDS_Shape hole_body = loft_twisted_wire_(hole, axis, h0, h1, ang0, ang1, n_seg);
-    BRepAlgoAPI_Cut    cut(body, hole_body);
-    EZY_ASSERT(cut.IsDone());
+    const TopoDS_Shape hole_body = loft_twisted_wire_(hole, axis, h0, h1, ang0, ang1, n_seg, scope.Next());
+    if (hole_body.IsNull())
+      return {};
+
+    BRepAlgoAPI_Cut cut(body, hole_body, scope.Next());
+    if (!cut.IsDone())
+      return {};
+
     body = try_make_solid(cut.Shape());
   }
 
@@ -600,11 +722,12 @@ void Shp_extrude::clear_session_inputs_()
 
 void Shp_extrude::clear_preview_()
 {
+  cancel_body_tasks_();
   clear_lite_other_face_();
   clear_length_dim_();
   clear_angle_dim_();
   clear_all(m_face_edge_count, m_lite_preview_active, m_last_preview_dist, m_last_preview_side, m_last_preview_both_sides,
-            m_last_preview_twist, m_last_preview_was_twist_phase, m_phase, m_twist_angle);
+            m_last_preview_twist, m_last_preview_was_twist_phase, m_last_preview_lite, m_phase, m_twist_angle);
 }
 
 void Shp_extrude::refresh_tmp_dimension_style(const Length_dimension_style& style)
@@ -663,7 +786,7 @@ gp_Trsf section_trsf_(const gp_Ax1& axis, double height_along_axis, double twist
 /// Ruled thru-sections solid from a closed wire with height + twist along `axis`.
 /// Compatibility is off so intentional twist keeps edge/vertex pairing.
 TopoDS_Shape loft_twisted_wire_(const TopoDS_Wire& wire, const gp_Ax1& axis, const double h0, const double h1,
-                                const double ang0, const double ang1, const int n_seg)
+                                const double ang0, const double ang1, const int n_seg, const Message_ProgressRange& range)
 {
   EZY_ASSERT(!wire.IsNull());
   EZY_ASSERT(n_seg >= 1);
@@ -678,8 +801,10 @@ TopoDS_Shape loft_twisted_wire_(const TopoDS_Wire& wire, const gp_Ax1& axis, con
     maker.AddWire(transform_wire_(wire, section_trsf_(axis, height, ang)));
   }
 
-  maker.Build();
-  EZY_ASSERT(maker.IsDone());
+  // Not done after a user break on `range` or a loft OCCT could not build; the caller checks.
+  maker.Build(range);
+  if (!maker.IsDone())
+    return {};
 
   return try_make_solid(maker.Shape());
 }
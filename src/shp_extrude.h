@@ -2,15 +2,19 @@
 
 #include <PrsDim_AngleDimension.hxx>
 #include <PrsDim_LengthDimension.hxx>
+#include <TopoDS_Face.hxx>
 #include <gp_Ax1.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
+#include <cstdint>
+#include <memory>
 #include <optional>
 
 #include "utl_geom.h"
 #include "shp_operation.h"
 
 class AIS_Shape;
+class Shape_job_task;
 class V3d_View;
 enum class Plane_side;
 
@@ -35,6 +39,10 @@ public:
   /// Shift+Tab during twist phase: open angle edit; no-op in height phase.
   void begin_angle_input(const ScreenCoords& screen_coords);
   void refresh_tmp_dimension_style(const Length_dimension_style& style);
+  /// Show the preview body once its background build finishes; start the latest pending build. Call each frame.
+  void poll_preview();
+  /// A preview body is being built or waits to be (the lite face copy stands in meanwhile).
+  bool preview_busy() const;
 
 private:
   friend class Shp_extrude_access;
@@ -45,11 +53,29 @@ private:
     Twist
   };
 
+  /// `make_body_` inputs copied on the UI thread, so the preview body builds on a worker.
+  struct Body_request
+  {
+    std::uint64_t generation{0};
+    TopoDS_Face   face;
+    gp_Pln        pln;
+    gp_Ax1        twist_axis;
+    bool          both_sides{false};
+    double        extrude_dist{0.0};
+    Plane_side    side;
+    double        twist_rad{0.0};
+  };
+
   void         _update_extrude(const ScreenCoords& screen_coords);
   void         update_height_(const ScreenCoords& screen_coords);
   void         update_twist_(const ScreenCoords& screen_coords);
   void         lock_height_begin_twist_();
   void         update_extrude_preview_(double extrude_dist, Plane_side side);
+  void         show_lite_preview_(double extrude_dist, Plane_side side);
+  void         show_body_preview_(const TopoDS_Shape& body);
+  void         request_body_preview_(Body_request req);
+  void         start_body_task_(Body_request req);
+  void         cancel_body_tasks_();
   void         update_dim_(double extrude_dist, Plane_side side);
   void         update_angle_dim_();
   void         clear_length_dim_();
@@ -60,9 +86,13 @@ private:
   bool         use_lite_preview_();
   double       twist_dim_radius_() const;
   gp_Ax1       twist_axis_() const;
-  TopoDS_Shape make_prism_body_(double extrude_dist, Plane_side side) const;
+  Body_request body_request_(double extrude_dist, Plane_side side, double twist_rad) const;
   TopoDS_Shape make_body_(double extrude_dist, Plane_side side, double twist_rad) const;
 
+  static TopoDS_Shape make_prism_body_(const Body_request& req);
+  /// Null when \a progress was cancelled part way through a twisted body, or its loft / hole cut failed.
+  static TopoDS_Shape make_body_(const Body_request& req, const Atomic_progress_indicator_ptr& progress = {});
+
   // Face extrude related
   AIS_Shape_ptr         m_to_extrude;
   gp_Pln                m_to_extrude_pln;
@@ -89,4 +119,11 @@ private:
   bool                  m_last_preview_both_sides{false};
   double                m_last_preview_twist{0.0};
   bool                  m_last_preview_was_twist_phase{false};
+  bool                  m_last_preview_lite{false};
+  // Full preview bodies build on a worker; only the newest request is shown (like `Shp_cross_section`).
+  std::shared_ptr<Shape_job_task> m_body_task;               // Dropped on cancel; a late result is discarded
+  Atomic_progress_indicator_ptr   m_body_progress;           // Cancels `m_body_task`'s loft / cut when it is dropped
+  std::uint64_t                   m_body_task_generation{0};
+  std::uint64_t                   m_body_generation{0};      // Latest requested body
+  std::optional<Body_request>     m_body_pending;            // Waits for `m_body_task`
 };
@@ -1,6 +1,7 @@
 #include "shp_fillet.h"
 
 #include <BRepFilletAPI_MakeFillet.hxx>
+#include <Message_ProgressRange.hxx>
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Edge.hxx>
@@ -18,14 +19,25 @@ Shp_fillet::Shp_fillet(Occt_view& view)
 
 Status Shp_fillet::add_fillet(const ScreenCoords& screen_coords, const Fillet_mode fillet_mode)
 {
-  Shp_ptr fillet_src_shp = Shp_ptr::DownCast(get_shape_(screen_coords));
-  if (fillet_src_shp.IsNull())
-    return Status::user_error("Click on a shape.");
+  Result<Shape_job> job = fillet_job(screen_coords, fillet_mode);
+  if (!job.is_ok())
+    return Status(job.status(), job.message());
 
-  const Shape_rec removed = capture_shape_rec(*fillet_src_shp);
+  Shp_rslt r = job->run();
+  if (!r.is_ok())
+    return Status(r.status(), r.message());
 
-  BRepFilletAPI_MakeFillet fillet_maker(fillet_src_shp->Shape());
+  return Status::ok();
+}
 
+Result<Shape_job> Shp_fillet::fillet_job(const ScreenCoords& screen_coords, const Fillet_mode fillet_mode)
+{
+  Shp_ptr fillet_src_shp = Shp_ptr::DownCast(get_shape_(screen_coords));
+  if (fillet_src_shp.IsNull())
+    return Result<Shape_job>(Result_status::User_error, "Click on a shape.");
+
+  // Picked edges are copied out now; the fillet itself is built by the job.
+  std::vector<TopoDS_Edge> edges;
   switch (fillet_mode)
   {
   case Fillet_mode::Shape:
@@ -33,8 +45,7 @@ Status Shp_fillet::add_fillet(const ScreenCoords& screen_coords, const Fillet_mo
     TopExp_Explorer edge_explorer(fillet_src_shp->Shape(), TopAbs_EDGE);
     while (edge_explorer.More())
     {
-      const TopoDS_Edge& edge = TopoDS::Edge(edge_explorer.Current());
-      fillet_maker.Add(m_fillet_radius, edge);
+      edges.push_back(TopoDS::Edge(edge_explorer.Current()));
       edge_explorer.Next();
     }
 
@@ -45,13 +56,12 @@ Status Shp_fillet::add_fillet(const ScreenCoords& screen_coords, const Fillet_mo
   {
     const TopoDS_Face* face = get_face_(screen_coords);
     if (!face)
-      return Status::user_error("No fillet face detected.");
+      return Result<Shape_job>(Result_status::User_error, "No fillet face detected.");
 
     TopExp_Explorer edge_explorer(*face, TopAbs_EDGE);
     while (edge_explorer.More())
     {
-      const TopoDS_Edge& edge = TopoDS::Edge(edge_explorer.Current());
-      fillet_maker.Add(m_fillet_radius, edge);
+      edges.push_back(TopoDS::Edge(edge_explorer.Current()));
       edge_explorer.Next();
     }
 
@@ -62,14 +72,13 @@ Status Shp_fillet::add_fillet(const ScreenCoords& screen_coords, const Fillet_mo
   {
     const TopoDS_Wire* wire = get_wire_(screen_coords);
     if (!wire)
-      return Status::user_error("No fillet wire detected.");
+      return Result<Shape_job>(Result_status::User_error, "No fillet wire detected.");
 
     // Fillet all edges in the wire
     TopExp_Explorer edge_explorer(*wire, TopAbs_EDGE);
     while (edge_explorer.More())
     {
-      const TopoDS_Edge& wire_edge = TopoDS::Edge(edge_explorer.Current());
-      fillet_maker.Add(m_fillet_radius, wire_edge);
+      edges.push_back(TopoDS::Edge(edge_explorer.Current()));
       edge_explorer.Next();
     }
 
@@ -80,9 +89,9 @@ Status Shp_fillet::add_fillet(const ScreenCoords& screen_coords, const Fillet_mo
   {
     const TopoDS_Edge* edge = get_edge_(screen_coords);
     if (!edge)
-      return Status::user_error("No fillet edge detected.");
+      return Result<Shape_job>(Result_status::User_error, "No fillet edge detected.");
 
-    fillet_maker.Add(m_fillet_radius, *edge);
+    edges.push_back(*edge);
     break;
   }
 
@@ -90,27 +99,39 @@ Status Shp_fillet::add_fillet(const ScreenCoords& screen_coords, const Fillet_mo
     EZY_ASSERT(false);
   }
 
-  try
+  Shape_job job;
+  job.title   = "Filleting";
+  job.compute = [source = fillet_src_shp->Shape(), edges = std::move(edges),
+                 radius = m_fillet_radius](TopoDS_Shape& result, const Atomic_progress_indicator_ptr& progress)
   {
-    fillet_maker.Build();
-    Shp_ptr fillet_shp = new Shp(ctx(), fillet_maker.Shape());
-    replace_picked_shape_(fillet_src_shp, fillet_shp, "Filleted shape");
-    view().push_undo_delta(std::make_unique<Shape_replace_delta>(std::vector<Shape_rec>{removed},
-                                                                 std::vector<Shape_rec>{capture_shape_rec(*fillet_shp)}));
-  }
-  catch (const Standard_Failure& e)
-  {
-    const std::string err_str = standard_failure_message(e);
-    DBG_MSG(err_str);
-    return Status::user_error(err_str);
-  }
-  catch (...)
+    BRepFilletAPI_MakeFillet fillet_maker(source);
+    for (const TopoDS_Edge& edge : edges)
+      fillet_maker.Add(radius, edge);
+
+    fillet_maker.Build(progress.IsNull() ? Message_ProgressRange() : progress->Start());
+    if (!progress.IsNull() && progress->cancelled())
+      return Status::user_error("Fillet cancelled.");
+
+    if (!fillet_maker.IsDone())
+      return Status::user_error("Fillet failed; try a smaller radius.");
+
+    result = fillet_maker.Shape();
+    return Status::ok();
+  };
+  job.commit = [this, src = fillet_src_shp](const TopoDS_Shape& result) -> Shp_rslt
   {
-    // Investigate if this happens
-    EZY_ASSERT(false);
-  }
+    if (Status st = check_operands_current_({src}); !st.is_ok())
+      return Shp_rslt(st.status(), st.message());
 
-  return Status::ok();
+    Shp_ptr         old_shp    = src;
+    const Shape_rec removed    = capture_shape_rec(*old_shp);
+    Shp_ptr         fillet_shp = new Shp(ctx(), result);
+    replace_picked_shape_(old_shp, fillet_shp, "Filleted shape");
+    view().push_undo_delta(std::make_unique<Shape_replace_delta>(std::vector<Shape_rec>{removed},
+                                                                 std::vector<Shape_rec>{capture_shape_rec(*fillet_shp)}));
+    return Shp_rslt(fillet_shp);
+  };
+  return Result<Shape_job>(std::move(job));
 }
 
 void Shp_fillet::set_fillet_radius(const double radius) { m_fillet_radius = radius; }
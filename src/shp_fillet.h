@@ -9,7 +9,10 @@ class Shp_fillet : private Shp_operation_base
 public:
   Shp_fillet(Occt_view& view);
 
+  /// Fillet the edges picked at \a screen_coords, to completion on the calling thread.
   [[nodiscard]] Status add_fillet(const ScreenCoords& screen_coords, const Fillet_mode fillet_mode);
+  /// `add_fillet` as a `Shape_job` (GUI background run): edges are picked now, the shape is replaced on commit.
+  [[nodiscard]] Result<Shape_job> fillet_job(const ScreenCoords& screen_coords, const Fillet_mode fillet_mode);
 
   void   set_fillet_radius(const double radius);
   double get_fillet_radius() const;
@@ -10,6 +10,11 @@ public:
   /// Fuse two or more shapes; deletes inputs and adds the result. Returns the fused shape.
   [[nodiscard]] Shp_rslt fuse(std::vector<Shp_ptr> shps);
 
-  /// Fuse the current multi-shape selection (GUI).
+  /// Fuse the current multi-shape selection, to completion on the calling thread.
   [[nodiscard]] Status selected_fuse();
+
+  /// `fuse` as a `Shape_job` (GUI background run); the operands are replaced when the job commits.
+  [[nodiscard]] Result<Shape_job> fuse_job(std::vector<Shp_ptr> shps);
+  /// `fuse_job` on the current multi-shape selection.
+  [[nodiscard]] Result<Shape_job> selected_fuse_job();
 };
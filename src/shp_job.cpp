@@ -0,0 +1,65 @@
+#include "shp_job.h"
+
+#include <Standard_Failure.hxx>
+
+#include <exception>
+
+#include "utl_occt.h"
+
+namespace
+{
+Status run_compute_(const Shape_job::Compute& compute, TopoDS_Shape& result, const Atomic_progress_indicator_ptr& progress);
+} // namespace
+
+Shp_rslt Shape_job::run() const
+{
+  TopoDS_Shape result;
+  if (Status st = run_compute_(compute, result, {}); !st.is_ok())
+    return Shp_rslt(st.status(), st.message());
+
+  return commit(result);
+}
+
+std::shared_ptr<Shape_job_task> Shape_job_task::start(Shape_job::Compute compute, Atomic_progress_indicator_ptr progress,
+                                                      Task_priority priority, Job_thread thread)
+{
+  std::shared_ptr<Shape_job_task> task(new Shape_job_task());
+  const auto                      work = [task, compute = std::move(compute), progress = std::move(progress)]
+  {
+    task->m_status = run_compute_(compute, task->m_result, progress);
+    task->m_done.store(true, std::memory_order_release);
+  };
+
+  // The task outlives a caller that gave up on it; the thread holds the last reference until it finishes.
+  if (thread == Job_thread::Pool)
+    run_task(priority, work);
+  else
+    run_detached_task(priority, work);
+  return task;
+}
+
+Status Shape_job_task::take(TopoDS_Shape& result)
+{
+  result = std::move(m_result);
+  m_result.Nullify();
+  return m_status;
+}
+
+namespace
+{
+Status run_compute_(const Shape_job::Compute& compute, TopoDS_Shape& result, const Atomic_progress_indicator_ptr& progress)
+{
+  try
+  {
+    return compute(result, progress);
+  }
+  catch (const Standard_Failure& e)
+  {
+    return Status::user_error(standard_failure_message(e));
+  }
+  catch (const std::exception& e)
+  {
+    return Status::user_error(e.what());
+  }
+}
+} // namespace
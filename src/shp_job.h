@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <TopoDS_Shape.hxx>
+
+#include "shp.h"
+#include "utl.h"
+#include "utl_occt_progress.h"
+#include "utl_parallel.h"
+
+/// A shape operation split at the OCCT call: `compute` builds the result from geometry captured on the UI thread,
+/// `commit` puts it in the document. `GUI` runs `compute` in a `Shape_job_task` behind the busy dialog; scripts and
+/// tests call `run`.
+struct Shape_job
+{
+  /// Worker thread: reads only the captured `TopoDS_Shape` values (never the document or the viewer). \a progress
+  /// may be null; when set, `Start()` it once and stop early after `cancelled()`.
+  using Compute = std::function<Status(TopoDS_Shape& result, const Atomic_progress_indicator_ptr& progress)>;
+  /// UI thread: replaces the operands with \a result and pushes the undo delta. Fails without changes when an
+  /// operand left the document while `compute` ran.
+  using Commit  = std::function<Shp_rslt(const TopoDS_Shape& result)>;
+
+  std::string title; // Busy dialog heading, e.g. "Filleting"
+  Compute     compute;
+  Commit      commit;
+
+  /// Both halves on the calling thread.
+  [[nodiscard]] Shp_rslt run() const;
+};
+
+/// Where `Shape_job_task` runs `compute`.
+enum class Job_thread : uint8_t
+{
+  Detached, // Own thread (`run_detached_task`): busy-dialog jobs whose compute may ignore Cancel (some fillets)
+  Pool      // Shared worker pool (`run_task`): compute stops soon after Cancel, e.g. extrude preview bodies
+};
+
+/// `Shape_job::compute` running off the UI thread. Booleans poll the progress indicator and stop soon after Cancel;
+/// operations that never poll it (some fillets) keep running, so the caller drops the task instead of waiting and the
+/// result is discarded when it arrives. Such jobs run `Job_thread::Detached` so abandoned ones cannot starve imports,
+/// autosave or previews on the pool; frequent cancellable work (a preview per drag step) uses `Job_thread::Pool`.
+class Shape_job_task
+{
+public:
+  [[nodiscard]] static std::shared_ptr<Shape_job_task> start(Shape_job::Compute compute,
+                                                             Atomic_progress_indicator_ptr progress,
+                                                             Task_priority priority = Task_priority::Background,
+                                                             Job_thread thread = Job_thread::Detached);
+
+  [[nodiscard]] bool ready() const { return m_done.load(std::memory_order_acquire); }
+  /// After `ready()`: the status and shape `compute` produced (exceptions become an error status).
+  [[nodiscard]] Status take(TopoDS_Shape& result);
+
+private:
+  Shape_job_task() = default;
+
+  std::atomic<bool> m_done{false};
+  Status            m_status{Status::ok()};
+  TopoDS_Shape      m_result;
+};
@@ -4,6 +4,8 @@
 #include <unordered_set>
 
 #include "gui_occt_view.h"
+#include "shp_delta.h"
+#include "utl_boolean.h"
 
 Shp_operation_base::Shp_operation_base(Occt_view& view)
     : m_view(view)
@@ -107,6 +109,65 @@ void Shp_operation_base::restore_operation_selection_()
   m_completed_shps.clear();
 }
 
+Status Shp_operation_base::check_operands_current_(const std::vector<Shp_ptr>& shps) const
+{
+  for (const Shp_ptr& shp : shps)
+    if (shp.IsNull() || m_view.find_shape_by_id(shp->get_id()) != shp)
+      return Status::user_error("A shape used by the operation was removed while it ran.");
+
+  return Status::ok();
+}
+
+Result<Shape_job> Shp_operation_base::boolean_job_(Boolean_op op, std::vector<Shp_ptr> shps, const char* op_label,
+                                                   const char* title, const char* name)
+{
+  if (shps.size() < 2)
+    return Result<Shape_job>(Result_status::User_error, std::string(op_label) + " requires two or more shapes");
+
+  std::vector<TopoDS_Shape> operands;
+  operands.reserve(shps.size());
+  for (const Shp_ptr& shp : shps)
+  {
+    if (shp.IsNull())
+      return Result<Shape_job>(Result_status::User_error, std::string(op_label) + ": null shape");
+
+    operands.push_back(shp->Shape());
+  }
+
+  Shape_job job;
+  job.title   = title;
+  job.compute = [op, operands = std::move(operands)](TopoDS_Shape& result, const Atomic_progress_indicator_ptr& progress)
+  {
+    Boolean_params params;
+    params.progress = progress;
+    if (Status st = boolean_op_multi(op, operands, result, params); !st.is_ok())
+      return Status(st.status(), "Error: " + st.message());
+
+    return Status::ok();
+  };
+  job.commit = [this, shps = std::move(shps), name = std::string(name)](const TopoDS_Shape& result) -> Shp_rslt
+  {
+    if (Status st = check_operands_current_(shps); !st.is_ok())
+      return Shp_rslt(st.status(), st.message());
+
+    m_shps = shps;
+    std::vector<Shape_rec> removed;
+    removed.reserve(m_shps.size());
+    for (const Shp_ptr& shp : m_shps)
+      removed.push_back(capture_shape_rec(*shp));
+
+    Shp_ptr shp = new Shp(ctx(), result);
+    shp->set_name(name);
+    assign_result_parent_(shp, m_shps);
+    delete_operation_shps_();
+    add_shp_(shp);
+    view().push_undo_delta(
+        std::make_unique<Shape_replace_delta>(std::move(removed), std::vector<Shape_rec>{capture_shape_rec(*shp)}));
+    return Shp_rslt(shp);
+  };
+  return Result<Shape_job>(std::move(job));
+}
+
 AIS_Shape_ptr Shp_operation_base::get_shape_(const ScreenCoords& screen_coords) { return m_view.get_shape(screen_coords); }
 
 const TopoDS_Face* Shp_operation_base::get_face_(const ScreenCoords& screen_coords) const
@@ -140,7 +201,7 @@ void Shp_operation_base::replace_picked_shape_(Shp_ptr& old_shp, Shp_ptr& new_sh
   ctx().ClearSelected(false);
   ctx().Unhilight(old_shp, false);
   ctx().Remove(old_shp, false);
-  v.get_shapes().remove(old_shp);
+  v.erase_shp_(old_shp);
 
   new_shp->set_name(name);
   new_shp->set_parent_id(old_shp->get_parent_id());
@@ -173,5 +234,5 @@ void Shp_operation_base::redisplay_operation_shps_after_transform_()
   // from the B-Rep (re-triangulate faces, rebuild sensitive BVH) - very slow for dense shapes.
   // Dynamic highlight is disabled for Move/Rotate/Scale in Occt_view::on_mode() so stale
   // selection BVHs cannot paint a wireframe ghost at the original pose.
-  ctx().UpdateCurrentViewer();
+  view().update_viewer();
 }
\ No newline at end of file
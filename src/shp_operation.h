@@ -1,6 +1,7 @@
 #pragma once
 
 #include "shp.h"
+#include "shp_job.h"
 #include "utl_types.h"
 
 class GUI;
@@ -9,6 +10,7 @@ class AIS_InteractiveContext;
 class TopoDS_Face;
 class TopoDS_Wire;
 class TopoDS_Edge;
+enum class Boolean_op : uint8_t;
 
 class Shp_operation_base
 {
@@ -32,6 +34,12 @@ protected:
   /// Re-select the operands captured by `operation_shps_finalize_` / `operation_shps_cancel_`.
   /// Call *after* `reset()`: leaving the tool mode redisplays shapes and drops the AIS selection.
   void restore_operation_selection_();
+  /// Fails when any of \a shps is no longer in the document (a `Shape_job` commit after its compute ran).
+  [[nodiscard]] Status check_operands_current_(const std::vector<Shp_ptr>& shps) const;
+  /// `op` over \a shps (first shape first) as a job whose commit replaces them with one shape named \a name.
+  /// \a op_label prefixes the argument errors ("fuse requires two or more shapes").
+  [[nodiscard]] Result<Shape_job> boolean_job_(Boolean_op op, std::vector<Shp_ptr> shps, const char* op_label,
+                                               const char* title, const char* name);
 
   AIS_Shape_ptr      get_shape_(const ScreenCoords& screen_coords);
   const TopoDS_Face* get_face_(const ScreenCoords& screen_coords) const;
@@ -1,6 +1,5 @@
 #include "shp_polar_dup.h"
 
-#include <BRepAlgoAPI_Fuse.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
 #include <TopoDS.hxx>
@@ -14,6 +13,7 @@
 #include "skt.h"
 #include "skt_nodes.h"
 #include "shp_delta.h"
+#include "utl_boolean.h"
 
 Shp_polar_dup::Shp_polar_dup(Occt_view& view)
     : Shp_operation_base(view)
@@ -51,14 +51,16 @@ Status Shp_polar_dup::move_point(const ScreenCoords& screen_coords)
   if (m_polar_arm)
   {
     m_polar_arm->Set(polar_arm);
-    ctx().Redisplay(m_polar_arm, true);
+    ctx().Redisplay(m_polar_arm, false);
   }
   else
   {
     m_polar_arm = new AIS_Shape(polar_arm);
-    ctx().Display(m_polar_arm, true);
+    ctx().Display(m_polar_arm, false);
   }
 
+  view().update_viewer();
+
   return Status::ok();
 }
 
@@ -155,14 +157,10 @@ Status Shp_polar_dup::dup()
 
   if (m_combine_dups && !transformed_shapes.empty())
   {
-    // Combine all transformed shapes into one
+    // Combine all transformed shapes into one, in a single Boolean over every copy
     TopoDS_Shape combined_shape = transformed_shapes[0];
-    for (size_t i = 1; i < transformed_shapes.size(); ++i)
-    {
-      BRepAlgoAPI_Fuse fuse(combined_shape, transformed_shapes[i]);
-      if (fuse.IsDone())
-        combined_shape = fuse.Shape();
-    }
+    if (transformed_shapes.size() > 1)
+      CHK_RET(boolean_op_multi(Boolean_op::Fuse, transformed_shapes, combined_shape));
 
     // Create a single shape from all the combined shapes
     Shp_ptr new_shape = new Shp(ctx(), combined_shape);
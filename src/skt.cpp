@@ -126,14 +126,16 @@ void Sketch::update_edge_shp_(Edge& edge, const gp_Pnt2d& pt_a, const gp_Pnt2d&
   {
     edge.shp->Set(edge_shape);
     update_edge_style_(edge.shp);
-    m_ctx.Redisplay(edge.shp, true);
+    m_ctx.Redisplay(edge.shp, false);
   }
   else
   {
     edge.shp = new Sketch_AIS_edge(*this, edge_shape);
     update_edge_style_(edge.shp);
-    m_ctx.Display(edge.shp, true);
+    m_ctx.Display(edge.shp, false);
   }
+
+  m_view.update_viewer();
 }
 
 void Sketch::on_enter() { m_tools.on_enter(); }
@@ -176,7 +178,7 @@ std::vector<Sketch_face_shp_ptr> Sketch::get_selected_faces_() const
   return ret;
 }
 
-std::list<Sketch::Edge>::iterator Sketch::get_edge_at_(const ScreenCoords& screen_coords)
+std::optional<Sketch_edges::Edge_handle> Sketch::get_edge_at_(const ScreenCoords& screen_coords)
 {
   return m_edges.get_at(screen_coords);
 }
@@ -430,9 +432,7 @@ void Sketch::set_origin_pt(const gp_Pnt2d& pt)
   const std::optional<size_t> idx = origin_node_idx_();
   EZY_ASSERT(idx.has_value());
 
-  Sketch_nodes::Node& n = m_nodes[*idx];
-  n.SetX(pt.X());
-  n.SetY(pt.Y());
+  m_nodes.set_node_pt(*idx, pt);
   m_node_marks.sync();
 }
 
@@ -229,7 +229,7 @@ private:
   void remove_length_dimensions_referencing_node_(size_t node_idx);
 
   // Query related
-  std::list<Edge>::iterator get_edge_at_(const ScreenCoords& screen_coords);
+  std::optional<Sketch_edges::Edge_handle> get_edge_at_(const ScreenCoords& screen_coords);
 
   gp_Pnt to_3d_(size_t node_idx) const;
   gp_Pnt to_3d_(const std::optional<size_t>& node_idx) const;
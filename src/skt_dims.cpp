@@ -241,10 +241,10 @@ void Sketch_dims::toggle_edge_dim_anno(const ScreenCoords& screen_coords)
     return;
   }
 
-  if (std::list<Sketch::Edge>::iterator itr = m_sketch.get_edge_at_(screen_coords); itr != m_sketch.m_edges.edges().end())
-    if (sketch_edge_is_linear(*itr))
+  if (std::optional<Sketch_edges::Edge_handle> h = m_sketch.get_edge_at_(screen_coords))
+    if (const Sketch::Edge& edge = m_sketch.m_edges.edges()[*h]; sketch_edge_is_linear(edge))
     {
-      add_or_toggle_length_dim_between_node_indices_(itr->node_idx_a, *itr->node_idx_b);
+      add_or_toggle_length_dim_between_node_indices_(edge.node_idx_a, *edge.node_idx_b);
       clear_pick_state();
       return;
     }
@@ -295,19 +295,22 @@ void Sketch_dims::update_len_dim_rubber_line_(const ScreenCoords& screen_coords)
   {
     m_len_dim_rubber_shp->Set(edge_shape);
     m_sketch.update_edge_style_(m_len_dim_rubber_shp);
-    m_sketch.m_ctx.Redisplay(m_len_dim_rubber_shp, true);
+    m_sketch.m_ctx.Redisplay(m_len_dim_rubber_shp, false);
   }
   else
   {
     m_len_dim_rubber_shp = new AIS_Shape(edge_shape);
     m_sketch.update_edge_style_(m_len_dim_rubber_shp);
-    m_sketch.m_ctx.Display(m_len_dim_rubber_shp, AIS_WireFrame, 0, true);
+    m_sketch.m_ctx.Display(m_len_dim_rubber_shp, AIS_WireFrame, 0, false);
   }
+
+  m_sketch.m_view.update_viewer();
 }
 
 void Sketch_dims::show_tmp_dim_preview(const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b)
 {
-  m_sketch.m_ctx.Remove(m_tmp_dim_anno, true);
+  m_sketch.m_ctx.Remove(m_tmp_dim_anno, false);
+  m_sketch.m_view.update_viewer();
   if (!unique(pt_a, pt_b))
   {
     m_tmp_dim_anno.Nullify();
@@ -319,7 +322,7 @@ void Sketch_dims::show_tmp_dim_preview(const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_
       pt_a, pt_b, m_sketch.m_pln, m_sketch.m_view.gui().length_dimension_style(), approx_sketch_interior_ref_3d_(),
       m_sketch.m_topo.dim_classifier_faces().empty() ? nullptr : &m_sketch.m_topo.dim_classifier_faces());
   m_tmp_dim_anno->SetCustomValue(dist);
-  m_sketch.m_ctx.Display(m_tmp_dim_anno, true);
+  m_sketch.m_ctx.Display(m_tmp_dim_anno, false);
 }
 
 void Sketch_dims::offer_dist_edit_for_segment(const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b, double dist)
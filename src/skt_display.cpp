@@ -126,7 +126,7 @@ void Sketch::set_visible(bool state)
       for (AIS_Shape_ptr& face : m_topo.faces())
         m_ctx.Display(face, AIS_Shaded, 0, false);
 
-    for (Edge& e : m_edges.edges())
+    for (const Edge& e : m_edges.edges())
       m_ctx.Display(e.shp, AIS_WireFrame, 0, false);
 
     m_dims.on_sketch_shown();
@@ -145,7 +145,7 @@ void Sketch::set_visible(bool state)
     for (AIS_Shape_ptr& face : m_topo.faces())
       m_ctx.Erase(face, false);
 
-    for (Edge& e : m_edges.edges())
+    for (const Edge& e : m_edges.edges())
       m_ctx.Erase(e.shp, false);
 
     m_dims.on_sketch_hidden();
@@ -187,7 +187,7 @@ void Sketch::set_show_edges(bool show)
 {
   if (show && m_visible)
   {
-    for (Edge& e : m_edges.edges())
+    for (const Edge& e : m_edges.edges())
       m_ctx.Display(e.shp, AIS_WireFrame, 0, false);
 
     // Originating-face wire is the from-face profile cue; follow edge visibility so
@@ -197,7 +197,7 @@ void Sketch::set_show_edges(bool show)
   }
   else
   {
-    for (Edge& e : m_edges.edges())
+    for (const Edge& e : m_edges.edges())
       m_ctx.Erase(e.shp, false);
 
     if (m_originating_face)
@@ -270,7 +270,7 @@ void Sketch::set_edge_style(Edge_style style)
 {
   m_edge_style = style;
 
-  for (Edge& e : m_edges.edges())
+  for (const Edge& e : m_edges.edges())
   {
     update_edge_style_(e.shp);
     if (!e.shp.IsNull())
@@ -44,8 +44,8 @@ struct Sketch_edge_linear
 /// Read-only circle-arc edge (start, arc point, end).
 struct Sketch_edge_arc
 {
-  size_t              node_start;
-  size_t              node_arc;
-  size_t              node_end;
-  Sketch_AIS_edge_ptr shp;
+  size_t                node_start;
+  std::optional<size_t> node_arc; // Unset when the arc was added without midpoint nodes.
+  size_t                node_end;
+  Sketch_AIS_edge_ptr   shp;
 };
@@ -28,23 +28,158 @@ void Sketch_edges::remove_displayed()
     m_sketch.m_ctx.Remove(e.shp, false);
 
   m_edges.clear();
+  m_kind.clear();
+  m_end_a.clear();
+  m_end_b.clear();
+  m_mid.clear();
+  m_arc_pt.clear();
+  m_seg_dirty = true;
 }
 
 void Sketch_edges::remove_by_ais(const Sketch_AIS_edge& to_remove)
 {
   // Some shapes are composed with multiple edges, so we cannot break when an edge is found.
-  for (std::list<Sketch_edge>::iterator itr = m_edges.begin(); itr != m_edges.end();)
+  for (Edge_store::iterator itr = m_edges.begin(); itr != m_edges.end(); ++itr)
     if (itr->shp.get() == &to_remove)
-      itr = m_edges.erase(itr);
+      erase(itr.handle());
+}
+
+Sketch_edges::Edge_handle Sketch_edges::insert(Sketch_edge edge)
+{
+  EZY_ASSERT(edge.node_idx_b.has_value());
+  // The kind comes from the AIS curve, so classify once here rather than on every walk.
+  const Edge_kind   kind   = sketch_edge_is_arc(edge) ? Edge_kind::Arc : Edge_kind::Linear;
+  const size_t      a      = edge.node_idx_a;
+  const size_t      b      = *edge.node_idx_b;
+  const size_t      mid    = edge.node_idx_mid.value_or(k_no_node);
+  const size_t      arc_pt = edge.node_idx_arc_pt.value_or(k_no_node);
+  const Edge_handle h      = m_edges.insert(std::move(edge));
+  if (h >= m_kind.size())
+  {
+    m_kind.resize(h + 1, Edge_kind::Free);
+    m_end_a.resize(h + 1);
+    m_end_b.resize(h + 1);
+    m_mid.resize(h + 1);
+    m_arc_pt.resize(h + 1);
+  }
+
+  m_kind[h]   = kind;
+  m_end_a[h]  = a;
+  m_end_b[h]  = b;
+  m_mid[h]    = mid;
+  m_arc_pt[h] = arc_pt;
+  index_edge_(h);
+  return h;
+}
+
+void Sketch_edges::erase(Edge_handle h)
+{
+  if (!m_seg_dirty)
+    m_seg_grid.remove(h);
+
+  m_edges.erase(h);
+  m_kind[h] = Edge_kind::Free;
+}
+
+void Sketch_edges::set_name(Edge_handle h, std::string name) { m_edges[h].name = std::move(name); }
+
+std::vector<Sketch_edges::Edge_handle> Sketch_edges::edges_near(const gp_Pnt2d& a, const gp_Pnt2d& b, double pad)
+{
+  ensure_seg_index_();
+
+  const double             tol = pad + 10.0 * Precision::Confusion();
+  const glm::dvec2         lo  = glm::min(to_glm(a), to_glm(b)) - tol;
+  const glm::dvec2         hi  = glm::max(to_glm(a), to_glm(b)) + tol;
+  std::vector<Edge_handle> ret;
+  m_seg_grid.query(lo, hi, [&](size_t h) { ret.push_back(h); });
+
+  // Stable order regardless of cell layout.
+  std::sort(ret.begin(), ret.end());
+  return ret;
+}
+
+void Sketch_edges::ensure_seg_index_()
+{
+  if (!m_seg_dirty && m_seg_node_stamp != m_sketch.m_nodes.move_stamp())
+  {
+    if (const auto moves = m_sketch.m_nodes.moves_since(m_seg_node_stamp))
+    {
+      // Only edges ending at a moved node have stale bounds, and those bounds still cover the node's old position.
+      const double             tol = 10.0 * Precision::Confusion();
+      std::vector<Edge_handle> hits;
+      for (const Sketch_nodes::Node_move& move : *moves)
+      {
+        const glm::dvec2 old_pt = to_glm(move.old_pt);
+        hits.clear();
+        m_seg_grid.query(old_pt - tol, old_pt + tol, [&](size_t h) { hits.push_back(h); });
+        for (Edge_handle h : hits)
+          if (m_end_a[h] == move.idx || m_end_b[h] == move.idx)
+            index_edge_(h);
+      }
+
+      m_seg_node_stamp = m_sketch.m_nodes.move_stamp();
+    }
     else
-      ++itr;
+      m_seg_dirty = true;
+  }
+
+  // Re-pick the cell size once the edge count has grown well past the last build (amortized O(1)).
+  if (!m_seg_dirty && m_edges.size() <= 2 * m_seg_built_count + 64)
+    return;
+
+  // Aim for cells about the size of an average edge.
+  double     mean_extent = 0.0;
+  glm::dvec2 lo, hi;
+  for (const Sketch_edge& e : m_edges)
+  {
+    edge_bounds_(e, lo, hi);
+    mean_extent += std::max(hi.x - lo.x, hi.y - lo.y);
+  }
+
+  if (!m_edges.empty())
+    mean_extent /= static_cast<double>(m_edges.size());
+
+  m_seg_grid.reset(std::max(mean_extent, 100.0 * Precision::Confusion()));
+  m_seg_built_count = m_edges.size();
+  m_seg_node_stamp  = m_sketch.m_nodes.move_stamp();
+  m_seg_dirty       = false;
+  for (Edge_store::iterator itr = m_edges.begin(); itr != m_edges.end(); ++itr)
+    index_edge_(itr.handle());
+}
+
+void Sketch_edges::index_edge_(Edge_handle h)
+{
+  if (m_seg_dirty)
+    return;
+
+  glm::dvec2 lo, hi;
+  edge_bounds_(m_edges[h], lo, hi);
+  m_seg_grid.insert(h, lo, hi);
+}
+
+void Sketch_edges::edge_bounds_(const Sketch_edge& e, glm::dvec2& min, glm::dvec2& max) const
+{
+  const glm::dvec2 a = to_glm(m_sketch.m_nodes[e.node_idx_a]);
+  const glm::dvec2 b = e.node_idx_b.has_value() ? to_glm(m_sketch.m_nodes[*e.node_idx_b]) : a;
+  min                = glm::min(a, b);
+  max                = glm::max(a, b);
+
+  if (!sketch_edge_is_arc(e) || e.shp.IsNull())
+    return;
+
+  // Full circle bounds: conservative and cheap.
+  const BRepAdaptor_Curve curve(TopoDS::Edge(e.shp->Shape()));
+  const gp_Circ           circ   = curve.Circle();
+  const glm::dvec2        center = to_glm(to_2d(m_sketch.m_pln, circ.Location()));
+  min                            = glm::min(min, center - circ.Radius());
+  max                            = glm::max(max, center + circ.Radius());
 }
 
 void Sketch_edges::add_edge_raw_(const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b)
 {
   Sketch_edge edge{m_sketch.m_nodes.get_node_exact(pt_a)};
   update_end_pt(edge, m_sketch.m_nodes.get_node_exact(pt_b));
-  m_edges.emplace_back(edge);
+  insert(std::move(edge));
   m_sketch.m_nodes.finalize();
 }
 
@@ -64,8 +199,9 @@ void Sketch_edges::add_edge_impl_(const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b, Sk
   // Find intersections (crossings or T-touches) between this new segment and all *currently existing* linear edges.
   // We will split the existing ones at interior intersections, and subdivide this new one as needed.
   std::vector<gp_Pnt2d> inters;
-  for (const Sketch_edge& e : m_edges)
+  for (Edge_handle h : edges_near(pt_a, pt_b))
   {
+    const Sketch_edge& e = m_edges[h];
     if (is_linear(e))
     {
       gp_Pnt2d qa = m_sketch.m_nodes[e.node_idx_a];
@@ -87,8 +223,9 @@ void Sketch_edges::add_edge_impl_(const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b, Sk
   for (const auto& ip : inters)
   {
     bool split_here = false;
-    for (const Sketch_edge& e : m_edges)
+    for (Edge_handle h : edges_near(ip, ip))
     {
+      const Sketch_edge& e = m_edges[h];
       if (is_linear(e))
       {
         gp_Pnt2d qa = m_sketch.m_nodes[e.node_idx_a];
@@ -167,7 +304,7 @@ void Sketch_edges::sketch_json_add_linear_edge(size_t idx_a, size_t idx_b, std::
   const gp_Pnt2d& pt_a = m_sketch.m_nodes[idx_a];
   const gp_Pnt2d& pt_b = m_sketch.m_nodes[idx_b];
   m_sketch.update_edge_shp_(edge, pt_a, pt_b);
-  m_edges.emplace_back(edge);
+  insert(std::move(edge));
   m_sketch.m_nodes.finalize();
 }
 
@@ -197,10 +334,20 @@ void Sketch_edges::add_arc_circle_edges(const std::vector<size_t>& node_idxs, Sk
   const gp_Pnt2d    pt_start = m_sketch.m_nodes[node_idxs[0]];
   const gp_Pnt2d    pt_end   = m_sketch.m_nodes[node_idxs[1]];
 
-  // Intersections with all existing edges (split both olds and the new arc).
+  // Intersections with all existing edges near the arc (split both olds and the new arc).
+  glm::dvec2 arc_lo, arc_hi;
+  {
+    const BRepAdaptor_Curve curve(new_edge);
+    const gp_Circ           circ   = curve.Circle();
+    const glm::dvec2        center = to_glm(to_2d(m_sketch.m_pln, circ.Location()));
+    arc_lo                         = center - circ.Radius();
+    arc_hi                         = center + circ.Radius();
+  }
+
   std::vector<gp_Pnt2d> inters;
-  for (const Sketch_edge& e : m_edges)
+  for (Edge_handle h : edges_near(gp_Pnt2d(arc_lo.x, arc_lo.y), gp_Pnt2d(arc_hi.x, arc_hi.y)))
   {
+    const Sketch_edge& e = m_edges[h];
     if (is_linear(e))
     {
       const gp_Pnt2d qa = m_sketch.m_nodes[e.node_idx_a];
@@ -225,8 +372,9 @@ void Sketch_edges::add_arc_circle_edges(const std::vector<size_t>& node_idxs, Sk
   for (const gp_Pnt2d& ip : inters)
   {
     bool split_here = false;
-    for (const Sketch_edge& e : m_edges)
+    for (Edge_handle h : edges_near(ip, ip))
     {
+      const Sketch_edge& e = m_edges[h];
       if (is_linear(e))
       {
         const gp_Pnt2d qa = m_sketch.m_nodes[e.node_idx_a];
@@ -269,7 +417,7 @@ void Sketch_edges::add_arc_circle_edges(const std::vector<size_t>& node_idxs, Sk
   m_sketch.m_ctx.Display(shp, false);
 
   // One graph edge per arc; endpoints are start and end only.
-  m_edges.push_back({node_idxs[0], node_idxs[1], arc_pt_idx, std::nullopt, shp});
+  insert({node_idxs[0], node_idxs[1], arc_pt_idx, std::nullopt, shp});
 
   for (const gp_Pnt2d& ip : inters)
   {
@@ -284,19 +432,20 @@ void Sketch_edges::add_arc_circle_edges(const std::vector<size_t>& node_idxs, Sk
   }
 }
 
-void Sketch_edges::split_arc_at_node_(std::list<Sketch_edge>::iterator itr, size_t split_idx, Sketch_op_recorder* rec)
+void Sketch_edges::split_arc_at_node_(Edge_handle h, size_t split_idx, Sketch_op_recorder* rec)
 {
-  EZY_ASSERT(sketch_edge_is_arc(*itr));
-  EZY_ASSERT(itr->node_idx_b.has_value());
+  const Sketch_edge& edge = m_edges[h];
+  EZY_ASSERT(sketch_edge_is_arc(edge));
+  EZY_ASSERT(edge.node_idx_b.has_value());
 
-  const size_t idx_a = itr->node_idx_a;
-  const size_t idx_b = *itr->node_idx_b;
+  const size_t idx_a = edge.node_idx_a;
+  const size_t idx_b = *edge.node_idx_b;
   EZY_ASSERT(split_idx != idx_a && split_idx != idx_b);
 
-  const TopoDS_Edge occ_edge = TopoDS::Edge(itr->shp->Shape());
+  const TopoDS_Edge occ_edge = TopoDS::Edge(edge.shp->Shape());
   if (rec)
   {
-    const gp_Pnt2d arc_pt = itr->node_idx_arc_pt.has_value() ? m_sketch.m_nodes[*itr->node_idx_arc_pt]
+    const gp_Pnt2d arc_pt = edge.node_idx_arc_pt.has_value() ? m_sketch.m_nodes[*edge.node_idx_arc_pt]
                                                              : arc_curve_midpoint_2d(occ_edge, m_sketch.m_pln);
     rec->note_prev_arc_edge(m_sketch.m_nodes[idx_a], arc_pt, m_sketch.m_nodes[idx_b]);
   }
@@ -320,8 +469,8 @@ void Sketch_edges::split_arc_at_node_(std::list<Sketch_edge>::iterator itr, size
   const gp_Pnt2d bulge1 = to_2d(m_sketch.m_pln, curve.Value((u_a + u_split) * 0.5));
   const gp_Pnt2d bulge2 = to_2d(m_sketch.m_pln, curve.Value((u_split + u_b) * 0.5));
 
-  m_sketch.m_ctx.Remove(itr->shp, false);
-  m_sketch.m_edges.edges().erase(itr);
+  m_sketch.m_ctx.Remove(edge.shp, false);
+  erase(h);
 
   const size_t bulge1_idx = m_sketch.m_nodes.get_node_exact(bulge1);
   const size_t bulge2_idx = m_sketch.m_nodes.get_node_exact(bulge2);
@@ -339,26 +488,32 @@ void Sketch_edges::split_arc_at_node_(std::list<Sketch_edge>::iterator itr, size
 
 void Sketch_edges::for_each_linear(const Linear_visitor& fn) const
 {
-  for (const Sketch_edge& e : m_edges)
+  for (Edge_handle h = 0; h < m_kind.size(); ++h)
   {
-    if (!is_linear(e))
+    if (m_kind[h] != Edge_kind::Linear)
       continue;
 
-    EZY_ASSERT(e.node_idx_b.has_value());
-    fn(Sketch_edge_linear{e.node_idx_a, *e.node_idx_b, e.node_idx_mid});
+    std::optional<size_t> mid;
+    if (m_mid[h] != k_no_node)
+      mid = m_mid[h];
+
+    fn(Sketch_edge_linear{m_end_a[h], m_end_b[h], mid});
   }
 }
 
 void Sketch_edges::for_each_arc(const Arc_visitor& fn) const
 {
-  for (const Sketch_edge& e : m_edges)
+  for (Edge_handle h = 0; h < m_kind.size(); ++h)
   {
-    if (!sketch_edge_is_arc(e))
+    if (m_kind[h] != Edge_kind::Arc)
       continue;
 
-    EZY_ASSERT(e.node_idx_b.has_value());
-    EZY_ASSERT(e.node_idx_arc_pt.has_value());
-    fn(Sketch_edge_arc{e.node_idx_a, *e.node_idx_arc_pt, *e.node_idx_b, e.shp});
+    std::optional<size_t> arc_pt;
+    if (m_arc_pt[h] != k_no_node)
+      arc_pt = m_arc_pt[h];
+
+    // Only the AIS shape comes from the cold record.
+    fn(Sketch_edge_arc{m_end_a[h], arc_pt, m_end_b[h], m_edges[h].shp});
   }
 }
 
@@ -373,14 +528,14 @@ std::vector<Sketch_edge> Sketch_edges::get_selected() const
   return ret;
 }
 
-std::list<Sketch_edge>::iterator Sketch_edges::get_at(const ScreenCoords& screen_coords)
+std::optional<Sketch_edges::Edge_handle> Sketch_edges::get_at(const ScreenCoords& screen_coords)
 {
   AIS_Shape_ptr shp = m_sketch.m_view.get_shape(screen_coords);
   if (auto edge = dynamic_cast<Sketch_AIS_edge*>(shp.get()); edge)
     if (&edge->owner_sketch == &m_sketch)
-      for (std::list<Sketch_edge>::iterator itr = m_edges.begin(); itr != m_edges.end(); ++itr)
+      for (Edge_store::iterator itr = m_edges.begin(); itr != m_edges.end(); ++itr)
         if (itr->shp.get() == edge)
-          return itr;
+          return itr.handle();
 
-  return m_edges.end();
+  return std::nullopt;
 }
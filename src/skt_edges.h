@@ -1,21 +1,48 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <gp_Pnt2d.hxx>
-#include <list>
 #include <optional>
+#include <span>
+#include <string>
 #include <vector>
 
 #include "skt_edge.h"
+#include "utl_grid_index.h"
+#include "utl_slot_vector.h"
 #include "utl_types.h"
 
 class Sketch;
 class Sketch_op_recorder;
 
 /// Persistent sketch edge list and edge CRUD (add, pick, remove, JSON load).
+///
+/// Edges live in a `Slot_vector`; an `Edge_handle` stays valid until its edge is erased. The node indices and kind of
+/// each edge are also kept per handle as a structure of arrays (`kinds`, `end_nodes_a`, ...), which the topology graph
+/// passes, the `for_each_*` visitors and the JSON writer read; the `Sketch_edge` records are the cold side (AIS shape,
+/// name) used for display, picking and edits. A segment index (uniform grid over edge bounds) backs the split, snap,
+/// and intersection queries. `edges()` is read-only: every change to a stored edge goes through `insert`, `erase` or
+/// `set_name`, so the records, the arrays and the index cannot drift apart. An edge's node indices never change once
+/// it is inserted; replace the edge instead. Node moves reach the index through `Sketch_nodes::moves_since`, which
+/// re-indexes only the edges ending at a moved node.
 class Sketch_edges
 {
 public:
+  using Edge_store  = Slot_vector<Sketch_edge>;
+  using Edge_handle = Edge_store::Handle;
+
+  /// What a slot holds; `Free` for erased handles.
+  enum class Edge_kind : uint8_t
+  {
+    Free,
+    Linear,
+    Arc
+  };
+
+  /// Optional node (`mid_nodes`, `arc_pt_nodes`) that is not set.
+  static constexpr size_t k_no_node = SIZE_MAX;
+
   explicit Sketch_edges(Sketch& sketch);
 
   void add_edge(const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b);
@@ -28,14 +55,32 @@ public:
   void remove_by_ais(const Sketch_AIS_edge& to_remove);
   void remove_displayed();
 
-  [[nodiscard]] std::list<Sketch_edge>::iterator get_at(const ScreenCoords& screen_coords);
-  [[nodiscard]] std::vector<Sketch_edge>         get_selected() const;
+  /// Stores `edge` and adds it to the segment index.
+  Edge_handle insert(Sketch_edge edge);
+  /// Removes edge `h` from the store and the segment index (the AIS shape is left to the caller). Iterators on other
+  /// edges stay valid, so erasing while walking `edges()` is safe.
+  void        erase(Edge_handle h);
+  /// Renames edge `h` (the only record field that may change in place).
+  void        set_name(Edge_handle h, std::string name);
+
+  /// Edges whose bounds come within `pad` (plus a small tolerance) of the box spanned by `a` and `b`, in handle
+  /// order. Broad phase only: callers run the exact test.
+  [[nodiscard]] std::vector<Edge_handle> edges_near(const gp_Pnt2d& a, const gp_Pnt2d& b, double pad = 0.0);
+
+  [[nodiscard]] std::optional<Edge_handle> get_at(const ScreenCoords& screen_coords);
+  [[nodiscard]] std::vector<Sketch_edge>   get_selected() const;
 
   [[nodiscard]] bool   empty() const { return m_edges.empty(); }
   [[nodiscard]] size_t size() const { return m_edges.size(); }
 
-  [[nodiscard]] const std::list<Sketch_edge>& edges() const { return m_edges; }
-  [[nodiscard]] std::list<Sketch_edge>&       edges() { return m_edges; }
+  [[nodiscard]] const Edge_store& edges() const { return m_edges; }
+
+  /// Per-handle edge geometry (`edges().slot_count()` entries; stale for `Free` slots).
+  [[nodiscard]] std::span<const Edge_kind> kinds() const { return m_kind; }
+  [[nodiscard]] std::span<const size_t>    end_nodes_a() const { return m_end_a; }
+  [[nodiscard]] std::span<const size_t>    end_nodes_b() const { return m_end_b; }
+  [[nodiscard]] std::span<const size_t>    mid_nodes() const { return m_mid; }       // `k_no_node` when absent
+  [[nodiscard]] std::span<const size_t>    arc_pt_nodes() const { return m_arc_pt; } // `k_no_node` when absent
 
   static bool is_linear(const Sketch_edge& e) { return sketch_edge_is_linear(e); }
 
@@ -51,8 +96,25 @@ private:
 
   void add_edge_raw_(const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b);
   void add_edge_impl_(const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b, Sketch_op_recorder* rec);
-  void split_arc_at_node_(std::list<Sketch_edge>::iterator itr, size_t split_idx, Sketch_op_recorder* rec);
-
-  Sketch&                m_sketch;
-  std::list<Sketch_edge> m_edges;
+  void split_arc_at_node_(Edge_handle h, size_t split_idx, Sketch_op_recorder* rec);
+
+  void ensure_seg_index_();
+  void index_edge_(Edge_handle h);
+  void edge_bounds_(const Sketch_edge& e, glm::dvec2& min, glm::dvec2& max) const;
+
+  Sketch&    m_sketch;
+  Edge_store m_edges;
+
+  // Hot per-handle structure of arrays; see `kinds`.
+  std::vector<Edge_kind> m_kind;
+  std::vector<size_t>    m_end_a;
+  std::vector<size_t>    m_end_b;
+  std::vector<size_t>    m_mid;
+  std::vector<size_t>    m_arc_pt;
+
+  // Segment index keyed by edge handle; patched from the node move log, rebuilt lazily when dirty.
+  Grid_index_2d m_seg_grid;
+  size_t        m_seg_built_count{0}; // Edge count when the cell size was chosen.
+  uint64_t      m_seg_node_stamp{0};  // `Sketch_nodes::move_stamp` the index reflects.
+  bool          m_seg_dirty{true};
 };
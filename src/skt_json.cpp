@@ -20,6 +20,7 @@
 #include "utl_asset_store.h"
 #include "gui_occt_view.h"
 #include "utl_json.h"
+#include "utl_occt.h"
 
 using json = nlohmann::json;
 
@@ -117,7 +118,7 @@ void Sketch_json::from_json_legacy_coords_(Sketch& ret, const json& j,
     }
 }
 
-nlohmann::json Sketch_json::to_json(const Sketch& sketch, const Ezy_asset_store& assets)
+nlohmann::json Sketch_json::to_json(const Sketch& sketch, const Ezy_asset_store& assets, Ezy_geom_entries* geoms)
 {
   json j;
   j["isCurrent"] = sketch.is_current();
@@ -131,9 +132,18 @@ nlohmann::json Sketch_json::to_json(const Sketch& sketch, const Ezy_asset_store&
   if (sketch.m_originating_face)
   {
     const TopoDS_Shape& shape = sketch.m_originating_face->Shape();
-    std::ostringstream  oss;
-    BRepTools::Write(shape, oss, false, false, TopTools_FormatVersion_CURRENT);
-    j["originating_face"] = oss.str();
+    if (geoms)
+    {
+      const std::string ref     = "sketch_" + std::to_string(sketch.get_id()) + "_face";
+      (*geoms)[ref]             = write_brep_binary(shape);
+      j["originating_face_ref"] = ref;
+    }
+    else
+    {
+      std::ostringstream oss;
+      BRepTools::Write(shape, oss, false, false, TopTools_FormatVersion_CURRENT);
+      j["originating_face"] = oss.str();
+    }
   }
 
   json& edges_json = j["edges"] = json::array();
@@ -172,19 +182,17 @@ nlohmann::json Sketch_json::to_json(const Sketch& sketch, const Ezy_asset_store&
           edges_json.push_back(json::array({remap(e.node_a), remap(e.node_b)}));
       });
 
-  for (const Sketch_edge& e : sketch.m_edges.edges())
-  {
-    if (!sketch_edge_is_arc(e) || !e.node_idx_b.has_value() || e.shp.IsNull())
-      continue;
-
-    json arc_mid_json;
-    if (e.node_idx_arc_pt.has_value())
-      arc_mid_json = remap(*e.node_idx_arc_pt);
-    else
-      arc_mid_json = ::to_json(arc_curve_midpoint_2d(TopoDS::Edge(e.shp->Shape()), sketch.m_pln));
+  sketch.m_edges.for_each_arc(
+      [&](const Sketch_edge_arc& e)
+      {
+        json arc_mid_json;
+        if (e.node_arc.has_value())
+          arc_mid_json = remap(*e.node_arc);
+        else
+          arc_mid_json = ::to_json(arc_curve_midpoint_2d(TopoDS::Edge(e.shp->Shape()), sketch.m_pln));
 
-    arc_edges_json.push_back(json::array({remap(e.node_idx_a), arc_mid_json, remap(*e.node_idx_b)}));
-  }
+        arc_edges_json.push_back(json::array({remap(e.node_start), arc_mid_json, remap(e.node_end)}));
+      });
 
   json& len_dims_json = j["length_dimensions"] = json::array();
   for (const Sketch_dims::Length_dimension& ld : sketch.m_dims.dimensions())
@@ -214,7 +222,31 @@ nlohmann::json Sketch_json::to_json(const Sketch& sketch, const Ezy_asset_store&
   return j;
 }
 
-Sketch::sptr Sketch_json::from_json(Occt_view& view, const nlohmann::json& j)
+Sketch::sptr Sketch_json::from_json(Occt_view& view, const nlohmann::json& j, const Ezy_geom_reader& read_geom)
+{
+  return from_json(view, j, read_originating_face(j, read_geom));
+}
+
+TopoDS_Shape Sketch_json::read_originating_face(const nlohmann::json& j, const Ezy_geom_reader& read_geom)
+{
+  TopoDS_Shape shape;
+  if (j.contains("originating_face_ref") && j["originating_face_ref"].is_string())
+  {
+    if (read_geom)
+      if (const std::optional<std::string> bytes = read_geom(j["originating_face_ref"].get<std::string>()))
+        shape = read_brep_binary(*bytes);
+  }
+  else if (j.contains("originating_face"))
+  {
+    std::istringstream iss;
+    iss.str(j["originating_face"].get<std::string>());
+    BRepTools::Read(shape, iss, BRep_Builder());
+  }
+
+  return shape;
+}
+
+Sketch::sptr Sketch_json::from_json(Occt_view& view, const nlohmann::json& j, const TopoDS_Shape& shape)
 {
   EZY_ASSERT(j.contains("name") && j["name"].is_string());
   EZY_ASSERT(j.contains("edges") && j["edges"].is_array());
@@ -223,12 +255,9 @@ Sketch::sptr Sketch_json::from_json(Occt_view& view, const nlohmann::json& j)
 
   Sketch::sptr ret;
 
-  if (j.contains("originating_face"))
+  // A missing or unreadable v4 entry degrades to a plain sketch on the saved plane.
+  if (!shape.IsNull())
   {
-    TopoDS_Shape       shape;
-    std::istringstream iss;
-    iss.str(j["originating_face"].get<std::string>());
-    BRepTools::Read(shape, iss, BRep_Builder());
     EZY_ASSERT(shape.ShapeType() == TopAbs_WIRE);
     const TopoDS_Wire& face = TopoDS::Wire(shape);
 
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <TopoDS_Shape.hxx>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <utility>
 #include <vector>
 
+#include "utl_io.h"
+
 class Sketch;
 class Occt_view;
 class Ezy_asset_store;
@@ -12,8 +15,17 @@ class Ezy_asset_store;
 class Sketch_json
 {
 public:
-  static nlohmann::json          to_json(const Sketch& sketch, const Ezy_asset_store& assets);
-  static std::shared_ptr<Sketch> from_json(Occt_view& view, const nlohmann::json& j);
+  /// With `geoms`, the originating face goes to a binary geometry entry referenced by `"originating_face_ref"`
+  /// (`.ezy` v4) instead of inline BRep text.
+  static nlohmann::json          to_json(const Sketch& sketch, const Ezy_asset_store& assets,
+                                         Ezy_geom_entries* geoms = nullptr);
+  /// `read_geom` resolves a v4 `"originating_face_ref"`; if it cannot, the sketch loads on its plane without the face.
+  static std::shared_ptr<Sketch> from_json(Occt_view& view, const nlohmann::json& j, const Ezy_geom_reader& read_geom = {});
+  /// As above with the originating face already decoded by `read_originating_face` (null for none).
+  static std::shared_ptr<Sketch> from_json(Occt_view& view, const nlohmann::json& j, const TopoDS_Shape& originating_face);
+  /// Decodes the inline or referenced originating face of sketch `j`. Touches no view state, so project loads call it
+  /// on worker threads.
+  static TopoDS_Shape            read_originating_face(const nlohmann::json& j, const Ezy_geom_reader& read_geom);
 
 private:
   Sketch_json()  = default;
@@ -72,7 +72,7 @@ void Sketch_node_marks::sync()
     {
       m_marks[i]->Set(marker);
       apply_style_(m_marks[i], node.origin);
-      m_sketch.m_ctx.Redisplay(m_marks[i], true);
+      m_sketch.m_ctx.Redisplay(m_marks[i], false);
       if (node.origin)
         m_sketch.m_ctx.Deactivate(m_marks[i]);
     }
@@ -86,6 +86,8 @@ void Sketch_node_marks::sync()
         m_sketch.m_ctx.Deactivate(mk);
     }
   }
+
+  m_sketch.m_view.update_viewer();
 }
 
 void Sketch_node_marks::remove_at(size_t node_idx)
@@ -12,6 +12,7 @@
 
 #include "utl_dbg.h"
 #include "utl_geom.h"
+#include "utl_grid_index.h"
 #include "imgui.h"
 #include "gui_occt_view.h"
 
@@ -45,6 +46,7 @@ public:
   size_t                  get_node_exact(const gp_Pnt2d& pt, bool permanent_for_new);
   std::optional<size_t>   get_node(const ScreenCoords& screen_coords);
   std::optional<size_t>   try_pick_existing_node(const ScreenCoords& screen_coords);
+  std::optional<size_t>   nearest_node(const gp_Pnt2d& pt, double max_dist);
   std::optional<size_t>   try_get_node_idx_snap(gp_Pnt2d& pt, const std::vector<size_t>& to_exclude = {});
   void                    get_snap_pts_3d(std::vector<gp_Pnt>& out);
   void                    hide_snap_annos();
@@ -77,6 +79,9 @@ public:
   void               set_origin_snap_enabled(bool enabled) { m_origin_snap_enabled = enabled; }
   [[nodiscard]] bool origin_snap_enabled() const { return m_origin_snap_enabled; }
 
+  [[nodiscard]] uint64_t                                  move_stamp() const { return m_move_stamp; }
+  [[nodiscard]] std::optional<std::span<const Node_move>> moves_since(uint64_t stamp) const;
+
 private:
   Sketch_nodes*           m_owner;
   std::vector<Node>       m_nodes;
@@ -90,6 +95,22 @@ private:
   AIS_Shape_ptr           m_global_coax_fs_h;
   AIS_Shape_ptr           m_global_coax_markers;
   size_t                  m_prev_num_nodes{0}; // Used when an operation is canceled.
+  uint64_t                m_move_stamp{0};     // Bumped whenever an existing slot moves.
+  std::vector<Node_move>  m_move_log;          // Recent moves; `m_move_stamp == m_move_log_base + m_move_log.size()`.
+  uint64_t                m_move_log_base{0};  // `m_move_stamp` before `m_move_log.front()`.
+
+  // Spatial indexes over every slot of `m_nodes` (tombstones included; eligibility is checked per query).
+  // Rebuilt lazily when dirty so bulk loads (`resize` + `set_node`) stay linear.
+  Grid_index_2d                       m_node_grid;
+  std::set<std::pair<double, size_t>> m_axis_index[2];             // (U or V coordinate, node index) for axis snapping.
+  std::vector<gp_Pnt2d>               m_indexed_pts;               // Position each slot was indexed at.
+  size_t                              m_node_index_built_count{0}; // Node count when the grid cell size was chosen.
+  bool                                m_node_index_dirty{true};
+
+  // `m_outside_snap_pts` in set order, plus per-axis positions into it sorted by U / V. Rebuilt lazily.
+  std::vector<gp_Pnt2d> m_outside_pts_vec;
+  std::vector<size_t>   m_outside_axis_order[2];
+  bool                  m_outside_index_dirty{true};
 
   // Owner related
   Occt_view&              m_view;
@@ -106,6 +127,15 @@ private:
     return true;
   }
 
+  void                 index_node_(size_t idx);
+  void                 unindex_node_(size_t idx);
+  void                 note_move_(size_t idx, const gp_Pnt2d& old_pt);
+  const Grid_index_2d& node_grid_();
+  void                 ensure_node_index_();
+  void                 ensure_outside_index_();
+  /// Node and outside-point indices (each ascending) whose `axis_idx` coordinate may lie within `tol` of `c`.
+  void axis_candidates_(int axis_idx, double c, double tol, std::vector<size_t>& node_ids, std::vector<size_t>& outside_ids);
+
   /// World-space snap radius at `pt` (same convention as `try_get_node_idx_snap` / `try_pick_existing_node`).
   double snap_radius_world_(const gp_Pnt2d& pt) const;
   bool   view_bounds_2d_(double& min_u, double& min_v, double& max_u, double& max_v) const;
@@ -162,39 +192,32 @@ std::optional<size_t> Sketch_nodes::Impl::try_pick_existing_node(const ScreenCoo
     return std::nullopt;
   }
 
-  const gp_Pnt2d pt        = *pt_opt;
-  const double   snap_dist = snap_radius_world_(pt);
-  size_t         best_idx  = static_cast<size_t>(-1);
-  double         best_sq   = std::numeric_limits<double>::max();
-  for (size_t idx = 0, num = m_nodes.size(); idx < num; ++idx)
-  {
-    if (!node_snap_eligible_(m_nodes[idx]))
-      continue;
-
-    const double sq = m_nodes[idx].SquareDistance(pt);
-    if (sq < best_sq)
-    {
-      best_sq  = sq;
-      best_idx = idx;
-    }
-  }
-
-  if (best_idx == static_cast<size_t>(-1))
+  const gp_Pnt2d              pt        = *pt_opt;
+  const double                snap_dist = snap_radius_world_(pt);
+  const std::optional<size_t> best_idx  = nearest_node(pt, snap_dist * 0.5);
+  if (!best_idx)
   {
     m_owner->hide_snap_annos();
     return std::nullopt;
   }
 
-  if (best_sq <= snap_dist * 0.25 * snap_dist)
+  // `try_get_node_idx_snap` can modify the input `pt`, we call this function to display snapping annotations.
+  gp_Pnt2d pt_snapped = m_nodes[*best_idx];
+  m_owner->try_get_node_idx_snap(pt_snapped, {});
+  return best_idx;
+}
+
+std::optional<size_t> Sketch_nodes::Impl::nearest_node(const gp_Pnt2d& pt, double max_dist)
+{
+  auto sq_dist = [&](size_t idx) -> std::optional<double>
   {
-    // `try_get_node_idx_snap` can modify the input `pt`, we call this function to display snapping annotations.
-    gp_Pnt2d pt_snapped = m_nodes[best_idx];
-    m_owner->try_get_node_idx_snap(pt_snapped, {});
-    return best_idx;
-  }
+    if (!node_snap_eligible_(m_nodes[idx]))
+      return std::nullopt;
 
-  m_owner->hide_snap_annos();
-  return std::nullopt;
+    return m_nodes[idx].SquareDistance(pt);
+  };
+
+  return node_grid_().nearest(to_glm(pt), max_dist, sq_dist);
 }
 
 std::optional<gp_Pnt2d> Sketch_nodes::Impl::snap(const ScreenCoords& screen_coords)
@@ -208,25 +231,30 @@ std::optional<gp_Pnt2d> Sketch_nodes::Impl::snap(const ScreenCoords& screen_coor
 
 size_t Sketch_nodes::Impl::get_node_exact(const gp_Pnt2d& pt, bool permanent_for_new)
 {
+  // Lowest matching index wins, as with a linear scan.
+  std::optional<size_t> live_match;
   std::optional<size_t> deleted_match;
-  for (size_t idx = 0, num = m_nodes.size(); idx < num; ++idx)
-    if (equal(pt, gp_Pnt2d(m_nodes[idx])))
-    {
-      Node& n = m_nodes[idx];
-      // Never bind to tombstoned nodes while searching for an exact live match.
-      if (n.deleted)
-      {
-        if (!deleted_match.has_value())
-          deleted_match = idx;
-
-        continue;
-      }
-      // If caller requests permanence (e.g. add-node tool), preserve/promote it.
-      if (permanent_for_new)
-        n.permanent = true;
+  const glm::dvec2      tol(Precision::Confusion());
+  node_grid_().query(to_glm(pt) - tol, to_glm(pt) + tol,
+                     [&](size_t idx)
+                     {
+                       if (!equal(pt, gp_Pnt2d(m_nodes[idx])))
+                         return;
+
+                       // Never bind to tombstoned nodes while searching for an exact live match.
+                       std::optional<size_t>& match = m_nodes[idx].deleted ? deleted_match : live_match;
+                       if (!match || idx < *match)
+                         match = idx;
+                     });
+
+  if (live_match.has_value())
+  {
+    // If caller requests permanence (e.g. add-node tool), preserve/promote it.
+    if (permanent_for_new)
+      m_nodes[*live_match].permanent = true;
 
-      return idx;
-    }
+    return *live_match;
+  }
 
   // If only a deleted exact match exists, revive it instead of appending a duplicate index.
   if (deleted_match.has_value())
@@ -243,6 +271,7 @@ size_t Sketch_nodes::Impl::get_node_exact(const gp_Pnt2d& pt, bool permanent_for
   n.permanent      = permanent_for_new;
   const size_t ret = m_nodes.size();
   m_nodes.push_back(n);
+  index_node_(ret);
   return ret;
 }
 
@@ -284,7 +313,7 @@ void Sketch_nodes::Impl::hide_snap_annos()
   clear_snap_ais_(m_ctx, m_global_coax_fs_h);
   clear_snap_ais_(m_ctx, m_global_coax_markers);
 
-  m_ctx.UpdateCurrentViewer();
+  m_view.update_viewer();
   m_last_snap_pt = std::nullopt;
 }
 
@@ -295,6 +324,7 @@ size_t Sketch_nodes::Impl::add_new_node(const gp_Pnt2d& pt, bool is_edge_mid_poi
   n.midpoint  = is_edge_mid_point;
   n.permanent = is_permanent;
   m_nodes.emplace_back(n);
+  index_node_(ret);
   return ret;
 }
 
@@ -398,12 +428,22 @@ void Sketch_nodes::Impl::update_global_coaxial_annotations_(double snap_dist)
   if (all_pts.empty())
     return;
 
-  // Collect all X and Y values
+  // Collect all X and Y values in ascending order by merging the sorted node and outside-point axis indexes.
+  ensure_node_index_();
+  ensure_outside_index_();
   std::vector<double> all_xs, all_ys;
-  for (const auto& p : all_pts)
+  for (int axis_idx = 0; axis_idx < 2; ++axis_idx)
   {
-    all_xs.push_back(p.X());
-    all_ys.push_back(p.Y());
+    std::vector<double>& vals = axis_idx == 0 ? all_xs : all_ys;
+    for (const auto& [coord, nd_idx] : m_axis_index[axis_idx])
+      if (!m_nodes[nd_idx].deleted)
+        vals.push_back(coord);
+
+    const size_t num_nodes = vals.size();
+    for (size_t out_idx : m_outside_axis_order[axis_idx])
+      vals.push_back(m_outside_pts_vec[out_idx].XY().Coord(axis_idx + 1));
+
+    std::inplace_merge(vals.begin(), vals.begin() + static_cast<std::ptrdiff_t>(num_nodes), vals.end());
   }
 
   // Canonicalize unique values within Precision::Confusion() (as per requirement for co-axial alignments)
@@ -412,7 +452,6 @@ void Sketch_nodes::Impl::update_global_coaxial_annotations_(double snap_dist)
     if (vals.empty())
       return;
 
-    std::sort(vals.begin(), vals.end());
     std::vector<double> unique;
     double              tol = Precision::Confusion();
     for (double v : vals)
@@ -514,6 +553,8 @@ std::optional<size_t> Sketch_nodes::Impl::try_get_node_idx_snap(
 
   gp_Pnt2d              pt_original = pt;
   std::optional<size_t> snap_node_idx[2];
+  std::vector<size_t>   node_ids;
+  std::vector<size_t>   outside_ids;
   for (int axis_idx = 0; axis_idx < 2; ++axis_idx)
   {
     std::optional<gp_Pnt2d> snap_axis_point;
@@ -550,7 +591,9 @@ std::optional<size_t> Sketch_nodes::Impl::try_get_node_idx_snap(
       return false;
     };
 
-    for (size_t nd_idx = 0, num = m_nodes.size(); nd_idx < num; ++nd_idx)
+    // Only nodes inside the axis band can match; candidates come back in index order like a full scan.
+    axis_candidates_(axis_idx, pt_original.XY().Coord(axis_idx + 1), sqrt(snap_dist) * 0.5, node_ids, outside_ids);
+    for (size_t nd_idx : node_ids)
     {
       if (!node_snap_eligible_(m_nodes[nd_idx]))
         continue;
@@ -562,8 +605,8 @@ std::optional<size_t> Sketch_nodes::Impl::try_get_node_idx_snap(
         snap_node_idx[axis_idx] = nd_idx;
     }
 
-    for (const gp_Pnt2d& nd_pt : m_outside_snap_pts)
-      try_nd_pt(nd_pt);
+    for (size_t out_idx : outside_ids)
+      try_nd_pt(m_outside_pts_vec[out_idx]);
 
     // If the "annotate all coaxial" option is on we keep the full list (dedup later if wanted).
     // Otherwise we only annotate the single closest one that drove the snap.
@@ -608,8 +651,10 @@ std::optional<size_t> Sketch_nodes::Impl::try_get_node_idx_snap(
       double guide_val = (axis_idx == 0 ? pt.X() : pt.Y());
 
       std::vector<gp_Pnt2d> matches;
-      for (const auto& n : m_nodes)
+      axis_candidates_(axis_idx, guide_val, Precision::Confusion(), node_ids, outside_ids);
+      for (size_t nd_idx : node_ids)
       {
+        const Node& n = m_nodes[nd_idx];
         if (!node_snap_eligible_(n))
           continue;
 
@@ -618,9 +663,10 @@ std::optional<size_t> Sketch_nodes::Impl::try_get_node_idx_snap(
           matches.push_back(n);
       }
 
-      for (const auto& p : m_outside_snap_pts)
+      for (size_t out_idx : outside_ids)
       {
-        double axis_diff = std::fabs(guide_val - p.XY().Coord(axis_idx + 1));
+        const gp_Pnt2d& p         = m_outside_pts_vec[out_idx];
+        double          axis_diff = std::fabs(guide_val - p.XY().Coord(axis_idx + 1));
         if (axis_diff <= Precision::Confusion())
           matches.push_back(p);
       }
@@ -657,14 +703,140 @@ std::optional<size_t> Sketch_nodes::Impl::try_get_node_idx_snap(
     }
 
     update_node_snap_anno_(pt, sqrt(snap_dist));
-    m_ctx.UpdateCurrentViewer();
+    m_view.update_viewer();
     return snap_node_idx[0];
   }
 
-  m_ctx.UpdateCurrentViewer();
+  m_view.update_viewer();
   return {};
 }
 
+// === Impl node grid ========================================================
+
+void Sketch_nodes::Impl::index_node_(size_t idx)
+{
+  if (m_node_index_dirty)
+    return;
+
+  // Re-pick the cell size once the node count has grown well past the last build (amortized O(1)).
+  if (m_nodes.size() > 2 * m_node_index_built_count + 64)
+  {
+    m_node_index_dirty = true;
+    return;
+  }
+
+  const gp_Pnt2d pt = m_nodes[idx];
+  if (idx < m_indexed_pts.size())
+  {
+    m_axis_index[0].erase({m_indexed_pts[idx].X(), idx});
+    m_axis_index[1].erase({m_indexed_pts[idx].Y(), idx});
+  }
+  else
+    m_indexed_pts.resize(idx + 1);
+
+  m_indexed_pts[idx] = pt;
+  m_axis_index[0].insert({pt.X(), idx});
+  m_axis_index[1].insert({pt.Y(), idx});
+  m_node_grid.insert(idx, to_glm(pt));
+}
+
+void Sketch_nodes::Impl::unindex_node_(size_t idx)
+{
+  if (m_node_index_dirty || idx >= m_indexed_pts.size())
+    return;
+
+  m_axis_index[0].erase({m_indexed_pts[idx].X(), idx});
+  m_axis_index[1].erase({m_indexed_pts[idx].Y(), idx});
+  m_node_grid.remove(idx);
+}
+
+const Grid_index_2d& Sketch_nodes::Impl::node_grid_()
+{
+  ensure_node_index_();
+  return m_node_grid;
+}
+
+void Sketch_nodes::Impl::ensure_node_index_()
+{
+  if (!m_node_index_dirty)
+    return;
+
+  // Aim for roughly one node per cell over the bounding box of all slots.
+  glm::dvec2 lo(std::numeric_limits<double>::max());
+  glm::dvec2 hi(std::numeric_limits<double>::lowest());
+  for (const Node& n : m_nodes)
+  {
+    lo = glm::min(lo, to_glm(n));
+    hi = glm::max(hi, to_glm(n));
+  }
+
+  double cell_size = 1.0;
+  if (!m_nodes.empty())
+  {
+    const double extent = std::max(hi.x - lo.x, hi.y - lo.y);
+    if (extent > Precision::Confusion())
+      cell_size = extent / std::ceil(std::sqrt(static_cast<double>(m_nodes.size())));
+  }
+
+  m_node_grid.reset(cell_size);
+  for (std::set<std::pair<double, size_t>>& axis : m_axis_index)
+    axis.clear();
+
+  m_indexed_pts.clear();
+  m_node_index_built_count = m_nodes.size();
+  m_node_index_dirty       = false;
+  for (size_t idx = 0, num = m_nodes.size(); idx < num; ++idx)
+    index_node_(idx);
+}
+
+void Sketch_nodes::Impl::ensure_outside_index_()
+{
+  if (!m_outside_index_dirty)
+    return;
+
+  m_outside_pts_vec.assign(m_outside_snap_pts.begin(), m_outside_snap_pts.end());
+  for (int axis_idx = 0; axis_idx < 2; ++axis_idx)
+  {
+    std::vector<size_t>& order = m_outside_axis_order[axis_idx];
+    order.resize(m_outside_pts_vec.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b)
+              { return m_outside_pts_vec[a].XY().Coord(axis_idx + 1) < m_outside_pts_vec[b].XY().Coord(axis_idx + 1); });
+  }
+
+  m_outside_index_dirty = false;
+}
+
+void Sketch_nodes::Impl::axis_candidates_(int axis_idx, double c, double tol, std::vector<size_t>& node_ids,
+                                          std::vector<size_t>& outside_ids)
+{
+  ensure_node_index_();
+  ensure_outside_index_();
+
+  // Pad the range slightly; callers re-test with their exact predicate.
+  const double lo = c - tol - Precision::Confusion();
+  const double hi = c + tol + Precision::Confusion();
+
+  node_ids.clear();
+  const std::set<std::pair<double, size_t>>& axis = m_axis_index[axis_idx];
+  for (auto it = axis.lower_bound({lo, 0}); it != axis.end() && it->first <= hi; ++it)
+    node_ids.push_back(it->second);
+
+  std::sort(node_ids.begin(), node_ids.end());
+
+  outside_ids.clear();
+  const std::vector<size_t>& order = m_outside_axis_order[axis_idx];
+  auto coord = [&](size_t i) { return m_outside_pts_vec[i].XY().Coord(axis_idx + 1); };
+  auto first = std::lower_bound(order.begin(), order.end(), lo, [&](size_t i, double v) { return coord(i) < v; });
+  for (auto it = first; it != order.end() && coord(*it) <= hi; ++it)
+    outside_ids.push_back(*it);
+
+  std::sort(outside_ids.begin(), outside_ids.end());
+}
+
 // === Impl data access ======================================================
 
 // clang-format off
@@ -688,13 +860,23 @@ bool Sketch_nodes::Impl::empty() const { return m_nodes.empty(); }
 
 size_t Sketch_nodes::Impl::size() const { return m_nodes.size(); }
 
-void Sketch_nodes::Impl::resize(size_t count) { m_nodes.assign(count, Node{}); }
+void Sketch_nodes::Impl::resize(size_t count)
+{
+  m_nodes.assign(count, Node{});
+  m_node_index_dirty = true;
+  ++m_move_stamp;
+  m_move_log.clear();
+  m_move_log_base = m_move_stamp;
+}
 
 void Sketch_nodes::Impl::set_node(size_t idx, const gp_Pnt2d& pt, bool deleted, bool midpoint, bool permanent, bool origin,
                                   const std::string& name)
 {
   EZY_ASSERT(idx < m_nodes.size());
   Node& n = m_nodes[idx];
+  if (n.X() != pt.X() || n.Y() != pt.Y())
+    note_move_(idx, n);
+
   n.SetX(pt.X());
   n.SetY(pt.Y());
   n.deleted   = deleted;
@@ -702,6 +884,41 @@ void Sketch_nodes::Impl::set_node(size_t idx, const gp_Pnt2d& pt, bool deleted,
   n.permanent = permanent;
   n.origin    = origin;
   n.name      = name;
+  index_node_(idx);
+}
+
+void Sketch_nodes::Impl::set_node_pt(size_t idx, const gp_Pnt2d& pt)
+{
+  EZY_ASSERT(idx < m_nodes.size());
+  if (m_nodes[idx].X() == pt.X() && m_nodes[idx].Y() == pt.Y())
+    return;
+
+  note_move_(idx, m_nodes[idx]);
+  m_nodes[idx].SetX(pt.X());
+  m_nodes[idx].SetY(pt.Y());
+  index_node_(idx);
+}
+
+void Sketch_nodes::Impl::note_move_(size_t idx, const gp_Pnt2d& old_pt)
+{
+  // Keep the log bounded: drop the older half, so only a consumer that fell far behind has to rebuild.
+  constexpr size_t c_max_move_log = 1024;
+  if (m_move_log.size() == c_max_move_log)
+  {
+    m_move_log.erase(m_move_log.begin(), m_move_log.begin() + c_max_move_log / 2);
+    m_move_log_base += c_max_move_log / 2;
+  }
+
+  m_move_log.push_back({idx, old_pt});
+  ++m_move_stamp;
+}
+
+std::optional<std::span<const Sketch_nodes::Node_move>> Sketch_nodes::Impl::moves_since(uint64_t stamp) const
+{
+  if (stamp < m_move_log_base || stamp > m_move_stamp)
+    return std::nullopt;
+
+  return std::span<const Node_move>(m_move_log).subspan(static_cast<size_t>(stamp - m_move_log_base));
 }
 
 void Sketch_nodes::Impl::restore_node_at(size_t idx, const gp_Pnt2d& pt, bool deleted, bool midpoint, bool permanent,
@@ -715,11 +932,27 @@ void Sketch_nodes::Impl::restore_node_at(size_t idx, const gp_Pnt2d& pt, bool de
 
 void Sketch_nodes::Impl::finalize() { m_prev_num_nodes = m_nodes.size(); }
 
-void Sketch_nodes::Impl::cancel() { m_nodes.resize(m_prev_num_nodes); }
+void Sketch_nodes::Impl::cancel()
+{
+  for (size_t idx = m_prev_num_nodes; idx < m_nodes.size(); ++idx)
+    unindex_node_(idx);
+
+  m_nodes.resize(m_prev_num_nodes);
+  if (m_indexed_pts.size() > m_nodes.size())
+    m_indexed_pts.resize(m_nodes.size());
+}
 
-void Sketch_nodes::Impl::clear_outside_snap_pnts() { m_outside_snap_pts.clear(); }
+void Sketch_nodes::Impl::clear_outside_snap_pnts()
+{
+  m_outside_snap_pts.clear();
+  m_outside_index_dirty = true;
+}
 
-void Sketch_nodes::Impl::add_outside_snap_pnt(const gp_Pnt& pt3d) { m_outside_snap_pts.insert(to_2d(m_pln, pt3d)); }
+void Sketch_nodes::Impl::add_outside_snap_pnt(const gp_Pnt& pt3d)
+{
+  m_outside_snap_pts.insert(to_2d(m_pln, pt3d));
+  m_outside_index_dirty = true;
+}
 
 Sketch_nodes::Sketch_nodes(Occt_view& view, const gp_Pln& pln)
     : m_impl(std::make_unique<Impl>(this, view, pln))
@@ -763,6 +996,11 @@ std::optional<size_t> Sketch_nodes::try_get_node_idx_snap(
   return m_impl->try_get_node_idx_snap(pt, to_exclude);
 }
 
+std::optional<size_t> Sketch_nodes::nearest_node(const gp_Pnt2d& pt, double max_dist)
+{
+  return m_impl->nearest_node(pt, max_dist);
+}
+
 void Sketch_nodes::hide_snap_annos() { m_impl->hide_snap_annos(); }
 
 size_t Sketch_nodes::add_new_node(const gp_Pnt2d& pt, bool is_edge_mid_point, bool is_permanent)
@@ -800,6 +1038,15 @@ void Sketch_nodes::set_node(size_t idx, const gp_Pnt2d& pt, bool deleted, bool m
   m_impl->set_node(idx, pt, deleted, midpoint, permanent, origin, name);
 }
 
+void Sketch_nodes::set_node_pt(size_t idx, const gp_Pnt2d& pt) { m_impl->set_node_pt(idx, pt); }
+
+uint64_t Sketch_nodes::move_stamp() const { return m_impl->move_stamp(); }
+
+std::optional<std::span<const Sketch_nodes::Node_move>> Sketch_nodes::moves_since(uint64_t stamp) const
+{
+  return m_impl->moves_since(stamp);
+}
+
 void Sketch_nodes::finalize() { m_impl->finalize(); }
 
 void Sketch_nodes::cancel() { m_impl->cancel(); }
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <gp_Pnt2d.hxx>
 #include <glm/glm.hpp>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -50,6 +52,8 @@ public:
   /// Projects the click onto the sketch plane and returns a node index only if within snap range of an
   /// existing non-deleted node. Never creates nodes (unlike `get_node`).
   std::optional<size_t> try_pick_existing_node(const ScreenCoords& screen_coords);
+  /// Closest snap-eligible node within `max_dist` of `pt` (no annotations, never creates nodes).
+  std::optional<size_t> nearest_node(const gp_Pnt2d& pt, double max_dist);
   std::optional<size_t>
   try_get_node_idx_snap(gp_Pnt2d& pt, // `pt` could be snapped to a node, an axis of another node, or an outside snap point.
                         const std::vector<size_t>& to_exclude = {});
@@ -61,6 +65,23 @@ public:
   void               set_origin_snap_enabled(bool enabled);
   [[nodiscard]] bool origin_snap_enabled() const;
 
+  /// Moves node `idx` to `pt`. Use this rather than writing through `operator[]` so the snap index stays in sync.
+  void set_node_pt(size_t idx, const gp_Pnt2d& pt);
+  /// Changes whenever an existing node moves (`set_node_pt`, undo restore, JSON load); appends and writes that keep
+  /// the position leave it unchanged. Lets derived indexes (e.g. the edge segment index) detect stale geometry.
+  [[nodiscard]] uint64_t move_stamp() const;
+
+  /// One logged move: slot `idx` left `old_pt`.
+  struct Node_move
+  {
+    size_t   idx;
+    gp_Pnt2d old_pt;
+  };
+
+  /// Moves made since `move_stamp()` returned `stamp`, oldest first, so derived indexes can patch only what moved.
+  /// `std::nullopt` when the bounded log no longer reaches back that far (or after `resize`); rebuild then.
+  [[nodiscard]] std::optional<std::span<const Node_move>> moves_since(uint64_t stamp) const;
+
   Node&       operator[](size_t idx);
   const Node& operator[](size_t idx) const;
   Node&       operator[](const std::optional<size_t> idx);
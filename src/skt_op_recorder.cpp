@@ -79,6 +79,8 @@ struct Sketch_op_data
            !curr_operation_axis.has_value();
   }
 
+  /// Heap bytes held by the record vectors (for the undo memory budget).
+  size_t  approx_bytes_() const;
   Sketch* resolve_sketch_(Occt_view& view) const;
   void    apply_forward_(Occt_view& view) const;
   void    apply_reverse_(Occt_view& view) const;
@@ -117,6 +119,10 @@ public:
 
   std::unique_ptr<Delta> clone() const override { return std::make_unique<Sketch_op_delta>(m_data); }
 
+  size_t approx_bytes() const override { return sizeof(*this) + m_data.approx_bytes_(); }
+
+  void collect_dirty(Doc_dirty& out) const override { out.sketches.insert(m_data.m_sketch_id); }
+
 private:
   Sketch_op_data m_data;
 };
@@ -387,6 +393,25 @@ void Sketch_op_recorder::Impl::cancel()
   unregister_owner_();
 }
 
+size_t Sketch_op_data::approx_bytes_() const
+{
+  size_t bytes = prev_linear_edges.capacity() * sizeof(Prev_edge_rec) +
+                 curr_linear_edges.capacity() * sizeof(Curr_linear_edge_record) +
+                 (prev_arc_edges.capacity() + curr_arc_edges.capacity()) * sizeof(Arc_edge_record) +
+                 curr_nodes.capacity() * sizeof(Curr_node_record) +
+                 (prev_length_dims.capacity() + curr_length_dims.capacity()) * sizeof(Length_dim_record);
+  for (const Prev_edge_rec& rec : prev_linear_edges)
+    bytes += rec.name.capacity();
+
+  for (const Length_dim_record& rec : prev_length_dims)
+    bytes += rec.name.capacity();
+
+  for (const Length_dim_record& rec : curr_length_dims)
+    bytes += rec.name.capacity();
+
+  return bytes;
+}
+
 Sketch* Sketch_op_data::resolve_sketch_(Occt_view& view) const
 {
   for (const Sketch::sptr& s : view.get_sketches())
@@ -521,23 +546,20 @@ bool Sketch_op_data::length_dim_equal_(const Length_dim_record& x, const Length_
 
 void Sketch_op_data::remove_linear_edges_on_segment_(Sketch& sketch, const gp_Pnt2d& seg_a, const gp_Pnt2d& seg_b)
 {
-  for (auto itr = sketch.m_edges.edges().begin(); itr != sketch.m_edges.edges().end();)
+  // Only edges whose bounds overlap the segment can lie on it.
+  for (Sketch_edges::Edge_handle h : sketch.m_edges.edges_near(seg_a, seg_b))
   {
-    if (!sketch_edge_is_linear(*itr))
-    {
-      ++itr;
+    const Sketch::Edge& edge = sketch.m_edges.edges()[h];
+    if (!sketch_edge_is_linear(edge))
       continue;
-    }
 
-    const gp_Pnt2d& pa = sketch.m_nodes[itr->node_idx_a];
-    const gp_Pnt2d& pb = sketch.m_nodes[*itr->node_idx_b];
+    const gp_Pnt2d& pa = sketch.m_nodes[edge.node_idx_a];
+    const gp_Pnt2d& pb = sketch.m_nodes[*edge.node_idx_b];
     if (on_closed_segment_2d_(pa, seg_a, seg_b) && on_closed_segment_2d_(pb, seg_a, seg_b))
     {
-      sketch.m_ctx.Remove(itr->shp, false);
-      itr = sketch.m_edges.edges().erase(itr);
+      sketch.m_ctx.Remove(edge.shp, false);
+      sketch.m_edges.erase(h);
     }
-    else
-      ++itr;
   }
 }
 
@@ -548,22 +570,16 @@ void Sketch_op_data::remove_linear_edges_on_node_segment_(Sketch& sketch, const
 
 void Sketch_op_data::remove_arc_edge_(Sketch& sketch, const Arc_edge_record& rec)
 {
-  for (auto itr = sketch.m_edges.edges().begin(); itr != sketch.m_edges.edges().end();)
+  for (auto itr = sketch.m_edges.edges().begin(); itr != sketch.m_edges.edges().end(); ++itr)
   {
     if (!sketch_edge_is_arc(*itr))
-    {
-      ++itr;
       continue;
-    }
 
     if (!arc_edge_matches_record_(sketch, *itr, rec))
-    {
-      ++itr;
       continue;
-    }
 
     sketch.m_ctx.Remove(itr->shp, false);
-    itr = sketch.m_edges.edges().erase(itr);
+    sketch.m_edges.erase(itr.handle());
   }
 }
 
@@ -634,15 +650,18 @@ void Sketch_op_data::restore_prev_linear_edge_(Sketch& sketch, const Prev_edge_r
 
   sketch.sketch_json_add_linear_edge_(idx_a, idx_b, idx_mid);
   if (!rec.name.empty())
-    for (Sketch::Edge& e : sketch.m_edges.edges())
+    for (auto itr = sketch.m_edges.edges().begin(); itr != sketch.m_edges.edges().end(); ++itr)
+    {
+      const Sketch::Edge& e = *itr;
       if (sketch_edge_is_linear(e) && pts_equal_(sketch.m_nodes[e.node_idx_a], rec.pt_a) &&
           pts_equal_(sketch.m_nodes[*e.node_idx_b], rec.pt_b) &&
           ((!rec.pt_mid.has_value() && !e.node_idx_mid.has_value()) ||
            (rec.pt_mid.has_value() && e.node_idx_mid.has_value() && pts_equal_(sketch.m_nodes[*e.node_idx_mid], *rec.pt_mid))))
       {
-        e.name = rec.name;
+        sketch.m_edges.set_name(itr.handle(), rec.name);
         break;
       }
+    }
 }
 
 void Sketch_op_data::restore_length_dim_(Sketch& sketch, const Length_dim_record& rec)
@@ -311,7 +311,7 @@ void Sketch_tools::move_line_string_pt_(const ScreenCoords& screen_coords)
       {
         if (edge.shp)
         {
-          m_sketch.m_ctx.Remove(edge.shp, true);
+          m_sketch.m_ctx.Remove(edge.shp, false);
           edge.shp.Nullify();
         }
         m_sketch.m_dims.clear_tmp_dim_anno();
@@ -400,7 +400,7 @@ void Sketch_tools::move_line_string_pt_(const ScreenCoords& screen_coords)
 
     else if (edge.shp)
     {
-      m_sketch.m_ctx.Remove(edge.shp, true);
+      m_sketch.m_ctx.Remove(edge.shp, false);
       edge.shp.Nullify();
     }
   };
@@ -515,7 +515,9 @@ void Sketch_tools::finalize_edges_(Sketch_op_recorder& rec)
     }
   }
 
-  append(m_sketch.m_edges.edges(), m_tmp_edges);
+  for (Sketch_edge& e : m_tmp_edges)
+    m_sketch.m_edges.insert(std::move(e));
+
   m_tmp_edges.clear();
 
   // Ensure topology is correct if snapping on a midpoint happened.
@@ -539,10 +541,10 @@ void Sketch_tools::finalize_edges_(Sketch_op_recorder& rec)
           rec.note_curr_node(edge_a.node_idx_mid.value());
           rec.note_curr_node(edge_b.node_idx_mid.value());
           m_sketch.m_ctx.Remove(itr->shp, false);
-          m_sketch.m_edges.edges().erase(itr);
+          m_sketch.m_edges.erase(itr.handle());
           m_sketch.m_nodes[mid_pt_idx].midpoint = false;
-          m_sketch.m_edges.edges().emplace_back(edge_a);
-          m_sketch.m_edges.edges().emplace_back(edge_b);
+          m_sketch.m_edges.insert(edge_a);
+          m_sketch.m_edges.insert(edge_b);
           break;
         }
 
@@ -719,7 +721,7 @@ void Sketch_tools::move_arc_circle_pt_(const ScreenCoords& screen_coords)
     }
 
     const TopoDS_Edge edge = BRepBuilderAPI_MakeEdge(to_3d(m_sketch.m_pln, pt_a), to_3d(m_sketch.m_pln, *pt)).Edge();
-    show(m_sketch.m_ctx, m_tmp_shp, edge);
+    show(m_sketch.m_ctx, m_tmp_shp, edge, false);
     return;
   }
 
@@ -739,7 +741,7 @@ void Sketch_tools::move_arc_circle_pt_(const ScreenCoords& screen_coords)
   }
 
   TopoDS_Edge edge = BRepBuilderAPI_MakeEdge(arc_circle);
-  show(m_sketch.m_ctx, m_tmp_shp, edge);
+  show(m_sketch.m_ctx, m_tmp_shp, edge, false);
 }
 
 void Sketch_tools::move_square_pt_(const ScreenCoords& screen_coords)
@@ -749,7 +751,7 @@ void Sketch_tools::move_square_pt_(const ScreenCoords& screen_coords)
   auto l = [&](Sketch_edge& e, const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b)
   {
     TopoDS_Wire square = make_square_wire(m_sketch.m_pln, pt_a, *m_last_pt);
-    show(m_sketch.m_ctx, m_tmp_shp, square);
+    show(m_sketch.m_ctx, m_tmp_shp, square, false);
   };
 
   if_edge_pt_valid_(l);
@@ -782,11 +784,11 @@ void Sketch_tools::move_rectangle_pt_(const ScreenCoords& screen_coords)
     if (std::abs(pt_a.X() - pt_b.X()) > Precision::Confusion() && std::abs(pt_a.Y() - pt_b.Y()) > Precision::Confusion())
     {
       TopoDS_Wire rectangle = make_rectangle_wire(m_sketch.m_pln, pt_a, pt_b);
-      show(m_sketch.m_ctx, m_tmp_shp, rectangle);
+      show(m_sketch.m_ctx, m_tmp_shp, rectangle, false);
     }
     else
     {
-      m_sketch.m_ctx.Remove(m_tmp_shp, true);
+      m_sketch.m_ctx.Remove(m_tmp_shp, false);
       m_tmp_shp.Nullify();
     }
   };
@@ -825,7 +827,7 @@ void Sketch_tools::move_circle_pt_(const ScreenCoords& screen_coords)
   auto l = [&](Sketch_edge& e, const gp_Pnt2d& pt_a, const gp_Pnt2d& pt_b)
   {
     TopoDS_Wire circle = make_circle_wire(m_sketch.m_pln, pt_a, *m_last_pt);
-    show(m_sketch.m_ctx, m_tmp_shp, circle);
+    show(m_sketch.m_ctx, m_tmp_shp, circle, false);
   };
 
   if_edge_pt_valid_(l);
@@ -856,7 +858,7 @@ void Sketch_tools::move_slot_pt_(const ScreenCoords& screen_coords)
 
     const gp_Pnt2d& pt_a = m_sketch.m_nodes[m_tmp_edges.front().node_idx_a];
     if (unique(pt_a, pt_b, pt_c))
-      show(m_sketch.m_ctx, m_tmp_shp, make_slot_wire(m_sketch.m_pln, pt_a, pt_b, pt_c));
+      show(m_sketch.m_ctx, m_tmp_shp, make_slot_wire(m_sketch.m_pln, pt_a, pt_b, pt_c), false);
   };
 
   if_edge_pt_valid_(l);
@@ -945,6 +947,8 @@ template <typename Callback> void Sketch_tools::move_sketch_pt_(const ScreenCoor
   std::optional<size_t> node_idx = m_sketch.m_nodes.try_get_node_idx_snap(*m_last_pt);
 
   callback(node_idx, *m_last_pt);
+  // Rubber-band shapes are displayed without a redraw; the view redraws once at the end of the frame.
+  m_sketch.m_view.update_viewer();
 }
 
 /// Invokes callback(e, pt_a, pt_b) with the last tmp edge only when it exists and is non-degenerate.
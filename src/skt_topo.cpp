@@ -6,12 +6,14 @@
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepTools.hxx>
 #include <Precision.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Wire.hxx>
 #include <algorithm>
 #include <functional>
 #include <limits>
 #include <map>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -23,9 +25,58 @@
 #include "skt_edge.h"
 #include "utl.h"
 #include "utl_geom.h"
+#include "utl_grid_index.h"
 
 using namespace glm;
 
+namespace
+{
+// Flat (CSR) node -> incident edge adjacency; edge ids are `Sketch_edges` handles.
+struct Edge_adjacency
+{
+  struct Entry
+  {
+    size_t node; // Neighbor node.
+    size_t edge; // Edge id.
+  };
+
+  std::vector<size_t> offsets; // Entries of node `n` are [offsets[n], offsets[n + 1]).
+  std::vector<Entry>  entries;
+
+  // `end_a` / `end_b` give the end nodes per edge id; ids flagged in `excluded` are left out.
+  void build(size_t node_count, std::span<const size_t> end_a, std::span<const size_t> end_b,
+             const std::vector<bool>& excluded)
+  {
+    offsets.assign(node_count + 1, 0);
+    for (size_t id = 0; id < excluded.size(); ++id)
+      if (!excluded[id])
+      {
+        ++offsets[end_a[id] + 1];
+        ++offsets[end_b[id] + 1];
+      }
+
+    for (size_t n = 0; n < node_count; ++n)
+      offsets[n + 1] += offsets[n];
+
+    entries.resize(offsets[node_count]);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t id = 0; id < excluded.size(); ++id)
+      if (!excluded[id])
+      {
+        const size_t a       = end_a[id];
+        const size_t b       = end_b[id];
+        entries[cursor[a]++] = {b, id};
+        entries[cursor[b]++] = {a, id};
+      }
+  }
+
+  std::span<const Entry> operator[](size_t node) const
+  {
+    return {entries.data() + offsets[node], entries.data() + offsets[node + 1]};
+  }
+};
+} // namespace
+
 struct Sketch_topo::Face_edge
 {
   const Sketch::Edge& edge;
@@ -47,6 +98,8 @@ void Sketch_topo::remove_displayed_faces()
 
   m_faces.clear();
   m_dim_classifier_faces.clear();
+  m_face_cache.clear();
+  m_containment_cache.clear();
 }
 
 double Sketch_topo::plane_pick_snap_radius_world() const
@@ -75,8 +128,9 @@ void Sketch_topo::snap_placed_node_to_closest_linear_edge_interior_(size_t node_
   double                  best_err = std::numeric_limits<double>::infinity();
   std::optional<gp_Pnt2d> best_proj;
 
-  for (const auto& e : m_sketch.m_edges.edges())
+  for (Sketch_edges::Edge_handle h : m_sketch.m_edges.edges_near(p, p, max_d))
   {
+    const Sketch_edge& e = m_sketch.m_edges.edges()[h];
     if (!sketch_edge_is_linear(e))
       continue;
 
@@ -104,10 +158,8 @@ void Sketch_topo::snap_placed_node_to_closest_linear_edge_interior_(size_t node_
 
   if (best_proj)
   {
-    Sketch_nodes::Node& n = m_sketch.m_nodes[node_idx];
-    n.SetX(best_proj->X());
-    n.SetY(best_proj->Y());
-    n.midpoint = false;
+    m_sketch.m_nodes.set_node_pt(node_idx, *best_proj);
+    m_sketch.m_nodes[node_idx].midpoint = false;
   }
 }
 
@@ -125,22 +177,24 @@ void Sketch_topo::split_linear_edges_at_node_if_interior(size_t node_idx, Sketch
 {
   EZY_ASSERT(node_idx < m_sketch.m_nodes.size());
   snap_placed_node_to_closest_linear_edge_interior_(node_idx);
-  const gp_Pnt2d& p = m_sketch.m_nodes[node_idx];
+  // Copy: splitting may add midpoint nodes and reallocate node storage.
+  const gp_Pnt2d p = m_sketch.m_nodes[node_idx];
 
   bool progress = true;
   while (progress)
   {
     progress = false;
-    for (auto itr = m_sketch.m_edges.edges().begin(); itr != m_sketch.m_edges.edges().end(); ++itr)
+    for (Sketch_edges::Edge_handle h : m_sketch.m_edges.edges_near(p, p))
     {
-      if (!sketch_edge_is_linear(*itr))
+      const Sketch::Edge& edge = m_sketch.m_edges.edges()[h];
+      if (!sketch_edge_is_linear(edge))
         continue;
 
-      if (!itr->node_idx_b.has_value())
+      if (!edge.node_idx_b.has_value())
         continue;
 
-      const size_t    a  = itr->node_idx_a;
-      const size_t    b  = *itr->node_idx_b;
+      const size_t    a  = edge.node_idx_a;
+      const size_t    b  = *edge.node_idx_b;
       const gp_Pnt2d& pa = m_sketch.m_nodes[a];
       const gp_Pnt2d& pb = m_sketch.m_nodes[b];
 
@@ -156,13 +210,13 @@ void Sketch_topo::split_linear_edges_at_node_if_interior(size_t node_idx, Sketch
       m_sketch.update_edge_end_pt_(edge_b, b);
 
       if (rec)
-        rec->note_prev_linear_edge(itr->node_idx_a, *itr->node_idx_b, itr->node_idx_mid, itr->name);
+        rec->note_prev_linear_edge(edge.node_idx_a, *edge.node_idx_b, edge.node_idx_mid, edge.name);
 
-      m_sketch.m_ctx.Remove(itr->shp, false);
-      m_sketch.m_edges.edges().erase(itr);
+      m_sketch.m_ctx.Remove(edge.shp, false);
+      m_sketch.m_edges.erase(h);
       m_sketch.m_nodes[node_idx].midpoint = false;
-      m_sketch.m_edges.edges().push_back(std::move(edge_a));
-      m_sketch.m_edges.edges().push_back(std::move(edge_b));
+      m_sketch.m_edges.insert(std::move(edge_a));
+      m_sketch.m_edges.insert(std::move(edge_b));
 
       progress = true;
       break;
@@ -183,27 +237,28 @@ void Sketch_topo::split_arcs_at_node_if_interior(size_t node_idx, Sketch_op_reco
 void Sketch_topo::split_arcs_at_node_if_interior(size_t node_idx, Sketch_op_recorder* rec)
 {
   EZY_ASSERT(node_idx < m_sketch.m_nodes.size());
-  const gp_Pnt2d& p = m_sketch.m_nodes[node_idx];
+  const gp_Pnt2d p = m_sketch.m_nodes[node_idx];
 
   bool progress = true;
   while (progress)
   {
     progress = false;
-    for (auto itr = m_sketch.m_edges.edges().begin(); itr != m_sketch.m_edges.edges().end(); ++itr)
+    for (Sketch_edges::Edge_handle h : m_sketch.m_edges.edges_near(p, p))
     {
-      if (!sketch_edge_is_arc(*itr))
+      const Sketch::Edge& edge = m_sketch.m_edges.edges()[h];
+      if (!sketch_edge_is_arc(edge))
         continue;
 
-      EZY_ASSERT(itr->node_idx_b.has_value());
-      const size_t idx_a = itr->node_idx_a;
-      const size_t idx_b = *itr->node_idx_b;
+      EZY_ASSERT(edge.node_idx_b.has_value());
+      const size_t idx_a = edge.node_idx_a;
+      const size_t idx_b = *edge.node_idx_b;
       if (node_idx == idx_a || node_idx == idx_b)
         continue;
 
-      if (!point_on_open_arc_interior_2d(p, TopoDS::Edge(itr->shp->Shape()), m_sketch.m_pln))
+      if (!point_on_open_arc_interior_2d(p, TopoDS::Edge(edge.shp->Shape()), m_sketch.m_pln))
         continue;
 
-      m_sketch.m_edges.split_arc_at_node_(itr, node_idx, rec);
+      m_sketch.m_edges.split_arc_at_node_(h, node_idx, rec);
       m_sketch.m_nodes[node_idx].midpoint = false;
       progress                            = true;
       break;
@@ -216,33 +271,41 @@ void Sketch_topo::update_faces()
 {
   m_sketch.m_nodes.finalize();
 
-  m_sketch.m_view.remove(m_faces);
+  // Faces are rebuilt from the graph every time, but a face whose boundary cycle is unchanged keeps its AIS object,
+  // hole cut and nesting results. Only faces touching added, removed or split edges are created or removed.
+  std::multimap<Face_key, Cached_face> prev_faces;
+  prev_faces.swap(m_face_cache);
   m_faces.clear();
   m_dim_classifier_faces.clear();
 
   // Used to cleanup dangling nodes;
-  std::vector<bool> used_nodes(m_sketch.m_nodes.size());
-
-  // Build adjacency list
-  std::unordered_map<size_t, std::vector<std::pair<size_t, const Sketch::Edge*>>> adj_list;
-
-  for (const auto& edge : m_sketch.m_edges.edges())
+  const size_t      node_count = m_sketch.m_nodes.size();
+  std::vector<bool> used_nodes(node_count);
+
+  // Edge ids are `Sketch_edges` handles; erased slots start out excluded. The graph passes read the per-handle node
+  // arrays and only touch the edge records for arc tangents and face building.
+  const Sketch_edges::Edge_store&                edges  = m_sketch.m_edges.edges();
+  const std::span<const Sketch_edges::Edge_kind> kinds  = m_sketch.m_edges.kinds();
+  const std::span<const size_t>                  end_a  = m_sketch.m_edges.end_nodes_a();
+  const std::span<const size_t>                  end_b  = m_sketch.m_edges.end_nodes_b();
+  const std::span<const size_t>                  mid    = m_sketch.m_edges.mid_nodes();
+  const std::span<const size_t>                  arc_pt = m_sketch.m_edges.arc_pt_nodes();
+  std::vector<bool>                              excluded(edges.slot_count(), true);
+  for (size_t h = 0; h < kinds.size(); ++h)
   {
-    EZY_ASSERT(edge.node_idx_b.has_value());
+    if (kinds[h] == Sketch_edges::Edge_kind::Free)
+      continue;
 
-    size_t a = edge.node_idx_a;
-    size_t b = edge.node_idx_b.value();
-    adj_list[a].push_back({b, &edge});
-    adj_list[b].push_back({a, &edge});
+    excluded[h] = false;
 
     // Keep track of used nodes.
-    used_nodes[a] = true;
-    used_nodes[b] = true;
-    if (edge.node_idx_mid.has_value())
-      used_nodes[*edge.node_idx_mid] = true;
+    used_nodes[end_a[h]] = true;
+    used_nodes[end_b[h]] = true;
+    if (mid[h] != Sketch_edges::k_no_node)
+      used_nodes[mid[h]] = true;
 
-    if (edge.node_idx_arc_pt.has_value())
-      used_nodes[*edge.node_idx_arc_pt] = true;
+    if (arc_pt[h] != Sketch_edges::k_no_node)
+      used_nodes[arc_pt[h]] = true;
   }
 
   if (m_sketch.m_operation_axis.has_value())
@@ -252,46 +315,40 @@ void Sketch_topo::update_faces()
       used_nodes[*m_sketch.m_operation_axis->node_idx_b] = true;
   }
 
-  // Remove dangling edges (edges with degree-1 endpoints) iteratively.
-  // These edges cannot form closed faces, so we exclude them from face detection.
-  std::unordered_set<const Sketch::Edge*> excluded_edges;
+  Edge_adjacency adj;
+  adj.build(node_count, end_a, end_b, excluded);
 
-  bool changed = true;
-  while (changed)
+  // Remove dangling edges (edges with degree-1 endpoints) by peeling degree-1 nodes off a work queue.
+  // These edges cannot form closed faces, so we exclude them from face detection. Each edge is peeled at most once,
+  // so long open chains cost O(E) instead of one full rescan per removed layer.
+  std::vector<size_t> degree(node_count);
+  std::vector<size_t> peel_queue;
+  for (size_t idx = 0; idx < node_count; ++idx)
   {
-    changed = false;
-    std::unordered_set<const Sketch::Edge*> to_exclude;
+    degree[idx] = adj[idx].size();
+    if (degree[idx] == 1)
+      peel_queue.push_back(idx);
+  }
 
-    // Find edges where at least one endpoint has degree 1 (considering only non-excluded edges)
-    for (const auto& edge : m_sketch.m_edges.edges())
+  while (!peel_queue.empty())
+  {
+    const size_t idx = peel_queue.back();
+    peel_queue.pop_back();
+    if (degree[idx] != 1)
+      continue;
+
+    for (const Edge_adjacency::Entry& e : adj[idx])
     {
-      if (excluded_edges.count(&edge))
+      if (excluded[e.edge])
         continue;
 
-      EZY_ASSERT(edge.node_idx_b.has_value());
-      size_t a = edge.node_idx_a;
-      size_t b = edge.node_idx_b.value();
-
-      // Count degree for each endpoint (excluding already excluded edges)
-      int degree_a = 0;
-      int degree_b = 0;
-      for (const auto& [neighbor, e] : adj_list[a])
-        if (!excluded_edges.count(e))
-          ++degree_a;
-
-      for (const auto& [neighbor, e] : adj_list[b])
-        if (!excluded_edges.count(e))
-          ++degree_b;
-
-      // If either endpoint has degree 1, this edge is dangling
-      if (degree_a == 1 || degree_b == 1)
-      {
-        to_exclude.insert(&edge);
-        changed = true;
-      }
-    }
+      excluded[e.edge] = true;
+      --degree[idx];
+      if (--degree[e.node] == 1)
+        peel_queue.push_back(e.node);
 
-    excluded_edges.insert(to_exclude.begin(), to_exclude.end());
+      break;
+    }
   }
 
   // Bridge edge removal logic (active). Excludes edges that purely connect separate cycles
@@ -304,58 +361,49 @@ void Sketch_topo::update_faces()
   // Remove bridge edges that connect two separate cycles.
   // A bridge edge connects two cycles and has both endpoints with degree >= 3.
   // We detect this by checking if the edge is the only connection between two cycles.
-  std::unordered_set<const Sketch::Edge*> bridge_edges;
-  for (const auto& edge : m_sketch.m_edges.edges())
+  std::vector<size_t>   bridge_edges;
+  std::vector<uint32_t> bfs_stamp(node_count);
+  uint32_t              bfs_round = 0;
+  std::vector<size_t>   queue;
+  for (size_t edge_id = 0; edge_id < excluded.size(); ++edge_id)
   {
-    if (excluded_edges.count(&edge))
+    if (excluded[edge_id])
       continue;
 
-    EZY_ASSERT(edge.node_idx_b.has_value());
-    size_t a = edge.node_idx_a;
-    size_t b = edge.node_idx_b.value();
-
-    // Count degree for each endpoint (excluding already excluded edges)
-    int degree_a = 0;
-    int degree_b = 0;
-    for (const auto& [neighbor, e] : adj_list[a])
-      if (!excluded_edges.count(e))
-        ++degree_a;
-
-    for (const auto& [neighbor, e] : adj_list[b])
-      if (!excluded_edges.count(e))
-        ++degree_b;
+    const size_t a = end_a[edge_id];
+    const size_t b = end_b[edge_id];
 
-    // Bridge edges have both endpoints with degree >= 3
+    // Bridge edges have both endpoints with degree >= 3 (degrees already exclude dangling edges)
     // They connect two separate cycles. We detect this by checking if removing the edge
     // creates two disconnected components, each containing a cycle.
-    if (degree_a >= 3 && degree_b >= 3)
+    if (degree[a] >= 3 && degree[b] >= 3)
     {
       // Check if removing this edge disconnects the graph
       // by seeing if we can reach 'b' from 'a' without using this edge
-      std::unordered_set<size_t> visited;
-      std::vector<size_t>        queue;
+      ++bfs_round;
+      queue.clear();
       queue.push_back(a);
-      visited.insert(a);
+      bfs_stamp[a]     = bfs_round;
       bool can_reach_b = false;
 
       for (size_t i = 0; i < queue.size() && !can_reach_b; ++i)
       {
         size_t curr = queue[i];
-        for (const auto& [neighbor, e] : adj_list[curr])
+        for (const Edge_adjacency::Entry& e : adj[curr])
         {
-          if (excluded_edges.count(e) || e == &edge)
+          if (excluded[e.edge] || e.edge == edge_id)
             continue;
 
-          if (neighbor == b)
+          if (e.node == b)
           {
             can_reach_b = true;
             break;
           }
 
-          if (!visited.count(neighbor))
+          if (bfs_stamp[e.node] != bfs_round)
           {
-            visited.insert(neighbor);
-            queue.push_back(neighbor);
+            bfs_stamp[e.node] = bfs_round;
+            queue.push_back(e.node);
           }
         }
       }
@@ -365,71 +413,61 @@ void Sketch_topo::update_faces()
       if (!can_reach_b)
       {
         // Check if component containing 'a' has a cycle
-        auto has_cycle_in_component = [&](size_t start, const Sketch::Edge* exclude_edge) -> bool
+        auto has_cycle_in_component = [&](size_t start, size_t exclude_edge) -> bool
         {
           std::unordered_set<size_t>          comp_visited;
           std::function<bool(size_t, size_t)> dfs = [&](size_t curr, size_t parent) -> bool
           {
             comp_visited.insert(curr);
-            for (const auto& [neighbor, e] : adj_list[curr])
+            for (const Edge_adjacency::Entry& e : adj[curr])
             {
-              if (excluded_edges.count(e) || e == exclude_edge)
+              if (excluded[e.edge] || e.edge == exclude_edge)
                 continue;
 
-              if (neighbor == parent)
+              if (e.node == parent)
                 continue;
 
-              if (comp_visited.count(neighbor))
+              if (comp_visited.count(e.node))
                 // Found a back edge = cycle
                 return true;
 
-              if (dfs(neighbor, curr))
+              if (dfs(e.node, curr))
                 return true;
             }
             return false;
           };
 
           // Try starting from each neighbor
-          for (const auto& [neighbor, e] : adj_list[start])
+          for (const Edge_adjacency::Entry& e : adj[start])
           {
-            if (excluded_edges.count(e) || e == exclude_edge)
+            if (excluded[e.edge] || e.edge == exclude_edge)
               continue;
 
             comp_visited.clear();
             comp_visited.insert(start);
-            if (dfs(neighbor, start))
+            if (dfs(e.node, start))
               return true;
           }
 
           return false;
         };
 
-        bool a_has_cycle = has_cycle_in_component(a, &edge);
-        bool b_has_cycle = has_cycle_in_component(b, &edge);
+        bool a_has_cycle = has_cycle_in_component(a, edge_id);
+        bool b_has_cycle = has_cycle_in_component(b, edge_id);
 
         // If both components have cycles, this edge is a bridge
         if (a_has_cycle && b_has_cycle)
-          bridge_edges.insert(&edge);
+          bridge_edges.push_back(edge_id);
       }
     }
   }
 
   // Add bridge edges to excluded set
-  excluded_edges.insert(bridge_edges.begin(), bridge_edges.end());
+  for (size_t edge_id : bridge_edges)
+    excluded[edge_id] = true;
 
-  // Rebuild adjacency list excluding dangling and bridge edges
-  adj_list.clear();
-  for (const auto& edge : m_sketch.m_edges.edges())
-  {
-    if (excluded_edges.count(&edge))
-      continue;
-
-    EZY_ASSERT(edge.node_idx_b.has_value());
-    size_t a = edge.node_idx_a;
-    size_t b = edge.node_idx_b.value();
-    adj_list[a].push_back({b, &edge});
-    adj_list[b].push_back({a, &edge});
-  }
+  // Rebuild adjacency excluding dangling and bridge edges
+  adj.build(node_count, end_a, end_b, excluded);
 
   // Extract faces by walking the planar graph one half-edge at a time.
   //
@@ -441,26 +479,14 @@ void Sketch_topo::update_faces()
   // regions; the single clockwise cycle is the outer, unbounded region and is
   // discarded (it is still marked so it is never walked again).
   //
-  // Keying the visited set on the half-edge (edge pointer + direction) - rather
+  // Keying the visited set on the half-edge (edge id + direction) - rather
   // than on the endpoint node pair - is what lets fully enclosed faces be found: a
   // face whose every boundary edge is shared with an already-discovered neighbor
   // still owns its own, opposite-direction half-edges.
-  struct Half_edge
-  {
-    const Sketch::Edge* edge;
-    bool                reversed;
-    bool                operator==(const Half_edge& o) const { return edge == o.edge && reversed == o.reversed; }
-  };
-
-  struct Half_edge_hash
-  {
-    size_t operator()(const Half_edge& h) const noexcept
-    {
-      return std::hash<const void*>{}(h.edge) ^ (static_cast<size_t>(h.reversed) << 1);
-    }
-  };
+  auto half_edge = [&](size_t edge_id, size_t from_idx, size_t to_idx)
+  { return 2 * edge_id + (edges[edge_id].reversed(from_idx, to_idx) ? 1 : 0); };
 
-  std::unordered_set<Half_edge, Half_edge_hash> visited;
+  std::vector<bool> visited(2 * edges.slot_count());
 
   // A face walk consumes a distinct half-edge each step, so a valid walk cannot
   // exceed the total number of half-edges. The cap is a safety net against
@@ -469,64 +495,63 @@ void Sketch_topo::update_faces()
   // discarded.
   const size_t max_walk_steps = 2 * m_sketch.m_edges.size() + 2;
 
-  for (auto& [a_idx, edges] : adj_list)
-    for (auto& [b_idx, start_edge] : edges)
+  for (size_t a_idx = 0; a_idx < node_count; ++a_idx)
+    for (const Edge_adjacency::Entry& start : adj[a_idx])
     {
-      const Half_edge seed{start_edge, start_edge->reversed(a_idx, b_idx)};
+      const size_t seed = half_edge(start.edge, a_idx, start.node);
 
-      if (visited.count(seed))
+      if (visited[seed])
         continue;
 
-      size_t              prev_idx  = a_idx;
-      size_t              curr_idx  = b_idx;
-      const Sketch::Edge* curr_edge = start_edge;
-      Face_edges          face;
-      bool                closed = false;
+      size_t     prev_idx  = a_idx;
+      size_t     curr_idx  = start.node;
+      size_t     curr_edge = start.edge;
+      Face_edges face;
+      bool       closed = false;
 
       for (size_t step = 0; step < max_walk_steps; ++step)
       {
-        const bool reversed = curr_edge->reversed(prev_idx, curr_idx);
-        face.push_back({*curr_edge, reversed});
-        visited.insert({curr_edge, reversed});
+        const Sketch::Edge& edge     = edges[curr_edge];
+        const bool          reversed = edge.reversed(prev_idx, curr_idx);
+        face.push_back({edge, reversed});
+        visited[2 * curr_edge + (reversed ? 1 : 0)] = true;
 
         // Choose the next edge around curr_idx: the one turning as far left as
         // possible relative to the direction we arrived from (smallest signed
         // angle). This keeps the face interior on our left for the whole walk.
         const gp_Vec2d incoming_dir =
-            sketch_edge_incoming_dir_2d(*curr_edge, m_sketch.m_nodes[prev_idx], m_sketch.m_nodes[curr_idx], m_sketch.m_pln);
+            sketch_edge_incoming_dir_2d(edge, m_sketch.m_nodes[prev_idx], m_sketch.m_nodes[curr_idx], m_sketch.m_pln);
 
-        double              min_angle = std::numeric_limits<double>::max();
-        size_t              next_idx  = 0;
-        const Sketch::Edge* next_edge = nullptr;
-        for (auto& [cand_idx, cand_edge] : adj_list[curr_idx])
+        double                       min_angle = std::numeric_limits<double>::max();
+        const Edge_adjacency::Entry* next      = nullptr;
+        for (const Edge_adjacency::Entry& cand : adj[curr_idx])
         {
           // Never immediately backtrack along the edge we just traversed, but do
           // allow other parallel edges between the same node pair.
-          if (cand_idx == prev_idx && cand_edge == curr_edge)
+          if (cand.node == prev_idx && cand.edge == curr_edge)
             continue;
 
-          const gp_Vec2d outgoing_dir =
-              sketch_edge_outgoing_dir_2d(*cand_edge, m_sketch.m_nodes[curr_idx], m_sketch.m_nodes[cand_idx], m_sketch.m_pln);
-          const double angle = std::atan2(outgoing_dir.Crossed(incoming_dir), outgoing_dir.Dot(incoming_dir));
+          const gp_Vec2d outgoing_dir = sketch_edge_outgoing_dir_2d(edges[cand.edge], m_sketch.m_nodes[curr_idx],
+                                                                    m_sketch.m_nodes[cand.node], m_sketch.m_pln);
+          const double   angle        = std::atan2(outgoing_dir.Crossed(incoming_dir), outgoing_dir.Dot(incoming_dir));
           if (angle < min_angle)
           {
             min_angle = angle;
-            next_idx  = cand_idx;
-            next_edge = cand_edge;
+            next      = &cand;
           }
         }
 
-        if (!next_edge)
+        if (!next)
           // Dead end: only possible with invalid/dangling topology.
           break;
 
         prev_idx  = curr_idx;
-        curr_idx  = next_idx;
-        curr_edge = next_edge;
+        curr_idx  = next->node;
+        curr_edge = next->edge;
 
         // The face closes when the walk is about to re-traverse the seed
         // half-edge (the standard face-cycle termination condition).
-        if (Half_edge{curr_edge, curr_edge->reversed(prev_idx, curr_idx)} == seed)
+        if (half_edge(curr_edge, prev_idx, curr_idx) == seed)
         {
           closed = true;
           break;
@@ -539,14 +564,26 @@ void Sketch_topo::update_faces()
       if (!closed || face.size() < 2 || !is_face_ccw_(face))
         continue;
 
+      Face_key key  = face_key_(face);
+      auto     prev = prev_faces.find(key);
+      if (prev != prev_faces.end())
+      {
+        m_faces.push_back(prev->second.shp);
+        m_face_cache.insert(prev_faces.extract(prev));
+        continue;
+      }
+
       Sketch_face_shp_ptr f = create_face_shape_(face);
       m_sketch.update_face_style_(f);
-
-      m_sketch.m_ctx.Display(f, AIS_Shaded, AIS_Shape::SelectionMode(TopAbs_FACE), true);
-      m_sketch.m_ctx.Activate(f, AIS_Shape::SelectionMode(TopAbs_FACE));
       m_faces.push_back(f);
+      m_face_cache.emplace(std::move(key), make_cached_face_(f));
     }
 
+  // Faces whose boundary cycle no longer exists.
+  bool viewer_dirty = !prev_faces.empty();
+  for (auto& [key, gone] : prev_faces)
+    m_sketch.m_ctx.Remove(gone.shp, false);
+
   // Mark unused nodes as deleted so they're excluded from snapping operations.
   // Nodes become unused when all edges that reference them are removed.
   // Permanent add-node points are never auto-tombstoned when unused; user delete sets `deleted` and it stays.
@@ -557,73 +594,145 @@ void Sketch_topo::update_faces()
   // Book keeping
   struct Face_meta
   {
-    Sketch_face_shp_ptr           shp;
-    double                        area;
+    Cached_face*                  face;
     int                           parent_idx;
     std::vector<const Face_meta*> holes;
   };
 
   std::vector<Face_meta> face_metas;
-  face_metas.reserve(m_faces.size());
-  for (Sketch_face_shp_ptr& face : m_faces)
-    face_metas.push_back({face, compute_face_area(face), -1});
+  face_metas.reserve(m_face_cache.size());
+  for (auto& [key, face] : m_face_cache)
+    face_metas.push_back({&face, -1});
 
   // Sort faces by area (descending) to check larger faces first
   std::sort(face_metas.begin(), face_metas.end(),
             [](const Face_meta& a, const Face_meta& b)
             {
-              return a.area > b.area; // Descending by area
+              return a.face->area > b.face->area; // Descending by area
             });
 
-  // Classify faces
+  // Classify faces. A face can only contain another if its bounds enclose every vertex of the other, so candidate
+  // parents come from a grid over the face bounds instead of testing every pair.
+  double mean_extent = 0.0;
+  for (const Face_meta& meta : face_metas)
+    mean_extent += std::max(meta.face->box_max.x - meta.face->box_min.x, meta.face->box_max.y - meta.face->box_min.y);
+
+  if (!face_metas.empty())
+    mean_extent /= static_cast<double>(face_metas.size());
+
+  Grid_index_2d face_grid(std::max(mean_extent, Precision::Confusion()));
   for (size_t face_i = 0, num = face_metas.size(); face_i < num; ++face_i)
+    face_grid.insert(face_i, face_metas[face_i].face->box_min, face_metas[face_i].face->box_max);
+
+  std::vector<size_t> candidates;
+  for (size_t face_j = 0, num = face_metas.size(); face_j < num; ++face_j)
   {
-    Face_meta& face_a = face_metas[face_i];
-    for (size_t face_j = face_i + 1; face_j < num; ++face_j)
+    Face_meta&         face_b = face_metas[face_j];
+    const Cached_face& inner  = *face_b.face;
+
+    candidates.clear();
+    face_grid.query(inner.verts_min, inner.verts_max,
+                    [&](size_t face_i)
+                    {
+                      const Cached_face& outer = *face_metas[face_i].face;
+                      if (face_i < face_j && all(lessThanEqual(outer.box_min, inner.verts_min)) &&
+                          all(greaterThanEqual(outer.box_max, inner.verts_max)))
+                        candidates.push_back(face_i);
+                    });
+
+    // Larger faces first, as in the sorted order
+    std::sort(candidates.begin(), candidates.end());
+    for (size_t face_i : candidates)
     {
-      Face_meta& face_b = face_metas[face_j];
-      if (is_face_contained(face_b.shp->Shape(), face_a.shp->Shape()))
+      const Face_meta& face_a = face_metas[face_i];
+      if (is_face_contained_cached_(inner, *face_a.face))
         // Check if face_a is better (smaller) parent than the current one
-        if (face_b.parent_idx == -1 || face_a.area < face_metas[face_a.parent_idx].area)
+        if (face_b.parent_idx == -1 || face_a.face->area < face_metas[face_b.parent_idx].face->area)
           face_b.parent_idx = static_cast<int>(face_i);
     }
   }
 
+  if (!prev_faces.empty())
+  {
+    std::unordered_set<size_t> live_ids;
+    for (const auto& [key, face] : m_face_cache)
+      live_ids.insert(face.id);
+
+    std::erase_if(m_containment_cache,
+                  [&](const auto& entry)
+                  { return !live_ids.count(entry.first.first) || !live_ids.count(entry.first.second); });
+  }
+
   // Assign holes
   for (const Face_meta& face : face_metas)
     if (face.parent_idx != -1)
       face_metas[face.parent_idx].holes.push_back(&face);
 
-  // Rebuild face shapes with their holes
-  for (Face_meta& face : face_metas)
-    if (face.holes.size())
+  // Rebuild face shapes whose set of holes changed
+  for (Face_meta& meta : face_metas)
+  {
+    Cached_face&        face = *meta.face;
+    std::vector<size_t> hole_ids;
+    hole_ids.reserve(meta.holes.size());
+    for (const Face_meta* hole : meta.holes)
+      hole_ids.push_back(hole->face->id);
+
+    std::sort(hole_ids.begin(), hole_ids.end());
+    if (hole_ids == face.hole_ids)
+      continue;
+
+    if (hole_ids.empty())
+      face.shp->SetShape(face.outer);
+    else
     {
-      EZY_ASSERT(face.shp->Shape().ShapeType() == TopAbs_FACE);
-      BRepBuilderAPI_MakeFace face_maker(TopoDS::Face(face.shp->Shape()));
-      for (const Face_meta* hole : face.holes)
+      BRepBuilderAPI_MakeFace face_maker(face.outer);
+      for (const Face_meta* hole : meta.holes)
       {
-        EZY_ASSERT(hole->shp->Shape().ShapeType() == TopAbs_FACE);
-        TopoDS_Wire hole_wire = BRepTools::OuterWire(TopoDS::Face(hole->shp->Shape()));
+        TopoDS_Wire hole_wire = BRepTools::OuterWire(hole->face->outer);
         // Winding order is important
         hole_wire.Reverse();
         face_maker.Add(hole_wire);
       }
       EZY_ASSERT(face_maker.IsDone());
-      // auto dbg_face = to_boost(face_maker.Face(), m_pln);
       face.shp->SetShape(face_maker.Face());
     }
 
-  // Use the nesting depth of the faces to define the face selection sensitivity
-  for (const Face_meta& face : face_metas)
+    face.hole_ids = std::move(hole_ids);
+    if (face.displayed)
+    {
+      m_sketch.m_ctx.Redisplay(face.shp, false);
+      viewer_dirty = true;
+    }
+  }
+
+  // Display new faces once their holes are cut, and use the nesting depth of the faces to define the face selection
+  // sensitivity
+  for (const Face_meta& meta : face_metas)
   {
     int              nesting_depth = 0;
-    const Face_meta* curr_face     = &face;
+    const Face_meta* curr_face     = &meta;
     for (; curr_face->parent_idx != -1; ++nesting_depth)
       curr_face = &face_metas[curr_face->parent_idx];
 
-    m_sketch.m_ctx.SetSelectionSensitivity(face.shp, 0, nesting_depth + 1);
+    Cached_face& face = *meta.face;
+    if (!face.displayed)
+    {
+      m_sketch.m_ctx.Display(face.shp, AIS_Shaded, AIS_Shape::SelectionMode(TopAbs_FACE), false);
+      m_sketch.m_ctx.Activate(face.shp, AIS_Shape::SelectionMode(TopAbs_FACE));
+      face.displayed = true;
+      viewer_dirty   = true;
+    }
+
+    if (face.nesting_depth != nesting_depth)
+    {
+      m_sketch.m_ctx.SetSelectionSensitivity(face.shp, 0, nesting_depth + 1);
+      face.nesting_depth = nesting_depth;
+    }
   }
 
+  if (viewer_dirty)
+    m_sketch.m_ctx.UpdateCurrentViewer();
+
   rebuild_dim_classifier_face_cache_();
   m_sketch.m_dims.purge_stale_length_dimensions();
   m_sketch.m_node_marks.sync();
@@ -641,6 +750,36 @@ void Sketch_topo::rebuild_dim_classifier_face_cache_()
     m_dim_classifier_faces.push_back(TopoDS::Face(fp->Shape()));
 }
 
+bool Sketch_topo::is_face_contained_cached_(const Cached_face& inner, const Cached_face& outer)
+{
+  const std::pair<size_t, size_t> key {inner.id, outer.id};
+  if (auto it = m_containment_cache.find(key); it != m_containment_cache.end())
+    return it->second;
+
+  // Pre-check the vertices against the cached outline. A vertex farther than `ring_tol` from the outline is
+  // classified the same way as against the true face; only near-boundary vertices need the OCCT classifier.
+  bool contained    = true;
+  bool near_outline = false;
+  for (const gp_Pnt2d& v : inner.verts)
+  {
+    const int side = ezy_geom::classify(to_boost(v), outer.ring, outer.ring_tol);
+    if (side < 0)
+    {
+      contained = false;
+      break;
+    }
+
+    if (side == 0)
+      near_outline = true;
+  }
+
+  if (contained && near_outline)
+    contained = is_face_contained(inner.outer, outer.outer);
+
+  m_containment_cache.emplace(key, contained);
+  return contained;
+}
+
 size_t Sketch_topo::Face_edge::start_nd_idx() const
 {
   if (!reversed)
@@ -712,6 +851,106 @@ bool Sketch_topo::is_face_ccw_(const Face_edges& face) const
   return signed_area > 0;
 }
 
+Sketch_topo::Cached_face Sketch_topo::make_cached_face_(const Sketch_face_shp_ptr& shp)
+{
+  Cached_face face {m_next_face_id++, shp, TopoDS::Face(shp->Shape()), compute_face_area(shp)};
+  face.ring = to_boost(face.outer, m_sketch.m_pln).outer();
+
+  // `to_boost` samples circle edges at `k_boost_circle_edge_pts` points; the chord sagitta bounds how far the ring
+  // strays from an arc.
+  face.ring_tol = Precision::Confusion();
+  for (TopExp_Explorer exp(face.outer, TopAbs_EDGE); exp.More(); exp.Next())
+  {
+    const BRepAdaptor_Curve curve(TopoDS::Edge(exp.Current()));
+    if (curve.GetType() != GeomAbs_Circle)
+      continue;
+
+    const double step =
+        std::abs(curve.LastParameter() - curve.FirstParameter()) / static_cast<double>(k_boost_circle_edge_pts - 1);
+    const double sag  = curve.Circle().Radius() * (1.0 - std::cos(step / 2.0));
+    face.ring_tol     = std::max(face.ring_tol, sag + Precision::Confusion());
+  }
+
+  face.box_min = dvec2(std::numeric_limits<double>::max());
+  face.box_max = dvec2(std::numeric_limits<double>::lowest());
+  for (const ezy_geom::point_2d& p : face.ring)
+  {
+    face.box_min = min(face.box_min, dvec2(p.x(), p.y()));
+    face.box_max = max(face.box_max, dvec2(p.x(), p.y()));
+  }
+
+  face.box_min -= face.ring_tol;
+  face.box_max += face.ring_tol;
+
+  face.verts_min = dvec2(std::numeric_limits<double>::max());
+  face.verts_max = dvec2(std::numeric_limits<double>::lowest());
+  face.verts.reserve(shp->verts_3d.size());
+  for (const gp_Pnt& p : shp->verts_3d)
+  {
+    face.verts.push_back(to_2d(m_sketch.m_pln, p));
+    face.verts_min = min(face.verts_min, to_glm(face.verts.back()));
+    face.verts_max = max(face.verts_max, to_glm(face.verts.back()));
+  }
+
+  return face;
+}
+
+Sketch_topo::Face_key Sketch_topo::face_key_(const Face_edges& face) const
+{
+  // Per half-edge: start node index, start point, arc midpoint (infinity for lines).
+  constexpr size_t stride = 5;
+  constexpr double no_arc = std::numeric_limits<double>::infinity();
+
+  Face_key raw;
+  raw.reserve(face.size() * stride);
+  for (const Face_edge& e : face)
+  {
+    const size_t    start = e.start_nd_idx();
+    const gp_Pnt2d& p     = m_sketch.m_nodes[start];
+    raw.push_back(static_cast<double>(start));
+    raw.push_back(p.X());
+    raw.push_back(p.Y());
+    if (sketch_edge_is_arc(e.edge) && !e.edge.shp.IsNull())
+    {
+      const gp_Pnt2d pm = e.edge.node_idx_arc_pt.has_value()
+                              ? m_sketch.m_nodes[*e.edge.node_idx_arc_pt]
+                              : arc_curve_midpoint_2d(TopoDS::Edge(e.edge.shp->Shape()), m_sketch.m_pln);
+      raw.push_back(pm.X());
+      raw.push_back(pm.Y());
+    }
+    else
+    {
+      raw.push_back(no_arc);
+      raw.push_back(no_arc);
+    }
+  }
+
+  // The walk can start anywhere on the cycle; rotate to the lexicographically smallest start.
+  const size_t n             = face.size();
+  auto         rotation_less = [&](size_t a, size_t b)
+  {
+    for (size_t i = 0; i < raw.size(); ++i)
+    {
+      const double va = raw[(a * stride + i) % raw.size()];
+      const double vb = raw[(b * stride + i) % raw.size()];
+      if (va != vb)
+        return va < vb;
+    }
+    return false;
+  };
+
+  size_t best = 0;
+  for (size_t i = 1; i < n; ++i)
+    if (raw[i * stride] <= raw[best * stride] && rotation_less(i, best))
+      best = i;
+
+  Face_key key;
+  key.reserve(raw.size());
+  key.insert(key.end(), raw.begin() + static_cast<ptrdiff_t>(best * stride), raw.end());
+  key.insert(key.end(), raw.begin(), raw.begin() + static_cast<ptrdiff_t>(best * stride));
+  return key;
+}
+
 Sketch_face_shp_ptr Sketch_topo::create_face_shape_(const Face_edges& face)
 {
   EZY_ASSERT(face.size() >= 2);
@@ -1,8 +1,15 @@
 #pragma once
 
 #include <TopoDS_Face.hxx>
+#include <glm/glm.hpp>
+#include <gp_Pnt2d.hxx>
+#include <map>
+#include <unordered_map>
 #include <vector>
 
+#include "utl.h"
+#include "utl_geom.h"
+
 #include "utl_types.h"
 
 class Sketch;
@@ -14,6 +21,9 @@ class Sketch_topo
 public:
   explicit Sketch_topo(Sketch& sketch);
 
+  /// Rebuilds the face set from the current edges. The graph pass (adjacency, dangling and bridge pruning, face walk)
+  /// runs over the whole sketch on every call; no half-edge structure persists between calls. Only the per-face OCCT
+  /// and viewer work is reused, for faces whose boundary cycle is unchanged (see `Cached_face`).
   void update_faces();
   void split_linear_edges_at_node_if_interior(size_t node_idx);
   void split_linear_edges_at_node_if_interior(size_t node_idx, Sketch_op_recorder& rec);
@@ -34,13 +44,41 @@ public:
 private:
   struct Face_edge;
   using Face_edges = std::vector<Face_edge>;
+  /// Boundary cycle signature: per half-edge start node index, start point and arc midpoint, rotated to a canonical
+  /// start. Equal keys mean identical face geometry, so the face can be reused across `update_faces` calls.
+  using Face_key = std::vector<double>;
+
+  /// A face kept across `update_faces` calls while its boundary cycle is unchanged.
+  struct Cached_face
+  {
+    size_t                id;
+    Sketch_face_shp_ptr   shp;
+    TopoDS_Face           outer;    // Face without holes; used for nesting tests and hole rebuilds.
+    double                area;     // Area of `outer`.
+    ezy_geom::ring_2d     ring;     // `to_boost` outline of `outer` for the point-in-polygon pre-check.
+    double                ring_tol; // Max distance between `ring` and the true outline (arc chords).
+    glm::dvec2            box_min;  // Bounds of `outer`, padded by `ring_tol`.
+    glm::dvec2            box_max;
+    std::vector<gp_Pnt2d> verts; // Outline vertices; the points `is_face_contained` classifies.
+    glm::dvec2            verts_min;
+    glm::dvec2            verts_max;
+    std::vector<size_t>   hole_ids;          // Ids of the faces currently cut into `shp`.
+    int                   nesting_depth{-1}; // -1 until the selection sensitivity has been set.
+    bool                  displayed{false};
+  };
 
   void                snap_placed_node_to_closest_linear_edge_interior_(size_t node_idx);
   bool                is_face_ccw_(const Face_edges& face) const;
   Sketch_face_shp_ptr create_face_shape_(const Face_edges& face);
+  Face_key            face_key_(const Face_edges& face) const;
+  Cached_face         make_cached_face_(const Sketch_face_shp_ptr& shp);
+  bool                is_face_contained_cached_(const Cached_face& inner, const Cached_face& outer);
   void                rebuild_dim_classifier_face_cache_();
 
-  Sketch&                          m_sketch;
-  std::vector<Sketch_face_shp_ptr> m_faces;
-  std::vector<TopoDS_Face>         m_dim_classifier_faces;
+  Sketch&                                                        m_sketch;
+  std::vector<Sketch_face_shp_ptr>                               m_faces;
+  std::vector<TopoDS_Face>                                       m_dim_classifier_faces;
+  std::multimap<Face_key, Cached_face>                           m_face_cache;
+  std::unordered_map<std::pair<size_t, size_t>, bool, Pair_hash> m_containment_cache; // (inner id, outer id)
+  size_t                                                         m_next_face_id{0};
 };
@@ -117,9 +117,12 @@ private:
                            double& out_v);
 
   void build_ais_(const gp_Pln& pln);
+  /// Pixels of the current image, fetched from the asset store on first use; null if that read fails.
+  const uint8_t* rgba_();
 
   AIS_InteractiveContext&                     m_ctx;
   std::shared_ptr<const std::vector<uint8_t>> m_rgba;
+  const Ezy_asset_store*                      m_rgba_store{nullptr}; // Set while `m_rgba` is still to be fetched.
   std::string                                 m_asset_id;
   int                                         m_w{0};
   int                                         m_h{0};
@@ -391,7 +394,24 @@ Sketch_underlay::Impl::Impl(AIS_InteractiveContext& ctx)
 {
 }
 
-bool Sketch_underlay::Impl::has_image() const { return m_rgba && !m_rgba->empty() && m_w > 0 && m_h > 0; }
+bool Sketch_underlay::Impl::has_image() const
+{
+  return (m_rgba ? !m_rgba->empty() : m_rgba_store != nullptr) && m_w > 0 && m_h > 0;
+}
+
+const uint8_t* Sketch_underlay::Impl::rgba_()
+{
+  if (!m_rgba && m_rgba_store)
+  {
+    m_rgba       = m_rgba_store->get(m_asset_id);
+    m_rgba_store = nullptr;
+  }
+
+  if (!m_rgba || m_rgba->size() < static_cast<std::size_t>(m_w) * static_cast<std::size_t>(m_h) * 4u)
+    return nullptr;
+
+  return m_rgba->data();
+}
 
 bool  Sketch_underlay::Impl::key_white_transparent() const { return m_key_white_transparent; }
 bool  Sketch_underlay::Impl::line_tint_enabled() const { return m_line_tint_enabled; }
@@ -416,10 +436,11 @@ bool Sketch_underlay::Impl::set_image_rgba_(std::vector<uint8_t>&& rgba, int w,
   if (rgba.size() > k_max_rgba_bytes)
     return false;
 
-  m_asset_id = store.register_rgba(rgba, w, h);
-  m_rgba     = store.get(m_asset_id);
-  m_w        = w;
-  m_h        = h;
+  m_asset_id   = store.register_rgba(rgba, w, h);
+  m_rgba       = store.get(m_asset_id);
+  m_rgba_store = nullptr;
+  m_w          = w;
+  m_h          = h;
 
   // Default: centered at plane origin, 0.1 model units per image pixel (adjust in UI).
   const double s = 0.1;
@@ -726,6 +747,7 @@ void Sketch_underlay::Impl::clear_()
 {
   ctx_erase();
   clear_all(m_rgba, m_asset_id, m_w, m_h);
+  m_rgba_store = nullptr;
 }
 
 void Sketch_underlay::Impl::sync_visibility_(const gp_Pln& pln)
@@ -763,6 +785,10 @@ void Sketch_underlay::Impl::build_ais_(const gp_Pln& pln)
   if (!has_image())
     return;
 
+  const uint8_t* rgba = rgba_();
+  if (!rgba)
+    return;
+
   gp_Vec nudge(pln.Axis().Direction());
   nudge.Multiply(-10.0 * Precision::Confusion());
 
@@ -809,8 +835,8 @@ void Sketch_underlay::Impl::build_ais_(const gp_Pln& pln)
         return;
 
       face = faceMk.Face();
-      pix  = make_pixmap_bottom_up_linear_(m_rgba->data(), m_w, m_h, m_key_white_transparent, m_line_tint_enabled, m_tint_r,
-                                           m_tint_g, m_tint_b, m_tint_a);
+      pix  = make_pixmap_bottom_up_linear_(rgba, m_w, m_h, m_key_white_transparent, m_line_tint_enabled, m_tint_r, m_tint_g,
+                                           m_tint_b, m_tint_a);
     }
     else
     {
@@ -849,8 +875,8 @@ void Sketch_underlay::Impl::build_ais_(const gp_Pln& pln)
         return;
 
       face = faceMk.Face();
-      pix  = make_pixmap_bottom_up_warped_(m_rgba->data(), m_w, m_h, m_axis_u, m_axis_v, m_key_white_transparent,
-                                           m_line_tint_enabled, m_tint_r, m_tint_g, m_tint_b, m_tint_a);
+      pix  = make_pixmap_bottom_up_warped_(rgba, m_w, m_h, m_axis_u, m_axis_v, m_key_white_transparent, m_line_tint_enabled,
+                                           m_tint_r, m_tint_g, m_tint_b, m_tint_a);
     }
   }
   else
@@ -875,8 +901,8 @@ void Sketch_underlay::Impl::build_ais_(const gp_Pln& pln)
       return;
 
     face = faceMk.Face();
-    pix  = make_pixmap_bottom_up_linear_(m_rgba->data(), m_w, m_h, m_key_white_transparent, m_line_tint_enabled, m_tint_r,
-                                         m_tint_g, m_tint_b, m_tint_a);
+    pix  = make_pixmap_bottom_up_linear_(rgba, m_w, m_h, m_key_white_transparent, m_line_tint_enabled, m_tint_r, m_tint_g,
+                                         m_tint_b, m_tint_a);
 
     if (!pix.IsNull())
     {
@@ -985,10 +1011,13 @@ bool Sketch_underlay::Impl::from_json(const nlohmann::json& j, Ezy_asset_store&
 
   if (j.contains("asset") && j["asset"].is_string())
   {
+    // Only the size is checked here; lazily loaded projects read the pixels when the underlay is first drawn.
     m_asset_id = j["asset"].get<std::string>();
-    m_rgba     = store.get(m_asset_id);
-    if (!m_rgba || m_rgba->size() < static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4u)
+    if (store.asset_size(m_asset_id) < static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4u)
       return false;
+
+    m_rgba.reset();
+    m_rgba_store = &store;
   }
   else if (j.contains("rgba_b64"))
   {
@@ -1002,8 +1031,9 @@ bool Sketch_underlay::Impl::from_json(const nlohmann::json& j, Ezy_asset_store&
     if (decoded.size() > k_max_rgba_bytes)
       return false;
 
-    m_asset_id = store.register_rgba(decoded, w, h);
-    m_rgba     = store.get(m_asset_id);
+    m_asset_id   = store.register_rgba(decoded, w, h);
+    m_rgba       = store.get(m_asset_id);
+    m_rgba_store = nullptr;
   }
   else
     return false;
@@ -25,26 +25,77 @@ std::string Ezy_asset_store::register_rgba(const std::vector<uint8_t>& rgba, int
 {
   const std::string id = make_asset_id(rgba.data(), rgba.size(), w, h);
   if (m_by_id.find(id) == m_by_id.end())
+  {
+    m_pending.erase(id);
     m_by_id[id] = std::make_shared<const std::vector<uint8_t>>(rgba);
+  }
 
   return id;
 }
 
 std::shared_ptr<const std::vector<uint8_t>> Ezy_asset_store::get(const std::string& asset_id) const
 {
-  const auto it = m_by_id.find(asset_id);
-  if (it == m_by_id.end())
+  if (const auto it = m_by_id.find(asset_id); it != m_by_id.end())
+    return it->second;
+
+  const auto pending = m_pending.find(asset_id);
+  if (pending == m_pending.end())
     return {};
 
-  return it->second;
+  // A failed read stays failed; keeping the reader would retry it on every redraw.
+  std::vector<uint8_t> rgba = pending->second.read();
+  m_pending.erase(pending);
+  if (rgba.empty())
+    return {};
+
+  auto shared       = std::make_shared<const std::vector<uint8_t>>(std::move(rgba));
+  m_by_id[asset_id] = shared;
+  return shared;
+}
+
+bool Ezy_asset_store::contains(const std::string& asset_id) const
+{
+  return m_by_id.find(asset_id) != m_by_id.end() || m_pending.find(asset_id) != m_pending.end();
+}
+
+std::size_t Ezy_asset_store::asset_size(const std::string& asset_id) const
+{
+  if (const auto it = m_by_id.find(asset_id); it != m_by_id.end())
+    return it->second->size();
+
+  if (const auto it = m_pending.find(asset_id); it != m_pending.end())
+    return it->second.size;
+
+  return 0;
 }
 
 void Ezy_asset_store::import_asset(const std::string& asset_id, std::vector<uint8_t>&& rgba)
 {
+  m_pending.erase(asset_id);
   m_by_id[asset_id] = std::make_shared<const std::vector<uint8_t>>(std::move(rgba));
 }
 
-void Ezy_asset_store::clear() { m_by_id.clear(); }
+void Ezy_asset_store::import_lazy_asset(const std::string& asset_id, std::size_t size,
+                                        std::function<std::vector<uint8_t>()> read)
+{
+  m_by_id.erase(asset_id);
+  m_pending[asset_id] = Pending_asset{size, std::move(read)};
+}
+
+void Ezy_asset_store::load_pending()
+{
+  while (!m_pending.empty())
+  {
+    const std::string id = m_pending.begin()->first; // `get` erases the entry that owns the key.
+    (void)get(id);
+  }
+}
+
+void Ezy_asset_store::clear()
+{
+  m_by_id.clear();
+  m_pending.clear();
+}
 
 namespace
 {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -13,15 +14,32 @@ public:
   /// Content-addressed id (FNV-1a 64-bit hex) from w, h, and pixel bytes.
   [[nodiscard]] std::string register_rgba(const std::vector<uint8_t>& rgba, int w, int h);
 
+  /// Reads a lazily imported asset on first request. Empty when unknown or when its deferred read fails.
   [[nodiscard]] std::shared_ptr<const std::vector<uint8_t>> get(const std::string& asset_id) const;
+  [[nodiscard]] bool                                        contains(const std::string& asset_id) const;
+  /// Byte count of \a asset_id without reading a lazy asset; 0 when unknown.
+  [[nodiscard]] std::size_t                                 asset_size(const std::string& asset_id) const;
 
   /// Insert or replace bytes for \a asset_id (e.g. when loading a zip archive).
   void import_asset(const std::string& asset_id, std::vector<uint8_t>&& rgba);
+  /// Registers \a asset_id to be read by \a read on first `get` (lazy project load). \a size is the byte count \a read
+  /// returns, so underlays can validate dimensions up front.
+  void import_lazy_asset(const std::string& asset_id, std::size_t size, std::function<std::vector<uint8_t>()> read);
+  /// Reads every lazy asset still pending, so none depends on its source any more.
+  void load_pending();
 
   void clear();
 
   [[nodiscard]] static std::string make_asset_id(const uint8_t* rgba, std::size_t len, int w, int h);
 
 private:
-  std::unordered_map<std::string, std::shared_ptr<const std::vector<uint8_t>>> m_by_id;
+  struct Pending_asset
+  {
+    std::size_t                           size{0};
+    std::function<std::vector<uint8_t>()> read;
+  };
+
+  // `get` is const but moves pending assets into `m_by_id`; the store is UI-thread only.
+  mutable std::unordered_map<std::string, std::shared_ptr<const std::vector<uint8_t>>> m_by_id;
+  mutable std::unordered_map<std::string, Pending_asset>                               m_pending;
 };
@@ -0,0 +1,162 @@
+#include "utl_boolean.h"
+
+#include <BOPAlgo_CellsBuilder.hxx>
+#include <BRepAlgoAPI_BooleanOperation.hxx>
+#include <BRepBndLib.hxx>
+#include <BRep_Builder.hxx>
+#include <Bnd_OBB.hxx>
+#include <Message_ProgressRange.hxx>
+#include <Precision.hxx>
+#include <Standard_Failure.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopoDS_Compound.hxx>
+
+#include <algorithm>
+
+#include "utl_occt.h"
+#include "utl_parallel.h"
+
+namespace
+{
+bool   disjoint_(const Bnd_OBB& a, const Bnd_OBB& b);
+Status run_common_(const std::vector<TopoDS_Shape>& operands, TopoDS_Shape& out, const Boolean_params& params,
+                   const Message_ProgressRange& range);
+} // namespace
+
+Status boolean_op_multi(Boolean_op op, const std::vector<TopoDS_Shape>& operands, TopoDS_Shape& out,
+                        const Boolean_params& params)
+{
+  out.Nullify();
+  if (operands.size() < 2)
+    return Status::user_error("Boolean operation needs two or more shapes.");
+
+  for (const TopoDS_Shape& s : operands)
+    if (s.IsNull())
+      return Status::user_error("Boolean operation on a null shape.");
+
+  // Oriented boxes stay tight around rotated operands (polar duplicates), where axis-aligned boxes overlap widely.
+  // Built from the exact geometry (a mesh can sit inside curved faces by its sag) and grown by the fuzzy value, so
+  // only operands that cannot touch are dropped.
+  const double         gap = std::max(params.fuzzy_value, 0.0) + Precision::Confusion();
+  std::vector<Bnd_OBB> boxes(operands.size());
+  parallel_for_each_index(operands.size(),
+                          [&](size_t i)
+                          {
+                            try
+                            {
+                              BRepBndLib::AddOBB(operands[i], boxes[i], false /*isTriangulationUsed*/);
+                              if (!boxes[i].IsVoid())
+                                boxes[i].Enlarge(gap);
+                            }
+                            catch (const Standard_Failure&)
+                            {
+                              boxes[i] = Bnd_OBB(); // Void: never treated as disjoint
+                            }
+                          });
+
+  std::vector<size_t> tools;
+  for (size_t i = 1; i < operands.size(); ++i)
+    if (op != Boolean_op::Cut || !disjoint_(boxes[0], boxes[i]))
+      tools.push_back(i);
+
+  if (op == Boolean_op::Cut && tools.empty())
+  {
+    out = operands[0];
+    return Status::ok();
+  }
+
+  if (op == Boolean_op::Common)
+    for (size_t i = 0; i < boxes.size(); ++i)
+      for (size_t j = i + 1; j < boxes.size(); ++j)
+        if (disjoint_(boxes[i], boxes[j]))
+        {
+          TopoDS_Compound empty;
+          BRep_Builder().MakeCompound(empty);
+          out = empty;
+          return Status::ok();
+        }
+
+  Message_ProgressRange range;
+  if (!params.progress.IsNull())
+    range = params.progress->Start();
+
+  try
+  {
+    if (op == Boolean_op::Common)
+      CHK_RET(run_common_(operands, out, params, range));
+    else
+    {
+      TopTools_ListOfShape arguments;
+      TopTools_ListOfShape tool_list;
+      arguments.Append(operands[0]);
+      for (const size_t i : tools)
+        tool_list.Append(operands[i]);
+
+      BRepAlgoAPI_BooleanOperation bop;
+      bop.SetOperation(op == Boolean_op::Fuse ? BOPAlgo_FUSE : BOPAlgo_CUT);
+      bop.SetArguments(arguments);
+      bop.SetTools(tool_list);
+      bop.SetRunParallel(true);
+      bop.SetUseOBB(true);
+      // Operands are document shapes shared with undo checkpoints and read by autosave / preview workers.
+      bop.SetNonDestructive(true);
+      if (params.fuzzy_value > 0.0)
+        bop.SetFuzzyValue(params.fuzzy_value);
+
+      bop.Build(range);
+      if (!params.progress.IsNull() && params.progress->cancelled())
+        return Status::user_error("Boolean operation cancelled.");
+
+      if (!bop.IsDone() || bop.HasErrors())
+        return Status::user_error(op == Boolean_op::Fuse ? "Union operation failed." : "Difference operation failed.");
+
+      out = bop.Shape();
+    }
+  }
+  catch (const Standard_Failure& e)
+  {
+    out.Nullify();
+    return Status::user_error(std::string("Boolean operation failed: ") + standard_failure_message(e));
+  }
+
+  if (out.IsNull())
+    return Status::user_error("Resulting shape is null.");
+
+  return Status::ok();
+}
+
+namespace
+{
+bool disjoint_(const Bnd_OBB& a, const Bnd_OBB& b) { return !a.IsVoid() && !b.IsVoid() && a.IsOut(b); }
+
+Status run_common_(const std::vector<TopoDS_Shape>& operands, TopoDS_Shape& out, const Boolean_params& params,
+                   const Message_ProgressRange& range)
+{
+  // BRepAlgoAPI_Common intersects its arguments with the union of its tools, not with each tool; the cells builder
+  // splits all operands once and keeps the cells that lie inside every one of them.
+  BOPAlgo_CellsBuilder cells;
+  TopTools_ListOfShape all;
+  for (const TopoDS_Shape& s : operands)
+  {
+    cells.AddArgument(s);
+    all.Append(s);
+  }
+
+  cells.SetRunParallel(true);
+  cells.SetUseOBB(true);
+  cells.SetNonDestructive(true); // Operands are shared document shapes that other workers read
+  if (params.fuzzy_value > 0.0)
+    cells.SetFuzzyValue(params.fuzzy_value);
+
+  cells.Perform(range);
+  if (!params.progress.IsNull() && params.progress->cancelled())
+    return Status::user_error("Boolean operation cancelled.");
+
+  if (cells.HasErrors())
+    return Status::user_error("Common operation failed.");
+
+  cells.AddToResult(all, TopTools_ListOfShape());
+  out = cells.Shape();
+  return Status::ok();
+}
+} // namespace
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <TopoDS_Shape.hxx>
+
+#include "utl.h"
+#include "utl_occt_progress.h"
+
+enum class Boolean_op : uint8_t
+{
+  Fuse,   // Union of all operands
+  Common, // Region inside every operand
+  Cut     // First operand minus all the others
+};
+
+struct Boolean_params
+{
+  double                        fuzzy_value{0.0}; // > 0: gaps and overlaps below this are treated as touching
+  Atomic_progress_indicator_ptr progress;         // Optional position and Cancel (`Start()` is called once)
+};
+
+/// Runs \a op over all \a operands (two or more) as one OCCT Boolean with `SetRunParallel`, so the operands are
+/// intersected once instead of folding a growing result pairwise. Oriented boxes (exact geometry, grown by the fuzzy
+/// value) are computed in parallel first: a Cut drops tools that cannot touch the first operand, and a Common with two
+/// disjoint operands ends empty without running OCCT. OCCT also uses the boxes to skip disjoint pairs internally
+/// (`SetUseOBB`). Worker-thread safe; the operands are never modified (`SetNonDestructive`).
+[[nodiscard]] Status boolean_op_multi(Boolean_op op, const std::vector<TopoDS_Shape>& operands, TopoDS_Shape& out,
+                                      const Boolean_params& params = {});
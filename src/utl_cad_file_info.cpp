@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include <BRepBndLib.hxx>
 #include <BRep_Builder.hxx>
@@ -49,17 +50,17 @@ std::string fmt_bytes_(const size_t n);
 
 std::string fmt_double_(const double v);
 
-bool starts_with_ci_(const std::string& s, const char* prefix);
+bool starts_with_ci_(std::string_view s, const char* prefix);
 
-bool looks_like_ply_(const std::string& bytes);
+bool looks_like_ply_(std::string_view bytes);
 
-bool looks_like_step_(const std::string& bytes);
+bool looks_like_step_(std::string_view bytes);
 
-bool looks_like_iges_(const std::string& bytes);
+bool looks_like_iges_(std::string_view bytes);
 
-bool is_binary_stl_(const std::string& bytes);
+bool is_binary_stl_(std::string_view bytes);
 
-bool looks_like_stl_(const std::string& bytes);
+bool looks_like_stl_(std::string_view bytes);
 
 int count_subshapes_(const TopoDS_Shape& shape, const TopAbs_ShapeEnum type);
 
@@ -106,7 +107,7 @@ Status read_step_named_tree_xcaf_(const std::string& file_bytes, std::vector<Nam
                                   const Message_ProgressRange& progress);
 } // namespace
 
-Format detect(const std::string& file_path, const std::string& file_bytes)
+Format detect(const std::string& file_path, std::string_view file_bytes)
 {
   const std::string ext = to_lower_ext_(file_path);
   if (ext == ".step" || ext == ".stp")
@@ -254,7 +255,7 @@ std::string fmt_double_(const double v)
   return buf;
 }
 
-bool starts_with_ci_(const std::string& s, const char* prefix)
+bool starts_with_ci_(std::string_view s, const char* prefix)
 {
   const size_t n = std::strlen(prefix);
   if (s.size() < n)
@@ -267,15 +268,15 @@ bool starts_with_ci_(const std::string& s, const char* prefix)
   return true;
 }
 
-bool looks_like_ply_(const std::string& bytes) { return starts_with_ci_(bytes, "ply"); }
+bool looks_like_ply_(std::string_view bytes) { return starts_with_ci_(bytes, "ply"); }
 
-bool looks_like_step_(const std::string& bytes)
+bool looks_like_step_(std::string_view bytes)
 {
   // ISO-10303-21 exchange files typically start with "ISO-10303-21;"
-  return bytes.find("ISO-10303-21") != std::string::npos;
+  return bytes.find("ISO-10303-21") != std::string_view::npos;
 }
 
-bool looks_like_iges_(const std::string& bytes)
+bool looks_like_iges_(std::string_view bytes)
 {
   // Start / global / directory / parameter / terminate section markers (cols 73-80).
   if (bytes.size() < 80)
@@ -285,7 +286,7 @@ bool looks_like_iges_(const std::string& bytes)
   return c73 == 'S' || c73 == 'G' || c73 == 'D' || c73 == 'P' || c73 == 'T';
 }
 
-bool is_binary_stl_(const std::string& bytes)
+bool is_binary_stl_(std::string_view bytes)
 {
   if (bytes.size() < 84)
     return false;
@@ -296,7 +297,7 @@ bool is_binary_stl_(const std::string& bytes)
   return expected == bytes.size();
 }
 
-bool looks_like_stl_(const std::string& bytes)
+bool looks_like_stl_(std::string_view bytes)
 {
   if (is_binary_stl_(bytes))
     return true;
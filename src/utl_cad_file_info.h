@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <Message_ProgressRange.hxx>
@@ -45,7 +46,7 @@ struct Named_node
   int          parent_index{-1}; // index in the output vector, or -1 for root
 };
 
-[[nodiscard]] Format detect(const std::string& file_path, const std::string& file_bytes);
+[[nodiscard]] Format detect(const std::string& file_path, std::string_view file_bytes);
 
 /// True for formats File -> Import can load (STEP, PLY).
 [[nodiscard]] bool can_import(Format fmt);
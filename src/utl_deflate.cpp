@@ -0,0 +1,647 @@
+#include "utl_deflate.h"
+
+#include <stb_image/stb_image.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "utl_dbg.h"
+
+namespace
+{
+
+constexpr size_t c_window      = 32768;
+constexpr int    c_hash_bits   = 15;
+constexpr size_t c_min_match   = 3;
+constexpr size_t c_max_match   = 258;
+constexpr size_t c_block_syms  = size_t(1) << 15; // Symbols per block before a new Huffman table is emitted.
+constexpr size_t c_max_stored  = 65535;
+constexpr int    c_max_bits    = 15;
+constexpr int    c_max_cl_bits = 7;
+constexpr int    c_lit_syms    = 286;
+constexpr int    c_dist_syms   = 30;
+constexpr int    c_cl_syms     = 19;
+
+constexpr std::array<uint16_t, 29> c_len_base  = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                                  31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<uint8_t, 29>  c_len_extra = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                                  2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<uint16_t, 30> c_dist_base = {1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+                                                  33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+                                                  1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577};
+constexpr std::array<uint8_t, 30>  c_dist_extra = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                                   6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+constexpr std::array<uint8_t, 19>  c_cl_order   = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+struct Level_cfg
+{
+  int    max_chain; // Hash chain candidates tried per position.
+  size_t good_len;  // A match this long quarters the remaining chain.
+  size_t nice_len;  // A match this long stops the search.
+  bool   lazy;      // Defer a match by one byte when the next position matches longer.
+};
+
+// Mirrors zlib's speed/size trade-off per level.
+constexpr std::array<Level_cfg, 10> c_levels = {{{0, 0, 0, false},
+                                                 {4, 4, 16, false},
+                                                 {8, 8, 32, false},
+                                                 {16, 16, 32, false},
+                                                 {16, 8, 32, true},
+                                                 {32, 16, 64, true},
+                                                 {128, 32, 128, true},
+                                                 {256, 32, 258, true},
+                                                 {1024, 64, 258, true},
+                                                 {4096, 64, 258, true}}};
+
+struct Symbol
+{
+  uint16_t lit_or_len; // Literal byte, or match length when `dist` != 0.
+  uint16_t dist;
+};
+
+// One code-length alphabet symbol with its repeat count payload.
+struct Cl_symbol
+{
+  uint8_t sym;
+  uint8_t extra;
+};
+
+struct Huffman
+{
+  std::vector<uint8_t>  lens;
+  std::vector<uint16_t> codes; // Bit-reversed, ready for LSB-first output.
+};
+
+class Bit_writer
+{
+public:
+  explicit Bit_writer(std::vector<uint8_t>& out)
+      : m_out(out)
+  {
+  }
+
+  void put(uint32_t bits, int count)
+  {
+    m_buf |= uint64_t(bits) << m_count;
+    m_count += count;
+    while (m_count >= 8)
+    {
+      m_out.push_back(uint8_t(m_buf));
+      m_buf >>= 8;
+      m_count -= 8;
+    }
+  }
+
+  void align()
+  {
+    if (m_count > 0)
+      put(0, 8 - m_count);
+  }
+
+  // Requires a byte-aligned writer (after `align`).
+  void put_bytes(const uint8_t* data, size_t size) { m_out.insert(m_out.end(), data, data + size); }
+
+private:
+  std::vector<uint8_t>& m_out;
+  uint64_t              m_buf{0};
+  int                   m_count{0};
+};
+
+int      len_code_(size_t len);
+int      dist_code_(size_t dist);
+uint32_t hash_(const uint8_t* p);
+void     pad_to_two_codes_(uint32_t* freqs, int n);
+Huffman  build_huffman_(const uint32_t* freqs, int n, int max_bits);
+void     build_codes_(Huffman& h);
+void     rle_code_lengths_(const std::vector<uint8_t>& lens, std::vector<Cl_symbol>& out);
+uint64_t symbols_cost_(const std::vector<Symbol>& syms, const Huffman& lit, const Huffman& dist);
+void     write_symbols_(Bit_writer& bw, const std::vector<Symbol>& syms, const Huffman& lit, const Huffman& dist);
+void     write_stored_(Bit_writer& bw, const uint8_t* raw, size_t size, bool final);
+void     write_block_(Bit_writer& bw, const std::vector<Symbol>& syms, const uint8_t* raw, size_t raw_size, bool final);
+const Huffman& fixed_lit_();
+const Huffman& fixed_dist_();
+
+} // namespace
+
+void deflate_raw(const uint8_t* data, size_t size, int level, std::vector<uint8_t>& out)
+{
+  Bit_writer bw(out);
+  level = std::clamp(level, 0, 9);
+  if (level == 0 || size < c_min_match)
+  {
+    write_stored_(bw, data, size, true);
+    bw.align();
+    return;
+  }
+
+  const Level_cfg&     cfg = c_levels[level];
+  std::vector<int64_t> head(size_t(1) << c_hash_bits, -1);
+  std::vector<int64_t> prev(c_window, -1);
+  std::vector<Symbol>  syms;
+  syms.reserve(c_block_syms);
+  size_t               block_start = 0;
+  size_t               emitted_end = 0;
+
+  const auto insert = [&](size_t pos)
+  {
+    if (pos + c_min_match > size)
+      return;
+
+    const uint32_t h           = hash_(data + pos);
+    prev[pos & (c_window - 1)] = head[h];
+    head[h]                    = int64_t(pos);
+  };
+
+  // Longest earlier match for `pos` (0 when shorter than `c_min_match`); `pos` itself must not be inserted yet.
+  const auto longest_match = [&](size_t pos, size_t& best_dist) -> size_t
+  {
+    const size_t max_len = std::min(c_max_match, size - pos);
+    if (max_len < c_min_match)
+      return 0;
+
+    size_t  best  = c_min_match - 1;
+    int     chain = cfg.max_chain;
+    int64_t cand  = head[hash_(data + pos)];
+    while (cand >= 0 && chain-- > 0)
+    {
+      const size_t dist = pos - size_t(cand);
+      if (dist > c_window)
+        break;
+
+      const uint8_t* a = data + cand;
+      const uint8_t* b = data + pos;
+      if (a[best] == b[best] && a[0] == b[0])
+      {
+        size_t len = 0;
+        while (len < max_len && a[len] == b[len])
+          ++len;
+
+        if (len > best)
+        {
+          best      = len;
+          best_dist = dist;
+          if (len >= cfg.nice_len || len == max_len)
+            break;
+
+          if (len >= cfg.good_len)
+            chain >>= 2;
+        }
+      }
+
+      // Slots are reused every window; a newer entry means the chain ran past the window.
+      const int64_t next = prev[size_t(cand) & (c_window - 1)];
+      if (next >= cand)
+        break;
+
+      cand = next;
+    }
+
+    return best >= c_min_match ? best : 0;
+  };
+
+  const auto flush_if_full = [&]()
+  {
+    if (syms.size() < c_block_syms)
+      return;
+
+    write_block_(bw, syms, data + block_start, emitted_end - block_start, false);
+    block_start = emitted_end;
+    syms.clear();
+  };
+
+  const auto emit_literal = [&](size_t pos)
+  {
+    syms.push_back({data[pos], 0});
+    emitted_end = pos + 1;
+    flush_if_full();
+  };
+
+  // Emits a match at `pos` and indexes the positions it covers (`pos` and `pos + 1` are already indexed when lazy).
+  const auto emit_match = [&](size_t pos, size_t len, size_t dist, size_t first_unindexed)
+  {
+    syms.push_back({uint16_t(len), uint16_t(dist)});
+    emitted_end = pos + len;
+    for (size_t p = first_unindexed; p < emitted_end; ++p)
+      insert(p);
+
+    flush_if_full();
+  };
+
+  size_t pos       = 0;
+  bool   have_prev = false;
+  size_t prev_len  = 0;
+  size_t prev_dist = 0;
+  while (pos < size)
+  {
+    size_t       dist = 0;
+    const size_t len  = have_prev && prev_len >= cfg.nice_len ? 0 : longest_match(pos, dist);
+    insert(pos);
+    if (have_prev)
+    {
+      if (len > prev_len)
+      {
+        emit_literal(pos - 1);
+        prev_len  = len;
+        prev_dist = dist;
+        ++pos;
+        continue;
+      }
+
+      emit_match(pos - 1, prev_len, prev_dist, pos + 1);
+      pos       = emitted_end;
+      have_prev = false;
+      continue;
+    }
+
+    if (len == 0)
+    {
+      emit_literal(pos);
+      ++pos;
+      continue;
+    }
+
+    if (!cfg.lazy)
+    {
+      emit_match(pos, len, dist, pos + 1);
+      pos = emitted_end;
+      continue;
+    }
+
+    have_prev = true;
+    prev_len  = len;
+    prev_dist = dist;
+    ++pos;
+  }
+
+  // A pending match needs at least `c_min_match` bytes after it started, so the loop always resolves it.
+  EZY_ASSERT(!have_prev);
+  write_block_(bw, syms, data + block_start, emitted_end - block_start, true);
+  bw.align();
+}
+
+bool inflate_raw(const uint8_t* data, size_t size, size_t out_size, std::string& out)
+{
+  if (size > size_t(INT_MAX) || out_size > size_t(INT_MAX))
+    return false;
+
+  out.resize(out_size);
+  const int n = stbi_zlib_decode_noheader_buffer(out.data(), int(out_size), reinterpret_cast<const char*>(data), int(size));
+  return n == int(out_size);
+}
+
+namespace
+{
+
+int len_code_(size_t len)
+{
+  return int(std::upper_bound(c_len_base.begin(), c_len_base.end(), len) - c_len_base.begin()) - 1;
+}
+
+int dist_code_(size_t dist)
+{
+  return int(std::upper_bound(c_dist_base.begin(), c_dist_base.end(), dist) - c_dist_base.begin()) - 1;
+}
+
+uint32_t hash_(const uint8_t* p)
+{
+  const uint32_t v = uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16);
+  return (v * 2654435761u) >> (32 - c_hash_bits);
+}
+
+// A one-code tree is incomplete, which strict decoders (zlib) reject; an unused second code costs nothing.
+void pad_to_two_codes_(uint32_t* freqs, int n)
+{
+  int used = int(std::count_if(freqs, freqs + n, [](uint32_t f) { return f != 0; }));
+  for (int i = 0; used < 2 && i < n; ++i)
+    if (!freqs[i])
+    {
+      freqs[i] = 1;
+      ++used;
+    }
+}
+
+Huffman build_huffman_(const uint32_t* freqs, int n, int max_bits)
+{
+  Huffman h;
+  h.lens.assign(size_t(n), 0);
+  h.codes.assign(size_t(n), 0);
+
+  std::vector<int> syms;
+  for (int i = 0; i < n; ++i)
+    if (freqs[i])
+      syms.push_back(i);
+
+  if (syms.size() == 1)
+    h.lens[size_t(syms[0])] = 1;
+
+  if (syms.size() > 1)
+  {
+    // Plain Huffman tree; leaves are nodes [0, syms.size()) and every parent follows its children.
+    struct Node
+    {
+      int left;
+      int right;
+    };
+
+    using Entry = std::pair<uint64_t, int>;
+    std::vector<Node>                                                nodes(syms.size(), Node {-1, -1});
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap;
+    for (size_t i = 0; i < syms.size(); ++i)
+      heap.push({freqs[syms[i]], int(i)});
+
+    while (heap.size() > 1)
+    {
+      const Entry a = heap.top();
+      heap.pop();
+      const Entry b = heap.top();
+      heap.pop();
+      heap.push({a.first + b.first, int(nodes.size())});
+      nodes.push_back({a.second, b.second});
+    }
+
+    std::vector<int> depth(nodes.size(), 0);
+    for (size_t i = nodes.size(); i-- > syms.size();)
+    {
+      depth[size_t(nodes[i].left)]  = depth[i] + 1;
+      depth[size_t(nodes[i].right)] = depth[i] + 1;
+    }
+
+    // Clamp to `max_bits`, then restore the Kraft equality by lengthening the shortest codes that can absorb it.
+    std::array<uint32_t, c_max_bits + 1> count {};
+    for (size_t i = 0; i < syms.size(); ++i)
+      ++count[size_t(std::min(depth[i], max_bits))];
+
+    uint32_t total = 0;
+    for (int i = max_bits; i > 0; --i)
+      total += count[size_t(i)] << (max_bits - i);
+
+    while (total != (uint32_t(1) << max_bits))
+    {
+      --count[size_t(max_bits)];
+      for (int i = max_bits - 1; i > 0; --i)
+        if (count[size_t(i)])
+        {
+          --count[size_t(i)];
+          count[size_t(i + 1)] += 2;
+          break;
+        }
+
+      --total;
+    }
+
+    // Most frequent symbols take the shortest lengths.
+    std::stable_sort(syms.begin(), syms.end(), [&](int a, int b) { return freqs[a] > freqs[b]; });
+    size_t k = 0;
+    for (int len = 1; len <= max_bits; ++len)
+      for (uint32_t c = 0; c < count[size_t(len)]; ++c)
+        h.lens[size_t(syms[k++])] = uint8_t(len);
+  }
+
+  build_codes_(h);
+  return h;
+}
+
+void build_codes_(Huffman& h)
+{
+  std::array<uint16_t, c_max_bits + 1> count {};
+  for (uint8_t len : h.lens)
+    if (len)
+      ++count[len];
+
+  std::array<uint16_t, c_max_bits + 1> next {};
+  uint16_t                             code = 0;
+  for (int bits = 1; bits <= c_max_bits; ++bits)
+  {
+    code       = uint16_t((code + count[size_t(bits - 1)]) << 1);
+    next[bits] = code;
+  }
+
+  h.codes.assign(h.lens.size(), 0);
+  for (size_t i = 0; i < h.lens.size(); ++i)
+  {
+    const int len = h.lens[i];
+    if (!len)
+      continue;
+
+    uint16_t c   = next[size_t(len)]++;
+    uint16_t rev = 0;
+    for (int b = 0; b < len; ++b, c >>= 1)
+      rev = uint16_t((rev << 1) | (c & 1));
+
+    h.codes[i] = rev;
+  }
+}
+
+void rle_code_lengths_(const std::vector<uint8_t>& lens, std::vector<Cl_symbol>& out)
+{
+  size_t i = 0;
+  while (i < lens.size())
+  {
+    const uint8_t cur = lens[i];
+    size_t        run = 1;
+    while (i + run < lens.size() && lens[i + run] == cur)
+      ++run;
+
+    i += run;
+    if (cur == 0)
+    {
+      while (run >= 11)
+      {
+        const size_t r = std::min<size_t>(run, 138);
+        out.push_back({18, uint8_t(r - 11)});
+        run -= r;
+      }
+
+      if (run >= 3)
+      {
+        out.push_back({17, uint8_t(run - 3)});
+        run = 0;
+      }
+    }
+    else
+    {
+      out.push_back({cur, 0});
+      --run;
+      while (run >= 3)
+      {
+        const size_t r = std::min<size_t>(run, 6);
+        out.push_back({16, uint8_t(r - 3)});
+        run -= r;
+      }
+    }
+
+    for (; run > 0; --run)
+      out.push_back({cur, 0});
+  }
+}
+
+uint64_t symbols_cost_(const std::vector<Symbol>& syms, const Huffman& lit, const Huffman& dist)
+{
+  uint64_t bits = lit.lens[256];
+  for (const Symbol& s : syms)
+  {
+    if (s.dist == 0)
+    {
+      bits += lit.lens[s.lit_or_len];
+      continue;
+    }
+
+    const int lc = len_code_(s.lit_or_len);
+    const int dc = dist_code_(s.dist);
+    bits += lit.lens[size_t(257 + lc)] + c_len_extra[size_t(lc)] + dist.lens[size_t(dc)] + c_dist_extra[size_t(dc)];
+  }
+
+  return bits;
+}
+
+void write_symbols_(Bit_writer& bw, const std::vector<Symbol>& syms, const Huffman& lit, const Huffman& dist)
+{
+  for (const Symbol& s : syms)
+  {
+    if (s.dist == 0)
+    {
+      bw.put(lit.codes[s.lit_or_len], lit.lens[s.lit_or_len]);
+      continue;
+    }
+
+    const size_t lc = size_t(len_code_(s.lit_or_len));
+    const size_t dc = size_t(dist_code_(s.dist));
+    bw.put(lit.codes[257 + lc], lit.lens[257 + lc]);
+    bw.put(uint32_t(s.lit_or_len - c_len_base[lc]), c_len_extra[lc]);
+    bw.put(dist.codes[dc], dist.lens[dc]);
+    bw.put(uint32_t(s.dist - c_dist_base[dc]), c_dist_extra[dc]);
+  }
+
+  bw.put(lit.codes[256], lit.lens[256]);
+}
+
+void write_stored_(Bit_writer& bw, const uint8_t* raw, size_t size, bool final)
+{
+  size_t off = 0;
+  do
+  {
+    const size_t n = std::min(size - off, c_max_stored);
+    bw.put(final && off + n == size ? 1 : 0, 1);
+    bw.put(0, 2);
+    bw.align();
+    bw.put(uint32_t(n), 16);
+    bw.put(uint32_t(~n & 0xFFFFu), 16);
+    bw.put_bytes(raw + off, n);
+    off += n;
+  } while (off < size);
+}
+
+void write_block_(Bit_writer& bw, const std::vector<Symbol>& syms, const uint8_t* raw, size_t raw_size, bool final)
+{
+  std::array<uint32_t, c_lit_syms>  lit_freq {};
+  std::array<uint32_t, c_dist_syms> dist_freq {};
+  for (const Symbol& s : syms)
+    if (s.dist == 0)
+      ++lit_freq[s.lit_or_len];
+    else
+    {
+      ++lit_freq[size_t(257 + len_code_(s.lit_or_len))];
+      ++dist_freq[size_t(dist_code_(s.dist))];
+    }
+
+  lit_freq[256] = 1;
+
+  pad_to_two_codes_(lit_freq.data(), c_lit_syms);
+  pad_to_two_codes_(dist_freq.data(), c_dist_syms);
+
+  const Huffman lit  = build_huffman_(lit_freq.data(), c_lit_syms, c_max_bits);
+  const Huffman dist = build_huffman_(dist_freq.data(), c_dist_syms, c_max_bits);
+
+  size_t hlit = c_lit_syms;
+  while (hlit > 257 && lit.lens[hlit - 1] == 0)
+    --hlit;
+
+  size_t hdist = c_dist_syms;
+  while (hdist > 1 && dist.lens[hdist - 1] == 0)
+    --hdist;
+
+  std::vector<uint8_t> all_lens(lit.lens.begin(), lit.lens.begin() + std::ptrdiff_t(hlit));
+  all_lens.insert(all_lens.end(), dist.lens.begin(), dist.lens.begin() + std::ptrdiff_t(hdist));
+  std::vector<Cl_symbol> cl_syms;
+  rle_code_lengths_(all_lens, cl_syms);
+
+  std::array<uint32_t, c_cl_syms> cl_freq {};
+  for (const Cl_symbol& c : cl_syms)
+    ++cl_freq[c.sym];
+
+  pad_to_two_codes_(cl_freq.data(), c_cl_syms);
+  const Huffman cl = build_huffman_(cl_freq.data(), c_cl_syms, c_max_cl_bits);
+  size_t        hclen = c_cl_syms;
+  while (hclen > 4 && cl.lens[c_cl_order[hclen - 1]] == 0)
+    --hclen;
+
+  constexpr std::array<uint8_t, 3> c_cl_extra_bits = {2, 3, 7}; // Symbols 16, 17, 18.
+  uint64_t                         dynamic_bits    = 3 + 5 + 5 + 4 + 3 * hclen + symbols_cost_(syms, lit, dist);
+  for (const Cl_symbol& c : cl_syms)
+    dynamic_bits += cl.lens[c.sym] + (c.sym >= 16 ? c_cl_extra_bits[c.sym - 16u] : 0u);
+
+  const uint64_t fixed_bits  = 3 + symbols_cost_(syms, fixed_lit_(), fixed_dist_());
+  const uint64_t stored_bits = (raw_size + 5 * (raw_size / c_max_stored + 1)) * 8 + 7;
+
+  if (stored_bits <= fixed_bits && stored_bits <= dynamic_bits)
+  {
+    write_stored_(bw, raw, raw_size, final);
+    return;
+  }
+
+  bw.put(final ? 1 : 0, 1);
+  if (fixed_bits <= dynamic_bits)
+  {
+    bw.put(1, 2);
+    write_symbols_(bw, syms, fixed_lit_(), fixed_dist_());
+    return;
+  }
+
+  bw.put(2, 2);
+  bw.put(uint32_t(hlit - 257), 5);
+  bw.put(uint32_t(hdist - 1), 5);
+  bw.put(uint32_t(hclen - 4), 4);
+  for (size_t i = 0; i < hclen; ++i)
+    bw.put(cl.lens[c_cl_order[i]], 3);
+
+  for (const Cl_symbol& c : cl_syms)
+  {
+    bw.put(cl.codes[c.sym], cl.lens[c.sym]);
+    if (c.sym >= 16)
+      bw.put(c.extra, c_cl_extra_bits[c.sym - 16u]);
+  }
+
+  write_symbols_(bw, syms, lit, dist);
+}
+
+const Huffman& fixed_lit_()
+{
+  static const Huffman h = []
+  {
+    Huffman ret;
+    ret.lens.assign(288, 8);
+    std::fill(ret.lens.begin() + 144, ret.lens.begin() + 256, uint8_t(9));
+    std::fill(ret.lens.begin() + 256, ret.lens.begin() + 280, uint8_t(7));
+    build_codes_(ret);
+    return ret;
+  }();
+  return h;
+}
+
+const Huffman& fixed_dist_()
+{
+  static const Huffman h = []
+  {
+    Huffman ret;
+    ret.lens.assign(c_dist_syms, 5);
+    build_codes_(ret);
+    return ret;
+  }();
+  return h;
+}
+
+} // namespace
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Raw DEFLATE streams (RFC 1951, no zlib header) for `.ezy` zip entries.
+
+/// Appends the compressed form of `data` to `out`. `level` follows zlib: 0 stores, 1 favours speed, 9 favours size.
+/// Each block picks the smallest of stored, fixed and dynamic Huffman coding.
+void deflate_raw(const uint8_t* data, size_t size, int level, std::vector<uint8_t>& out);
+
+/// Decodes a raw DEFLATE stream that expands to exactly `out_size` bytes into `out`. Returns false on corrupt or
+/// truncated input, or when the decoded size differs.
+[[nodiscard]] bool inflate_raw(const uint8_t* data, size_t size, size_t out_size, std::string& out);
@@ -48,6 +48,7 @@
 #include <V3d_View.hxx>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <gp_Ax1.hxx>
 #include <gp_Ax2.hxx>
 #include <gp_Ax3.hxx>
@@ -1125,7 +1126,7 @@ ezy_geom::polygon_2d to_boost(const TopoDS_Shape& shape, const gp_Pln& pln2)
         // Get the parameter range of the curve
         double       u_start = curve.FirstParameter();
         double       u_end   = curve.LastParameter();
-        const size_t num_pts = 25;
+        const size_t num_pts = k_boost_circle_edge_pts;
         double       step    = (u_end - u_start) / (num_pts - 1);
         for (size_t i = 0; i < num_pts; ++i)
         {
@@ -1345,6 +1346,38 @@ double ezy_geom::area(const polygon_2d& poly)
   return std::abs(a);
 }
 
+int ezy_geom::classify(const point_2d& pt, const ring_2d& ring, double tol)
+{
+  const size_t n = ring.size();
+  if (n < 3)
+    return 0;
+
+  bool   inside = false;
+  double min_sq = std::numeric_limits<double>::max();
+  for (size_t i = 0, j = n - 1; i < n; j = i++)
+  {
+    const point_2d& a = ring[j];
+    const point_2d& b = ring[i];
+    if ((b.y() > pt.y()) != (a.y() > pt.y()) && pt.x() < (a.x() - b.x()) * (pt.y() - b.y()) / (a.y() - b.y()) + b.x())
+      inside = !inside;
+
+    // Distance to the segment
+    const double dx     = a.x() - b.x();
+    const double dy     = a.y() - b.y();
+    const double len_sq = dx * dx + dy * dy;
+    double       t      = len_sq > 0.0 ? ((pt.x() - b.x()) * dx + (pt.y() - b.y()) * dy) / len_sq : 0.0;
+    t                   = std::clamp(t, 0.0, 1.0);
+    const double ex     = b.x() + t * dx - pt.x();
+    const double ey     = b.y() + t * dy - pt.y();
+    min_sq              = std::min(min_sq, ex * ex + ey * ey);
+  }
+
+  if (min_sq <= tol * tol)
+    return 0;
+
+  return inside ? 1 : -1;
+}
+
 namespace
 {
 std::string wkt_fmt_num_(double v);
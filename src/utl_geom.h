@@ -135,6 +135,7 @@ gp_Pnt2d center_point(const gp_Pnt2d& point1, const gp_Pnt2d& point2);
 gp_Dir2d get_unit_dir(const gp_Pnt2d& point1, const gp_Pnt2d& point2);
 
 inline glm::dvec2 to_glm(const gp_Dir2d& v) { return {v.X(), v.Y()}; }
+inline glm::dvec2 to_glm(const gp_Pnt2d& p) { return {p.X(), p.Y()}; }
 
 gp_Pnt2d get_midpoint(const gp_Pnt2d& p1, const gp_Pnt2d& p2);
 
@@ -201,6 +202,9 @@ ezy_geom::point_2d to_boost(const gp_Pln& plane, const gp_Pnt& point_3d);
 
 ezy_geom::point_2d to_boost(const gp_Pnt2d& point);
 
+/// Points `to_boost(shape, pln)` samples along each circle edge (ends included).
+inline constexpr size_t k_boost_circle_edge_pts = 25;
+
 // Convert a TopoDS_Shape to a ezy_geom::polygon_2d
 ezy_geom::polygon_2d to_boost(const TopoDS_Shape& shape, const gp_Pln& pln2);
 
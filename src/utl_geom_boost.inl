@@ -54,4 +54,7 @@ bool is_valid(const polygon_2d& poly);
 
 // Shoelace area (outer minus holes).
 double area(const polygon_2d& poly);
+
+// Even-odd point-in-ring test with a boundary band: 1 inside, -1 outside, 0 within `tol` of the ring.
+int classify(const point_2d& pt, const ring_2d& ring, double tol);
 } // namespace ezy_geom
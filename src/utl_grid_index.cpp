@@ -0,0 +1,289 @@
+#include "utl_grid_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "utl_dbg.h"
+
+namespace
+{
+// Entries covering more cells than this go to the oversized list instead of being copied into every cell.
+constexpr size_t c_max_cells_per_entry = 256;
+// Keep cell coordinates well inside int32 so ring arithmetic cannot overflow.
+constexpr double c_max_cell_coord = static_cast<double>(std::numeric_limits<int32_t>::max() / 4);
+
+uint64_t cell_key_(int32_t x, int32_t y);
+void     cell_from_key_(uint64_t key, int32_t& x, int32_t& y);
+} // namespace
+
+Grid_index_2d::Grid_index_2d(double cell_size)
+    : m_cell_size(cell_size)
+{
+  EZY_ASSERT(cell_size > 0.0);
+}
+
+void Grid_index_2d::reset(double cell_size)
+{
+  EZY_ASSERT(cell_size > 0.0);
+  clear();
+  m_cell_size = cell_size;
+}
+
+void Grid_index_2d::clear()
+{
+  m_cells.clear();
+  m_ranges.clear();
+  m_oversized.clear();
+  m_visit_stamp.clear();
+  m_query_stamp = 0;
+  m_size        = 0;
+}
+
+double Grid_index_2d::cell_size() const { return m_cell_size; }
+
+size_t Grid_index_2d::size() const { return m_size; }
+
+bool Grid_index_2d::contains(size_t id) const { return id < m_ranges.size() && m_ranges[id].valid(); }
+
+void Grid_index_2d::insert(size_t id, const glm::dvec2& min, const glm::dvec2& max)
+{
+  if (id >= m_ranges.size())
+  {
+    m_ranges.resize(id + 1);
+    m_visit_stamp.resize(id + 1, 0);
+  }
+  else if (m_ranges[id].valid())
+    remove(id);
+
+  Cell_range range = cell_range_(min, max);
+  if (range.cell_count() > c_max_cells_per_entry)
+  {
+    range.oversized = true;
+    m_oversized.push_back(id);
+  }
+  else
+    for (int32_t x = range.x0; x <= range.x1; ++x)
+      for (int32_t y = range.y0; y <= range.y1; ++y)
+        m_cells[cell_key_(x, y)].push_back(id);
+
+  m_ranges[id] = range;
+  ++m_size;
+}
+
+void Grid_index_2d::remove(size_t id)
+{
+  if (!contains(id))
+    return;
+
+  const Cell_range range = m_ranges[id];
+  if (range.oversized)
+    std::erase(m_oversized, id);
+  else
+    for (int32_t x = range.x0; x <= range.x1; ++x)
+      for (int32_t y = range.y0; y <= range.y1; ++y)
+      {
+        auto it = m_cells.find(cell_key_(x, y));
+        EZY_ASSERT(it != m_cells.end());
+        std::vector<size_t>& ids = it->second;
+        auto                 pos = std::find(ids.begin(), ids.end(), id);
+        EZY_ASSERT(pos != ids.end());
+        *pos = ids.back();
+        ids.pop_back();
+        if (ids.empty())
+          m_cells.erase(it);
+      }
+
+  m_ranges[id] = Cell_range {};
+  --m_size;
+}
+
+void Grid_index_2d::query(const glm::dvec2& min, const glm::dvec2& max, const std::function<void(size_t)>& fn) const
+{
+  if (m_size == 0)
+    return;
+
+  const uint32_t stamp = ++m_query_stamp;
+  if (stamp == 0)
+  {
+    std::fill(m_visit_stamp.begin(), m_visit_stamp.end(), 0);
+    m_query_stamp = 1;
+  }
+
+  const Cell_range range = cell_range_(min, max);
+  if (range.cell_count() > m_cells.size())
+  {
+    // Query box covers more cells than exist; walk the populated cells instead.
+    for (const auto& [key, ids] : m_cells)
+    {
+      int32_t x, y;
+      cell_from_key_(key, x, y);
+      if (x < range.x0 || x > range.x1 || y < range.y0 || y > range.y1)
+        continue;
+
+      for (size_t id : ids)
+        if (mark_visited_(id))
+          fn(id);
+    }
+  }
+  else
+    for (int32_t x = range.x0; x <= range.x1; ++x)
+      for (int32_t y = range.y0; y <= range.y1; ++y)
+        visit_cell_(x, y, fn);
+
+  for (size_t id : m_oversized)
+  {
+    const Cell_range& r = m_ranges[id];
+    if (r.x1 < range.x0 || r.x0 > range.x1 || r.y1 < range.y0 || r.y0 > range.y1)
+      continue;
+
+    if (mark_visited_(id))
+      fn(id);
+  }
+}
+
+std::optional<size_t> Grid_index_2d::nearest(const glm::dvec2& pt, double max_dist,
+                                             const std::function<std::optional<double>(size_t)>& sq_dist) const
+{
+  if (m_size == 0 || max_dist < 0.0)
+    return std::nullopt;
+
+  const double          max_sq = max_dist * max_dist;
+  std::optional<size_t> best;
+  double                best_sq = max_sq;
+  auto                  consider = [&](size_t id)
+  {
+    const std::optional<double> d = sq_dist(id);
+    if (!d || *d > max_sq)
+      return;
+
+    if (!best || *d < best_sq || (*d == best_sq && id < *best))
+    {
+      best    = id;
+      best_sq = *d;
+    }
+  };
+
+  const uint32_t stamp = ++m_query_stamp;
+  if (stamp == 0)
+  {
+    std::fill(m_visit_stamp.begin(), m_visit_stamp.end(), 0);
+    m_query_stamp = 1;
+  }
+
+  for (size_t id : m_oversized)
+    if (mark_visited_(id))
+      consider(id);
+
+  // Rings needed to cover `max_dist`; fall back to a full scan when that would touch more cells than exist.
+  const double rings_needed = std::ceil(max_dist / m_cell_size) + 1.0;
+  const double ring_cells   = (2.0 * rings_needed + 1.0) * (2.0 * rings_needed + 1.0);
+  if (!std::isfinite(rings_needed) || ring_cells > 4.0 * static_cast<double>(m_cells.size()) + 9.0)
+  {
+    for (const auto& [key, ids] : m_cells)
+      for (size_t id : ids)
+        if (mark_visited_(id))
+          consider(id);
+
+    return best;
+  }
+
+  const int32_t cx        = cell_coord_(pt.x);
+  const int32_t cy        = cell_coord_(pt.y);
+  const int32_t max_rings = static_cast<int32_t>(rings_needed);
+  auto          visit     = [&](size_t id)
+  {
+    if (mark_visited_(id))
+      consider(id);
+  };
+
+  for (int32_t k = 0; k <= max_rings; ++k)
+  {
+    if (k == 0)
+      visit_cell_(cx, cy, visit);
+    else
+    {
+      for (int32_t x = cx - k; x <= cx + k; ++x)
+      {
+        visit_cell_(x, cy - k, visit);
+        visit_cell_(x, cy + k, visit);
+      }
+
+      for (int32_t y = cy - k + 1; y <= cy + k - 1; ++y)
+      {
+        visit_cell_(cx - k, y, visit);
+        visit_cell_(cx + k, y, visit);
+      }
+    }
+
+    // Anything not yet visited lies at least `k` whole cells away from `pt`.
+    const double ring_dist = static_cast<double>(k) * m_cell_size;
+    if (best && best_sq <= ring_dist * ring_dist)
+      break;
+  }
+
+  return best;
+}
+
+size_t Grid_index_2d::Cell_range::cell_count() const
+{
+  if (!valid())
+    return 0;
+
+  return static_cast<size_t>(static_cast<int64_t>(x1) - x0 + 1) * static_cast<size_t>(static_cast<int64_t>(y1) - y0 + 1);
+}
+
+int32_t Grid_index_2d::cell_coord_(double v) const
+{
+  const double c = std::floor(v / m_cell_size);
+  if (!(c > -c_max_cell_coord))
+    return static_cast<int32_t>(-c_max_cell_coord);
+
+  if (!(c < c_max_cell_coord))
+    return static_cast<int32_t>(c_max_cell_coord);
+
+  return static_cast<int32_t>(c);
+}
+
+Grid_index_2d::Cell_range Grid_index_2d::cell_range_(const glm::dvec2& min, const glm::dvec2& max) const
+{
+  Cell_range r;
+  r.x0 = cell_coord_(std::min(min.x, max.x));
+  r.y0 = cell_coord_(std::min(min.y, max.y));
+  r.x1 = cell_coord_(std::max(min.x, max.x));
+  r.y1 = cell_coord_(std::max(min.y, max.y));
+  return r;
+}
+
+void Grid_index_2d::visit_cell_(int32_t x, int32_t y, const std::function<void(size_t)>& fn) const
+{
+  const auto it = m_cells.find(cell_key_(x, y));
+  if (it == m_cells.end())
+    return;
+
+  for (size_t id : it->second)
+    fn(id);
+}
+
+bool Grid_index_2d::mark_visited_(size_t id) const
+{
+  if (m_visit_stamp[id] == m_query_stamp)
+    return false;
+
+  m_visit_stamp[id] = m_query_stamp;
+  return true;
+}
+
+namespace
+{
+uint64_t cell_key_(int32_t x, int32_t y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(y));
+}
+
+void cell_from_key_(uint64_t key, int32_t& x, int32_t& y)
+{
+  x = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+  y = static_cast<int32_t>(static_cast<uint32_t>(key & 0xffffffffu));
+}
+} // namespace
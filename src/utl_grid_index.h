@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <glm/glm.hpp>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/// Uniform hash grid over 2D axis-aligned boxes keyed by dense caller ids (e.g. sketch node or edge indices).
+/// Cells are created on demand, so the grid covers an unbounded plane. Queries return candidates whose boxes
+/// share a cell with the query; callers run the exact geometric test.
+///
+/// Not thread-safe: queries use a mutable visit stamp to report each id once.
+class Grid_index_2d
+{
+public:
+  explicit Grid_index_2d(double cell_size = 1.0);
+
+  /// Drops every entry and sets a new cell size (`cell_size` must be > 0).
+  void                 reset(double cell_size);
+  void                 clear();
+  [[nodiscard]] double cell_size() const;
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] bool   contains(size_t id) const;
+
+  /// Inserts or moves `id` so it covers [min, max].
+  void insert(size_t id, const glm::dvec2& min, const glm::dvec2& max);
+  void insert(size_t id, const glm::dvec2& pt) { insert(id, pt, pt); }
+  void remove(size_t id);
+
+  /// Calls `fn(id)` once per id whose box shares a cell with [min, max].
+  void query(const glm::dvec2& min, const glm::dvec2& max, const std::function<void(size_t)>& fn) const;
+
+  /// Ring search outward from `pt`. `sq_dist(id)` returns the squared distance from `pt` to the entry, or
+  /// `std::nullopt` to skip it. Returns the closest id within `max_dist`; ties keep the lowest id.
+  [[nodiscard]] std::optional<size_t> nearest(const glm::dvec2& pt, double max_dist,
+                                              const std::function<std::optional<double>(size_t)>& sq_dist) const;
+
+private:
+  struct Cell_range
+  {
+    int32_t x0{0};
+    int32_t y0{0};
+    int32_t x1{-1};
+    int32_t y1{-1};
+    bool    oversized{false};
+
+    [[nodiscard]] bool   valid() const { return x0 <= x1 && y0 <= y1; }
+    [[nodiscard]] size_t cell_count() const;
+  };
+
+  [[nodiscard]] int32_t    cell_coord_(double v) const;
+  [[nodiscard]] Cell_range cell_range_(const glm::dvec2& min, const glm::dvec2& max) const;
+  void                     visit_cell_(int32_t x, int32_t y, const std::function<void(size_t)>& fn) const;
+  [[nodiscard]] bool       mark_visited_(size_t id) const;
+
+  double                                            m_cell_size;
+  size_t                                            m_size{0};
+  std::unordered_map<uint64_t, std::vector<size_t>> m_cells;
+  std::vector<Cell_range>                           m_ranges;    // Indexed by id; invalid range == not present.
+  std::vector<size_t>                               m_oversized; // Ids spanning too many cells; tested on every query.
+  mutable std::vector<uint32_t>                     m_visit_stamp;
+  mutable uint32_t                                  m_query_stamp{0};
+};
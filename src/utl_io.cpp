@@ -1,6 +1,8 @@
 #include "utl_io.h"
 
 #include "utl_asset_store.h"
+#include "utl_deflate.h"
+#include "utl_mapped_file.h"
 
 #include <nlohmann/json.hpp>
 
@@ -14,36 +16,79 @@
 namespace
 {
 
-constexpr uint32_t k_zip_local_sig   = 0x04034b50u;
-constexpr uint32_t k_zip_central_sig = 0x02014b50u;
-constexpr uint32_t k_zip_eocd_sig    = 0x06054b50u;
+constexpr uint32_t k_zip_local_sig      = 0x04034b50u;
+constexpr uint32_t k_zip_central_sig    = 0x02014b50u;
+constexpr uint32_t k_zip_eocd_sig       = 0x06054b50u;
+constexpr uint16_t k_zip_method_store   = 0;
+constexpr uint16_t k_zip_method_deflate = 8;
+constexpr uint16_t k_zip_flag_encrypted = 0x0001u;
+constexpr uint32_t k_deflate_max_ratio  = 1032; // Most output one DEFLATE input byte can expand to
 
-struct Zip_entry
+struct Zip_entry_ref
 {
-  std::string name;
-  std::string data;
+  std::string        name;
+  Ezy_archive::Entry entry;
 };
 
-uint32_t             crc32_bytes_(const uint8_t* data, std::size_t len);
-void                 write_u16_(std::vector<uint8_t>& out, uint16_t v);
-void                 write_u32_(std::vector<uint8_t>& out, uint32_t v);
-bool                 read_u16_(const uint8_t* p, std::size_t avail, std::size_t& off, uint16_t& v);
-bool                 read_u32_(const uint8_t* p, std::size_t avail, std::size_t& off, uint32_t& v);
-std::vector<uint8_t> zip_write_stored_(const std::vector<Zip_entry>& entries);
-bool                 zip_read_stored_(const std::string& bytes, std::vector<Zip_entry>& out_entries);
-void                 collect_underlay_asset_ids_(const nlohmann::json& j, std::vector<std::string>& out);
-std::string          asset_path_(const std::string& asset_id);
-bool                 parse_asset_path_(std::string_view path, std::string& out_id);
-int                  from_b64_(char c);
+/// Zip32 writer that hands each entry to the sink as soon as it is added; only the central directory records are
+/// kept until `finish()`. Entries are compressed whole, so peak memory is one entry, not the archive.
+class Zip_stream_writer
+{
+public:
+  explicit Zip_stream_writer(const Ezy_write_sink& sink)
+      : m_sink(sink)
+  {
+  }
+
+  /// `level` 0 stores; otherwise DEFLATE, falling back to store when compression does not shrink the entry.
+  bool add(const std::string& name, const uint8_t* data, std::size_t size, int level);
+  bool finish();
+
+private:
+  struct Central_rec
+  {
+    std::string name;
+    uint32_t    offset;
+    uint32_t    crc;
+    uint32_t    comp_size;
+    uint32_t    size;
+    uint16_t    method;
+  };
+
+  bool write_(const uint8_t* data, std::size_t size);
+
+  const Ezy_write_sink&    m_sink;
+  uint64_t                 m_offset{0};
+  std::vector<Central_rec> m_central;
+  std::vector<uint8_t>     m_header;     // Reused per record.
+  std::vector<uint8_t>     m_compressed; // Reused per entry.
+};
+
+uint32_t    crc32_bytes_(const uint8_t* data, std::size_t len);
+void        write_u16_(std::vector<uint8_t>& out, uint16_t v);
+void        write_u32_(std::vector<uint8_t>& out, uint32_t v);
+bool        read_u16_(const uint8_t* p, std::size_t avail, std::size_t& off, uint16_t& v);
+bool        read_u32_(const uint8_t* p, std::size_t avail, std::size_t& off, uint32_t& v);
+/// Central directory of a zip (local headers checked, no entry data read).
+bool        zip_index_(const uint8_t* data, std::size_t n, std::vector<Zip_entry_ref>& out_entries);
+/// Inflates or copies one entry and checks its CRC.
+bool        zip_extract_(const uint8_t* data, const Ezy_archive::Entry& entry, std::string& out);
+void        collect_underlay_asset_ids_(const nlohmann::json& j, std::vector<std::string>& out);
+std::string asset_path_(const std::string& asset_id);
+bool        parse_asset_path_(std::string_view path, std::string& out_id);
+std::string geom_path_(const std::string& geom_id);
+bool        parse_geom_path_(std::string_view path, std::string& out_id);
+bool        parse_entry_path_(std::string_view path, std::string_view prefix, std::string_view suffix, std::string& out_id);
+int         from_b64_(char c);
 
 } // namespace
 
-bool is_ezy_zip(const std::string& bytes)
+bool is_ezy_zip(std::string_view bytes)
 {
   return bytes.size() >= 4 && bytes[0] == 'P' && bytes[1] == 'K' && bytes[2] == 0x03 && bytes[3] == 0x04;
 }
 
-bool is_ezy_json(const std::string& bytes)
+bool is_ezy_json(std::string_view bytes)
 {
   std::size_t i = 0;
   while (i < bytes.size() && (bytes[i] == ' ' || bytes[i] == '\t' || bytes[i] == '\r' || bytes[i] == '\n'))
@@ -52,24 +97,31 @@ bool is_ezy_json(const std::string& bytes)
   return i < bytes.size() && bytes[i] == '{';
 }
 
-std::optional<Ezy_unpack_result> unpack_ezy(const std::string& bytes)
+std::optional<Ezy_unpack_result> unpack_ezy(std::string_view bytes)
 {
-  std::vector<Zip_entry> entries;
-  if (!zip_read_stored_(bytes, entries))
+  const uint8_t*             data = reinterpret_cast<const uint8_t*>(bytes.data());
+  std::vector<Zip_entry_ref> entries;
+  if (!zip_index_(data, bytes.size(), entries))
     return std::nullopt;
 
   Ezy_unpack_result result;
-  for (Zip_entry& e : entries)
+  for (const Zip_entry_ref& e : entries)
   {
+    std::string contents;
+    if (!zip_extract_(data, e.entry, contents))
+      return std::nullopt;
+
     if (e.name == k_ezy_manifest_path)
     {
-      result.manifest_json = std::move(e.data);
+      result.manifest_json = std::move(contents);
       continue;
     }
 
-    std::string asset_id;
-    if (parse_asset_path_(e.name, asset_id))
-      result.assets.emplace(std::move(asset_id), std::vector<uint8_t>(e.data.begin(), e.data.end()));
+    std::string id;
+    if (parse_asset_path_(e.name, id))
+      result.assets.emplace(std::move(id), std::vector<uint8_t>(contents.begin(), contents.end()));
+    else if (parse_geom_path_(e.name, id))
+      result.geoms.emplace(std::move(id), std::move(contents));
   }
 
   if (result.manifest_json.empty())
@@ -78,7 +130,138 @@ std::optional<Ezy_unpack_result> unpack_ezy(const std::string& bytes)
   return result;
 }
 
-std::vector<uint8_t> pack_ezy(const std::string& manifest_json, const Ezy_asset_store& store)
+std::optional<std::string> read_ezy_manifest(std::string_view bytes)
+{
+  const uint8_t*             data = reinterpret_cast<const uint8_t*>(bytes.data());
+  std::vector<Zip_entry_ref> entries;
+  if (!zip_index_(data, bytes.size(), entries))
+    return std::nullopt;
+
+  for (const Zip_entry_ref& e : entries)
+  {
+    std::string manifest;
+    if (e.name == k_ezy_manifest_path && zip_extract_(data, e.entry, manifest) && !manifest.empty())
+      return manifest;
+  }
+
+  return std::nullopt;
+}
+
+std::shared_ptr<const Ezy_archive> Ezy_archive::open(std::shared_ptr<const Mapped_file> file)
+{
+  if (!file)
+    return nullptr;
+
+  std::vector<Zip_entry_ref> entries;
+  if (!zip_index_(file->data(), file->size(), entries))
+    return nullptr;
+
+  std::shared_ptr<Ezy_archive> archive(new Ezy_archive(std::move(file)));
+  bool                         has_manifest = false;
+  for (Zip_entry_ref& e : entries)
+  {
+    std::string id;
+    if (e.name == k_ezy_manifest_path)
+    {
+      archive->m_manifest = e.entry;
+      has_manifest        = true;
+    }
+    else if (parse_asset_path_(e.name, id))
+      archive->m_assets.emplace(std::move(id), e.entry);
+    else if (parse_geom_path_(e.name, id))
+      archive->m_geoms.emplace(std::move(id), e.entry);
+  }
+
+  if (!has_manifest)
+    return nullptr;
+
+  return archive;
+}
+
+Ezy_archive::Ezy_archive(std::shared_ptr<const Mapped_file> file)
+    : m_file(std::move(file))
+{
+}
+
+std::optional<std::string> Ezy_archive::read_manifest() const
+{
+  std::string manifest;
+  if (!read_(m_manifest, manifest) || manifest.empty())
+    return std::nullopt;
+
+  return manifest;
+}
+
+bool Ezy_archive::has_geom(const std::string& geom_id) const { return m_geoms.find(geom_id) != m_geoms.end(); }
+
+std::optional<std::string> Ezy_archive::read_geom(const std::string& geom_id) const
+{
+  const auto  it = m_geoms.find(geom_id);
+  std::string geom;
+  if (it == m_geoms.end() || !read_(it->second, geom))
+    return std::nullopt;
+
+  return geom;
+}
+
+std::optional<std::vector<uint8_t>> Ezy_archive::read_asset(const std::string& asset_id) const
+{
+  const auto  it = m_assets.find(asset_id);
+  std::string pixels;
+  if (it == m_assets.end() || !read_(it->second, pixels))
+    return std::nullopt;
+
+  return std::vector<uint8_t>(pixels.begin(), pixels.end());
+}
+
+std::vector<std::pair<std::string, std::size_t>> Ezy_archive::asset_sizes() const
+{
+  std::vector<std::pair<std::string, std::size_t>> out;
+  out.reserve(m_assets.size());
+  for (const auto& [id, entry] : m_assets)
+    out.emplace_back(id, entry.size);
+
+  return out;
+}
+
+std::vector<std::string> Ezy_archive::geom_ids() const
+{
+  std::vector<std::string> out;
+  out.reserve(m_geoms.size());
+  for (const auto& g : m_geoms)
+    out.push_back(g.first);
+
+  return out;
+}
+
+bool Ezy_archive::read_(const Entry& entry, std::string& out) const
+{
+  // Deferred reads run long after `open`, when another process may have truncated or rewritten the file: read the
+  // entry through `Mapped_file::read` (fails) rather than the mapping (faults). A rewrite fails the CRC check.
+  std::string payload;
+  if (!m_file->read(entry.data_offset, entry.comp_size, payload))
+    return false;
+
+  Entry local       = entry;
+  local.data_offset = 0;
+  return zip_extract_(reinterpret_cast<const uint8_t*>(payload.data()), local, out);
+}
+
+bool pack_ezy_to(const Ezy_write_sink& sink, const std::string& manifest_json, const Ezy_asset_store& store,
+                 const Ezy_geom_entries& geoms)
+{
+  Ezy_geom_source source;
+  source.ids.reserve(geoms.size());
+  for (const auto& g : geoms)
+    source.ids.push_back(g.first);
+
+  std::sort(source.ids.begin(), source.ids.end());
+  source.read = [&geoms](const std::string& geom_id) -> std::optional<std::string> { return geoms.at(geom_id); };
+  return pack_ezy_to(sink, manifest_json, store, source);
+}
+
+bool pack_ezy_to(const Ezy_write_sink& sink, const std::string& manifest_json, const Ezy_asset_store& store,
+                 const Ezy_geom_source& geoms)
 {
   std::vector<std::string> asset_ids;
   try
@@ -88,14 +271,16 @@ std::vector<uint8_t> pack_ezy(const std::string& manifest_json, const Ezy_asset_
   }
   catch (...)
   {
-    return {};
+    return false;
   }
 
   std::sort(asset_ids.begin(), asset_ids.end());
   asset_ids.erase(std::unique(asset_ids.begin(), asset_ids.end()), asset_ids.end());
 
-  std::vector<Zip_entry> entries;
-  entries.push_back({k_ezy_manifest_path, manifest_json});
+  Zip_stream_writer zip(sink);
+  if (!zip.add(k_ezy_manifest_path, reinterpret_cast<const uint8_t*>(manifest_json.data()), manifest_json.size(),
+               k_ezy_deflate_level_manifest))
+    return false;
 
   for (const std::string& id : asset_ids)
   {
@@ -103,10 +288,45 @@ std::vector<uint8_t> pack_ezy(const std::string& manifest_json, const Ezy_asset_
     if (!pixels)
       continue;
 
-    entries.push_back({asset_path_(id), std::string(reinterpret_cast<const char*>(pixels->data()), pixels->size())});
+    if (!zip.add(asset_path_(id), pixels->data(), pixels->size(), k_ezy_deflate_level_asset))
+      return false;
   }
 
-  return zip_write_stored_(entries);
+  for (const std::string& id : geoms.ids)
+  {
+    std::optional<std::string> bytes;
+    try
+    {
+      bytes = geoms.read(id);
+    }
+    catch (...)
+    {
+      return false;
+    }
+
+    if (!bytes)
+      continue;
+
+    if (!zip.add(geom_path_(id), reinterpret_cast<const uint8_t*>(bytes->data()), bytes->size(), k_ezy_deflate_level_geom))
+      return false;
+  }
+
+  return zip.finish();
+}
+
+std::vector<uint8_t> pack_ezy(const std::string& manifest_json, const Ezy_asset_store& store, const Ezy_geom_entries& geoms)
+{
+  std::vector<uint8_t> out;
+  const auto           append = [&out](const uint8_t* data, std::size_t size)
+  {
+    out.insert(out.end(), data, data + size);
+    return true;
+  };
+
+  if (!pack_ezy_to(append, manifest_json, store, geoms))
+    return {};
+
+  return out;
 }
 
 std::string ezy_base64_encode(const std::vector<uint8_t>& bytes)
@@ -169,21 +389,21 @@ namespace
 
 uint32_t crc32_bytes_(const uint8_t* data, std::size_t len)
 {
-  static uint32_t table[256];
-  static bool     init = false;
-  if (!init)
+  // Function-local static: initialized once even when archive entries are read from several threads.
+  static const std::array<uint32_t, 256> table = []
   {
+    std::array<uint32_t, 256> t{};
     for (uint32_t i = 0; i < 256; ++i)
     {
       uint32_t c = i;
       for (int k = 0; k < 8; ++k)
         c = (c & 1u) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
 
-      table[i] = c;
+      t[i] = c;
     }
 
-    init = true;
-  }
+    return t;
+  }();
 
   uint32_t crc = 0xFFFFFFFFu;
   for (std::size_t i = 0; i < len; ++i)
@@ -227,89 +447,122 @@ bool read_u32_(const uint8_t* p, std::size_t avail, std::size_t& off, uint32_t&
   return true;
 }
 
-std::vector<uint8_t> zip_write_stored_(const std::vector<Zip_entry>& entries)
+bool Zip_stream_writer::add(const std::string& name, const uint8_t* data, std::size_t size, int level)
 {
-  std::vector<uint8_t> out;
-  struct Local_rec
-  {
-    uint32_t    offset;
-    uint16_t    name_len;
-    uint32_t    crc;
-    uint32_t    size;
-    std::string name;
-  };
-  std::vector<Local_rec> locals;
+  // Zip32 limits; larger documents would need the zip64 extensions.
+  if (size > std::numeric_limits<uint32_t>::max() || name.size() > std::numeric_limits<uint16_t>::max() ||
+      m_central.size() >= std::numeric_limits<uint16_t>::max())
+    return false;
+
+  Central_rec rec;
+  rec.name   = name;
+  rec.crc    = crc32_bytes_(data, size);
+  rec.size   = static_cast<uint32_t>(size);
+  rec.method = k_zip_method_store;
 
-  for (const Zip_entry& e : entries)
+  const uint8_t* payload      = data;
+  std::size_t    payload_size = size;
+  if (level > 0 && size > 0)
   {
-    Local_rec rec;
-    rec.offset   = static_cast<uint32_t>(out.size());
-    rec.name     = e.name;
-    rec.name_len = static_cast<uint16_t>(e.name.size());
-    rec.size     = static_cast<uint32_t>(e.data.size());
-    rec.crc      = crc32_bytes_(reinterpret_cast<const uint8_t*>(e.data.data()), e.data.size());
-
-    write_u32_(out, k_zip_local_sig);
-    write_u16_(out, 20); // version needed to extract
-    write_u16_(out, 0);  // flags
-    write_u16_(out, 0);  // compression: store
-    write_u16_(out, 0);  // mod time
-    write_u16_(out, 0);  // mod date
-    write_u32_(out, rec.crc);
-    write_u32_(out, rec.size);
-    write_u32_(out, rec.size);
-    write_u16_(out, rec.name_len);
-    write_u16_(out, 0); // extra len
-    out.insert(out.end(), e.name.begin(), e.name.end());
-    out.insert(out.end(), e.data.begin(), e.data.end());
-    locals.push_back(std::move(rec));
+    m_compressed.clear();
+    deflate_raw(data, size, level, m_compressed);
+    if (m_compressed.size() < size)
+    {
+      payload      = m_compressed.data();
+      payload_size = m_compressed.size();
+      rec.method   = k_zip_method_deflate;
+    }
   }
 
-  const uint32_t central_start = static_cast<uint32_t>(out.size());
-  for (const Local_rec& rec : locals)
+  if (m_offset + 30 + name.size() + payload_size > std::numeric_limits<uint32_t>::max())
+    return false;
+
+  rec.offset    = static_cast<uint32_t>(m_offset);
+  rec.comp_size = static_cast<uint32_t>(payload_size);
+
+  m_header.clear();
+  write_u32_(m_header, k_zip_local_sig);
+  write_u16_(m_header, 20); // version needed to extract
+  write_u16_(m_header, 0);  // flags
+  write_u16_(m_header, rec.method);
+  write_u16_(m_header, 0); // mod time
+  write_u16_(m_header, 0); // mod date
+  write_u32_(m_header, rec.crc);
+  write_u32_(m_header, rec.comp_size);
+  write_u32_(m_header, rec.size);
+  write_u16_(m_header, static_cast<uint16_t>(name.size()));
+  write_u16_(m_header, 0); // extra len
+  m_header.insert(m_header.end(), name.begin(), name.end());
+  if (!write_(m_header.data(), m_header.size()) || !write_(payload, payload_size))
+    return false;
+
+  m_central.push_back(std::move(rec));
+  return true;
+}
+
+bool Zip_stream_writer::finish()
+{
+  const uint64_t central_start = m_offset;
+  for (const Central_rec& rec : m_central)
   {
-    write_u32_(out, k_zip_central_sig);
-    write_u16_(out, 20); // version made by
-    write_u16_(out, 20); // version needed
-    write_u16_(out, 0);
-    write_u16_(out, 0);
-    write_u16_(out, 0);
-    write_u16_(out, 0);
-    write_u32_(out, rec.crc);
-    write_u32_(out, rec.size);
-    write_u32_(out, rec.size);
-    write_u16_(out, rec.name_len);
-    write_u16_(out, 0); // extra
-    write_u16_(out, 0); // comment
-    write_u16_(out, 0); // disk start
-    write_u16_(out, 0); // int attrs
-    write_u32_(out, 0); // ext attrs
-    write_u32_(out, rec.offset);
-    out.insert(out.end(), rec.name.begin(), rec.name.end());
+    m_header.clear();
+    write_u32_(m_header, k_zip_central_sig);
+    write_u16_(m_header, 20); // version made by
+    write_u16_(m_header, 20); // version needed
+    write_u16_(m_header, 0);  // flags
+    write_u16_(m_header, rec.method);
+    write_u16_(m_header, 0); // mod time
+    write_u16_(m_header, 0); // mod date
+    write_u32_(m_header, rec.crc);
+    write_u32_(m_header, rec.comp_size);
+    write_u32_(m_header, rec.size);
+    write_u16_(m_header, static_cast<uint16_t>(rec.name.size()));
+    write_u16_(m_header, 0); // extra
+    write_u16_(m_header, 0); // comment
+    write_u16_(m_header, 0); // disk start
+    write_u16_(m_header, 0); // int attrs
+    write_u32_(m_header, 0); // ext attrs
+    write_u32_(m_header, rec.offset);
+    m_header.insert(m_header.end(), rec.name.begin(), rec.name.end());
+    if (!write_(m_header.data(), m_header.size()))
+      return false;
   }
 
-  const uint32_t central_size = static_cast<uint32_t>(out.size()) - central_start;
-  write_u32_(out, k_zip_eocd_sig);
-  write_u16_(out, 0); // disk
-  write_u16_(out, 0); // disk with central
-  write_u16_(out, static_cast<uint16_t>(locals.size()));
-  write_u16_(out, static_cast<uint16_t>(locals.size()));
-  write_u32_(out, central_size);
-  write_u32_(out, central_start);
-  write_u16_(out, 0); // comment len
+  const uint64_t central_size = m_offset - central_start;
+  if (m_offset > std::numeric_limits<uint32_t>::max())
+    return false;
 
-  return out;
+  m_header.clear();
+  write_u32_(m_header, k_zip_eocd_sig);
+  write_u16_(m_header, 0); // disk
+  write_u16_(m_header, 0); // disk with central
+  write_u16_(m_header, static_cast<uint16_t>(m_central.size()));
+  write_u16_(m_header, static_cast<uint16_t>(m_central.size()));
+  write_u32_(m_header, static_cast<uint32_t>(central_size));
+  write_u32_(m_header, static_cast<uint32_t>(central_start));
+  write_u16_(m_header, 0); // comment len
+  return write_(m_header.data(), m_header.size());
+}
+
+bool Zip_stream_writer::write_(const uint8_t* data, std::size_t size)
+{
+  if (size == 0)
+    return true;
+
+  if (!m_sink(data, size))
+    return false;
+
+  m_offset += size;
+  return true;
 }
 
-bool zip_read_stored_(const std::string& bytes, std::vector<Zip_entry>& out_entries)
+bool zip_index_(const uint8_t* data, std::size_t n, std::vector<Zip_entry_ref>& out_entries)
 {
   out_entries.clear();
-  if (bytes.size() < 22)
+  if (n < 22)
     return false;
 
-  const uint8_t*    data = reinterpret_cast<const uint8_t*>(bytes.data());
-  const std::size_t n    = bytes.size();
-  std::size_t       eocd = std::string::npos;
+  std::size_t eocd = std::string::npos;
 
   for (std::size_t i = n; i >= 4; --i)
   {
@@ -335,9 +588,10 @@ bool zip_read_stored_(const std::string& bytes, std::vector<Zip_entry>& out_entr
       !read_u32_(data, n, off, cd_size) || !read_u32_(data, n, off, cd_offset))
     return false;
 
-  if (num_entries_cd != num_entries_total || cd_offset + cd_size > n)
+  if (num_entries_cd != num_entries_total || std::size_t(cd_offset) + cd_size > n)
     return false;
 
+  out_entries.reserve(num_entries_cd);
   off = cd_offset;
   for (uint16_t i = 0; i < num_entries_cd; ++i)
   {
@@ -361,10 +615,17 @@ bool zip_read_stored_(const std::string& bytes, std::vector<Zip_entry>& out_entr
     const std::string name(reinterpret_cast<const char*>(data + off), name_len);
     off += name_len + extra_len + comment_len;
 
-    if (method != 0 || comp_size != uncomp_size)
+    if (flags & k_zip_flag_encrypted)
       return false;
 
-    if (local_offset + 30u > n)
+    if (method != k_zip_method_deflate && (method != k_zip_method_store || comp_size != uncomp_size))
+      return false;
+
+    // The inflate buffer is sized from the declared size, so a few corrupt bytes must not claim gigabytes.
+    if (uint64_t(uncomp_size) > uint64_t(comp_size) * k_deflate_max_ratio)
+      return false;
+
+    if (std::size_t(local_offset) + 30u > n)
       return false;
 
     std::size_t loc = local_offset + 4u;
@@ -376,19 +637,37 @@ bool zip_read_stored_(const std::string& bytes, std::vector<Zip_entry>& out_entr
         !read_u16_(data, n, loc, loc_extra_len))
       return false;
 
-    const std::size_t data_start = local_offset + 30u + loc_name_len + loc_extra_len;
+    const std::size_t data_start = std::size_t(local_offset) + 30u + loc_name_len + loc_extra_len;
     if (data_start + comp_size > n)
       return false;
 
-    Zip_entry entry;
-    entry.name = name;
-    entry.data.assign(reinterpret_cast<const char*>(data + data_start), comp_size);
-    out_entries.push_back(std::move(entry));
+    Zip_entry_ref ref;
+    ref.name              = name;
+    ref.entry.data_offset = data_start;
+    ref.entry.comp_size   = comp_size;
+    ref.entry.size        = uncomp_size;
+    ref.entry.crc         = crc;
+    ref.entry.method      = method;
+    out_entries.push_back(std::move(ref));
   }
 
   return true;
 }
 
+bool zip_extract_(const uint8_t* data, const Ezy_archive::Entry& entry, std::string& out)
+{
+  const uint8_t* payload = data + entry.data_offset;
+  if (entry.method == k_zip_method_deflate)
+  {
+    if (!inflate_raw(payload, entry.comp_size, entry.size, out))
+      return false;
+  }
+  else
+    out.assign(reinterpret_cast<const char*>(payload), entry.comp_size);
+
+  return crc32_bytes_(reinterpret_cast<const uint8_t*>(out.data()), out.size()) == entry.crc;
+}
+
 void collect_underlay_asset_ids_(const nlohmann::json& j, std::vector<std::string>& out)
 {
   if (!j.contains("sketches") || !j["sketches"].is_array())
@@ -409,8 +688,18 @@ std::string asset_path_(const std::string& asset_id) { return std::string(k_ezy_
 
 bool parse_asset_path_(std::string_view path, std::string& out_id)
 {
-  const std::string_view prefix = k_ezy_assets_dir;
-  const std::string_view suffix = ".rgba";
+  return parse_entry_path_(path, k_ezy_assets_dir, ".rgba", out_id);
+}
+
+std::string geom_path_(const std::string& geom_id) { return std::string(k_ezy_geom_dir) + geom_id + ".brep"; }
+
+bool parse_geom_path_(std::string_view path, std::string& out_id)
+{
+  return parse_entry_path_(path, k_ezy_geom_dir, ".brep", out_id);
+}
+
+bool parse_entry_path_(std::string_view path, std::string_view prefix, std::string_view suffix, std::string& out_id)
+{
   if (path.size() <= prefix.size() + suffix.size())
     return false;
 
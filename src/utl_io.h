@@ -1,31 +1,115 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 class Ezy_asset_store;
+class Mapped_file;
 
 inline constexpr const char* k_ezy_manifest_path = "manifest.json";
 inline constexpr const char* k_ezy_assets_dir    = "assets/";
+inline constexpr const char* k_ezy_geom_dir      = "geom/";
 
-[[nodiscard]] bool is_ezy_zip(const std::string& bytes);
+/// DEFLATE level per entry kind (zlib scale, 0 = store): geometry favours save speed. Raw RGBA underlays compress
+/// well at the default level; 9 is several times slower for a few percent, and Save packs them on the UI thread.
+inline constexpr int k_ezy_deflate_level_manifest = 6;
+inline constexpr int k_ezy_deflate_level_geom     = 1;
+inline constexpr int k_ezy_deflate_level_asset    = 6;
 
-[[nodiscard]] bool is_ezy_json(const std::string& bytes);
+/// Receives archive bytes in order as they are produced; returns false to abort (e.g. a failed file write).
+using Ezy_write_sink = std::function<bool(const uint8_t* data, std::size_t size)>;
+
+/// v4 geometry entries: manifest `"geomRef"` id -> binary BRep bytes (`write_brep_binary`), stored as
+/// `geom/<id>.brep`.
+using Ezy_geom_entries = std::unordered_map<std::string, std::string>;
+
+/// Looks up v4 geometry entry bytes by `"geomRef"` id during project load; nullopt for a missing or unreadable entry.
+using Ezy_geom_reader = std::function<std::optional<std::string>(const std::string& geom_id)>;
+
+/// v4 geometry entries encoded while packing: `pack_ezy_to` calls `read` once per id, in order, just before writing the
+/// entry, so only one payload is held at a time. An id `read` returns nullopt for is left out.
+struct Ezy_geom_source
+{
+  std::vector<std::string> ids; // Sorted, so saving the same document twice produces identical archives
+  Ezy_geom_reader          read;
+};
+
+[[nodiscard]] bool is_ezy_zip(std::string_view bytes);
+
+[[nodiscard]] bool is_ezy_json(std::string_view bytes);
 
 struct Ezy_unpack_result
 {
   std::string                                           manifest_json;
   std::unordered_map<std::string, std::vector<uint8_t>> assets; // asset_id -> raw RGBA bytes
+  Ezy_geom_entries                                      geoms;  // Empty for v3 archives.
+};
+
+/// Read a v3 or v4 zip `.ezy` archive (stored or DEFLATE entries). Returns nullopt on invalid zip, CRC mismatch, or
+/// missing manifest.
+[[nodiscard]] std::optional<Ezy_unpack_result> unpack_ezy(std::string_view bytes);
+
+/// Manifest JSON of a zip `.ezy` without inflating its other entries (project validation).
+[[nodiscard]] std::optional<std::string> read_ezy_manifest(std::string_view bytes);
+
+/// Zip `.ezy` opened for on-demand reads. `open` parses only the central directory; each entry is inflated and
+/// CRC-checked when read. The archive keeps its file (usually a memory map) alive, so deferred readers that hold the
+/// archive can run long after the project was opened. Reads are const and independent, so any thread may call them.
+class Ezy_archive
+{
+public:
+  /// Where one entry's data sits in the file (from the central directory and local header).
+  struct Entry
+  {
+    std::size_t data_offset{0};
+    uint32_t    comp_size{0};
+    uint32_t    size{0};
+    uint32_t    crc{0};
+    uint16_t    method{0};
+  };
+
+  /// nullptr when `file` is not a zip this reader supports (see `unpack_ezy`) or has no manifest entry.
+  [[nodiscard]] static std::shared_ptr<const Ezy_archive> open(std::shared_ptr<const Mapped_file> file);
+
+  [[nodiscard]] std::optional<std::string>          read_manifest() const;
+  [[nodiscard]] bool                                has_geom(const std::string& geom_id) const;
+  /// nullopt when the entry is missing, corrupt, or fails its CRC.
+  [[nodiscard]] std::optional<std::string>          read_geom(const std::string& geom_id) const;
+  [[nodiscard]] std::optional<std::vector<uint8_t>> read_asset(const std::string& asset_id) const;
+  /// Asset ids with their uncompressed byte counts, known without reading the entries.
+  [[nodiscard]] std::vector<std::pair<std::string, std::size_t>> asset_sizes() const;
+  [[nodiscard]] std::vector<std::string>                         geom_ids() const;
+
+private:
+  explicit Ezy_archive(std::shared_ptr<const Mapped_file> file);
+
+  [[nodiscard]] bool read_(const Entry& entry, std::string& out) const;
+
+  std::shared_ptr<const Mapped_file>     m_file;
+  Entry                                  m_manifest;
+  std::unordered_map<std::string, Entry> m_geoms;  // geom id -> entry
+  std::unordered_map<std::string, Entry> m_assets; // asset id -> entry
 };
 
-/// Read a v3 zip `.ezy` archive. Returns nullopt on invalid zip or missing manifest.
-[[nodiscard]] std::optional<Ezy_unpack_result> unpack_ezy(const std::string& bytes);
+/// Stream a zip `.ezy` into `sink`: manifest JSON, assets referenced by underlay `"asset"` fields and, for v4
+/// manifests, the geometry entries their `"geomRef"` fields name. Entries are written one at a time, so the whole
+/// archive is never held in memory. Returns false on invalid manifest JSON, zip32 overflow, or a failing sink.
+[[nodiscard]] bool pack_ezy_to(const Ezy_write_sink& sink, const std::string& manifest_json, const Ezy_asset_store& store,
+                               const Ezy_geom_entries& geoms = {});
+/// `pack_ezy_to` with geometry encoded entry by entry (project saves, autosave). Also false when `geoms.read` throws.
+[[nodiscard]] bool pack_ezy_to(const Ezy_write_sink& sink, const std::string& manifest_json, const Ezy_asset_store& store,
+                               const Ezy_geom_source& geoms);
 
-/// Build a v3 zip `.ezy` from manifest JSON and assets referenced by underlay `"asset"` fields.
-[[nodiscard]] std::vector<uint8_t> pack_ezy(const std::string& manifest_json, const Ezy_asset_store& store);
+/// `pack_ezy_to` collected in memory (browser download, localStorage startup project). Empty on failure.
+[[nodiscard]] std::vector<uint8_t> pack_ezy(const std::string& manifest_json, const Ezy_asset_store& store,
+                                            const Ezy_geom_entries& geoms = {});
 
 /// Base64 encode/decode for binary startup project storage (Emscripten localStorage).
 [[nodiscard]] std::string          ezy_base64_encode(const std::vector<uint8_t>& bytes);
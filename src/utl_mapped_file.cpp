@@ -0,0 +1,198 @@
+#include "utl_mapped_file.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+/// Maps all of `path` read-only. Returns null (and leaves `out_size` 0) when the platform has no mapping, the file is
+/// empty, or any step fails; callers then read the file instead. `out_fd` is the POSIX descriptor left open for
+/// `Mapped_file::read` (-1 elsewhere).
+void* map_file_(const std::string& path, std::size_t& out_size, int& out_fd);
+void  unmap_file_(void* base, std::size_t size, int fd);
+/// `pread` of the whole range (POSIX); false on a short read, e.g. after truncation.
+bool  read_file_at_(int fd, std::size_t offset, std::size_t size, std::string& out);
+} // namespace
+
+std::shared_ptr<const Mapped_file> Mapped_file::open(const std::string& path)
+{
+  std::shared_ptr<Mapped_file> file(new Mapped_file());
+  std::size_t                  size = 0;
+  int                          fd   = -1;
+  if (void* base = map_file_(path, size, fd))
+  {
+    file->m_map  = base;
+    file->m_data = static_cast<const uint8_t*>(base);
+    file->m_size = size;
+    file->m_fd   = fd;
+    return file;
+  }
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open())
+    return nullptr;
+
+  std::string bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  if (in.bad())
+    return nullptr;
+
+  file->set_bytes_(std::move(bytes));
+  return file;
+}
+
+std::shared_ptr<const Mapped_file> Mapped_file::from_bytes(std::string bytes)
+{
+  std::shared_ptr<Mapped_file> file(new Mapped_file());
+  file->set_bytes_(std::move(bytes));
+  return file;
+}
+
+Mapped_file::~Mapped_file()
+{
+  if (m_map)
+    unmap_file_(m_map, m_size, m_fd);
+}
+
+bool Mapped_file::read(std::size_t offset, std::size_t size, std::string& out) const
+{
+  if (offset > m_size || size > m_size - offset)
+    return false;
+
+  if (m_fd >= 0)
+    return read_file_at_(m_fd, offset, size, out);
+
+  // In-memory bytes, or a Windows view: the file cannot be truncated while a view of it exists.
+  out.assign(reinterpret_cast<const char*>(m_data) + offset, size);
+  return true;
+}
+
+void Mapped_file::set_bytes_(std::string&& bytes)
+{
+  m_bytes = std::move(bytes);
+  m_data  = reinterpret_cast<const uint8_t*>(m_bytes.data());
+  m_size  = m_bytes.size();
+}
+
+namespace
+{
+#if defined(_WIN32)
+void* map_file_(const std::string& path, std::size_t& out_size, int& out_fd)
+{
+  out_size = 0;
+  out_fd   = -1;
+  // FILE_SHARE_DELETE lets the project be renamed or replaced by other tools while it is open.
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  LARGE_INTEGER size{};
+  void*         base = nullptr;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && static_cast<unsigned long long>(size.QuadPart) <= SIZE_MAX)
+    if (HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+    {
+      base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      // The view keeps the mapping and the file open on its own.
+      CloseHandle(mapping);
+    }
+
+  CloseHandle(file);
+  if (base)
+    out_size = static_cast<std::size_t>(size.QuadPart);
+
+  return base;
+}
+
+void unmap_file_(void* base, std::size_t, int) { UnmapViewOfFile(base); }
+
+bool read_file_at_(int, std::size_t, std::size_t, std::string&) { return false; }
+
+#elif !defined(__EMSCRIPTEN__)
+void* map_file_(const std::string& path, std::size_t& out_size, int& out_fd)
+{
+  out_size     = 0;
+  out_fd       = -1;
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat st{};
+  void*       base = nullptr;
+  if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+  {
+    base = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED)
+      base = nullptr;
+  }
+
+  // The descriptor stays open for `read`, which must not go through the mapping once the file may have changed.
+  if (!base)
+  {
+    ::close(fd);
+    return nullptr;
+  }
+
+  out_size = static_cast<std::size_t>(st.st_size);
+  out_fd   = fd;
+  return base;
+}
+
+void unmap_file_(void* base, std::size_t size, int fd)
+{
+  ::munmap(base, size);
+  ::close(fd);
+}
+
+bool read_file_at_(int fd, std::size_t offset, std::size_t size, std::string& out)
+{
+  out.resize(size);
+  std::size_t done = 0;
+  while (done < size)
+  {
+    const ssize_t n = ::pread(fd, out.data() + done, size - done, static_cast<off_t>(offset + done));
+    if (n < 0 && errno == EINTR)
+      continue;
+
+    if (n <= 0)
+    {
+      out.clear();
+      return false;
+    }
+
+    done += static_cast<std::size_t>(n);
+  }
+
+  return true;
+}
+
+#else
+// The browser build's files live in MEMFS already; copying them is all a mapping would do.
+void* map_file_(const std::string&, std::size_t& out_size, int& out_fd)
+{
+  out_size = 0;
+  out_fd   = -1;
+  return nullptr;
+}
+
+void unmap_file_(void*, std::size_t, int) {}
+
+bool read_file_at_(int, std::size_t, std::size_t, std::string&) { return false; }
+#endif
+} // namespace
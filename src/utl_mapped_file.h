@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/// Read-only bytes of a whole file. Native builds memory-map the file, so pages are read from disk only when first
+/// touched; Emscripten, `from_bytes` and failed mappings keep the bytes in memory instead.
+///
+/// A mapping sees later writes to the file, and on POSIX truncating the file under it makes access through `data()`
+/// fault. So `data()` / `view()` are for reads right after `open`; anything reading later, when another process may
+/// have rewritten the file (sync clients, git checkout, another instance saving), uses `read`, which fails instead.
+/// Self-saves still finish pending reads first (see `Occt_view::load_deferred`).
+class Mapped_file
+{
+public:
+  /// nullptr when `path` cannot be opened or read.
+  [[nodiscard]] static std::shared_ptr<const Mapped_file> open(const std::string& path);
+  /// Wraps bytes already in memory (browser file picker, saved startup project).
+  [[nodiscard]] static std::shared_ptr<const Mapped_file> from_bytes(std::string bytes);
+
+  ~Mapped_file();
+
+  Mapped_file(const Mapped_file&)            = delete;
+  Mapped_file& operator=(const Mapped_file&) = delete;
+
+  [[nodiscard]] const uint8_t*   data() const { return m_data; }
+  [[nodiscard]] std::size_t      size() const { return m_size; }
+  [[nodiscard]] std::string_view view() const { return {reinterpret_cast<const char*>(m_data), m_size}; }
+  /// True when backed by a file mapping rather than an in-memory copy.
+  [[nodiscard]] bool             mapped() const { return m_map != nullptr; }
+  /// Copies \a size bytes at \a offset into \a out; false when the file no longer holds them. POSIX mappings are
+  /// read with `pread` on the descriptor kept open, not through the mapping. Any thread.
+  [[nodiscard]] bool             read(std::size_t offset, std::size_t size, std::string& out) const;
+
+private:
+  Mapped_file() = default;
+
+  void set_bytes_(std::string&& bytes);
+
+  const uint8_t* m_data{nullptr};
+  std::size_t    m_size{0};
+  void*          m_map{nullptr}; // Base of the mapped view; null for in-memory bytes.
+  int            m_fd{-1};       // POSIX descriptor of the mapped file, for `read`
+  std::string    m_bytes;
+};
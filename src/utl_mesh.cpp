@@ -0,0 +1,193 @@
+#include "utl_mesh.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRep_Tool.hxx>
+#include <IMeshTools_Parameters.hxx>
+#include <Poly_Triangle.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <gp.hxx>
+#include <gp_Vec.hxx>
+
+#include "utl_occt.h"
+#include "utl_parallel.h"
+#include "utl_types.h"
+
+namespace
+{
+void collect_mesh_leaves_(const TopoDS_Shape& shape, std::vector<TopoDS_Shape>& out);
+void mesh_leaf_(const TopoDS_Shape& leaf, const IMeshTools_Parameters& params);
+} // namespace
+
+void mesh_shape_parallel(const TopoDS_Shape& shape, double lin_deflection, double ang_deflection_rad)
+{
+  std::vector<TopoDS_Shape> leaves;
+  collect_mesh_leaves_(shape, leaves);
+
+  // Triangulations live on the shared TFace/TEdge, so bodies that share any of them cannot be meshed concurrently.
+  std::vector<TopoDS_Shape>                independent;
+  std::vector<TopoDS_Shape>                overlapping;
+  std::unordered_set<const TopoDS_TShape*> claimed;
+  for (const TopoDS_Shape& leaf : leaves)
+  {
+    TopTools_IndexedMapOfShape sub;
+    TopExp::MapShapes(leaf, TopAbs_FACE, sub);
+    TopExp::MapShapes(leaf, TopAbs_EDGE, sub);
+    bool overlaps = false;
+    for (int i = 1; i <= sub.Extent() && !overlaps; ++i)
+      overlaps = claimed.contains(sub(i).TShape().get());
+
+    if (overlaps)
+    {
+      overlapping.push_back(leaf);
+      continue;
+    }
+
+    for (int i = 1; i <= sub.Extent(); ++i)
+      claimed.insert(sub(i).TShape().get());
+
+    independent.push_back(leaf);
+  }
+
+  IMeshTools_Parameters params;
+  params.Deflection = lin_deflection;
+  params.Angle      = ang_deflection_rad;
+#ifndef __EMSCRIPTEN__
+  params.InParallel = independent.size() < parallel_worker_count();
+#endif
+
+  parallel_for_each_index(independent.size(), [&](size_t i) { mesh_leaf_(independent[i], params); });
+
+  // Faces already meshed above are kept; only the rest of each overlapping body is tessellated here.
+  for (const TopoDS_Shape& leaf : overlapping)
+    mesh_leaf_(leaf, params);
+}
+
+size_t mesh_triangle_count(const TopoDS_Shape& shape)
+{
+  size_t count = 0;
+  for (TopExp_Explorer exp(shape, TopAbs_FACE); exp.More(); exp.Next())
+  {
+    TopLoc_Location               loc;
+    const Poly_Triangulation_ptr& tri = BRep_Tool::Triangulation(TopoDS::Face(exp.Current()), loc);
+    if (!tri.IsNull())
+      count += static_cast<size_t>(tri->NbTriangles());
+  }
+
+  return count;
+}
+
+void for_each_mesh_triangle(const TopoDS_Shape&                                                   shape,
+                            const std::function<void(const gp_Pnt&, const gp_Pnt&, const gp_Pnt&)>& fn)
+{
+  for (TopExp_Explorer exp(shape, TopAbs_FACE); exp.More(); exp.Next())
+  {
+    const TopoDS_Face&            face = TopoDS::Face(exp.Current());
+    TopLoc_Location               loc;
+    const Poly_Triangulation_ptr& tri = BRep_Tool::Triangulation(face, loc);
+    if (tri.IsNull())
+      continue;
+
+    // OCCT 7.9+: Poly_Triangulation has Node(i) and Triangle(i), not Nodes()/Triangles().
+    const gp_Trsf& tr       = loc.Transformation();
+    const bool     reversed = face.Orientation() == TopAbs_REVERSED;
+    for (int ti = 1, nbt = tri->NbTriangles(); ti <= nbt; ++ti)
+    {
+      int i1 = 0, i2 = 0, i3 = 0;
+      tri->Triangle(ti).Get(i1, i2, i3);
+      if (reversed)
+        std::swap(i2, i3);
+
+      fn(tri->Node(i1).Transformed(tr), tri->Node(i2).Transformed(tr), tri->Node(i3).Transformed(tr));
+    }
+  }
+}
+
+Status export_stl_binary_file(const TopoDS_Shape& shape, const std::string& file_path)
+{
+  const size_t ntri = mesh_triangle_count(shape);
+  if (ntri == 0)
+    return Status::user_error("STL: no mesh data (tessellate the shape first).");
+
+  if (ntri > std::numeric_limits<std::uint32_t>::max())
+    return Status::user_error("STL: too many triangles for binary STL.");
+
+  std::ofstream out(file_path, std::ios::binary);
+  if (!out)
+    return Status::user_error("STL: could not open file for writing.");
+
+  char header[80] = {};
+  std::strncpy(header, "EzyCad export", sizeof(header));
+  const std::uint32_t count = static_cast<std::uint32_t>(ntri);
+  out.write(header, sizeof(header));
+  out.write(reinterpret_cast<const char*>(&count), 4);
+
+  // 50-byte records (normal, three vertices, attribute count), little-endian like the PLY writer.
+  for_each_mesh_triangle(shape,
+                         [&out](const gp_Pnt& p1, const gp_Pnt& p2, const gp_Pnt& p3)
+                         {
+                           gp_Vec n = gp_Vec(p1, p2).Crossed(gp_Vec(p1, p3));
+                           if (n.Magnitude() > gp::Resolution())
+                             n.Normalize();
+
+                           const float rec[12] = {
+                               float(n.X()),  float(n.Y()),  float(n.Z()),  float(p1.X()), float(p1.Y()), float(p1.Z()),
+                               float(p2.X()), float(p2.Y()), float(p2.Z()), float(p3.X()), float(p3.Y()), float(p3.Z())};
+                           const std::uint16_t attr = 0;
+                           out.write(reinterpret_cast<const char*>(rec), sizeof(rec));
+                           out.write(reinterpret_cast<const char*>(&attr), sizeof(attr));
+                         });
+
+  if (!out.good())
+    return Status::user_error("STL: error writing file.");
+
+  return Status::ok();
+}
+
+namespace
+{
+void collect_mesh_leaves_(const TopoDS_Shape& shape, std::vector<TopoDS_Shape>& out)
+{
+  if (shape.IsNull())
+    return;
+
+  if (shape.ShapeType() != TopAbs_COMPOUND)
+  {
+    // An imported mesh already is its tessellation; there is no surface to mesh again.
+    if (!has_mesh_only_faces(shape))
+      out.push_back(shape);
+
+    return;
+  }
+
+  for (TopoDS_Iterator it(shape); it.More(); it.Next())
+    collect_mesh_leaves_(it.Value(), out);
+}
+
+void mesh_leaf_(const TopoDS_Shape& leaf, const IMeshTools_Parameters& params)
+{
+  // Runs on worker threads, where an escaping exception would terminate; an unmeshed face is skipped by the writers.
+  try
+  {
+    const BRepMesh_IncrementalMesh mesher(leaf, params);
+    (void)mesher;
+  }
+  catch (const Standard_Failure&)
+  {
+  }
+}
+} // namespace
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <TopoDS_Shape.hxx>
+#include <gp_Pnt.hxx>
+
+#include "utl.h"
+
+/// Tessellates every face of \a shape with `BRepMesh_IncrementalMesh`. Compounds are split into their leaf bodies,
+/// which are meshed as separate tasks on `parallel_for_each_index`; a body that shares faces or edges with an earlier
+/// one is meshed after the parallel pass so no two tasks write the same triangulation. When there are fewer bodies
+/// than cores, OCCT's own per-face parallel mode fills the rest. Deflections are in the units of \a shape.
+void mesh_shape_parallel(const TopoDS_Shape& shape, double lin_deflection, double ang_deflection_rad);
+
+/// Triangles in the face triangulations of \a shape (faces without one are skipped).
+[[nodiscard]] size_t mesh_triangle_count(const TopoDS_Shape& shape);
+
+/// Calls `fn(p1, p2, p3)` for every triangle of \a shape's face triangulations, in `mesh_triangle_count` order, with
+/// face locations applied and reversed faces flipped so the winding is counter-clockwise seen from outside.
+void for_each_mesh_triangle(const TopoDS_Shape&                                                   shape,
+                            const std::function<void(const gp_Pnt&, const gp_Pnt&, const gp_Pnt&)>& fn);
+
+/// Streams binary STL from the mesh on \a shape (mesh the shape first) without collecting it in memory.
+[[nodiscard]] Status export_stl_binary_file(const TopoDS_Shape& shape, const std::string& file_path);
@@ -1,6 +1,8 @@
 #include "utl_occt.h"
 
+#include <BinTools.hxx>
 #include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
 #include <BRepBuilderAPI_MakeSolid.hxx>
 #include <BRepBuilderAPI_Sewing.hxx>
 #include <Precision.hxx>
@@ -9,8 +11,10 @@
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Compound.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Iterator.hxx>
 #include <TopoDS_Shell.hxx>
+#include <sstream>
 
 const char* standard_failure_message(const Standard_Failure& e)
 {
@@ -118,6 +122,46 @@ void append_cad_import_bodies(const TopoDS_Shape& shape, std::vector<TopoDS_Shap
   }
 }
 
+bool has_mesh_only_faces(const TopoDS_Shape& shape)
+{
+  for (TopExp_Explorer exp(shape, TopAbs_FACE); exp.More(); exp.Next())
+  {
+    TopLoc_Location    loc;
+    const TopoDS_Face& face = TopoDS::Face(exp.Current());
+    if (BRep_Tool::Surface(face, loc).IsNull() && !BRep_Tool::Triangulation(face, loc).IsNull())
+      return true;
+  }
+
+  return false;
+}
+
+std::string write_brep_binary(const TopoDS_Shape& shape)
+{
+  // Display triangulations are rebuilt on load, but a mesh-only face has no other geometry to rebuild from.
+  std::ostringstream oss(std::ios::out | std::ios::binary);
+  BinTools::Write(shape, oss, has_mesh_only_faces(shape), false, BinTools_FormatVersion_CURRENT);
+  return oss.str();
+}
+
+TopoDS_Shape read_brep_binary(const std::string& bytes)
+{
+  TopoDS_Shape shape;
+  if (bytes.empty())
+    return shape;
+
+  std::istringstream iss(bytes, std::ios::in | std::ios::binary);
+  try
+  {
+    BinTools::Read(shape, iss);
+  }
+  catch (const Standard_Failure&)
+  {
+    return TopoDS_Shape();
+  }
+
+  return shape;
+}
+
 namespace
 {
 TopoDS_Shape solid_from_shell_(const TopoDS_Shell& shell)
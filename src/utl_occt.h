@@ -3,6 +3,7 @@
 #include <TopAbs_ShapeEnum.hxx>
 #include <TopoDS_Shape.hxx>
 #include <array>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -36,6 +37,16 @@ TopoDS_Shape try_make_solid(const TopoDS_Shape& shape);
 /// Compounds / compsolids expand to nested solids (or free shells if there are no solids).
 void append_cad_import_bodies(const TopoDS_Shape& shape, std::vector<TopoDS_Shape>& out);
 
+/// True when a face of \a shape has a `Poly_Triangulation` but no surface (PLY `Ply_import_mode::Triangulation`).
+/// Such a mesh is the only geometry there is, so writers and copies must keep triangulations for these shapes.
+[[nodiscard]] bool has_mesh_only_faces(const TopoDS_Shape& shape);
+
+/// Binary BRep (`BinTools`) used for `.ezy` v4 `geom/<id>.brep` entries; parses several times faster than the ASCII
+/// `BRepTools` text older manifests embed. Triangulations are written only for `has_mesh_only_faces` shapes.
+[[nodiscard]] std::string write_brep_binary(const TopoDS_Shape& shape);
+/// Returns a null shape when `bytes` is empty or not a valid `BinTools` stream.
+[[nodiscard]] TopoDS_Shape read_brep_binary(const std::string& bytes);
+
 class Standard_Failure;
 
 /// Message from `Standard_Failure` for logging / `Status` text.
@@ -21,6 +21,8 @@ public:
 
   void               request_cancel() { m_cancel.store(true, std::memory_order_relaxed); }
   [[nodiscard]] bool cancelled() const { return m_cancel.load(std::memory_order_relaxed); }
+  /// For `parallel_for_each_index`, so worker loops stop taking items once Cancel is pressed.
+  [[nodiscard]] const std::atomic<bool>* cancel_flag() const { return &m_cancel; }
 
   /// Overall position in [0, 1] from the last OCCT Show() (0 if transfer has not started).
   [[nodiscard]] float position() const { return m_pos.load(std::memory_order_relaxed); }
@@ -0,0 +1,230 @@
+#include "utl_parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+#ifndef __EMSCRIPTEN__
+/// FIFO queue per priority, drained by a fixed set of detached threads.
+class Task_pool
+{
+public:
+  static Task_pool& instance();
+
+  void   push(Task_priority priority, std::function<void()> task);
+  size_t worker_count() const { return m_worker_count; }
+  /// Interactive tasks waiting for a thread; background loops hand their helpers back while this is nonzero.
+  bool   interactive_queued() const { return m_interactive_queued.load(std::memory_order_relaxed) != 0; }
+
+private:
+  explicit Task_pool(size_t worker_count);
+  void worker_loop_();
+
+  std::mutex                                       m_mu;
+  std::condition_variable                          m_cv;
+  std::array<std::deque<std::function<void()>>, 2> m_queues; // Indexed by Task_priority
+  std::atomic<size_t>                              m_interactive_queued{0};
+  size_t                                           m_worker_count;
+};
+
+/// Helpers queued by one `parallel_for_each_index` call. A helper only touches the loop after registering in
+/// `running`, and the caller waits for `running` to drop to zero after `closed` is set, so helpers that start late
+/// return without reading the caller's stack.
+struct Loop_state
+{
+  std::mutex              mu;
+  std::condition_variable cv;
+  std::atomic<size_t>     next{0};
+  size_t                  running{0};
+  bool                    closed{false};
+};
+
+thread_local Task_priority t_priority = Task_priority::Interactive; // Priority of the pool task on this thread
+
+void queue_loop_helper_(const std::shared_ptr<Loop_state>& state, Task_priority priority, size_t count,
+                        const std::function<void(size_t)>& fn, const std::atomic<bool>* cancel);
+bool run_loop_items_(Loop_state& state, size_t count, const std::function<void(size_t)>& fn,
+                     const std::atomic<bool>* cancel, bool yield_to_interactive);
+#endif
+} // namespace
+
+size_t parallel_worker_count()
+{
+#ifdef __EMSCRIPTEN__
+  return 1;
+#else
+  return Task_pool::instance().worker_count();
+#endif
+}
+
+void run_task(Task_priority priority, std::function<void()> task)
+{
+#ifdef __EMSCRIPTEN__
+  (void)priority;
+  task();
+#else
+  Task_pool::instance().push(priority, std::move(task));
+#endif
+}
+
+void run_detached_task(Task_priority priority, std::function<void()> task)
+{
+#ifdef __EMSCRIPTEN__
+  (void)priority;
+  task();
+#else
+  std::thread(
+      [priority, task = std::move(task)]
+      {
+        t_priority = priority;
+        task();
+      })
+      .detach();
+#endif
+}
+
+void parallel_for_each_index(size_t count, const std::function<void(size_t)>& fn, const std::atomic<bool>* cancel)
+{
+  if (count == 0)
+    return;
+
+#ifdef __EMSCRIPTEN__
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (cancel && cancel->load())
+      break;
+
+    fn(i);
+  }
+#else
+  if (count == 1)
+  {
+    if (!(cancel && cancel->load()))
+      fn(0);
+
+    return;
+  }
+
+  // The calling thread is one of the workers, so a loop issued from a pool task always makes progress.
+  const auto   state   = std::make_shared<Loop_state>();
+  const size_t helpers = std::min(count, parallel_worker_count()) - 1;
+  for (size_t h = 0; h < helpers; ++h)
+    queue_loop_helper_(state, t_priority, count, fn, cancel);
+
+  // The caller never yields: it alone finishes the loop if every helper handed its thread to interactive work.
+  run_loop_items_(*state, count, fn, cancel, false);
+
+  std::unique_lock<std::mutex> lock(state->mu);
+  state->closed = true;
+  state->cv.wait(lock, [&state] { return state->running == 0; });
+#endif
+}
+
+namespace
+{
+#ifndef __EMSCRIPTEN__
+Task_pool& Task_pool::instance()
+{
+  // Never destroyed: a detached worker may still run an abandoned job at exit.
+  static Task_pool* pool = new Task_pool(std::max<size_t>(std::thread::hardware_concurrency(), 2));
+  return *pool;
+}
+
+Task_pool::Task_pool(size_t worker_count)
+    : m_worker_count(worker_count)
+{
+  for (size_t w = 0; w < m_worker_count; ++w)
+    std::thread([this] { worker_loop_(); }).detach();
+}
+
+void Task_pool::push(Task_priority priority, std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mu);
+    m_queues[static_cast<size_t>(priority)].push_back(std::move(task));
+    if (priority == Task_priority::Interactive)
+      ++m_interactive_queued;
+  }
+  m_cv.notify_one();
+}
+
+void Task_pool::worker_loop_()
+{
+  for (;;)
+  {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mu);
+      m_cv.wait(lock, [this] { return !m_queues[0].empty() || !m_queues[1].empty(); });
+
+      for (size_t p = 0; p < m_queues.size(); ++p)
+        if (!m_queues[p].empty())
+        {
+          task = std::move(m_queues[p].front());
+          m_queues[p].pop_front();
+          if (p == static_cast<size_t>(Task_priority::Interactive))
+            --m_interactive_queued;
+
+          t_priority = static_cast<Task_priority>(p);
+          break;
+        }
+    }
+
+    task();
+  }
+}
+
+void queue_loop_helper_(const std::shared_ptr<Loop_state>& state, const Task_priority priority, const size_t count,
+                        const std::function<void(size_t)>& fn, const std::atomic<bool>* cancel)
+{
+  Task_pool::instance().push(priority,
+                             [state, priority, count, &fn, cancel]()
+                             {
+                               {
+                                 std::lock_guard<std::mutex> lock(state->mu);
+                                 if (state->closed)
+                                   return;
+
+                                 ++state->running;
+                               }
+
+                               // Priorities do not preempt running work, so a background helper hands its thread
+                               // to queued interactive tasks between items and waits its turn again at the back of
+                               // the background queue. Still registered here, so `fn` stays valid for the re-queue.
+                               if (!run_loop_items_(*state, count, fn, cancel, priority == Task_priority::Background))
+                                 queue_loop_helper_(state, priority, count, fn, cancel);
+
+                               std::lock_guard<std::mutex> lock(state->mu);
+                               if (--state->running == 0)
+                                 state->cv.notify_all();
+                             });
+}
+
+/// False when it stopped early with indices left because interactive tasks were queued (\a yield_to_interactive).
+bool run_loop_items_(Loop_state& state, size_t count, const std::function<void(size_t)>& fn,
+                     const std::atomic<bool>* cancel, const bool yield_to_interactive)
+{
+  for (;;)
+  {
+    if (cancel && cancel->load())
+      break;
+
+    if (yield_to_interactive && Task_pool::instance().interactive_queued())
+      return state.next.load(std::memory_order_relaxed) >= count;
+
+    const size_t i = state.next.fetch_add(1, std::memory_order_relaxed);
+    if (i >= count)
+      break;
+
+    fn(i);
+  }
+
+  return true;
+}
+#endif
+} // namespace
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/// Queue order on the shared worker pool. Workers take every queued interactive task before a background one.
+enum class Task_priority : uint8_t
+{
+  Interactive, // Previews being dragged (cross-section, extrude body); also threads outside the pool, e.g. the UI
+  Background   // Import, open, autosave, shape jobs behind the busy dialog
+};
+
+/// Threads in the application-wide pool (`hardware_concurrency`, at least 2; 1 on Emscripten).
+[[nodiscard]] size_t parallel_worker_count();
+
+/// Queues \a task on the application-wide worker pool and returns at once. The pool threads are created on first use
+/// and never joined, so a task still running at exit does not hold up closing the app. Emscripten builds
+/// run \a task on the calling thread before returning.
+///
+/// `task` must not throw: an exception escaping a pool thread terminates the program.
+void run_task(Task_priority priority, std::function<void()> task);
+
+/// Runs \a task on a new detached thread outside the pool, for work that may ignore Cancel and be abandoned by its
+/// caller (fillets behind the busy dialog): it never takes a pool thread away from other tasks. Loops nested in
+/// \a task queue their helpers at \a priority. Emscripten builds run \a task on the calling thread before returning.
+///
+/// `task` must not throw: an exception escaping the thread terminates the program.
+void run_detached_task(Task_priority priority, std::function<void()> task);
+
+/// `run_task` with the result (or exception) delivered through a future. Unlike `std::async`, destroying the future
+/// does not wait for the task, so whatever \a fn captures must stay valid without the caller.
+template <typename Fn>
+[[nodiscard]] std::future<std::invoke_result_t<Fn&>> run_task_async(Task_priority priority, Fn fn)
+{
+  using Result = std::invoke_result_t<Fn&>;
+
+  auto                job = std::make_shared<std::packaged_task<Result()>>(std::move(fn));
+  std::future<Result> fut = job->get_future();
+  run_task(priority, [job] { (*job)(); });
+  return fut;
+}
+
+/// Calls `fn(i)` for every `i` in [0, count) and returns once all calls have finished. The calling thread works through
+/// the indices together with pool threads queued at its own priority (a pool task keeps its priority, other threads
+/// count as interactive); indices are handed out one at a time, so items of uneven cost balance across threads and a
+/// loop nested in a pool task cannot deadlock. Helpers of a background loop give their thread back between items while
+/// interactive tasks are queued, so a long loop does not hold previews behind it. After `cancel` reads true no further
+/// indices are started; pass `Atomic_progress_indicator::cancel_flag()` to tie a loop to a Cancel button. Emscripten
+/// builds run the loop on the calling thread.
+///
+/// `fn` must not throw: an exception escaping a worker thread terminates the program.
+void parallel_for_each_index(size_t count, const std::function<void(size_t)>& fn, const std::atomic<bool>* cancel = nullptr);
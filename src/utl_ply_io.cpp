@@ -1,26 +1,33 @@
 #include "utl_ply_io.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <functional>
+#include <limits>
 #include <sstream>
 #include <vector>
 
 #include <BRep_Builder.hxx>
-#include <BRep_Tool.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepBuilderAPI_MakePolygon.hxx>
-#include <Poly_Triangulation.hxx>
 #include <Poly_Triangle.hxx>
+#include <Poly_Triangulation.hxx>
 #include <Precision.hxx>
+#include <Standard_Failure.hxx>
 #include <TopAbs_ShapeEnum.hxx>
-#include <TopExp_Explorer.hxx>
-#include <TopoDS.hxx>
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Face.hxx>
+#include <TopoDS_Iterator.hxx>
 #include <TopoDS_Shape.hxx>
 #include <gp_Pnt.hxx>
 
+#include "utl_mesh.h"
+#include "utl_parallel.h"
+
 namespace
 {
 enum class ScalarType
@@ -57,18 +64,36 @@ struct ElementDesc
   std::vector<ListProp>   lists;
 };
 
-void       trim_inplace_(std::string& s);
-bool       iequals_(const std::string& a, const std::string& b);
-ScalarType scalar_from_token_(const std::string& t);
-int        size_of_scalar_(ScalarType t);
-bool       read_scalar_bin_at_(const unsigned char* base, size_t off, const unsigned char* endbuf, ScalarType t, double& out);
-std::uint32_t read_list_count_bin_(const unsigned char*& p, const unsigned char* end, ScalarType ct);
-bool          read_face_indices_bin_(const unsigned char*& p, const unsigned char* end, ScalarType vt, std::uint32_t n,
-                                     std::vector<int>& idx_out);
+/// Where x/y/z sit in a vertex record: byte offsets for binary, property positions for ASCII.
+struct VertexLayout
+{
+  size_t     stride{0};
+  size_t     fields{0};
+  size_t     off[3]{};
+  size_t     field[3]{};
+  ScalarType type[3]{ScalarType::Unknown, ScalarType::Unknown, ScalarType::Unknown};
+};
+
+// Vertices or faces per parallel parse task.
+constexpr size_t k_ply_chunk = size_t(1) << 16;
+
+void        trim_inplace_(std::string& s);
+bool        iequals_(const std::string& a, const std::string& b);
+ScalarType  scalar_from_token_(const std::string& t);
+int         size_of_scalar_(ScalarType t);
+bool        read_scalar_bin_at_(const unsigned char* base, size_t off, const unsigned char* endbuf, ScalarType t, double& out);
+Status      read_binary_mesh_(std::string_view body, const VertexLayout& layout, const ListProp& face_list, double scale,
+                              Poly_Triangulation& tri);
+Status      read_ascii_mesh_(std::string_view body, const VertexLayout& layout, double scale, Poly_Triangulation& tri);
+const char* read_ascii_line_(std::string_view line, size_t index, const VertexLayout& layout, double scale,
+                             std::string& buf, Poly_Triangulation& tri);
+/// Runs `fn(chunk)` for every chunk in parallel; `fn` returns an error message or null. Stops at the first error.
+Status      run_chunks_(size_t chunks, const std::function<const char*(size_t)>& fn);
+Status      build_facet_compound_(const Poly_Triangulation& tri, TopoDS_Shape& out_shape);
 bool append_triangle_(TopoDS_Compound& comp, BRep_Builder& bb, const gp_Pnt& p0, const gp_Pnt& p1, const gp_Pnt& p2, int& ntri);
 } // namespace
 
-Status import_ply_shape(const std::string& file_bytes, TopoDS_Shape& out_shape)
+Status import_ply_shape(std::string_view file_bytes, TopoDS_Shape& out_shape, Ply_import_mode mode, double scale)
 {
   out_shape.Nullify();
 
@@ -193,211 +218,61 @@ Status import_ply_shape(const std::string& file_bytes, TopoDS_Shape& out_shape)
   if (face_el->lists.size() != 1)
     return Status::user_error("PLY: only one list property per face is supported.");
 
-  size_t     off_x = 0, off_y = 0, off_z = 0;
-  size_t     vstride = 0;
-  ScalarType tx = ScalarType::Unknown, ty = ScalarType::Unknown, tz = ScalarType::Unknown;
-
+  VertexLayout layout;
   {
     size_t o = 0;
-    for (const ScalarProp& sp : vert_el->scalars)
+    for (size_t i = 0; i < vert_el->scalars.size(); ++i)
     {
-      const int sz = size_of_scalar_(sp.type);
-      if (iequals_(sp.name, "x"))
+      const ScalarProp& sp   = vert_el->scalars[i];
+      const int         axis = iequals_(sp.name, "x") ? 0 : iequals_(sp.name, "y") ? 1 : iequals_(sp.name, "z") ? 2 : -1;
+      if (axis >= 0)
       {
-        off_x = o;
-        tx    = sp.type;
+        layout.off[axis]   = o;
+        layout.type[axis]  = sp.type;
+        layout.field[axis] = i;
       }
-      else if (iequals_(sp.name, "y"))
-      {
-        off_y = o;
-        ty    = sp.type;
-      }
-      else if (iequals_(sp.name, "z"))
-      {
-        off_z = o;
-        tz    = sp.type;
-      }
-      o += static_cast<size_t>(sz);
+      o += static_cast<size_t>(size_of_scalar_(sp.type));
     }
-    vstride = o;
-    if (vstride == 0 || off_x >= vstride || off_y >= vstride || off_z >= vstride)
+    layout.stride = o;
+    layout.fields = vert_el->scalars.size();
+    if (layout.stride == 0 || layout.type[0] == ScalarType::Unknown || layout.type[1] == ScalarType::Unknown ||
+        layout.type[2] == ScalarType::Unknown)
       return Status::user_error("PLY: vertex x/y/z properties not found.");
-
-    if (tx == ScalarType::Unknown || ty == ScalarType::Unknown || tz == ScalarType::Unknown)
-      return Status::user_error("PLY: vertex x/y/z types invalid.");
-  }
-
-  const ListProp& face_list = face_el->lists.front();
-
-  std::vector<gp_Pnt> verts(static_cast<size_t>(vert_el->count));
-  TopoDS_Compound     comp;
-  BRep_Builder        bb;
-  bb.MakeCompound(comp);
-  int ntri = 0;
-
-  if (format_mode == "ascii")
-  {
-    std::istringstream body(file_bytes.substr(pos));
-    for (size_t vi = 0; vi < verts.size(); ++vi)
-    {
-      std::string vl;
-      if (!std::getline(body, vl))
-        return Status::user_error("PLY: unexpected EOF in vertices.");
-
-      trim_inplace_(vl);
-      std::istringstream ls(vl);
-      double             x = 0, y = 0, z = 0;
-      for (const ScalarProp& sp : vert_el->scalars)
-      {
-        if (sp.type == ScalarType::Float32 || sp.type == ScalarType::Float64)
-        {
-          double d = 0;
-          if (!(ls >> d))
-            return Status::user_error("PLY: bad vertex data.");
-
-          if (iequals_(sp.name, "x"))
-            x = d;
-          else if (iequals_(sp.name, "y"))
-            y = d;
-          else if (iequals_(sp.name, "z"))
-            z = d;
-        }
-        else if (sp.type == ScalarType::Int8 || sp.type == ScalarType::UInt8 || sp.type == ScalarType::Int16 ||
-                 sp.type == ScalarType::UInt16 || sp.type == ScalarType::Int32 || sp.type == ScalarType::UInt32)
-        {
-          long long v = 0;
-          if (!(ls >> v))
-            return Status::user_error("PLY: bad vertex data.");
-
-          const double d = static_cast<double>(v);
-          if (iequals_(sp.name, "x"))
-            x = d;
-          else if (iequals_(sp.name, "y"))
-            y = d;
-          else if (iequals_(sp.name, "z"))
-            z = d;
-        }
-        else
-          return Status::user_error("PLY: unsupported vertex property for ASCII.");
-      }
-      verts[vi] = gp_Pnt(x, y, z);
-    }
-
-    for (int fi = 0; fi < face_el->count; ++fi)
-    {
-      std::string fl;
-      if (!std::getline(body, fl))
-        return Status::user_error("PLY: unexpected EOF in faces.");
-
-      trim_inplace_(fl);
-      std::istringstream fs(fl);
-      int                nidx = 0;
-      fs >> nidx;
-      if (nidx != 3)
-        return Status::user_error("PLY: only triangular faces are supported.");
-
-      int i0 = 0, i1 = 0, i2 = 0;
-      fs >> i0 >> i1 >> i2;
-      if (i0 < 0 || i1 < 0 || i2 < 0)
-        return Status::user_error("PLY: negative vertex index.");
-
-      const size_t su0 = static_cast<size_t>(i0);
-      const size_t su1 = static_cast<size_t>(i1);
-      const size_t su2 = static_cast<size_t>(i2);
-      if (su0 >= verts.size() || su1 >= verts.size() || su2 >= verts.size())
-        return Status::user_error("PLY: face vertex index out of range.");
-
-      append_triangle_(comp, bb, verts[su0], verts[su1], verts[su2], ntri);
-    }
-    if (ntri == 0)
-      return Status::user_error("PLY: no valid triangles.");
-
-    out_shape = comp;
-    return Status::ok();
   }
 
-  // binary_little_endian
-  const unsigned char* p   = reinterpret_cast<const unsigned char*>(file_bytes.data()) + pos;
-  const unsigned char* end = reinterpret_cast<const unsigned char*>(file_bytes.data()) + file_bytes.size();
-
-  for (size_t vi = 0; vi < verts.size(); ++vi)
-  {
-    if (static_cast<size_t>(end - p) < vstride)
-      return Status::user_error("PLY: truncated vertex data.");
-
-    double x = 0, y = 0, z = 0;
-    if (!read_scalar_bin_at_(p, off_x, end, tx, x) || !read_scalar_bin_at_(p, off_y, end, ty, y) ||
-        !read_scalar_bin_at_(p, off_z, end, tz, z))
-      return Status::user_error("PLY: bad binary vertex.");
+  if (format_mode != "ascii" && !face_el->scalars.empty())
+    return Status::user_error("PLY: binary face properties other than the index list are not supported.");
 
-    verts[vi] = gp_Pnt(x, y, z);
-    p += vstride;
-  }
-
-  for (int fi = 0; fi < face_el->count; ++fi)
-  {
-    if (static_cast<size_t>(end - p) < 1u)
-      return Status::user_error("PLY: truncated face data.");
-
-    const std::uint32_t n = read_list_count_bin_(p, end, face_list.count_type);
-    if (n != 3u)
-      return Status::user_error("PLY: only triangular faces are supported.");
-
-    std::vector<int> idx;
-    if (!read_face_indices_bin_(p, end, face_list.value_type, n, idx) || idx.size() != 3u)
-      return Status::user_error("PLY: bad face indices.");
+  if (face_el->count <= 0)
+    return Status::user_error("PLY: no valid triangles.");
 
-    const size_t su0 = static_cast<size_t>(idx[0]);
-    const size_t su1 = static_cast<size_t>(idx[1]);
-    const size_t su2 = static_cast<size_t>(idx[2]);
-    if (su0 >= verts.size() || su1 >= verts.size() || su2 >= verts.size())
-      return Status::user_error("PLY: face vertex index out of range.");
+  if (vert_el->count >= std::numeric_limits<int>::max() || face_el->count >= std::numeric_limits<int>::max())
+    return Status::user_error("PLY: too many vertices or faces.");
 
-    append_triangle_(comp, bb, verts[su0], verts[su1], verts[su2], ntri);
-  }
+  // Parsed straight into the triangulation; a facet import builds its faces from it afterwards.
+  Poly_Triangulation_ptr tri  = new Poly_Triangulation(vert_el->count, face_el->count, false);
+  const std::string_view body = file_bytes.substr(pos);
+  CHK_RET(format_mode == "ascii" ? read_ascii_mesh_(body, layout, scale, *tri)
+                                 : read_binary_mesh_(body, layout, face_el->lists.front(), scale, *tri));
 
-  if (ntri == 0)
-    return Status::user_error("PLY: no valid triangles.");
+  if (mode == Ply_import_mode::Brep_facets)
+    return build_facet_compound_(*tri, out_shape);
 
-  out_shape = comp;
+  TopoDS_Face  face;
+  BRep_Builder bb;
+  bb.MakeFace(face, tri);
+  out_shape = face;
   return Status::ok();
 }
 
 Status export_ply_binary_file(const TopoDS_Shape& shape, const std::string& file_path)
 {
-  struct Tri
-  {
-    double x0, y0, z0, x1, y1, z1, x2, y2, z2;
-  };
-  std::vector<Tri> tris;
-
-  for (TopExp_Explorer exp(shape, TopAbs_FACE); exp.More(); exp.Next())
-  {
-    const TopoDS_Face&            face = TopoDS::Face(exp.Current());
-    TopLoc_Location               loc;
-    const Poly_Triangulation_ptr& tri = BRep_Tool::Triangulation(face, loc);
-    if (tri.IsNull())
-      continue;
-
-    // OCCT 7.9+: Poly_Triangulation has Node(i) and Triangle(i), not Nodes()/Triangles().
-    const gp_Trsf& tr = loc.Transformation();
-    for (int ti = 1, nbt = tri->NbTriangles(); ti <= nbt; ++ti)
-    {
-      const Poly_Triangle& tab = tri->Triangle(ti);
-      int                  i1 = 0, i2 = 0, i3 = 0;
-      tab.Get(i1, i2, i3);
-      const gp_Pnt p1 = tri->Node(i1).Transformed(tr);
-      const gp_Pnt p2 = tri->Node(i2).Transformed(tr);
-      const gp_Pnt p3 = tri->Node(i3).Transformed(tr);
-      tris.push_back(Tri{p1.X(), p1.Y(), p1.Z(), p2.X(), p2.Y(), p2.Z(), p3.X(), p3.Y(), p3.Z()});
-    }
-  }
-
-  if (tris.empty())
+  // Triangles are counted first so the header can be written and the mesh streamed straight from the faces.
+  const size_t nf = mesh_triangle_count(shape);
+  if (nf == 0)
     return Status::user_error("PLY: no mesh data (tessellate the shape first).");
 
-  const size_t nv = tris.size() * 3;
-  const size_t nf = tris.size();
+  const size_t nv = nf * 3;
 
   std::ostringstream hdr;
   hdr << "ply\nformat binary_little_endian 1.0\n"
@@ -416,11 +291,12 @@ Status export_ply_binary_file(const TopoDS_Shape& shape, const std::string& file
     return Status::user_error("PLY: could not open file for writing.");
 
   out.write(hdr_str.data(), static_cast<std::streamsize>(hdr_str.size()));
-  for (const Tri& t : tris)
-  {
-    const double v[9] = {t.x0, t.y0, t.z0, t.x1, t.y1, t.z1, t.x2, t.y2, t.z2};
-    out.write(reinterpret_cast<const char*>(v), sizeof(v));
-  }
+  for_each_mesh_triangle(shape,
+                         [&out](const gp_Pnt& p1, const gp_Pnt& p2, const gp_Pnt& p3)
+                         {
+                           const double v[9] = {p1.X(), p1.Y(), p1.Z(), p2.X(), p2.Y(), p2.Z(), p3.X(), p3.Y(), p3.Z()};
+                           out.write(reinterpret_cast<const char*>(v), sizeof(v));
+                         });
 
   for (size_t fi = 0; fi < nf; ++fi)
   {
@@ -599,63 +475,222 @@ bool read_scalar_bin_at_(const unsigned char* base, size_t off, const unsigned c
   }
 }
 
-std::uint32_t read_list_count_bin_(const unsigned char*& p, const unsigned char* end, ScalarType ct)
+Status read_binary_mesh_(std::string_view body, const VertexLayout& layout, const ListProp& face_list, double scale,
+                         Poly_Triangulation& tri)
 {
-  switch (ct)
-  {
-  case ScalarType::UInt8:
+  const size_t         nv    = static_cast<size_t>(tri.NbNodes());
+  const size_t         nf    = static_cast<size_t>(tri.NbTriangles());
+  const unsigned char* base  = reinterpret_cast<const unsigned char*>(body.data());
+  const unsigned char* end   = base + body.size();
+  const size_t         csize = static_cast<size_t>(size_of_scalar_(face_list.count_type));
+  const size_t         isize = static_cast<size_t>(size_of_scalar_(face_list.value_type));
+  // Triangle-only meshes have fixed-size face records, so both blocks can be split at any record.
+  const size_t fstride = csize + 3 * isize;
+  if (nv > body.size() / layout.stride)
+    return Status::user_error("PLY: truncated vertex data.");
+
+  const unsigned char* faces = base + nv * layout.stride;
+  if (nf > static_cast<size_t>(end - faces) / fstride)
+    return Status::user_error("PLY: truncated face data.");
+
+  const size_t vchunks = (nv + k_ply_chunk - 1) / k_ply_chunk;
+  const size_t fchunks = (nf + k_ply_chunk - 1) / k_ply_chunk;
+  return run_chunks_(vchunks + fchunks,
+                     [&](size_t chunk) -> const char*
+                     {
+                       if (chunk < vchunks)
+                       {
+                         for (size_t i = chunk * k_ply_chunk, n = std::min(nv, i + k_ply_chunk); i < n; ++i)
+                         {
+                           const unsigned char* v = base + i * layout.stride;
+                           double               x = 0, y = 0, z = 0;
+                           if (!read_scalar_bin_at_(v, layout.off[0], end, layout.type[0], x) ||
+                               !read_scalar_bin_at_(v, layout.off[1], end, layout.type[1], y) ||
+                               !read_scalar_bin_at_(v, layout.off[2], end, layout.type[2], z))
+                             return "PLY: bad binary vertex.";
+
+                           tri.SetNode(static_cast<int>(i) + 1, gp_Pnt(x * scale, y * scale, z * scale));
+                         }
+                         return nullptr;
+                       }
+
+                       const size_t first = (chunk - vchunks) * k_ply_chunk;
+                       for (size_t i = first, n = std::min(nf, first + k_ply_chunk); i < n; ++i)
+                       {
+                         const unsigned char* f     = faces + i * fstride;
+                         double               count = 0;
+                         double               idx[3]{};
+                         if (!read_scalar_bin_at_(f, 0, end, face_list.count_type, count) || count != 3.0)
+                           return "PLY: only triangular faces are supported.";
+
+                         for (size_t k = 0; k < 3; ++k)
+                           if (!read_scalar_bin_at_(f, csize + k * isize, end, face_list.value_type, idx[k]) || idx[k] < 0 ||
+                               idx[k] >= static_cast<double>(nv))
+                             return "PLY: face vertex index out of range.";
+
+                         tri.SetTriangle(static_cast<int>(i) + 1,
+                                         Poly_Triangle(static_cast<int>(idx[0]) + 1, static_cast<int>(idx[1]) + 1,
+                                                       static_cast<int>(idx[2]) + 1));
+                       }
+                       return nullptr;
+                     });
+}
+
+Status read_ascii_mesh_(std::string_view body, const VertexLayout& layout, double scale, Poly_Triangulation& tri)
+{
+  const size_t nv    = static_cast<size_t>(tri.NbNodes());
+  const size_t total = nv + static_cast<size_t>(tri.NbTriangles());
+
+  // One serial newline scan records where every chunk of lines starts; the chunks then parse independently.
+  std::vector<size_t> starts;
+  starts.reserve(total / k_ply_chunk + 1);
+  size_t pos = 0;
+  for (size_t line = 0; line < total; ++line)
   {
-    if (static_cast<size_t>(end - p) < 1)
-      return 0;
+    if (pos >= body.size())
+      return Status::user_error(line < nv ? "PLY: unexpected EOF in vertices." : "PLY: unexpected EOF in faces.");
+
+    if (line % k_ply_chunk == 0)
+      starts.push_back(pos);
 
-    std::uint32_t v = *p;
-    ++p;
-    return v;
+    const void* nl = std::memchr(body.data() + pos, '\n', body.size() - pos);
+    pos            = nl ? static_cast<size_t>(static_cast<const char*>(nl) - body.data()) + 1 : body.size();
   }
-  case ScalarType::UInt16:
+
+  return run_chunks_(starts.size(),
+                     [&](size_t chunk) -> const char*
+                     {
+                       std::string buf;
+                       size_t      at = starts[chunk];
+                       for (size_t i = chunk * k_ply_chunk, n = std::min(total, i + k_ply_chunk); i < n; ++i)
+                       {
+                         const void*  nl  = std::memchr(body.data() + at, '\n', body.size() - at);
+                         const size_t end = nl ? static_cast<size_t>(static_cast<const char*>(nl) - body.data()) : body.size();
+                         if (const char* err = read_ascii_line_(body.substr(at, end - at), i, layout, scale, buf, tri))
+                           return err;
+
+                         at = end + 1;
+                       }
+                       return nullptr;
+                     });
+}
+
+const char* read_ascii_line_(std::string_view line, size_t index, const VertexLayout& layout, double scale,
+                             std::string& buf, Poly_Triangulation& tri)
+{
+  // strtod/strtol need a terminated string; the mapped file is not, so each line is copied into a reused buffer.
+  buf.assign(line.data(), line.size());
+  const char* cur = buf.c_str();
+  char*       end = nullptr;
+
+  const size_t nv = static_cast<size_t>(tri.NbNodes());
+  if (index < nv)
   {
-    if (static_cast<size_t>(end - p) < 2)
-      return 0;
+    double xyz[3]{};
+    for (size_t f = 0; f < layout.fields; ++f)
+    {
+      const double d = std::strtod(cur, &end);
+      if (end == cur)
+        return "PLY: bad vertex data.";
+
+      cur = end;
+      for (int axis = 0; axis < 3; ++axis)
+        if (layout.field[axis] == f)
+          xyz[axis] = d;
+    }
 
-    std::uint16_t v;
-    std::memcpy(&v, p, 2);
-    p += 2;
-    return v;
+    tri.SetNode(static_cast<int>(index) + 1, gp_Pnt(xyz[0] * scale, xyz[1] * scale, xyz[2] * scale));
+    return nullptr;
   }
-  case ScalarType::UInt32:
+
+  if (std::strtol(cur, &end, 10) != 3 || end == cur)
+    return "PLY: only triangular faces are supported.";
+
+  long idx[3]{};
+  for (long& v : idx)
   {
-    if (static_cast<size_t>(end - p) < 4)
-      return 0;
+    cur = end;
+    v   = std::strtol(cur, &end, 10);
+    if (end == cur)
+      return "PLY: bad face indices.";
 
-    std::uint32_t v;
-    std::memcpy(&v, p, 4);
-    p += 4;
-    return v;
-  }
-  default:
-    return 0;
+    if (v < 0)
+      return "PLY: negative vertex index.";
+
+    if (static_cast<size_t>(v) >= nv)
+      return "PLY: face vertex index out of range.";
   }
+
+  tri.SetTriangle(static_cast<int>(index - nv) + 1,
+                  Poly_Triangle(static_cast<int>(idx[0]) + 1, static_cast<int>(idx[1]) + 1, static_cast<int>(idx[2]) + 1));
+  return nullptr;
 }
 
-bool read_face_indices_bin_(const unsigned char*& p, const unsigned char* end, ScalarType vt, std::uint32_t n,
-                            std::vector<int>& idx_out)
+Status run_chunks_(size_t chunks, const std::function<const char*(size_t)>& fn)
 {
-  idx_out.clear();
-  idx_out.reserve(n);
-  for (std::uint32_t i = 0; i < n; ++i)
+  std::vector<const char*> errors(chunks, nullptr);
+  std::atomic<bool>        failed{false};
+  parallel_for_each_index(
+      chunks,
+      [&](size_t chunk)
+      {
+        if ((errors[chunk] = fn(chunk)) != nullptr)
+          failed.store(true);
+      },
+      &failed);
+
+  for (const char* err : errors)
+    if (err)
+      return Status::user_error(err);
+
+  return Status::ok();
+}
+
+Status build_facet_compound_(const Poly_Triangulation& tri, TopoDS_Shape& out_shape)
+{
+  // Facet faces are built per chunk in parallel, then gathered into one compound in file order.
+  const size_t                 nf     = static_cast<size_t>(tri.NbTriangles());
+  const size_t                 chunks = (nf + k_ply_chunk - 1) / k_ply_chunk;
+  std::vector<TopoDS_Compound> parts(chunks);
+  std::vector<int>             counts(chunks, 0);
+  const auto                   build_chunk = [&](size_t chunk) -> const char*
   {
-    double d = 0;
-    if (!read_scalar_bin_at_(p, 0, end, vt, d))
-      return false;
+    try
+    {
+      BRep_Builder bb;
+      bb.MakeCompound(parts[chunk]);
+      for (size_t i = chunk * k_ply_chunk, n = std::min(nf, i + k_ply_chunk); i < n; ++i)
+      {
+        int n1 = 0, n2 = 0, n3 = 0;
+        tri.Triangle(static_cast<int>(i) + 1).Get(n1, n2, n3);
+        append_triangle_(parts[chunk], bb, tri.Node(n1), tri.Node(n2), tri.Node(n3), counts[chunk]);
+      }
+    }
+    catch (const Standard_Failure&)
+    {
+      return "PLY: could not build facet faces.";
+    }
+    return nullptr;
+  };
+  CHK_RET(run_chunks_(chunks, build_chunk));
 
-    int sz = size_of_scalar_(vt);
-    if (sz <= 0 || static_cast<size_t>(end - p) < static_cast<size_t>(sz))
-      return false;
+  TopoDS_Compound comp;
+  BRep_Builder    bb;
+  bb.MakeCompound(comp);
+  int ntri = 0;
+  for (size_t c = 0; c < chunks; ++c)
+  {
+    for (TopoDS_Iterator it(parts[c]); it.More(); it.Next())
+      bb.Add(comp, it.Value());
 
-    p += static_cast<size_t>(sz);
-    idx_out.push_back(static_cast<int>(d));
+    ntri += counts[c];
   }
-  return true;
+
+  if (ntri == 0)
+    return Status::user_error("PLY: no valid triangles.");
+
+  out_shape = comp;
+  return Status::ok();
 }
 
 bool append_triangle_(TopoDS_Compound& comp, BRep_Builder& bb, const gp_Pnt& p0, const gp_Pnt& p1, const gp_Pnt& p2, int& ntri)
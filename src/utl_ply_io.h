@@ -1,13 +1,19 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include <TopoDS_Shape.hxx>
 
 #include "utl.h"
+#include "utl_types.h"
 
-/// Parses PLY (ASCII or binary_little_endian) with vertex x/y/z and triangular faces.
-[[nodiscard]] Status import_ply_shape(const std::string& file_bytes, TopoDS_Shape& out_shape);
+/// Parses PLY (ASCII or binary_little_endian) with vertex x/y/z and triangular faces, reading \a file_bytes in place
+/// (e.g. a `Mapped_file` view). Vertex and face blocks are decoded in parallel chunks; coordinates are multiplied by
+/// \a scale. `Ply_import_mode::Triangulation` returns one face carrying the whole `Poly_Triangulation`;
+/// `Brep_facets` returns a compound with one planar face per non-degenerate triangle.
+[[nodiscard]] Status import_ply_shape(std::string_view file_bytes, TopoDS_Shape& out_shape,
+                                      Ply_import_mode mode = Ply_import_mode::Triangulation, double scale = 1.0);
 
-/// Writes binary_little_endian PLY from mesh on \a shape (run `BRepMesh_IncrementalMesh` first).
+/// Streams binary_little_endian PLY from the mesh on \a shape (run `mesh_shape_parallel` first).
 [[nodiscard]] Status export_ply_binary_file(const TopoDS_Shape& shape, const std::string& file_path);
@@ -201,6 +201,15 @@ std::filesystem::path user_startup_project_path()
   return dir / "startup.ezy";
 }
 
+std::filesystem::path user_recovery_project_path()
+{
+  const std::filesystem::path dir = user_config_directory();
+  if (dir.empty())
+    return {};
+
+  return dir / "recovery.ezy";
+}
+
 std::string load_user_startup_project()
 {
 #ifdef __EMSCRIPTEN__
@@ -240,9 +249,19 @@ std::string load_user_startup_project()
 #endif
 }
 
-bool save_user_startup_project(const std::vector<uint8_t>& ezy_bytes)
+bool save_user_startup_project(const std::function<bool(const Ezy_write_sink&)>& write_ezy)
 {
 #ifdef __EMSCRIPTEN__
+  std::vector<uint8_t> ezy_bytes;
+  const bool           written = write_ezy(
+      [&ezy_bytes](const uint8_t* data, std::size_t size)
+      {
+        ezy_bytes.insert(ezy_bytes.end(), data, data + size);
+        return true;
+      });
+  if (!written)
+    return false;
+
   const std::string b64 = std::string("B64:") + ezy_base64_encode(ezy_bytes);
   EM_ASM_({ localStorage.setItem('ezycad_startup_ezy', UTF8ToString($0)); }, b64.c_str());
   return true;
@@ -260,8 +279,12 @@ bool save_user_startup_project(const std::vector<uint8_t>& ezy_bytes)
   if (!f)
     return false;
 
-  f.write(reinterpret_cast<const char*>(ezy_bytes.data()), static_cast<std::streamsize>(ezy_bytes.size()));
-  return true;
+  return write_ezy(
+      [&f](const uint8_t* data, std::size_t size)
+      {
+        f.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        return f.good();
+      });
 #endif
 }
 
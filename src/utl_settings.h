@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include "utl_io.h"
+
 namespace settings
 {
 // Optional: set a callback to receive log messages from load_defaults() (e.g. GUI log window).
@@ -31,8 +33,13 @@ std::filesystem::path user_settings_json_path();
 // Path to the user "startup" project (.../startup.ezy). Empty if user_config_directory() is empty.
 std::filesystem::path user_startup_project_path();
 
+// Autosave recovery project (.../recovery.ezy, see Doc_autosave). Empty if user_config_directory() is empty, so
+// Emscripten has no autosave.
+std::filesystem::path user_recovery_project_path();
+
 // Optional startup project (Blender-style). Native: user_startup_project_path(); Wasm: localStorage.
 std::string load_user_startup_project();
-bool        save_user_startup_project(const std::vector<uint8_t>& ezy_bytes);
+// `write_ezy` streams the archive into the sink it is given (native: straight into the file).
+bool        save_user_startup_project(const std::function<bool(const Ezy_write_sink&)>& write_ezy);
 void        clear_user_startup_project();
 } // namespace settings
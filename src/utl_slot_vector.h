@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utl_dbg.h"
+
+/// Contiguous storage with stable handles. A handle is the slot index of an element and stays valid until that
+/// element is erased; erased slots go on a free list and are reused by later inserts. Iteration visits live slots in
+/// slot order, so walks run over one flat array instead of chasing list nodes.
+///
+/// `T` must be default constructible (erased slots are reset to `T{}` so they release what they own).
+template <typename T> class Slot_vector
+{
+public:
+  using Handle = size_t;
+
+  template <bool Is_const> class Iterator
+  {
+  public:
+    using Owner             = std::conditional_t<Is_const, const Slot_vector, Slot_vector>;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::conditional_t<Is_const, const T*, T*>;
+    using reference         = std::conditional_t<Is_const, const T&, T&>;
+
+    Iterator() = default;
+    Iterator(Owner* owner, Handle slot)
+        : m_owner(owner),
+          m_slot(slot)
+    {
+    }
+
+    // Non-const to const conversion.
+    operator Iterator<true>() const
+      requires(!Is_const)
+    {
+      return {m_owner, m_slot};
+    }
+
+    reference operator*() const { return m_owner->m_slots[m_slot]; }
+    pointer   operator->() const { return &m_owner->m_slots[m_slot]; }
+    bool      operator==(const Iterator& other) const { return m_slot == other.m_slot; }
+
+    Iterator& operator++()
+    {
+      m_slot = m_owner->first_live_(m_slot + 1);
+      return *this;
+    }
+
+    Iterator operator++(int)
+    {
+      Iterator ret = *this;
+      ++*this;
+      return ret;
+    }
+
+    // Steps back to the previous live slot; decrementing `begin()` is undefined, as for standard containers.
+    Iterator& operator--()
+    {
+      do
+        --m_slot;
+      while (!m_owner->m_live[m_slot]);
+
+      return *this;
+    }
+
+    Iterator operator--(int)
+    {
+      Iterator ret = *this;
+      --*this;
+      return ret;
+    }
+
+    [[nodiscard]] Handle handle() const { return m_slot; }
+
+  private:
+    Owner* m_owner{nullptr};
+    Handle m_slot{0};
+  };
+
+  using iterator               = Iterator<false>;
+  using const_iterator         = Iterator<true>;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /// Stores `value` in a free slot (or a new one) and returns its handle.
+  Handle insert(T value);
+  /// Releases the slot of `handle`; other handles are unaffected.
+  void   erase(Handle handle);
+  void   clear();
+
+  [[nodiscard]] bool   contains(Handle handle) const { return handle < m_live.size() && m_live[handle]; }
+  [[nodiscard]] size_t size() const { return m_size; }
+  [[nodiscard]] bool   empty() const { return m_size == 0; }
+  /// One past the largest handle ever in use; size per-handle side arrays with this.
+  [[nodiscard]] size_t slot_count() const { return m_slots.size(); }
+
+  T&       operator[](Handle handle);
+  const T& operator[](Handle handle) const;
+
+  iterator               begin() { return {this, first_live_(0)}; }
+  iterator               end() { return {this, m_slots.size()}; }
+  const_iterator         begin() const { return {this, first_live_(0)}; }
+  const_iterator         end() const { return {this, m_slots.size()}; }
+  const_iterator         cbegin() const { return begin(); }
+  const_iterator         cend() const { return end(); }
+  reverse_iterator       rbegin() { return reverse_iterator(end()); }
+  reverse_iterator       rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+private:
+  [[nodiscard]] Handle first_live_(Handle from) const;
+
+  std::vector<T>       m_slots;
+  std::vector<uint8_t> m_live; // Per slot; 0 for free slots.
+  std::vector<Handle>  m_free;
+  size_t               m_size{0};
+};
+
+#include "utl_slot_vector.inl"
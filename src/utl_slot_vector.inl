@@ -0,0 +1,57 @@
+template <typename T> typename Slot_vector<T>::Handle Slot_vector<T>::insert(T value)
+{
+  Handle handle;
+  if (!m_free.empty())
+  {
+    handle = m_free.back();
+    m_free.pop_back();
+    m_slots[handle] = std::move(value);
+    m_live[handle]  = 1;
+  }
+  else
+  {
+    handle = m_slots.size();
+    m_slots.push_back(std::move(value));
+    m_live.push_back(1);
+  }
+
+  ++m_size;
+  return handle;
+}
+
+template <typename T> void Slot_vector<T>::erase(Handle handle)
+{
+  EZY_ASSERT(contains(handle));
+  m_slots[handle] = T{};
+  m_live[handle]  = 0;
+  m_free.push_back(handle);
+  --m_size;
+}
+
+template <typename T> void Slot_vector<T>::clear()
+{
+  m_slots.clear();
+  m_live.clear();
+  m_free.clear();
+  m_size = 0;
+}
+
+template <typename T> T& Slot_vector<T>::operator[](Handle handle)
+{
+  EZY_ASSERT(contains(handle));
+  return m_slots[handle];
+}
+
+template <typename T> const T& Slot_vector<T>::operator[](Handle handle) const
+{
+  EZY_ASSERT(contains(handle));
+  return m_slots[handle];
+}
+
+template <typename T> typename Slot_vector<T>::Handle Slot_vector<T>::first_live_(Handle from) const
+{
+  while (from < m_live.size() && !m_live[from])
+    ++from;
+
+  return from;
+}
@@ -145,6 +145,13 @@ enum class Export_unit
   Millimeter
 };
 
+/// Tessellation tolerances for STL/PLY export (`Occt_view::export_document`).
+struct Mesh_export_params
+{
+  double lin_deflection{0.0};      // Chord tolerance in export units; <= 0 uses 0.1 model units
+  double ang_deflection_deg{28.6}; // Angle between neighboring facets on curved faces (OCCT's 0.5 rad default)
+};
+
 /// How STEP assemblies land in the Shape List on import.
 enum class Step_import_mode
 {
@@ -153,6 +160,13 @@ enum class Step_import_mode
   Union_shapes        // fuse all leaves into one solid
 };
 
+/// What PLY import builds from the file's triangles.
+enum class Ply_import_mode
+{
+  Triangulation, // one face carrying a `Poly_Triangulation` (fast; display and mesh export)
+  Brep_facets    // one planar BRep face per triangle (slow; usable by BRep tools)
+};
+
 /// Project display/input length unit. Model space stays inch-scaled
 /// (`model = inches * dimension_scale`); this only affects UI and dimensions.
 enum class Project_unit
@@ -16,14 +16,35 @@
 #include <gp_Ax1.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Trsf.hxx>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <map>
 #include <numbers>
+#include <thread>
 
+#include "doc_autosave.h"
 #include "shp.h"
 #include "shp_create.h"
 #include "shp_info.h"
+#include "shp_job.h"
 #include "shp_cross_section.h"
+#include "shp_delta.h"
 #include "skt_op_recorder.h"
 #include "utl.h"
+#include "utl_boolean.h"
+#include "utl_io.h"
+#include "utl_mapped_file.h"
+#include "utl_mesh.h"
+#include "utl_occt.h"
+#include "utl_parallel.h"
+#include "utl_ply_io.h"
 
 namespace
 {
@@ -42,6 +63,12 @@ void get_bbox(const TopoDS_Shape& shape, double& xmin, double& ymin, double& zmi
   bbox.Get(xmin, ymin, zmin, xmax, ymax, zmax);
 }
 
+std::string read_file_bytes(const std::filesystem::path& path)
+{
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
 bool contains_solid_like(const TopoDS_Shape& shape)
 {
   return !shape.IsNull() && (shape.ShapeType() == TopAbs_SOLID || TopExp_Explorer(shape, TopAbs_SOLID).More());
@@ -63,6 +90,32 @@ void select_shapes(Occt_view& view, const std::vector<Shp_ptr>& shapes)
   for (const Shp_ptr& shp : shapes)
     cctx.AddOrRemoveSelected(shp, true);
 }
+
+// Compares the view's indexed tree queries against a plain scan of the shape list.
+void expect_registry_matches_scan(Occt_view& view)
+{
+  std::map<Shape_id, std::vector<Shp_ptr>> kids_by_parent;
+  kids_by_parent[0];
+  for (const Shp_ptr& s : view.get_shapes())
+  {
+    EXPECT_EQ(view.find_shape_by_id(s->get_id()), s);
+    kids_by_parent[s->get_parent_id()].push_back(s);
+    kids_by_parent[s->get_id()];
+  }
+
+  for (auto& [parent, kids] : kids_by_parent)
+  {
+    std::sort(kids.begin(), kids.end(),
+              [](const Shp_ptr& a, const Shp_ptr& b)
+              {
+                if (a->get_sibling_order() != b->get_sibling_order())
+                  return a->get_sibling_order() < b->get_sibling_order();
+                return a->get_id() < b->get_id();
+              });
+    EXPECT_EQ(view.shape_children(parent), kids);
+    EXPECT_EQ(view.next_sibling_order(parent), kids.empty() ? 0 : kids.back()->get_sibling_order() + 1);
+  }
+}
 } // namespace
 
 // Headless Occt_view fixture shared with sketch tests.
@@ -397,6 +450,42 @@ TEST_F(Shp_test, Cross_section_selection_stale_after_selection_change)
   EXPECT_TRUE(contains_solid_like(view().get_shapes().back()->Shape()));
 }
 
+TEST_F(Shp_test, Cross_section_reuses_cached_section_for_revisited_offset)
+{
+  view().add_box(0, 0, 0, 10, 10, 10);
+  select_shapes(view(), {view().get_shapes().back()});
+  gui().set_mode(Mode::Shape_cross_section);
+  Shp_cross_section& section = view().shp_cross_section();
+
+  double offset_min = 0.0;
+  double offset_max = 0.0;
+  ASSERT_TRUE(section.try_get_offset_range_display(offset_min, offset_max));
+  section.set_offset_display(offset_min * 0.5);
+  ASSERT_TRUE(section.preview_selected().is_ok());
+  const TopoDS_Shape first = section.last_section_compound();
+
+  section.set_offset_display(offset_max * 0.5);
+  ASSERT_TRUE(section.preview_selected().is_ok());
+  const size_t bytes = section.cache_bytes();
+  EXPECT_GT(bytes, 0u);
+
+  // Back to the first offset: the cached edges come back and nothing new is stored.
+  section.set_offset_display(offset_min * 0.5);
+  ASSERT_TRUE(section.preview_selected().is_ok());
+  EXPECT_EQ(section.cache_bytes(), bytes);
+  TopExp_Explorer first_edge(first, TopAbs_EDGE);
+  TopExp_Explorer again_edge(section.last_section_compound(), TopAbs_EDGE);
+  ASSERT_TRUE(first_edge.More() && again_edge.More());
+  EXPECT_TRUE(first_edge.Current().IsSame(again_edge.Current()));
+
+  // The slider snaps to precompute samples only while precompute is on; the range ends are samples.
+  EXPECT_EQ(section.snap_offset_display(1.234, offset_min, offset_max), 1.234);
+  section.set_precompute(true);
+  EXPECT_DOUBLE_EQ(section.snap_offset_display(offset_max + 1.0, offset_min, offset_max), offset_max);
+  EXPECT_DOUBLE_EQ(section.snap_offset_display(offset_min, offset_min, offset_max), offset_min);
+  section.set_precompute(false);
+}
+
 TEST_F(Shp_test, Cross_section_clip_removes_fully_discarded_solids)
 {
   // Short box lies entirely below the shared midplane; tall box is cut (kept half survives).
@@ -589,6 +678,64 @@ TEST_F(Shp_test, Common_overlapping_boxes)
   EXPECT_NEAR(volume_of(view().get_shapes().back()->Shape()), 500.0, 1e-3);
 }
 
+TEST_F(Shp_test, Common_of_three_boxes_keeps_region_inside_all)
+{
+  view().add_box(0, 0, 0, 10, 10, 10);
+  view().add_box(5, 0, 0, 10, 10, 10);
+  view().add_box(0, 5, 0, 10, 10, 10);
+
+  std::vector<Shp_ptr> to_select(view().get_shapes().begin(), view().get_shapes().end());
+  select_shapes(view(), to_select);
+
+  Status st = view().shp_common().selected_common();
+  ASSERT_TRUE(st.is_ok()) << st.message();
+
+  // Inside all three is a 5x5x10 prism (the first box against the union of the others would be 750).
+  ASSERT_EQ(view().get_shapes().size(), 1u);
+  EXPECT_NEAR(volume_of(view().get_shapes().back()->Shape()), 250.0, 1e-3);
+}
+
+TEST_F(Shp_test, Boolean_op_multi_runs_one_operation_over_all_operands)
+{
+  std::vector<TopoDS_Shape> row;
+  for (int i = 0; i < 8; ++i)
+  {
+    view().add_box(i * 5.0, 0, 0, 10, 10, 10);
+    row.push_back(view().get_shapes().back()->Shape());
+  }
+
+  TopoDS_Shape fused;
+  ASSERT_TRUE(boolean_op_multi(Boolean_op::Fuse, row, fused).is_ok());
+  EXPECT_NEAR(volume_of(fused), 4500.0, 1e-3);
+
+  // A tool whose box misses the first operand is dropped; with none left the first operand comes back as is.
+  view().add_box(100, 0, 0, 1, 1, 1);
+  const TopoDS_Shape far = view().get_shapes().back()->Shape();
+  TopoDS_Shape       cut;
+  ASSERT_TRUE(boolean_op_multi(Boolean_op::Cut, {row[0], far}, cut).is_ok());
+  EXPECT_TRUE(cut.IsSame(row[0]));
+  ASSERT_TRUE(boolean_op_multi(Boolean_op::Cut, {row[0], row[1], far}, cut).is_ok());
+  EXPECT_NEAR(volume_of(cut), 500.0, 1e-3);
+
+  TopoDS_Shape common;
+  ASSERT_TRUE(boolean_op_multi(Boolean_op::Common, {row[0], row[1], far}, common).is_ok());
+  EXPECT_FALSE(TopExp_Explorer(common, TopAbs_SOLID).More());
+
+  // A tool within the fuzzy distance of the first operand is kept, not dropped by the box prefilter.
+  view().add_box(10.05, 0, 0, 1, 1, 1);
+  const TopoDS_Shape near_tool = view().get_shapes().back()->Shape();
+  Boolean_params     fuzzy;
+  fuzzy.fuzzy_value = 0.1;
+  ASSERT_TRUE(boolean_op_multi(Boolean_op::Cut, {row[0], near_tool}, cut, fuzzy).is_ok());
+  EXPECT_FALSE(cut.IsSame(row[0]));
+
+  Boolean_params params;
+  params.progress = new Atomic_progress_indicator();
+  params.progress->request_cancel();
+  EXPECT_FALSE(boolean_op_multi(Boolean_op::Fuse, row, fused, params).is_ok());
+  EXPECT_FALSE(boolean_op_multi(Boolean_op::Fuse, {row[0]}, fused).is_ok());
+}
+
 TEST_F(Shp_test, Fuse_requires_two_shapes)
 {
   view().add_box(0, 0, 0, 1, 1, 1);
@@ -599,6 +746,123 @@ TEST_F(Shp_test, Fuse_requires_two_shapes)
   EXPECT_EQ(view().get_shapes().size(), 1u);
 }
 
+TEST_F(Shp_test, Fuse_job_computes_off_thread_and_commits_on_return)
+{
+  view().add_box(0, 0, 0, 10, 10, 10);
+  view().add_box(5, 0, 0, 10, 10, 10);
+  std::vector<Shp_ptr> boxes(view().get_shapes().begin(), view().get_shapes().end());
+  select_shapes(view(), boxes);
+
+  Result<Shape_job> job = view().shp_fuse().selected_fuse_job();
+  ASSERT_TRUE(job.is_ok()) << job.message();
+  EXPECT_EQ(view().get_shapes().size(), 2u); // Nothing changes before commit
+
+  const auto wait_for = [](const std::shared_ptr<Shape_job_task>& task)
+  {
+    while (!task->ready())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  };
+
+  std::shared_ptr<Shape_job_task> task = Shape_job_task::start(job->compute, new Atomic_progress_indicator());
+  wait_for(task);
+  TopoDS_Shape result;
+  ASSERT_TRUE(task->take(result).is_ok());
+  ASSERT_TRUE(job->commit(result).is_ok());
+  ASSERT_EQ(view().get_shapes().size(), 1u);
+  EXPECT_NEAR(volume_of(view().get_shapes().back()->Shape()), 1500.0, 1e-3);
+
+  // An operand deleted while the job ran: the commit leaves the document alone.
+  view().add_box(0, 0, 0, 10, 10, 10);
+  view().add_box(5, 0, 0, 10, 10, 10);
+  boxes.assign(std::next(view().get_shapes().begin()), view().get_shapes().end());
+  select_shapes(view(), boxes);
+  job = view().shp_fuse().selected_fuse_job();
+  ASSERT_TRUE(job.is_ok());
+  view().remove_shape_by_id(boxes.back()->get_id());
+  EXPECT_FALSE(job->run().is_ok());
+  EXPECT_EQ(view().get_shapes().size(), 2u);
+
+  // Cancel before the Boolean starts polling.
+  Atomic_progress_indicator_ptr progress = new Atomic_progress_indicator();
+  progress->request_cancel();
+  task = Shape_job_task::start(job->compute, progress);
+  wait_for(task);
+  EXPECT_FALSE(task->take(result).is_ok());
+}
+
+TEST(Task_pool, Nested_loops_in_pool_tasks_visit_every_index)
+{
+  // More outer tasks than pool threads, each running an inner loop: callers take part in their own loops, so
+  // every task finishes even though all pool threads are busy with outer tasks.
+  constexpr size_t                 k_outer = 16;
+  constexpr size_t                 k_inner = 200;
+  std::vector<std::future<size_t>> sums;
+  for (size_t t = 0; t < k_outer; ++t)
+    sums.push_back(run_task_async(Task_priority::Background,
+                                  []
+                                  {
+                                    std::vector<std::atomic<int>> hits(k_inner);
+                                    parallel_for_each_index(k_inner, [&](size_t i) { hits[i].fetch_add(1); });
+                                    return static_cast<size_t>(std::count_if(hits.begin(), hits.end(),
+                                                                              [](const auto& h) { return h.load() == 1; }));
+                                  }));
+
+  for (std::future<size_t>& sum : sums)
+  {
+    ASSERT_EQ(sum.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+    EXPECT_EQ(sum.get(), k_inner);
+  }
+
+  std::atomic<bool> cancel{true};
+  size_t            calls = 0;
+  parallel_for_each_index(k_inner, [&](size_t) { ++calls; }, &cancel);
+  EXPECT_EQ(calls, 0u);
+}
+
+TEST(Task_pool, Background_loop_yields_to_interactive_task)
+{
+  // A background loop far longer than the test: its helpers must hand their threads to an interactive task queued
+  // meanwhile instead of holding every worker until the loop ends.
+  const auto        item = [](size_t) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); };
+  std::atomic<bool> cancel{false};
+  std::future<void> loop = run_task_async(Task_priority::Background,
+                                          [item, &cancel] { parallel_for_each_index(1000000, item, &cancel); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  std::future<int> preview = run_task_async(Task_priority::Interactive, [] { return 7; });
+  EXPECT_EQ(preview.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+
+  cancel = true;
+  ASSERT_EQ(loop.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+  EXPECT_EQ(preview.get(), 7);
+}
+
+TEST(Task_pool, Abandoned_shape_jobs_do_not_starve_background_tasks)
+{
+  // Jobs that ignore Cancel (like some fillets) and are dropped by the busy dialog, one more than there are pool
+  // threads: a background task queued afterwards must still run.
+  std::promise<void>       release;
+  std::shared_future<void> released = release.get_future().share();
+  for (size_t j = 0; j <= parallel_worker_count(); ++j)
+  {
+    Atomic_progress_indicator_ptr   progress = new Atomic_progress_indicator();
+    std::shared_ptr<Shape_job_task> task     = Shape_job_task::start(
+        [released](TopoDS_Shape&, const Atomic_progress_indicator_ptr&)
+        {
+          released.wait();
+          return Status::ok();
+        },
+        progress);
+    progress->request_cancel();
+  }
+
+  std::future<int> answer = run_task_async(Task_priority::Background, [] { return 42; });
+  ASSERT_EQ(answer.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+  EXPECT_EQ(answer.get(), 42);
+
+  release.set_value();
+}
+
 // ---------------------------------------------------------------------------
 // Shape undo / redo (typed deltas, no full-document snapshot)
 // ---------------------------------------------------------------------------
@@ -724,6 +988,351 @@ TEST_F(Shp_test, Shape_frame_persists_in_json_and_undo)
   EXPECT_TRUE(view().get_shapes().back()->get_frame().XDirection().IsEqual(expected.XDirection(), 1e-9));
 }
 
+TEST_F(Shp_test, Ezy_v4_binary_geometry_round_trip)
+{
+  view().add_box(1, 2, 3, 3, 4, 5);
+  ASSERT_EQ(view().get_shapes().size(), 1u);
+  const Shape_id id = view().get_shapes().back()->get_id();
+
+  Ezy_geom_entries     geoms;
+  const nlohmann::json doc = nlohmann::json::parse(view().to_json(&geoms));
+  EXPECT_EQ(doc["ezyFormat"].get<int>(), 4);
+  ASSERT_EQ(doc["shapes"].size(), 1u);
+  EXPECT_FALSE(doc["shapes"][0].contains("geom"));
+  EXPECT_EQ(doc["shapes"][0]["geomRef"].get<std::string>(), std::to_string(id));
+  ASSERT_EQ(geoms.size(), 1u);
+
+  const std::vector<uint8_t> bytes = pack_ezy(doc.dump(), view().asset_store(), geoms);
+  auto unpacked = unpack_ezy(std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+  ASSERT_TRUE(unpacked);
+  ASSERT_EQ(unpacked->geoms.size(), 1u);
+  EXPECT_EQ(unpacked->geoms.begin()->second, geoms.begin()->second);
+
+  // The streaming save encodes each shape as its entry is written and produces the same archive.
+  Ezy_geom_source      source;
+  const std::string    streamed_manifest = view().to_json(source);
+  std::vector<uint8_t> streamed;
+  EXPECT_EQ(streamed_manifest, view().to_json(&geoms));
+  ASSERT_EQ(source.ids, std::vector<std::string>{std::to_string(id)});
+  ASSERT_TRUE(pack_ezy_to(
+      [&streamed](const uint8_t* data, size_t size)
+      {
+        streamed.insert(streamed.end(), data, data + size);
+        return true;
+      },
+      streamed_manifest, view().asset_store(), source));
+  EXPECT_EQ(streamed, pack_ezy(streamed_manifest, view().asset_store(), geoms));
+
+  view().new_file();
+  view().load(unpacked->manifest_json, false, &unpacked->geoms);
+  ASSERT_EQ(view().get_shapes().size(), 1u);
+  EXPECT_EQ(view().get_shapes().back()->get_id(), id);
+  EXPECT_NEAR(volume_of(view().get_shapes().back()->Shape()), 60.0, 1e-6);
+
+  // A v4 manifest whose entry is missing skips that shape instead of failing the whole load.
+  view().load(unpacked->manifest_json, false, nullptr);
+  EXPECT_TRUE(view().get_shapes().empty());
+}
+
+TEST_F(Shp_test, Ezy_lazy_load_reads_geometry_on_first_use)
+{
+  view().add_box(0, 0, 0, 1, 2, 3);
+  view().add_box(5, 0, 0, 2, 2, 2);
+  Shp_ptr hidden = view().get_shapes().back();
+  hidden->set_visible(false);
+  const Shape_id hidden_id = hidden->get_id();
+
+  Ezy_geom_entries           geoms;
+  const std::string          manifest = view().to_json(&geoms);
+  const std::vector<uint8_t> bytes    = pack_ezy(manifest, view().asset_store(), geoms);
+  const auto archive = Ezy_archive::open(Mapped_file::from_bytes(std::string(bytes.begin(), bytes.end())));
+  ASSERT_TRUE(archive);
+
+  view().new_file();
+  view().load_lazy(manifest, archive, false);
+  ASSERT_EQ(view().get_shapes().size(), 2u);
+  hidden = view().find_shape_by_id(hidden_id);
+  ASSERT_FALSE(hidden.IsNull());
+  EXPECT_FALSE(hidden->get_visible());
+  EXPECT_TRUE(hidden->deferred_geom());
+  EXPECT_GE(view().deferred_shape_count(), 1u);
+
+  // Undo checkpoints share the pending geometry instead of reading it.
+  view().push_undo_snapshot();
+  EXPECT_TRUE(hidden->deferred_geom());
+
+  EXPECT_NEAR(volume_of(hidden->Shape()), 8.0, 1e-6);
+  EXPECT_FALSE(hidden->deferred_geom());
+  EXPECT_NEAR(volume_of(view().get_shapes().front()->Shape()), 6.0, 1e-6);
+  EXPECT_EQ(view().deferred_shape_count(), 0u);
+
+  // load_deferred reads everything still pending, as before a save over the mapped file.
+  view().load_lazy(manifest, archive, false);
+  view().load_deferred();
+  EXPECT_EQ(view().deferred_shape_count(), 0u);
+  EXPECT_NEAR(volume_of(view().find_shape_by_id(hidden_id)->Shape()), 8.0, 1e-6);
+}
+
+TEST_F(Shp_test, Project_load_prepares_geometry_off_the_ui_thread)
+{
+  for (int i = 0; i < 12; ++i)
+    view().add_box(i * 2.0, 0, 0, 1, 1, 1 + i);
+
+  Ezy_geom_entries  geoms;
+  const std::string manifest = view().to_json(&geoms);
+  const std::string text     = view().to_json();
+
+  for (const bool binary : {true, false})
+  {
+    const Atomic_progress_indicator_ptr progress = new Atomic_progress_indicator();
+    Occt_view::Project_load_geom        geom;
+    const Ezy_geom_reader               read_geom = Occt_view::geom_reader(binary ? &geoms : nullptr);
+    const std::string&                  json      = binary ? manifest : text;
+
+    auto prepared = std::async(std::launch::async,
+                               [&] { return Occt_view::prepare_load(json, read_geom, nullptr, geom, progress); });
+    ASSERT_TRUE(prepared.get().is_ok());
+    ASSERT_EQ(geom.shapes.size(), 12u);
+    EXPECT_NEAR(progress->position(), 1.0f, 1e-3f);
+
+    view().new_file();
+    view().commit_load(geom, false);
+    ASSERT_EQ(view().get_shapes().size(), 12u);
+    double total = 0.0;
+    for (const Shp_ptr& shp : view().get_shapes())
+      total += volume_of(shp->Shape());
+
+    EXPECT_NEAR(total, 78.0, 1e-6); // 1 + 2 + ... + 12
+  }
+
+  Occt_view::Project_load_geom geom;
+  EXPECT_FALSE(Occt_view::prepare_load("{not json", {}, nullptr, geom).is_ok());
+
+  const Atomic_progress_indicator_ptr cancelled = new Atomic_progress_indicator();
+  cancelled->request_cancel();
+  EXPECT_FALSE(Occt_view::prepare_load(manifest, Occt_view::geom_reader(&geoms), nullptr, geom, cancelled).is_ok());
+}
+
+TEST_F(Shp_test, Autosave_snapshot_recaptures_only_dirty_records)
+{
+  view().add_box(0, 0, 0, 1, 1, 1);
+  view().add_box(3, 0, 0, 2, 2, 2);
+  const uint64_t rev = view().doc_edit_revision();
+  EXPECT_GT(rev, 0u);
+
+  const std::shared_ptr<const Doc_snapshot> first = view().capture_doc_snapshot();
+  ASSERT_EQ(first->shapes.size(), 2u);
+
+  // Nothing changed: every slot is shared with the previous capture.
+  const std::shared_ptr<const Doc_snapshot> same = view().capture_doc_snapshot();
+  EXPECT_EQ(same->shapes[0], first->shapes[0]);
+  EXPECT_EQ(same->shapes[1], first->shapes[1]);
+
+  const Shp_ptr renamed = view().get_shapes().back();
+  renamed->set_name("Renamed");
+  view().mark_shape_dirty(renamed->get_id());
+  EXPECT_GT(view().doc_edit_revision(), rev);
+
+  const std::shared_ptr<const Doc_snapshot> second = view().capture_doc_snapshot();
+  ASSERT_EQ(second->shapes.size(), 2u);
+  EXPECT_EQ(second->shapes[0], first->shapes[0]);
+  EXPECT_NE(second->shapes[1], first->shapes[1]);
+  EXPECT_EQ(second->shapes[1]->rec.name, "Renamed");
+
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "ezycad_autosave_test.ezy";
+  ASSERT_TRUE(Doc_autosave::write_recovery(*second, path).is_ok());
+  EXPECT_FALSE(std::filesystem::exists(std::filesystem::path(path).concat(".tmp")));
+
+  const std::string bytes = read_file_bytes(path);
+  std::filesystem::remove(path);
+  auto unpacked = unpack_ezy(bytes);
+  ASSERT_TRUE(unpacked);
+
+  view().new_file();
+  view().load(unpacked->manifest_json, false, &unpacked->geoms);
+  ASSERT_EQ(view().get_shapes().size(), 2u);
+  EXPECT_EQ(view().get_shapes().back()->get_name(), "Renamed");
+  EXPECT_NEAR(volume_of(view().get_shapes().back()->Shape()), 8.0, 1e-6);
+}
+
+TEST_F(Shp_test, Mesh_export_streams_every_body)
+{
+  view().add_box(0, 0, 0, 1, 1, 1);
+  view().add_box(3, 0, 0, 2, 2, 2);
+  view().add_sphere(0, 5, 0, 1);
+
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::filesystem::path stl = dir / "ezycad_mesh_export_test.stl";
+  const std::filesystem::path ply = dir / "ezycad_mesh_export_test.ply";
+
+  // Binary STL: 80-byte header, triangle count, then 50 bytes per triangle.
+  ASSERT_TRUE(view().export_document(Export_format::Stl, Export_unit::Inch, stl.string()).is_ok());
+  const std::string coarse = read_file_bytes(stl);
+  ASSERT_GE(coarse.size(), 84u);
+  std::uint32_t coarse_count = 0;
+  std::memcpy(&coarse_count, coarse.data() + 80, 4);
+  EXPECT_GT(coarse_count, 24u); // Two boxes (12 triangles each) plus the sphere
+  EXPECT_EQ(coarse.size(), 84u + 50u * coarse_count);
+
+  Mesh_export_params fine;
+  fine.lin_deflection     = 0.01;
+  fine.ang_deflection_deg = 5.0;
+  ASSERT_TRUE(view().export_document(Export_format::Stl, Export_unit::Inch, stl.string(), fine).is_ok());
+  const std::string fine_bytes = read_file_bytes(stl);
+  std::uint32_t     fine_count = 0;
+  std::memcpy(&fine_count, fine_bytes.data() + 80, 4);
+  EXPECT_GT(fine_count, coarse_count);
+  std::filesystem::remove(stl);
+
+  // PLY streams the same triangles after a header that counted them up front.
+  ASSERT_TRUE(view().export_document(Export_format::Ply, Export_unit::Inch, ply.string(), fine).is_ok());
+  const std::string ply_bytes = read_file_bytes(ply);
+  std::filesystem::remove(ply);
+  EXPECT_NE(ply_bytes.find("element face " + std::to_string(fine_count) + "\n"), std::string::npos);
+  EXPECT_EQ(ply_bytes.size(), ply_bytes.find("end_header\n") + 11 + fine_count * (9 * 8 + 13));
+
+  TopoDS_Shape mesh;
+  ASSERT_TRUE(import_ply_shape(ply_bytes, mesh).is_ok());
+  EXPECT_TRUE(TopExp_Explorer(mesh, TopAbs_FACE).More());
+}
+
+TEST_F(Shp_test, Ply_import_builds_one_triangulated_face)
+{
+  view().add_box(0, 0, 0, 1, 1, 1);
+  view().add_sphere(3, 0, 0, 1);
+
+  const std::filesystem::path ply = std::filesystem::temp_directory_path() / "ezycad_ply_import_test.ply";
+  ASSERT_TRUE(view().export_document(Export_format::Ply, Export_unit::Inch, ply.string()).is_ok());
+  const std::string bytes = read_file_bytes(ply);
+  std::filesystem::remove(ply);
+  const size_t count_at = bytes.find("element face ");
+  ASSERT_NE(count_at, std::string::npos);
+  const size_t tri_count = std::stoul(bytes.substr(count_at + 13));
+
+  // Default mode: every triangle lands in one surface-less face.
+  TopoDS_Shape mesh;
+  ASSERT_TRUE(import_ply_shape(bytes, mesh).is_ok());
+  int faces = 0;
+  for (TopExp_Explorer exp(mesh, TopAbs_FACE); exp.More(); exp.Next())
+    ++faces;
+
+  EXPECT_EQ(faces, 1);
+  EXPECT_TRUE(has_mesh_only_faces(mesh));
+  EXPECT_EQ(mesh_triangle_count(mesh), tri_count);
+
+  // The scale is applied while parsing.
+  TopoDS_Shape scaled;
+  ASSERT_TRUE(import_ply_shape(bytes, scaled, Ply_import_mode::Triangulation, 2.0).is_ok());
+  double xmin, ymin, zmin, xmax, ymax, zmax;
+  double sxmin, symin, szmin, sxmax, symax, szmax;
+  get_bbox(mesh, xmin, ymin, zmin, xmax, ymax, zmax);
+  get_bbox(scaled, sxmin, symin, szmin, sxmax, symax, szmax);
+  EXPECT_NEAR(sxmax, 2 * xmax, 1e-5);
+  EXPECT_NEAR(szmax, 2 * zmax, 1e-5);
+
+  // Project saves and copies keep the triangles; there is no surface to mesh again.
+  EXPECT_EQ(mesh_triangle_count(read_brep_binary(write_brep_binary(mesh))), tri_count);
+
+  TopoDS_Shape facets;
+  ASSERT_TRUE(import_ply_shape(bytes, facets, Ply_import_mode::Brep_facets).is_ok());
+  EXPECT_FALSE(has_mesh_only_faces(facets));
+  size_t facet_count = 0;
+  for (TopExp_Explorer exp(facets, TopAbs_FACE); exp.More(); exp.Next())
+    ++facet_count;
+
+  EXPECT_GT(facet_count, 12u);
+  EXPECT_LE(facet_count, tri_count);
+
+  const std::string ascii = "ply\nformat ascii 1.0\ncomment unit square\nelement vertex 4\nproperty float x\n"
+                            "property float y\nproperty float z\nelement face 2\nproperty list uchar int vertex_indices\n"
+                            "end_header\n0 0 0\n1 0 0\n1 1 0\n0 1 0\n3 0 1 2\n3 0 2 3\n";
+  TopoDS_Shape square;
+  ASSERT_TRUE(import_ply_shape(ascii, square).is_ok());
+  EXPECT_EQ(mesh_triangle_count(square), 2u);
+  EXPECT_FALSE(import_ply_shape(ascii.substr(0, ascii.size() - 8), square).is_ok());
+}
+
+TEST_F(Shp_test, Step_import_union_fuses_all_leaves_at_once)
+{
+  view().add_box(0, 0, 0, 1, 1, 1);
+  view().add_box(0.5, 0, 0, 1, 1, 1);
+  view().add_box(5, 0, 0, 1, 1, 1);
+
+  const std::filesystem::path step = std::filesystem::temp_directory_path() / "ezycad_step_union_test.step";
+  ASSERT_TRUE(view().export_document(Export_format::Step, Export_unit::Inch, step.string()).is_ok());
+  const std::string bytes = read_file_bytes(step);
+  std::filesystem::remove(step);
+
+  Occt_view::Step_import_geom flat;
+  ASSERT_TRUE(Occt_view::prepare_step_import(bytes, Step_import_mode::Flat_solids, view().step_import_model_scale(), flat)
+                  .is_ok());
+  std::vector<double> volumes;
+  for (const utl_cad_file_info::Named_node& node : flat.named)
+    if (!node.is_group && !node.shape.IsNull())
+      volumes.push_back(volume_of(node.shape));
+
+  ASSERT_EQ(volumes.size(), 3u);
+  EXPECT_NEAR(volumes[0], 1.0, 1e-6);
+
+  // The first two boxes overlap by half; the third is disjoint, so the union is one compound of two solids.
+  Occt_view::Step_import_geom fused;
+  ASSERT_TRUE(Occt_view::prepare_step_import(bytes, Step_import_mode::Union_shapes, view().step_import_model_scale(), fused)
+                  .is_ok());
+  ASSERT_FALSE(fused.fused.IsNull());
+  EXPECT_TRUE(fused.named.empty());
+  EXPECT_NEAR(volume_of(fused.fused), 2.5, 1e-6);
+  int solids = 0;
+  for (TopExp_Explorer exp(fused.fused, TopAbs_SOLID); exp.More(); exp.Next())
+    ++solids;
+
+  EXPECT_EQ(solids, 2);
+}
+
+// Save/load timing for a grouped assembly: v3 inline BRep text versus v4 binary geometry entries.
+TEST_F(Shp_test, Ezy_save_load_benchmark_large_assembly)
+{
+  constexpr int c_groups    = 10;
+  constexpr int c_per_group = 40;
+  for (int g = 0; g < c_groups; ++g)
+  {
+    const Shape_id gid = view().create_group("Group " + std::to_string(g), 0)->get_id();
+    for (int i = 0; i < c_per_group; ++i)
+    {
+      view().add_box(i * 2.0, g * 2.0, 0, 1, 1, 1 + i % 3);
+      ASSERT_TRUE(view().reparent_shape(view().get_shapes().back()->get_id(), gid, -1, false).is_ok());
+    }
+  }
+
+  const size_t shape_count = view().get_shapes().size();
+  ASSERT_EQ(shape_count, size_t(c_groups * (c_per_group + 1)));
+  const auto ms_since = [](std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  for (const bool binary : {false, true})
+  {
+    auto                       start = std::chrono::steady_clock::now();
+    Ezy_geom_entries           geoms;
+    const std::string          manifest = view().to_json(binary ? &geoms : nullptr);
+    const std::vector<uint8_t> bytes    = pack_ezy(manifest, view().asset_store(), geoms);
+    const double               save_ms  = ms_since(start);
+
+    view().new_file();
+    start         = std::chrono::steady_clock::now();
+    auto unpacked = unpack_ezy(std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+    ASSERT_TRUE(unpacked);
+    view().load(unpacked->manifest_json, false, &unpacked->geoms);
+    const double load_ms = ms_since(start);
+
+    std::cout << "[ bench    ] .ezy " << (binary ? "v4 binary" : "v3 text") << ": " << shape_count << " shapes, "
+              << manifest.size() / 1024 << " KiB manifest, " << bytes.size() / 1024 << " KiB archive, save " << save_ms
+              << " ms, load " << load_ms << " ms" << std::endl;
+
+    EXPECT_EQ(view().get_shapes().size(), shape_count);
+  }
+}
+
 // ---------------------------------------------------------------------------
 // Shape hierarchy (organizational groups)
 // ---------------------------------------------------------------------------
@@ -754,8 +1363,8 @@ TEST_F(Shp_test, Parent_chain_walk_tolerates_corrupt_cycle)
   Shp_ptr g2 = view().create_group("G2", 0);
   ASSERT_FALSE(g1.IsNull());
   ASSERT_FALSE(g2.IsNull());
-  g1->set_parent_id(g2->get_id());
-  g2->set_parent_id(g1->get_id());
+  view().apply_shape_link(g1->get_id(), g2->get_id(), 0);
+  view().apply_shape_link(g2->get_id(), g1->get_id(), 0);
 
   EXPECT_TRUE(view().would_reparent_create_cycle(g1->get_id(), g2->get_id()));
   EXPECT_FALSE(view().would_reparent_create_cycle(g1->get_id(), 0));
@@ -875,6 +1484,165 @@ TEST_F(Shp_test, Hierarchy_json_round_trip)
     EXPECT_EQ(c->get_parent_id(), group_id);
 }
 
+TEST_F(Shp_test, Registry_tracks_tree_edits_undo_and_load)
+{
+  for (int i = 0; i < 4; ++i)
+    view().add_box(2.0 * i, 0, 0, 1, 1, 1);
+
+  std::vector<Shp_ptr> boxes(view().get_shapes().begin(), view().get_shapes().end());
+  expect_registry_matches_scan(view());
+
+  ASSERT_TRUE(view().group_shapes({boxes[0], boxes[1]}).is_ok());
+  expect_registry_matches_scan(view());
+
+  Shp_ptr grp = view().create_group("Inner", view().current_group_id());
+  ASSERT_FALSE(grp.IsNull());
+  ASSERT_TRUE(view().reparent_shape(boxes[2]->get_id(), grp->get_id()).is_ok());
+  ASSERT_TRUE(view().reparent_shape(boxes[3]->get_id(), grp->get_id(), 0).is_ok());
+  expect_registry_matches_scan(view());
+  EXPECT_EQ(view().shape_descendant_solids(view().current_group_id()).size(), 4u);
+
+  ASSERT_TRUE(view().ungroup_shape(grp->get_id()).is_ok());
+  EXPECT_TRUE(view().find_shape_by_id(grp->get_id()).IsNull());
+  expect_registry_matches_scan(view());
+
+  while (view().undo())
+    expect_registry_matches_scan(view());
+
+  EXPECT_TRUE(view().get_shapes().empty());
+  while (view().redo())
+    expect_registry_matches_scan(view());
+
+  Shp_ptr redone = view().find_shape_by_id(boxes[1]->get_id()); // Redo re-creates shapes under their old ids.
+  ASSERT_FALSE(redone.IsNull());
+  view().delete_shapes({redone});
+  expect_registry_matches_scan(view());
+
+  const std::string json = view().to_json();
+  view().new_file();
+  expect_registry_matches_scan(view());
+  view().load(json, false);
+  expect_registry_matches_scan(view());
+}
+
+// A document with a duplicated shape id keeps the id findable until the last shape carrying it is gone.
+TEST_F(Shp_test, Registry_reindexes_duplicate_id_on_erase)
+{
+  view().add_box(0, 0, 0, 1, 1, 1);
+  view().add_box(2, 0, 0, 1, 1, 1);
+
+  nlohmann::json doc = nlohmann::json::parse(view().to_json());
+  ASSERT_EQ(doc["shapes"].size(), 2u);
+  const Shape_id id     = doc["shapes"][0]["id"].get<Shape_id>();
+  doc["shapes"][1]["id"] = id;
+  view().load(doc.dump(), false);
+  ASSERT_EQ(view().get_shapes().size(), 2u);
+
+  const Shp_ptr first  = view().get_shapes().front();
+  const Shp_ptr second = view().get_shapes().back();
+  EXPECT_EQ(view().find_shape_by_id(id), first);
+
+  view().delete_shapes({first});
+  EXPECT_EQ(view().find_shape_by_id(id), second);
+
+  view().delete_shapes({second});
+  EXPECT_TRUE(view().find_shape_by_id(id).IsNull());
+}
+
+TEST_F(Shp_test, Doc_tree_revision_tracks_structure_only)
+{
+  uint64_t rev = view().doc_tree_revision();
+  view().add_box(0, 0, 0, 1, 1, 1);
+  EXPECT_NE(view().doc_tree_revision(), rev);
+
+  Shp_ptr box = view().get_shapes().back();
+  rev         = view().doc_tree_revision();
+  box->set_name("Renamed");
+  box->set_visible(false);
+  EXPECT_EQ(view().doc_tree_revision(), rev);
+
+  Shp_ptr grp = view().create_group("Group", 0);
+  ASSERT_FALSE(grp.IsNull());
+  rev = view().doc_tree_revision();
+  ASSERT_TRUE(view().reparent_shape(box->get_id(), grp->get_id()).is_ok());
+  EXPECT_NE(view().doc_tree_revision(), rev);
+
+  rev = view().doc_tree_revision();
+  view().add_sketch(gp_Pln(gp::Origin(), gp::DZ()), "Sketch_xy");
+  EXPECT_NE(view().doc_tree_revision(), rev);
+
+  rev = view().doc_tree_revision();
+  EXPECT_TRUE(view().undo());
+  EXPECT_NE(view().doc_tree_revision(), rev);
+}
+
+TEST_F(Shp_test, Undo_checkpoint_shares_geometry_and_honors_budget)
+{
+  view().add_box(0, 0, 0, 1, 1, 1);
+  view().add_box(2, 0, 0, 1, 1, 1);
+  const Shp_ptr      first  = view().get_shapes().front();
+  const Shp_ptr      second = view().get_shapes().back();
+  const TopoDS_Shape geom   = first->Shape();
+
+  // Live geometry is shared with the add deltas, so only record overhead is counted.
+  EXPECT_LT(view().undo_memory_bytes(), approx_shape_bytes(geom));
+
+  view().push_undo_snapshot();
+  view().remove_shape_by_id(second->get_id());
+  ASSERT_EQ(view().get_shapes().size(), 1u);
+
+  ASSERT_TRUE(view().undo());
+  ASSERT_EQ(view().get_shapes().size(), 2u);
+  Shp_ptr restored = view().find_shape_by_id(first->get_id());
+  ASSERT_FALSE(restored.IsNull());
+  EXPECT_TRUE(restored->Shape().IsSame(geom)) << "Checkpoint restore must reuse the recorded TShape, not a BREP copy";
+  EXPECT_FALSE(view().find_shape_by_id(second->get_id()).IsNull());
+
+  ASSERT_TRUE(view().redo());
+  EXPECT_TRUE(view().find_shape_by_id(second->get_id()).IsNull());
+  EXPECT_GE(view().undo_memory_bytes(), approx_shape_bytes(second->Shape()));
+
+  // A tiny budget trims to the newest step, which stays undoable.
+  view().set_undo_budget_bytes(1);
+  EXPECT_EQ(view().undo_stack_size(), 1u);
+  ASSERT_TRUE(view().undo());
+  EXPECT_EQ(view().get_shapes().size(), 2u);
+  EXPECT_FALSE(view().undo());
+}
+
+// Checkpoints share clean sketch dumps with the previous capture; a sketch marked dirty in between is dumped again.
+TEST_F(Shp_test, Undo_checkpoint_redumps_edited_sketches)
+{
+  view().add_sketch(gp_Pln(gp::Origin(), gp::DZ()), "Sketch_a");
+  view().add_sketch(gp_Pln(gp::Origin(), gp::DX()), "Sketch_b");
+  Sketch_ptr other;
+  for (const Sketch_ptr& s : view().get_sketches())
+    if (s.get() != &view().curr_sketch())
+      other = s;
+
+  ASSERT_TRUE(other);
+  const size_t      other_id     = other->get_id();
+  const std::string current_name = view().curr_sketch().get_name();
+
+  view().push_undo_snapshot();
+  other->set_name("Renamed");
+  view().mark_sketch_dirty(other_id);
+  view().push_undo_snapshot();
+  other->set_name("Renamed again");
+
+  ASSERT_TRUE(view().undo());
+  size_t found = 0;
+  for (const Sketch_ptr& s : view().get_sketches())
+    if (s->get_id() == other_id)
+    {
+      EXPECT_EQ(s->get_name(), "Renamed");
+      ++found;
+    }
+
+  EXPECT_EQ(found, 1u);
+  EXPECT_EQ(view().curr_sketch().get_name(), current_name);
+}
+
 TEST_F(Shp_test, Hide_all_preserves_per_shape_visibility)
 {
   view().add_box(0, 0, 0, 1, 1, 1);
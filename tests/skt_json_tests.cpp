@@ -1,5 +1,9 @@
 #include "skt_test_fixture.h"
 
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
 #include <set>
 #include <string>
 #include <vector>
@@ -9,7 +13,9 @@
 #include "skt_nodes.h"
 #include "utl_geom.h"
 #include "utl_asset_store.h"
+#include "utl_deflate.h"
 #include "utl_io.h"
+#include "utl_mapped_file.h"
 
 using namespace glm;
 
@@ -245,6 +251,178 @@ TEST_F(Sketch_test, EzyZipUnderlayDedup)
   }
 }
 
+TEST_F(Sketch_test, DeflateRoundTripAllLevels)
+{
+  std::mt19937                       rng(5);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<std::vector<uint8_t>>  inputs(4);
+  inputs[1].assign({'a', 'b'});
+  for (int i = 0; i < 200000; ++i)
+    inputs[2].push_back(uint8_t(byte(rng)));
+
+  // Scanned-drawing style RGBA: white with periodic dark lines and sparse noise.
+  for (int i = 0; i < 300000; ++i)
+  {
+    const uint8_t v = (i % 97 == 0 || byte(rng) == 0) ? uint8_t(20) : uint8_t(255);
+    inputs[3].insert(inputs[3].end(), {v, v, v, 255});
+  }
+
+  for (const std::vector<uint8_t>& in : inputs)
+    for (int level : {0, 1, 6, 9})
+    {
+      std::vector<uint8_t> packed;
+      deflate_raw(in.data(), in.size(), level, packed);
+      std::string out;
+      ASSERT_TRUE(inflate_raw(packed.data(), packed.size(), in.size(), out)) << "level " << level << ", size " << in.size();
+      EXPECT_EQ(out, std::string(in.begin(), in.end()));
+      if (&in == &inputs[3] && level > 0)
+        EXPECT_LT(packed.size(), in.size() / 20);
+    }
+
+  std::vector<uint8_t> packed;
+  deflate_raw(inputs[3].data(), inputs[3].size(), 6, packed);
+  std::string out;
+  EXPECT_FALSE(inflate_raw(packed.data(), packed.size() / 2, inputs[3].size(), out));
+  EXPECT_FALSE(inflate_raw(packed.data(), packed.size(), inputs[3].size() - 1, out));
+}
+
+TEST_F(Sketch_test, EzyZipStreamsCompressedEntriesToSink)
+{
+  view().asset_store().clear();
+  std::vector<uint8_t> rgba(4 * 256 * 256, 255);
+  for (size_t i = 0; i < rgba.size(); i += 4 * 61)
+    rgba[i] = 0;
+
+  const std::string asset_id = view().asset_store().register_rgba(rgba, 256, 256);
+  nlohmann::json    doc      = nlohmann::json::parse(view().to_json());
+  nlohmann::json    sk       = minimal_sketch_json_with_underlay_b64(view().asset_store());
+  sk["underlay"]             = nlohmann::json::object({{"asset", asset_id}, {"w", 256}, {"h", 256}});
+  doc["sketches"]            = nlohmann::json::array({sk});
+  const std::string manifest = doc.dump();
+
+  std::vector<uint8_t> streamed;
+  size_t               chunks = 0;
+  ASSERT_TRUE(pack_ezy_to(
+      [&](const uint8_t* data, size_t size)
+      {
+        streamed.insert(streamed.end(), data, data + size);
+        ++chunks;
+        return true;
+      },
+      manifest, view().asset_store()));
+
+  EXPECT_GT(chunks, 2u);
+  EXPECT_EQ(streamed, pack_ezy(manifest, view().asset_store()));
+  EXPECT_LT(streamed.size(), rgba.size() / 20);
+
+  const auto unpacked = unpack_ezy(std::string(reinterpret_cast<const char*>(streamed.data()), streamed.size()));
+  ASSERT_TRUE(unpacked);
+  EXPECT_EQ(unpacked->manifest_json, manifest);
+  ASSERT_EQ(unpacked->assets.count(asset_id), 1u);
+  EXPECT_EQ(unpacked->assets.at(asset_id), rgba);
+
+  // A failing sink aborts the save.
+  EXPECT_FALSE(pack_ezy_to([](const uint8_t*, size_t) { return false; }, manifest, view().asset_store()));
+
+  // Corrupting compressed data fails the CRC / inflate check instead of loading garbage.
+  std::string corrupt(reinterpret_cast<const char*>(streamed.data()), streamed.size());
+  corrupt[60] = char(corrupt[60] ^ 0x5a);
+  EXPECT_FALSE(unpack_ezy(corrupt));
+
+  // A declared size past DEFLATE's maximum ratio is rejected from the central directory, before inflating.
+  std::string    oversized(reinterpret_cast<const char*>(streamed.data()), streamed.size());
+  const size_t   eocd      = oversized.size() - 22;
+  const uint32_t huge_size = 0x7fffffffu;
+  uint32_t       cd_offset = 0;
+  std::memcpy(&cd_offset, oversized.data() + eocd + 16, sizeof(cd_offset));
+  std::memcpy(oversized.data() + cd_offset + 24, &huge_size, sizeof(huge_size));
+  EXPECT_FALSE(unpack_ezy(oversized));
+}
+
+TEST_F(Sketch_test, EzyArchiveReadsEntriesOnDemand)
+{
+  view().asset_store().clear();
+  std::vector<uint8_t> rgba(4 * 64 * 64, 255);
+  for (size_t i = 0; i < rgba.size(); i += 4 * 13)
+    rgba[i] = 0;
+
+  const std::string asset_id = view().asset_store().register_rgba(rgba, 64, 64);
+  nlohmann::json    doc      = nlohmann::json::parse(view().to_json());
+  nlohmann::json    sk       = minimal_sketch_json_with_underlay_b64(view().asset_store());
+  sk["underlay"]             = nlohmann::json::object({{"asset", asset_id}, {"w", 64}, {"h", 64}});
+  doc["sketches"]            = nlohmann::json::array({sk});
+  const std::string          manifest = doc.dump();
+  const std::vector<uint8_t> zip      = pack_ezy(manifest, view().asset_store());
+  const std::string          bytes(reinterpret_cast<const char*>(zip.data()), zip.size());
+
+  const auto file = Mapped_file::from_bytes(bytes);
+  EXPECT_FALSE(file->mapped());
+  EXPECT_EQ(file->view(), bytes);
+  EXPECT_EQ(read_ezy_manifest(bytes), manifest);
+
+  const auto archive = Ezy_archive::open(file);
+  ASSERT_TRUE(archive);
+  EXPECT_EQ(archive->read_manifest(), manifest);
+  EXPECT_TRUE(archive->geom_ids().empty());
+  EXPECT_FALSE(archive->has_geom("1"));
+  EXPECT_FALSE(archive->read_geom("1"));
+  ASSERT_EQ(archive->asset_sizes().size(), 1u);
+  EXPECT_EQ(archive->asset_sizes()[0].first, asset_id);
+  EXPECT_EQ(archive->asset_sizes()[0].second, rgba.size());
+  EXPECT_EQ(archive->read_asset(asset_id), rgba);
+  EXPECT_FALSE(archive->read_asset("missing"));
+
+  // Lazy assets are read once, on first use.
+  Ezy_asset_store& store = view().asset_store();
+  int              reads = 0;
+  store.clear();
+  store.import_lazy_asset(asset_id, rgba.size(),
+                          [&]()
+                          {
+                            ++reads;
+                            return archive->read_asset(asset_id).value_or(std::vector<uint8_t>{});
+                          });
+  EXPECT_TRUE(store.contains(asset_id));
+  EXPECT_EQ(store.asset_size(asset_id), rgba.size());
+  EXPECT_EQ(reads, 0);
+  view().load(manifest, false);
+  ASSERT_TRUE(view().curr_sketch_shared());
+  EXPECT_TRUE(view().curr_sketch_shared()->underlay().has_image());
+
+  const auto data = store.get(asset_id);
+  ASSERT_TRUE(data);
+  EXPECT_EQ(*data, rgba);
+  (void)store.get(asset_id);
+  store.load_pending();
+  EXPECT_EQ(reads, 1);
+
+  // Only the central directory is checked when opening; a damaged entry fails when it is read.
+  std::string corrupt = bytes;
+  corrupt[60]         = char(corrupt[60] ^ 0x5a);
+  const auto damaged  = Ezy_archive::open(Mapped_file::from_bytes(corrupt));
+  ASSERT_TRUE(damaged);
+  EXPECT_FALSE(damaged->read_manifest());
+  EXPECT_EQ(damaged->read_asset(asset_id), rgba);
+
+  EXPECT_FALSE(Ezy_archive::open(Mapped_file::from_bytes(manifest)));
+
+#ifndef _WIN32
+  // Another process truncating a mapped project: the deferred read fails instead of faulting. (Windows refuses to
+  // truncate a file while a view of it exists.)
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "ezycad_truncated_test.ezy";
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+  const auto on_disk = Ezy_archive::open(Mapped_file::open(path.string()));
+  ASSERT_TRUE(on_disk);
+  EXPECT_EQ(on_disk->read_asset(asset_id), rgba);
+  std::filesystem::resize_file(path, 64);
+  EXPECT_FALSE(on_disk->read_asset(asset_id));
+  std::filesystem::remove(path);
+#endif
+}
+
 TEST_F(Sketch_test, LegacyUnderlayRgbaB64Load)
 {
   view().asset_store().clear();
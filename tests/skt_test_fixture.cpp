@@ -97,7 +97,9 @@ void Sketch_access::get_originating_face_snp_pts_3d_(Sketch& sketch, std::vector
 
 const std::vector<Sketch_face_shp_ptr>& Sketch_access::get_faces(const Sketch& sketch) { return sketch.m_topo.faces(); }
 
-const std::list<Sketch::Edge>& Sketch_access::get_edges(const Sketch& sketch) { return sketch.m_edges.edges(); }
+const Sketch_edges::Edge_store& Sketch_access::get_edges(const Sketch& sketch) { return sketch.m_edges.edges(); }
+
+const Sketch_edges& Sketch_access::get_sketch_edges(const Sketch& sketch) { return sketch.m_edges; }
 
 size_t Sketch_access::get_edge_count(const Sketch& sketch)
 {
@@ -228,3 +230,8 @@ TopoDS_Shape Shp_extrude_access::make_body(Shp_extrude& extrude, double extrude_
 {
   return extrude.make_body_(extrude_dist, side, twist_rad);
 }
+
+TopoDS_Shape Shp_extrude_access::preview_shape(const Shp_extrude& extrude)
+{
+  return extrude.m_extruded.IsNull() ? TopoDS_Shape() : extrude.m_extruded->Shape();
+}
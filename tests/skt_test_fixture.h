@@ -45,7 +45,8 @@ public:
   static void get_originating_face_snp_pts_3d_(Sketch& sketch, std::vector<gp_Pnt>& out);
 
   static const std::vector<Sketch_face_shp_ptr>& get_faces(const Sketch& sketch);
-  static const std::list<Sketch::Edge>&          get_edges(const Sketch& sketch);
+  static const Sketch_edges::Edge_store&         get_edges(const Sketch& sketch);
+  static const Sketch_edges&                     get_sketch_edges(const Sketch& sketch);
   static size_t                                  get_edge_count(const Sketch& sketch);
   static size_t                                  get_linear_edge_count(const Sketch& sketch);
   static size_t                                  get_arc_internal_edge_count(const Sketch& sketch);
@@ -81,6 +82,8 @@ public:
   static void lock_height_begin_twist(Shp_extrude& extrude);
   static void set_twist_angle_rad(Shp_extrude& extrude, double twist_rad);
   static TopoDS_Shape make_body(Shp_extrude& extrude, double extrude_dist, Plane_side side, double twist_rad);
+  /// Shape shown by the preview (face copy while the lite stand-in is active, else the body).
+  static TopoDS_Shape preview_shape(const Shp_extrude& extrude);
 };
 
 struct Headless_guard
@@ -5,7 +5,11 @@
 #include <TopoDS.hxx>
 #include <TopoDS_Wire.hxx>
 #include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <numbers>
+#include <random>
+#include <thread>
 #include <vector>
 
 #include "skt_edge.h"
@@ -725,6 +729,54 @@ TEST_F(Sketch_test, ExtrudeSketchFace_Twist_solid)
   EXPECT_EQ(shapes.back()->Shape().ShapeType(), TopAbs_SOLID);
 }
 
+TEST_F(Sketch_test, ExtrudeSketchFace_preview_body_from_worker)
+{
+  gp_Pln default_plane(gp::Origin(), gp::DZ());
+  Sketch sketch("PreviewWorker", view(), default_plane);
+
+  gp_Pnt2d p1(0, 0), p2(10, 0), p3(10, 5), p4(0, 5);
+  Sketch_access::add_edge_(sketch, p1, p2);
+  Sketch_access::add_edge_(sketch, p2, p3);
+  Sketch_access::add_edge_(sketch, p3, p4);
+  Sketch_access::add_edge_(sketch, p4, p1);
+  Sketch_access::update_faces_(sketch);
+  const auto& faces = Sketch_access::get_faces(sketch);
+  ASSERT_EQ(faces.size(), 1);
+
+  gui().set_mode(Mode::Sketch_face_extrude);
+  Shp_extrude& extrude = view().shp_extrude();
+  Shp_extrude_access::set_twist(extrude, true);
+  Shp_extrude_access::begin_face_extrude(extrude, faces[0], 8.0);
+  Shp_extrude_access::lock_height_begin_twist(extrude);
+
+  // Back-to-back requests: only the last one may end up shown.
+  Shp_extrude_access::set_twist_angle_rad(extrude, to_radians(30.0));
+  Shp_extrude_access::set_twist_angle_rad(extrude, to_radians(120.0));
+  ASSERT_TRUE(extrude.has_active_extrusion());
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (extrude.preview_busy() && std::chrono::steady_clock::now() < deadline)
+  {
+    extrude.poll_preview();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  ASSERT_FALSE(extrude.preview_busy());
+  const TopoDS_Shape shown = Shp_extrude_access::preview_shape(extrude);
+  ASSERT_EQ(shown.ShapeType(), TopAbs_SOLID);
+
+  const TopoDS_Shape expected = Shp_extrude_access::make_body(extrude, 8.0, Plane_side::Front, to_radians(120.0));
+  GProp_GProps       shown_props;
+  GProp_GProps       expected_props;
+  BRepGProp::VolumeProperties(shown, shown_props);
+  BRepGProp::VolumeProperties(expected, expected_props);
+  EXPECT_NEAR(shown_props.Mass(), expected_props.Mass(), 1e-6 * expected_props.Mass());
+  EXPECT_TRUE(shown_props.CentreOfMass().IsEqual(expected_props.CentreOfMass(), 1e-6));
+
+  extrude.finalize();
+  EXPECT_EQ(view().get_shapes().back()->Shape().ShapeType(), TopAbs_SOLID);
+}
+
 TEST_F(Sketch_test, ExtrudeSketchFace_Twist_both_sides_solid)
 {
   gp_Pln default_plane(gp::Origin(), gp::DZ());
@@ -940,3 +992,166 @@ TEST_F(Sketch_test, ProjectUnit_displayConversionAndJsonRoundTrip)
   view().new_file();
   EXPECT_EQ(view().get_project_unit(), Project_unit::Inch);
 }
+
+namespace
+{
+// Reference answer for `Sketch_nodes::nearest_node` (lowest index wins ties).
+std::optional<size_t> nearest_node_linear_(const Sketch_nodes& nodes, const gp_Pnt2d& pt, double max_dist)
+{
+  std::optional<size_t> best;
+  double                best_sq = max_dist * max_dist;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const Sketch_nodes::Node& n = nodes[i];
+    if (n.deleted || (n.origin && !nodes.origin_snap_enabled()))
+      continue;
+
+    const double sq = n.SquareDistance(pt);
+    if (sq <= best_sq && (!best || sq < best_sq))
+    {
+      best    = i;
+      best_sq = sq;
+    }
+  }
+
+  return best;
+}
+} // namespace
+
+// The node snap index must agree with a linear scan through add, move, delete and cancel.
+TEST_F(Sketch_test, NodeSnapIndexMatchesLinearScan)
+{
+  gp_Pln        default_plane(gp::Origin(), gp::DZ());
+  Sketch        sketch("NodeSnapIndex", view(), default_plane);
+  Sketch_nodes& nodes = sketch.get_nodes();
+
+  std::mt19937                           rng(7);
+  std::uniform_real_distribution<double> coord(-500.0, 500.0);
+  for (int i = 0; i < 2000; ++i)
+    nodes.add_new_node(gp_Pnt2d(coord(rng), coord(rng)));
+
+  nodes.finalize();
+
+  for (size_t i = 1; i < nodes.size(); i += 7)
+    nodes[i].deleted = true;
+
+  for (size_t i = 2; i < nodes.size(); i += 11)
+    nodes.set_node_pt(i, gp_Pnt2d(coord(rng), coord(rng)));
+
+  // Nodes dropped by cancel() must leave the index too.
+  const gp_Pnt2d transient(2000.0, 2000.0);
+  nodes.add_new_node(transient);
+  nodes.cancel();
+  EXPECT_FALSE(nodes.nearest_node(transient, 1.0).has_value());
+
+  std::uniform_real_distribution<double> radius(0.0, 60.0);
+  for (int q = 0; q < 500; ++q)
+  {
+    const gp_Pnt2d pt(coord(rng), coord(rng));
+    const double   r = radius(rng);
+    EXPECT_EQ(nodes.nearest_node(pt, r), nearest_node_linear_(nodes, pt, r)) << "query " << q;
+  }
+
+  // Exact lookups reuse live nodes and revive tombstones instead of appending.
+  const size_t count = nodes.size();
+  EXPECT_EQ(nodes.get_node_exact(gp_Pnt2d(nodes[3])), 3u);
+
+  const gp_Pnt2d tombstone = nodes[1];
+  EXPECT_EQ(nodes.get_node_exact(tombstone), 1u);
+  EXPECT_FALSE(nodes[1].deleted);
+  EXPECT_EQ(nodes.size(), count);
+}
+
+// Benchmark: snap lookup latency against node count (prints timings; only checks results).
+TEST_F(Sketch_test, NodeSnapLatencyVsNodeCount)
+{
+  gp_Pln default_plane(gp::Origin(), gp::DZ());
+
+  for (const size_t node_count : {1000u, 10000u, 50000u})
+  {
+    Sketch        sketch("NodeSnapBench", view(), default_plane);
+    Sketch_nodes& nodes = sketch.get_nodes();
+
+    // Traced-underlay style: dense jittered lattice.
+    std::mt19937                           rng(11);
+    std::uniform_real_distribution<double> jitter(-0.25, 0.25);
+    const size_t                           side = static_cast<size_t>(std::ceil(std::sqrt(double(node_count))));
+    for (size_t i = 0; i < node_count; ++i)
+      nodes.add_new_node(gp_Pnt2d(double(i % side) + jitter(rng), double(i / side) + jitter(rng)));
+
+    nodes.finalize();
+
+    constexpr int                          c_queries = 2000;
+    std::uniform_real_distribution<double> coord(0.0, double(side));
+    std::vector<gp_Pnt2d>                  queries;
+    for (int q = 0; q < c_queries; ++q)
+      queries.emplace_back(coord(rng), coord(rng));
+
+    size_t     hits  = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const gp_Pnt2d& pt : queries)
+      if (nodes.nearest_node(pt, 0.5))
+        ++hits;
+
+    for (size_t q = 0; q < queries.size(); ++q)
+      EXPECT_EQ(nodes.get_node_exact(nodes[(q * 7919) % nodes.size()]), (q * 7919) % nodes.size());
+
+    const auto   elapsed  = std::chrono::steady_clock::now() - start;
+    const double us_per_q = std::chrono::duration<double, std::micro>(elapsed).count() / (2.0 * c_queries);
+    std::cout << "[ bench    ] node snap: " << node_count << " nodes, " << us_per_q << " us/query (" << hits << " hits)"
+              << std::endl;
+
+    EXPECT_EQ(nodes.size(), node_count + 1); // + origin
+  }
+}
+
+// Axis-guide snapping reads the sorted U / V indexes; they must follow node moves, cancel, and outside points.
+TEST_F(Sketch_test, AxisSnapIndexTracksNodeChanges)
+{
+  Headless_guard guard(view());
+
+  gp_Pln        default_plane(gp::Origin(), gp::DZ());
+  Sketch        sketch("AxisSnapIndex", view(), default_plane);
+  Sketch_nodes& nodes = sketch.get_nodes();
+
+  for (int i = 1; i <= 30; ++i)
+    for (int j = 1; j <= 30; ++j)
+      nodes.add_new_node(gp_Pnt2d(100.0 * i, 100.0 * j));
+
+  nodes.finalize();
+
+  // X matches the column at 200; no row is near 5000 so Y is left alone.
+  gp_Pnt2d pt(201.0, 5000.0);
+  EXPECT_FALSE(nodes.try_get_node_idx_snap(pt).has_value());
+  EXPECT_NEAR(pt.X(), 200.0, Precision::Confusion());
+  EXPECT_NEAR(pt.Y(), 5000.0, Precision::Confusion());
+
+  // A moved node snaps at its new position only.
+  const size_t moved = 5;
+  nodes.set_node_pt(moved, gp_Pnt2d(7777.0, 8888.0));
+  pt = gp_Pnt2d(7778.0, 8887.0);
+  EXPECT_EQ(nodes.try_get_node_idx_snap(pt), moved);
+
+  nodes.set_node_pt(moved, gp_Pnt2d(-7777.0, -8888.0));
+  pt = gp_Pnt2d(7778.0, 8887.0);
+  EXPECT_FALSE(nodes.try_get_node_idx_snap(pt).has_value());
+  EXPECT_NEAR(pt.X(), 7778.0, Precision::Confusion());
+
+  // Transient nodes dropped by cancel() no longer act as guides.
+  nodes.add_new_node(gp_Pnt2d(9100.0, 9100.0));
+  nodes.cancel();
+  pt = gp_Pnt2d(9101.0, 9101.0);
+  EXPECT_FALSE(nodes.try_get_node_idx_snap(pt).has_value());
+  EXPECT_NEAR(pt.X(), 9101.0, Precision::Confusion());
+
+  // Points projected from other sketches guide the axis too.
+  nodes.add_outside_snap_pnt(gp_Pnt(12345.0, 0.0, 0.0));
+  pt = gp_Pnt2d(12346.0, 6000.0);
+  EXPECT_FALSE(nodes.try_get_node_idx_snap(pt).has_value());
+  EXPECT_NEAR(pt.X(), 12345.0, Precision::Confusion());
+
+  nodes.clear_outside_snap_pnts();
+  pt = gp_Pnt2d(12346.0, 6000.0);
+  nodes.try_get_node_idx_snap(pt);
+  EXPECT_NEAR(pt.X(), 12346.0, Precision::Confusion());
+}
@@ -7,7 +7,9 @@
 #include <TopoDS.hxx>
 #include <TopoDS_Wire.hxx>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <iostream>
 #include <numbers>
 #include <vector>
 
@@ -563,6 +565,218 @@ TEST_F(Sketch_test, UpdateFaces_MultipleFaces)
   }
 }
 
+// Faces whose boundary cycle is untouched by an edit keep their AIS object; a face that gains a hole keeps its
+// object but has the hole cut into its shape.
+TEST_F(Sketch_test, UpdateFaces_ReusesUnchangedFaces)
+{
+  Sketch sketch("test_sketch", view(), gp_Pln(gp::Origin(), gp::DZ()));
+
+  auto add_rect = [&](double x0, double y0, double x1, double y1)
+  {
+    Sketch_access::add_edge_(sketch, {x0, y0}, {x1, y0});
+    Sketch_access::add_edge_(sketch, {x1, y0}, {x1, y1});
+    Sketch_access::add_edge_(sketch, {x1, y1}, {x0, y1});
+    Sketch_access::add_edge_(sketch, {x0, y1}, {x0, y0});
+    Sketch_access::update_faces_(sketch);
+  };
+
+  add_rect(0, 0, 20, 20);
+  ASSERT_EQ(Sketch_access::get_faces(sketch).size(), 1);
+  const Sketch_face_shp_ptr outer = Sketch_access::get_faces(sketch)[0];
+
+  // Unrelated rectangle: the first face must be reused as-is.
+  add_rect(30, 0, 40, 10);
+  const auto& faces = Sketch_access::get_faces(sketch);
+  ASSERT_EQ(faces.size(), 2);
+  EXPECT_EQ(std::count(faces.begin(), faces.end(), outer), 1);
+  Sketch_face_shp_ptr other = faces[0] == outer ? faces[1] : faces[0];
+
+  // Rectangle inside the first one: both existing faces are reused, the first one now has a hole.
+  add_rect(5, 5, 15, 15);
+  ASSERT_EQ(faces.size(), 3);
+  EXPECT_EQ(std::count(faces.begin(), faces.end(), outer), 1);
+  EXPECT_EQ(std::count(faces.begin(), faces.end(), other), 1);
+  EXPECT_EQ(to_boost(outer->Shape(), sketch.get_plane()).inners().size(), 1);
+  EXPECT_EQ(to_boost(other->Shape(), sketch.get_plane()).inners().size(), 0);
+
+  // Re-running without edits keeps every face.
+  const std::vector<Sketch_face_shp_ptr> before = faces;
+  Sketch_access::update_faces_(sketch);
+  EXPECT_EQ(faces, before);
+}
+
+// Benchmark: dangling-edge peel on a 100k-segment open chain hanging off a square (prints timing; checks the face).
+TEST_F(Sketch_test, UpdateFaces_LongOpenChainBench)
+{
+  Sketch sketch("test_sketch", view(), gp_Pln(gp::Origin(), gp::DZ()));
+
+  Sketch_access::add_edge_raw_(sketch, {0, 0}, {-10, 0});
+  Sketch_access::add_edge_raw_(sketch, {-10, 0}, {-10, -10});
+  Sketch_access::add_edge_raw_(sketch, {-10, -10}, {0, -10});
+  Sketch_access::add_edge_raw_(sketch, {0, -10}, {0, 0});
+
+  // Zig-zag so consecutive segments are never collinear.
+  constexpr size_t c_segments = 100000;
+  for (size_t i = 0; i < c_segments; ++i)
+    Sketch_access::add_edge_raw_(sketch, {double(i), double(i % 2)}, {double(i + 1), double((i + 1) % 2)});
+
+  ASSERT_EQ(Sketch_access::get_edge_count(sketch), c_segments + 4);
+
+  const auto start = std::chrono::steady_clock::now();
+  Sketch_access::update_faces_(sketch);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "[ bench    ] update_faces: " << c_segments << "-segment open chain, "
+            << std::chrono::duration<double, std::milli>(elapsed).count() << " ms" << std::endl;
+
+  const auto& faces = Sketch_access::get_faces(sketch);
+  ASSERT_EQ(faces.size(), 1);
+  EXPECT_NEAR(compute_face_area(faces[0]), 100.0, 1e-6);
+}
+
+// Perforated plate: many holes, one with an island. Nesting must attach each hole to the plate and the island to
+// its hole (prints timing of the first build).
+TEST_F(Sketch_test, UpdateFaces_PerforatedPlateNesting)
+{
+  Sketch sketch("test_sketch", view(), gp_Pln(gp::Origin(), gp::DZ()));
+
+  auto add_rect = [&](double x0, double y0, double x1, double y1)
+  {
+    Sketch_access::add_edge_raw_(sketch, {x0, y0}, {x1, y0});
+    Sketch_access::add_edge_raw_(sketch, {x1, y0}, {x1, y1});
+    Sketch_access::add_edge_raw_(sketch, {x1, y1}, {x0, y1});
+    Sketch_access::add_edge_raw_(sketch, {x0, y1}, {x0, y0});
+  };
+
+  constexpr int c_side = 15;
+  add_rect(0, 0, 10.0 * c_side, 10.0 * c_side);
+  for (int i = 0; i < c_side; ++i)
+    for (int j = 0; j < c_side; ++j)
+      add_rect(10.0 * i + 2, 10.0 * j + 2, 10.0 * i + 8, 10.0 * j + 8);
+
+  add_rect(4, 4, 6, 6); // Island in the first hole
+
+  const auto start = std::chrono::steady_clock::now();
+  Sketch_access::update_faces_(sketch);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "[ bench    ] update_faces: plate with " << c_side * c_side << " holes, "
+            << std::chrono::duration<double, std::milli>(elapsed).count() << " ms" << std::endl;
+
+  const auto& faces = Sketch_access::get_faces(sketch);
+  ASSERT_EQ(faces.size(), size_t(c_side * c_side + 2));
+
+  size_t plates = 0, holes_with_island = 0;
+  for (const auto& face : faces)
+  {
+    const size_t inners = to_boost(face->Shape(), sketch.get_plane()).inners().size();
+    if (inners == size_t(c_side * c_side))
+      ++plates;
+    else if (inners == 1)
+      ++holes_with_island;
+    else
+      EXPECT_EQ(inners, 0);
+  }
+
+  EXPECT_EQ(plates, 1);
+  EXPECT_EQ(holes_with_island, 1);
+}
+
+// Lattice of crossing lines added through the splitting path: every crossing must split both lines (prints timing
+// of the adds, which run their intersection and split queries through the segment index).
+TEST_F(Sketch_test, AddEdges_CrossingLattice_SplitsEveryCrossing)
+{
+  Sketch sketch("test_sketch", view(), gp_Pln(gp::Origin(), gp::DZ()));
+
+  constexpr int c_lines = 30;
+  const auto    start   = std::chrono::steady_clock::now();
+  for (int i = 1; i <= c_lines; ++i)
+  {
+    Sketch_access::add_edge_(sketch, {0.0, double(i)}, {double(c_lines + 1), double(i)});
+    Sketch_access::add_edge_(sketch, {double(i), 0.0}, {double(i), double(c_lines + 1)});
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "[ bench    ] add_edge: " << 2 * c_lines << "-line lattice, "
+            << std::chrono::duration<double, std::milli>(elapsed).count() << " ms" << std::endl;
+
+  // Each line is crossed by `c_lines` others, leaving `c_lines + 1` pieces.
+  ASSERT_EQ(Sketch_access::get_edge_count(sketch), size_t(2 * c_lines * (c_lines + 1)));
+  for (const Sketch::Edge& e : Sketch_access::get_edges(sketch))
+  {
+    const gp_Pnt2d& a = sketch.get_nodes()[e.node_idx_a];
+    const gp_Pnt2d& b = sketch.get_nodes()[*e.node_idx_b];
+    EXPECT_NEAR(a.Distance(b), 1.0, 1e-9);
+  }
+
+  Sketch_access::update_faces_(sketch);
+  EXPECT_EQ(Sketch_access::get_faces(sketch).size(), size_t((c_lines - 1) * (c_lines - 1)));
+}
+
+// Node moves reach the segment index through the move log, so an edge is found at its new position without a rebuild.
+TEST_F(Sketch_test, AddEdges_SegmentIndexFollowsNodeMoves)
+{
+  Sketch        sketch("test_sketch", view(), gp_Pln(gp::Origin(), gp::DZ()));
+  Sketch_nodes& nodes = sketch.get_nodes();
+
+  Sketch_access::add_edge_(sketch, {0, 0}, {10, 0});
+  ASSERT_EQ(Sketch_access::get_edge_count(sketch), 1);
+
+  const size_t   idx_b = *Sketch_access::get_edges(sketch).begin()->node_idx_b;
+  const uint64_t stamp = nodes.move_stamp();
+  nodes.set_node_pt(idx_b, gp_Pnt2d(10, 0));
+  EXPECT_EQ(nodes.move_stamp(), stamp) << "Writing the same position is not a move";
+
+  nodes.set_node_pt(idx_b, gp_Pnt2d(10, 100));
+  const auto moves = nodes.moves_since(stamp);
+  ASSERT_TRUE(moves.has_value());
+  ASSERT_EQ(moves->size(), 1);
+  EXPECT_EQ((*moves)[0].idx, idx_b);
+  EXPECT_LT((*moves)[0].old_pt.Distance(gp_Pnt2d(10, 0)), Precision::Confusion());
+
+  // Crosses the moved edge (now (0,0)-(10,100)) at (5,50), far from where it was indexed.
+  Sketch_access::add_edge_(sketch, {0, 50}, {10, 50});
+  EXPECT_EQ(Sketch_access::get_edge_count(sketch), 4);
+}
+
+// Splitting one edge must not disturb the handles of the others; freed slots are reused and the flat end-node arrays
+// match the edge records.
+TEST_F(Sketch_test, AddEdges_SplitKeepsOtherEdgeHandles)
+{
+  Sketch sketch("test_sketch", view(), gp_Pln(gp::Origin(), gp::DZ()));
+
+  Sketch_access::add_edge_(sketch, {0, 0}, {10, 0});
+  Sketch_access::add_edge_(sketch, {0, 5}, {10, 5});
+
+  const Sketch_edges::Edge_store&          store = Sketch_access::get_edges(sketch);
+  std::optional<Sketch_edges::Edge_handle> upper;
+  for (auto itr = store.begin(); itr != store.end(); ++itr)
+    if (sketch.get_nodes()[itr->node_idx_a].Y() > 1.0)
+      upper = itr.handle();
+
+  ASSERT_TRUE(upper.has_value());
+  const Sketch_AIS_edge_ptr upper_shp = store[*upper].shp;
+
+  // Crosses the lower line only.
+  Sketch_access::add_edge_(sketch, {3, -5}, {3, 2});
+
+  ASSERT_EQ(store.size(), 5);
+  EXPECT_EQ(store.slot_count(), store.size()) << "The split edge's slot should be reused";
+  ASSERT_TRUE(store.contains(*upper));
+  EXPECT_EQ(store[*upper].shp, upper_shp);
+
+  const Sketch_edges& edges = Sketch_access::get_sketch_edges(sketch);
+  for (auto itr = store.begin(); itr != store.end(); ++itr)
+  {
+    EXPECT_EQ(edges.kinds()[itr.handle()], Sketch_edges::Edge_kind::Linear);
+    EXPECT_EQ(edges.end_nodes_a()[itr.handle()], itr->node_idx_a);
+    EXPECT_EQ(edges.end_nodes_b()[itr.handle()], *itr->node_idx_b);
+    EXPECT_EQ(edges.mid_nodes()[itr.handle()], itr->node_idx_mid.value_or(Sketch_edges::k_no_node));
+  }
+
+  size_t visited = 0;
+  edges.for_each_linear([&](const Sketch_edge_linear&) { ++visited; });
+  EXPECT_EQ(visited, store.size());
+}
+
 // Invalid face (non-closed shape)
 TEST_F(Sketch_test, UpdateFaces_InvalidFace)
 {